@@ -0,0 +1,594 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_BIT_MATRIX_H__
+#define __ALP_BIT_MATRIX_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Matriz de bits (máscaras).
+ *
+ *  - COMENTARIOS: Un Matrix<bool> ocupa un byte por pixel. Bit_matrix
+ *	guarda 64 pixels por palabra: el pixel (i, j) es el bit j % 64 de la
+ *	palabra j / 64 de la fila i. Cada fila empieza en una palabra nueva
+ *	(words_per_row() palabras por fila) y los bits de relleno de la última
+ *	palabra de cada fila siempre valen 0.
+ *
+ *	Sigue el interfaz de Matrix (rows, cols, Position, Range2D...), pero
+ *	operator() devuelve un proxy (Bit_matrix::reference) ya que no se
+ *	puede tener una referencia a un bit.
+ *
+ *	Las operaciones lógicas (&, |, ^, ~), contar pixels (count) y buscar
+ *	pixels a 1 (find_next, for_each_set) trabajan palabra a palabra.
+ *
+ *	Para convertir de/a Matrix: from_matrix(m, pred) y to_matrix.
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    19/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "alp_rframe_ij.h"
+#include "alp_matrix.h"
+
+namespace alp{
+
+template <typename Ind_t = size_t>
+class Bit_matrix{
+public:
+    using value_type      = bool;
+    using word_type	  = uint64_t;
+
+    using size_type       = Ind_t;
+    using difference_type = std::make_signed_t<Ind_t>;
+
+    using Ind	    = Ind_t;
+    using Position  = Vector_ij<Ind>;
+    using Size2D    = alp::Size_ij<Ind>;
+    using Range2D   = alp::Range_ij<Ind>;
+
+    /// Referencia al pixel (i, j)
+    class reference{
+    public:
+	reference& operator=(bool x)
+	{
+	    if (x) *w_ |= mask_;
+	    else   *w_ &= ~mask_;
+
+	    return *this;
+	}
+
+	reference& operator=(const reference& x)
+	{ return *this = static_cast<bool>(x); }
+
+	operator bool() const {return (*w_ & mask_) != 0;}
+
+	void flip() {*w_ ^= mask_;}
+
+    private:
+	word_type* w_;
+	word_type mask_;
+
+	reference(word_type* w, word_type mask) : w_{w}, mask_{mask} { }
+	friend class Bit_matrix;
+    };
+
+    using const_reference = bool;
+
+
+// Construcción
+// ------------
+    /// Matrix de rows x cols con todos los pixels a value
+    Bit_matrix(Ind rows, Ind cols, bool value = false);
+
+    /// Matrix de rows x cols con todos los pixels a value
+    Bit_matrix(Size2D sz, bool value = false)
+	: Bit_matrix{sz.rows, sz.cols, value} { }
+
+    /// Máscara con los pixels x de m que cumplen pred(x)
+    template <typename T, typename Pred>
+    static Bit_matrix from_matrix(const Matrix<T, Ind>& m, Pred pred);
+
+    /// Máscara con los pixels diferentes de T{}
+    template <typename T>
+    static Bit_matrix from_matrix(const Matrix<T, Ind>& m)
+    { return from_matrix(m, [](const T& x) { return x != T{}; }); }
+
+
+// Dimensiones
+// -----------
+    /// Número de pixels
+    size_type size() const {return rows() * cols();}
+
+    /// Número de filas
+    Ind rows() const {return rows_;}
+
+    /// Número de columnas
+    Ind cols() const {return cols_;}
+
+    /// Dimensiones de la matrix
+    Size2D size2D() const {return Size2D{rows(), cols()};}
+
+    /// Extensión que ocupa dentro del sistema de referencia local (i, j)
+    Range2D extension() const {return Range2D{0, rows(), 0, cols()};}
+
+    /// Número de palabras que ocupa cada fila
+    Ind words_per_row() const {return nw_;}
+
+
+// Acceso aleatorio
+// ----------------
+    reference operator()(Ind i, Ind j)
+    { return reference{&w_[i * nw_ + j / 64], bit(j)}; }
+
+    bool operator()(Ind i, Ind j) const
+    { return (w_[i * nw_ + j / 64] & bit(j)) != 0; }
+
+    reference operator()(const Position& p) {return (*this)(p.i, p.j);}
+    bool operator()(const Position& p) const {return (*this)(p.i, p.j);}
+
+
+// Acceso a las palabras
+// ---------------------
+    /// Palabras de la fila i
+    word_type* row_data(Ind i) {return &w_[i * nw_];}
+    const word_type* row_data(Ind i) const {return &w_[i * nw_];}
+
+    word_type* data() {return w_.data();}
+    const word_type* data() const {return w_.data();}
+
+
+// Modificación
+// ------------
+    /// Todos los pixels a x
+    void fill(bool x);
+
+    /// Pixels del rango rg a x
+    void fill(const Range2D& rg, bool x);
+
+    /// Invierte todos los pixels
+    void flip();
+
+
+// Operaciones lógicas
+// -------------------
+    Bit_matrix& operator&=(const Bit_matrix& b);
+    Bit_matrix& operator|=(const Bit_matrix& b);
+    Bit_matrix& operator^=(const Bit_matrix& b);
+
+    /// this = this and not b
+    Bit_matrix& and_not(const Bit_matrix& b);
+
+    bool operator==(const Bit_matrix& b) const
+    { return rows_ == b.rows_ and cols_ == b.cols_ and w_ == b.w_; }
+
+
+// Contar pixels
+// -------------
+    /// Número de pixels a 1
+    size_type count() const;
+
+    /// Número de pixels a 1 de la fila i
+    size_type count_row(Ind i) const;
+
+    /// Número de pixels a 1 dentro del rango rg
+    size_type count(const Range2D& rg) const;
+
+    bool any() const;
+    bool none() const {return !any();}
+
+
+// Búsqueda
+// --------
+    /// Primer pixel a 1 en p o después (recorriendo por filas). Si no hay
+    /// ninguno devuelve {rows(), 0}.
+    Position find_next(const Position& p) const;
+
+    /// Primer pixel a 1. Si no hay ninguno devuelve {rows(), 0}.
+    Position find_first() const {return find_next(Position{0, 0});}
+
+    /// Llama a f(i, j) para cada pixel a 1, recorriendo por filas.
+    template <typename F>
+    void for_each_set(F f) const;
+
+private:
+// Data
+    Ind rows_, cols_;
+    Ind nw_;			// palabras por fila
+    std::vector<word_type> w_;
+
+// Helpers
+    static word_type bit(Ind j) {return word_type{1} << (j % 64);}
+
+    // Máscara con los bits [b0, be) de una palabra (0 <= b0 <= be <= 64)
+    static word_type bits(Ind b0, Ind be);
+
+    // Máscara de los pixels válidos de la última palabra de cada fila
+    word_type ultima() const {return bits(0, cols_ - (nw_ - 1) * 64);}
+
+    void borra_relleno();
+
+    // Parte de rg que está dentro de la matriz
+    Range2D recorta(const Range2D& rg) const;
+
+    void check_size(const Bit_matrix& b) const
+    {
+	if (size2D() != b.size2D())
+	    throw std::logic_error{"Bit_matrix: matrices de diferente tamaño"};
+    }
+
+    // Llama a f(w, mask) para las palabras w de la fila i que tienen
+    // pixels de [j0, je), siendo mask los bits de esos pixels.
+    template <typename W, typename F>
+    static void recorre_fila(W* w, Ind j0, Ind je, F f);
+};
+
+
+template <typename I>
+Bit_matrix<I>::Bit_matrix(Ind rows, Ind cols, bool value)
+    : rows_{rows}, cols_{cols}, nw_{static_cast<Ind>((cols + 63) / 64)},
+      w_(rows * nw_, value? ~word_type{0}: word_type{0})
+{
+    if (value)
+	borra_relleno();
+}
+
+
+template <typename I>
+template <typename T, typename Pred>
+Bit_matrix<I> Bit_matrix<I>::from_matrix(const Matrix<T, I>& m, Pred pred)
+{
+    Bit_matrix res{m.rows(), m.cols()};
+
+    for (Ind i = 0; i < m.rows(); ++i){
+	word_type* w = res.row_data(i);
+
+	for (Ind k = 0; k < res.nw_; ++k){
+	    Ind j0 = k * 64;
+	    Ind je = std::min<Ind>(j0 + 64, m.cols());
+
+	    word_type x = 0;
+	    for (Ind j = j0; j < je; ++j)
+		x |= static_cast<word_type>(pred(m(i, j)) ? 1: 0) << (j - j0);
+
+	    w[k] = x;
+	}
+    }
+
+    return res;
+}
+
+
+template <typename I>
+inline typename Bit_matrix<I>::word_type Bit_matrix<I>::bits(Ind b0, Ind be)
+{
+    word_type hi = (be >= 64)? ~word_type{0}: (word_type{1} << be) - 1;
+    word_type lo = (b0 >= 64)? ~word_type{0}: (word_type{1} << b0) - 1;
+    return hi & ~lo;
+}
+
+
+template <typename I>
+void Bit_matrix<I>::borra_relleno()
+{
+    if (nw_ == 0)
+	return;
+
+    word_type u = ultima();
+    for (Ind i = 0; i < rows_; ++i)
+	w_[i * nw_ + nw_ - 1] &= u;
+}
+
+
+template <typename I>
+typename Bit_matrix<I>::Range2D Bit_matrix<I>::recorta(const Range2D& rg) const
+{
+    Ind i0 = std::max<Ind>(rg.i0, 0);
+    Ind ie = std::min<Ind>(rg.ie, rows_);
+    Ind j0 = std::max<Ind>(rg.j0, 0);
+    Ind je = std::min<Ind>(rg.je, cols_);
+
+    if (i0 >= ie or j0 >= je)
+	return Range2D{};
+
+    return Range2D{i0, ie, j0, je};
+}
+
+
+template <typename I>
+template <typename W, typename F>
+void Bit_matrix<I>::recorre_fila(W* w, Ind j0, Ind je, F f)
+{
+    if (j0 >= je)
+	return;
+
+    Ind k0 = j0 / 64;
+    Ind ke = (je - 1) / 64;
+
+    if (k0 == ke){
+	f(w[k0], bits(j0 % 64, je - k0 * 64));
+	return;
+    }
+
+    f(w[k0], bits(j0 % 64, 64));
+    for (Ind k = k0 + 1; k < ke; ++k)
+	f(w[k], ~word_type{0});
+
+    f(w[ke], bits(0, je - ke * 64));
+}
+
+
+template <typename I>
+void Bit_matrix<I>::fill(bool x)
+{
+    std::fill(w_.begin(), w_.end(), x? ~word_type{0}: word_type{0});
+
+    if (x)
+	borra_relleno();
+}
+
+
+template <typename I>
+void Bit_matrix<I>::fill(const Range2D& rg, bool x)
+{
+    Range2D r = recorta(rg);
+    if (r.empty())
+	return;
+
+    for (Ind i = r.i0; i < r.ie; ++i)
+	recorre_fila(row_data(i), r.j0, r.je, [x](word_type& w, word_type m) {
+	    if (x) w |= m;
+	    else   w &= ~m;
+	});
+}
+
+
+template <typename I>
+void Bit_matrix<I>::flip()
+{
+    for (auto& w: w_)
+	w = ~w;
+
+    borra_relleno();
+}
+
+
+template <typename I>
+Bit_matrix<I>& Bit_matrix<I>::operator&=(const Bit_matrix& b)
+{
+    check_size(b);
+
+    word_type* p = w_.data();
+    const word_type* q = b.w_.data();
+    for (size_t k = 0; k < w_.size(); ++k)
+	p[k] &= q[k];
+
+    return *this;
+}
+
+
+template <typename I>
+Bit_matrix<I>& Bit_matrix<I>::operator|=(const Bit_matrix& b)
+{
+    check_size(b);
+
+    word_type* p = w_.data();
+    const word_type* q = b.w_.data();
+    for (size_t k = 0; k < w_.size(); ++k)
+	p[k] |= q[k];
+
+    return *this;
+}
+
+
+template <typename I>
+Bit_matrix<I>& Bit_matrix<I>::operator^=(const Bit_matrix& b)
+{
+    check_size(b);
+
+    word_type* p = w_.data();
+    const word_type* q = b.w_.data();
+    for (size_t k = 0; k < w_.size(); ++k)
+	p[k] ^= q[k];
+
+    return *this;
+}
+
+
+template <typename I>
+Bit_matrix<I>& Bit_matrix<I>::and_not(const Bit_matrix& b)
+{
+    check_size(b);
+
+    word_type* p = w_.data();
+    const word_type* q = b.w_.data();
+    for (size_t k = 0; k < w_.size(); ++k)
+	p[k] &= ~q[k];
+
+    return *this;
+}
+
+
+template <typename I>
+typename Bit_matrix<I>::size_type Bit_matrix<I>::count() const
+{
+    size_type n = 0;
+    for (word_type w: w_)
+	n += static_cast<size_type>(std::popcount(w));
+
+    return n;
+}
+
+
+template <typename I>
+typename Bit_matrix<I>::size_type Bit_matrix<I>::count_row(Ind i) const
+{
+    const word_type* w = row_data(i);
+
+    size_type n = 0;
+    for (Ind k = 0; k < nw_; ++k)
+	n += static_cast<size_type>(std::popcount(w[k]));
+
+    return n;
+}
+
+
+template <typename I>
+typename Bit_matrix<I>::size_type
+	    Bit_matrix<I>::count(const Range2D& rg) const
+{
+    Range2D r = recorta(rg);
+    if (r.empty())
+	return 0;
+
+    size_type n = 0;
+    for (Ind i = r.i0; i < r.ie; ++i)
+	recorre_fila(row_data(i), r.j0, r.je, [&n](word_type w, word_type m) {
+	    n += static_cast<size_type>(std::popcount(w & m));
+	});
+
+    return n;
+}
+
+
+template <typename I>
+bool Bit_matrix<I>::any() const
+{
+    return std::any_of(w_.begin(), w_.end(),
+			[](word_type w) { return w != 0; });
+}
+
+
+template <typename I>
+typename Bit_matrix<I>::Position
+	Bit_matrix<I>::find_next(const Position& p) const
+{
+    Ind i = p.i;
+    Ind k = p.j / 64;
+    word_type mask = bits(p.j % 64, 64);
+
+    if (p.j >= cols_){	// pasamos a la siguiente fila
+	++i;
+	k = 0;
+	mask = ~word_type{0};
+    }
+
+    for (; i < rows_; ++i){
+	const word_type* w = row_data(i);
+
+	for (; k < nw_; ++k){
+	    word_type x = w[k] & mask;
+	    if (x != 0)
+		return Position{i, static_cast<Ind>(k * 64 + std::countr_zero(x))};
+
+	    mask = ~word_type{0};
+	}
+
+	k = 0;
+    }
+
+    return Position{rows_, 0};
+}
+
+
+template <typename I>
+template <typename F>
+void Bit_matrix<I>::for_each_set(F f) const
+{
+    for (Ind i = 0; i < rows_; ++i){
+	const word_type* w = row_data(i);
+
+	for (Ind k = 0; k < nw_; ++k){
+	    word_type x = w[k];
+	    while (x != 0){
+		f(i, static_cast<Ind>(k * 64 + std::countr_zero(x)));
+		x &= x - 1;	// borramos el bit más bajo
+	    }
+	}
+    }
+}
+
+
+// Operaciones lógicas
+// -------------------
+template <typename I>
+inline Bit_matrix<I> operator&(Bit_matrix<I> a, const Bit_matrix<I>& b)
+{ return a &= b; }
+
+template <typename I>
+inline Bit_matrix<I> operator|(Bit_matrix<I> a, const Bit_matrix<I>& b)
+{ return a |= b; }
+
+template <typename I>
+inline Bit_matrix<I> operator^(Bit_matrix<I> a, const Bit_matrix<I>& b)
+{ return a ^= b; }
+
+template <typename I>
+inline Bit_matrix<I> operator~(Bit_matrix<I> a)
+{
+    a.flip();
+    return a;
+}
+
+
+// Conversiones
+// ------------
+/// m(i, j) = dentro si b(i, j) está a 1, fuera si no.
+/// m tiene que tener el mismo tamaño que b.
+template <typename T, typename I>
+void to_matrix(const Bit_matrix<I>& b, Matrix<T, I>& m,
+	       const T& dentro = T{1}, const T& fuera = T{})
+{
+    if (b.size2D() != m.size2D())
+	throw std::logic_error{"to_matrix: matrices de diferente tamaño"};
+
+    for (I i = 0; i < b.rows(); ++i){
+	const uint64_t* w = b.row_data(i);
+	T* p = &m(i, I{0});
+
+	for (I j = 0; j < b.cols(); ++j)
+	    p[j] = ((w[j / 64] >> (j % 64)) & 1)? dentro: fuera;
+    }
+}
+
+
+template <typename I>
+std::ostream& operator<<(std::ostream& out, const Bit_matrix<I>& b)
+{
+    for (I i = 0; i < b.rows(); ++i){
+	for (I j = 0; j < b.cols(); ++j)
+	    out << (b(i, j)? '1': '0');
+
+	out << '\n';
+    }
+
+    return out;
+}
+
+
+}// namespace
+
+#endif
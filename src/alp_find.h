@@ -55,19 +55,166 @@
  *	28/02/2018 Reestructurado y ampliado.
  *	16/02/2019 Traigo los finds de visar. 
  *		 TODO: revisar, están duplicados con diferentes argumentos!!!
+ *	18/10/2026 Versión por bloques para rangos de números continuos en
+ *		   memoria (ver impl_of::find_pair_block).
  *
  ****************************************************************************/
 #include <alp_concepts.h>
+#include "alp_functional.h"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>   // to_address
+#include <ranges>
+#include <type_traits>
 #include <utility>
 #include <tuple>    // tie
 
 namespace alp{
+
+/***************************************************************************
+ *			BÚSQUEDA POR BLOQUES
+ ***************************************************************************/
+// Las imágenes son filas de números continuos en memoria. Si la relación es
+// simple (ver is_simple_relation) evaluamos la relación en bloques de
+// N pares, sin saltos, de tal manera que el compilador puede vectorizar el
+// bucle (compara los vectores p[k..k+N) y p[k+1..k+N+1)). Solo cuando un
+// bloque contiene el par buscado miramos cuál es.
+namespace impl_of{
+
+template <typename It, typename R>
+concept Pair_search_by_blocks = 
+	std::contiguous_iterator<It> and
+	std::is_arithmetic_v<std::iter_value_t<It>> and
+	is_simple_relation_v<R>;
+
+template <typename C, typename R>
+concept Pair_search_by_blocks_c = 
+	std::ranges::contiguous_range<const C> and
+	std::is_arithmetic_v<std::ranges::range_value_t<const C>> and
+	is_simple_relation_v<R>;
+
+inline constexpr size_t find_pair_block_size = 32;
+
+/// Devuelve el primer k de [0, n - 1) tal que rel(p[k], p[k+1]) == valor.
+/// Si no lo encuentra devuelve n.
+template <bool valor, typename T, typename R>
+size_t find_pair_block(const T* p, size_t n, R rel)
+{
+    constexpr size_t N = find_pair_block_size;
+
+    if (n < 2)
+	return n;
+
+    size_t k = 0;
+    for (; k + N < n; k += N){
+	unsigned hay = 0;
+	for (size_t i = 0; i < N; ++i)
+	    hay |= (rel(p[k + i], p[k + i + 1]) == valor);
+
+	if (hay)
+	    break;
+    }
+
+    for (; k + 1 < n; ++k)
+	if (rel(p[k], p[k + 1]) == valor)
+	    return k;
+
+    return n;
+}
+
+
+/// Devuelve el último k de [0, n - 1) tal que rel(p[k], p[k+1]) == valor.
+/// Si no lo encuentra devuelve n.
+template <bool valor, typename T, typename R>
+size_t rfind_pair_block(const T* p, size_t n, R rel)
+{
+    constexpr size_t N = find_pair_block_size;
+
+    if (n < 2)
+	return n;
+
+    size_t e = n - 1; // los pares [e, n - 1) ya los hemos mirado
+    for (; e >= N; e -= N){
+	const T* q = p + (e - N);
+
+	unsigned hay = 0;
+	for (size_t i = 0; i < N; ++i)
+	    hay |= (rel(q[i], q[i + 1]) == valor);
+
+	if (hay)
+	    break;
+    }
+
+    while (e-- > 0)
+	if (rel(p[e], p[e + 1]) == valor)
+	    return e;
+
+    return n;
+}
+
+
+// ¿Se puede leer [j0, je) directamente de data(c)? Hay contenedores
+// contiguos cuyo operator[] no es data()[i] fuera de [0, size) (por
+// ejemplo, Array_circular da la vuelta con i % N): en ese caso usamos la
+// versión genérica.
+template <typename C>
+inline bool dentro_de_data(const C& c, int j0, int je)
+{ return 0 <= j0 and j0 < je and je <= std::ranges::ssize(c); }
+
+// Versión por bloques de find_pair_if_i y find_pair_if_not_i
+template <bool valor, typename C, typename R>
+inline std::pair<int, int> find_pair_i(const C& c, int j0, int je, R rel)
+{
+    size_t n = static_cast<size_t>(je - j0);
+    size_t k = find_pair_block<valor>(std::ranges::data(c) + j0, n, rel);
+
+    if (k == n)
+	return {je, je};
+
+    int j = j0 + static_cast<int>(k);
+    return {j, j + 1};
+}
+
+// Versión por bloques de find_pair_if y find_pair_if_not
+template <bool valor, typename It, typename R>
+inline std::pair<It, It> find_pair(It p0, It pe, R rel)
+{
+    size_t n = static_cast<size_t>(pe - p0);
+    size_t k = find_pair_block<valor>(std::to_address(p0), n, rel);
+
+    if (k == n)
+	return std::make_pair(pe, pe);
+
+    return std::make_pair(p0 + k, p0 + (k + 1));
+}
+
+// Versión por bloques de rfind_pair_if y rfind_pair_if_not
+template <bool valor, typename It, typename R>
+inline std::pair<It, It> rfind_pair(It p1, It pb, R rel)
+{
+    size_t n = static_cast<size_t>(p1 - pb) + 1;
+    size_t k = rfind_pair_block<valor>(std::to_address(pb), n, rel);
+
+    if (k == n)
+	return std::make_pair(pb, pb);
+
+    return std::make_pair(pb + k, pb + (k + 1));
+}
+
+}// namespace impl_of
+
 /// Devuelve la primera pareja de elementos [j0, j1] que satisface la relación
 /// Solo busca dentro del intervalo [j0, je).
 /// En caso de no encontrarlo devuelve una pareja no válida (j0 = j1 = je).
 template <Contenedor_unidimensional C, typename R>
 inline std::pair<int,int> find_pair_if_i(const C& c, int j0, int je, R rel)
 {
+    if constexpr (impl_of::Pair_search_by_blocks_c<C, R>){
+	if (impl_of::dentro_de_data(c, j0, je))
+	    return impl_of::find_pair_i<true>(c, j0, je, rel);
+    }
+
     int j1 = j0 + 1;
 
     while (j1 < je and !rel(c[j0], c[j1])){
@@ -87,6 +234,11 @@ inline std::pair<int,int> find_pair_if_i(const C& c, int j0, int je, R rel)
 template <Contenedor_unidimensional C, typename R>
 inline std::pair<int,int> find_pair_if_not_i(const C& c, int j0, int je, R rel)
 {
+    if constexpr (impl_of::Pair_search_by_blocks_c<C, R>){
+	if (impl_of::dentro_de_data(c, j0, je))
+	    return impl_of::find_pair_i<false>(c, j0, je, rel);
+    }
+
     int j1 = j0 + 1;
 
     while (j1 < je and rel(c[j0], c[j1])){
@@ -210,12 +362,15 @@ template <typename It, typename R>
 //	     predicate(R): R: *It x *It --> bool
 inline std::pair<It, It> find_pair_if(It p0, It pe, R rel)
 {
+    if constexpr (impl_of::Pair_search_by_blocks<It, R>)
+	return impl_of::find_pair<true>(p0, pe, rel);
+
     // DUDA: de momento lo valido, pero puede que sea muy ineficiente
     // así que garantizar que tenga 2 elementos.
 //    if (p0 == pe) 
 //	return std::make_pair(pe, pe);
 //
-    auto p1 = siguiente(p0);
+    auto p1 = std::next(p0);
 //
 //    if (p1 == pe) 
 //	return std::make_pair(pe, pe);
@@ -236,12 +391,15 @@ template <typename It, typename R>
 //	     predicate(R): R: *It x *It --> bool
 inline std::pair<It, It> find_pair_if_not(It p0, It pe, R rel)
 {
+    if constexpr (impl_of::Pair_search_by_blocks<It, R>)
+	return impl_of::find_pair<false>(p0, pe, rel);
+
     // DUDA: de momento lo valido, pero puede que sea muy ineficiente
     // así que garantizar que tenga 2 elementos.
 //    if (p0 == pe) 
 //	return std::make_pair(pe, pe);
 //
-    auto p1 = siguiente(p0);
+    auto p1 = std::next(p0);
 //
 //    if (p1 == pe) 
 //	return std::make_pair(pe, pe);
@@ -285,7 +443,10 @@ template <typename It, typename R>
 //	     predicate(R): R: *It x *It --> bool
 inline std::pair<It, It> rfind_pair_if(It p1, It pb, R rel)
 {
-    auto p0 = anterior(p1);
+    if constexpr (impl_of::Pair_search_by_blocks<It, R>)
+	return impl_of::rfind_pair<true>(p1, pb, rel);
+
+    auto p0 = std::prev(p1);
 
     while (p0 != pb and !rel(*p0, *p1)){
 	p1 = p0;
@@ -304,9 +465,12 @@ template <typename It, typename R>
 //	     predicate(R): R: *It x *It --> bool
 inline std::pair<It, It> rfind_pair_if_not(It p1, It pb, R rel)
 {
+    if constexpr (impl_of::Pair_search_by_blocks<It, R>)
+	return impl_of::rfind_pair<false>(p1, pb, rel);
+
     // precondición: [pb, p1] tiene mínimo 2 elementos (está definido
     // anterior(p1).
-    auto p0 = anterior(p1);
+    auto p0 = std::prev(p1);
 
 
     while (p0 != pb and rel(*p0, *p1)){
@@ -354,7 +518,7 @@ std::pair<It, It> find_first_range_overlapped_if(It f0, It fe, It p0, It pe,
     if (p0 == pe) 
 	return std::pair<It, It>{fe, fe};
 
-    auto p1 = siguiente(p0);
+    auto p1 = std::next(p0);
 
     if (p1 == pe) 
 	return std::pair<It, It>{fe, fe};
@@ -33,6 +33,7 @@
  ****************************************************************************/
 
 #include <functional>
+#include <type_traits>
 
 namespace alp{
 
@@ -229,6 +230,67 @@ struct Incr_negativo_menor_o_igual_que{
 };
 
 
+/***************************************************************************
+ *			    is_simple_relation
+ ***************************************************************************/
+/// Una relación es simple si no tiene efectos secundarios y cuesta poco
+/// evaluarla. Los algoritmos pueden evaluarla de más (por ejemplo, en
+/// bloques de varios elementos para que el compilador pueda vectorizar el
+/// bucle). Ver find_pair_if en alp_find.h.
+template <typename R>
+struct is_simple_relation : std::false_type {};
+
+template <typename R>
+inline constexpr bool is_simple_relation_v = 
+			is_simple_relation<std::remove_cvref_t<R>>::value;
+
+template <typename T>
+struct is_simple_relation<std::less<T>> : std::true_type {};
+
+template <typename T>
+struct is_simple_relation<std::less_equal<T>> : std::true_type {};
+
+template <typename T>
+struct is_simple_relation<std::greater<T>> : std::true_type {};
+
+template <typename T>
+struct is_simple_relation<std::greater_equal<T>> : std::true_type {};
+
+template <typename T>
+struct is_simple_relation<std::equal_to<T>> : std::true_type {};
+
+template <typename T>
+struct is_simple_relation<std::not_equal_to<T>> : std::true_type {};
+
+template <typename Int>
+struct is_simple_relation<Incr_positivo_menor_que<Int>> : std::true_type {};
+
+template <typename Int>
+struct is_simple_relation<Incr_positivo_menor_o_igual_que<Int>> 
+						    : std::true_type {};
+
+template <typename Int>
+struct is_simple_relation<Incr_positivo_mayor_que<Int>> : std::true_type {};
+
+template <typename Int>
+struct is_simple_relation<Incr_positivo_mayor_o_igual_que<Int>> 
+						    : std::true_type {};
+
+template <typename Int>
+struct is_simple_relation<Incr_negativo_mayor_que<Int>> : std::true_type {};
+
+template <typename Int>
+struct is_simple_relation<Incr_negativo_mayor_o_igual_que<Int>> 
+						    : std::true_type {};
+
+template <typename Int>
+struct is_simple_relation<Incr_negativo_menor_que<Int>> : std::true_type {};
+
+template <typename Int>
+struct is_simple_relation<Incr_negativo_menor_o_igual_que<Int>> 
+						    : std::true_type {};
+
+
 }// namespace
 
 #endif
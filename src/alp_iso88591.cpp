@@ -87,5 +87,42 @@ unsigned char to_lower_without_accents(unsigned char c)
     return to_lower(c);
 }
 
+
+namespace {
+// Tabla con el resultado de aplicar f a cada uno de los 256 caracteres.
+struct Tabla{
+    unsigned char x[num_char_codes];
+
+    explicit Tabla(unsigned char (*f)(unsigned char))
+    {
+	for (int i = 0; i < num_char_codes; ++i)
+	    x[i] = f(static_cast<unsigned char>(i));
+    }
+
+    void aplica(char* p0, char* pe) const
+    {
+	for (; p0 != pe; ++p0)
+	    *p0 = static_cast<char>(x[static_cast<unsigned char>(*p0)]);
+    }
+};
+
+}// namespace
+
+
+void to_lower(char* p0, char* pe)
+{
+    static const Tabla tabla{static_cast<unsigned char (*)(unsigned char)>
+								(to_lower)};
+    tabla.aplica(p0, pe);
+}
+
+
+void to_lower_without_accents(char* p0, char* pe)
+{
+    static const Tabla tabla{static_cast<unsigned char (*)(unsigned char)>
+					    (to_lower_without_accents)};
+    tabla.aplica(p0, pe);
+}
+
 }// namespace
 }// namespace
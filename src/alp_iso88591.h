@@ -29,9 +29,10 @@
  *  - HISTORIA:
  *    Manuel Perez
  *    31/10/2021 v0.0 Todo experimental!!!
+ *    18/10/2026 to_lower/to_lower_without_accents de cadenas completas.
  *
  ****************************************************************************/
-
+#include <string>
 
 namespace alp{
 
@@ -75,6 +76,30 @@ inline bool is_alnum(unsigned char c)
 unsigned char to_lower(unsigned char);
 unsigned char to_lower_without_accents(unsigned char);
 
+
+// Versiones para cadenas completas
+// --------------------------------
+// Operan in situ sobre [p0, pe) usando una tabla de 256 entradas, en lugar
+// de evaluar los if de la versión de un solo caracter para cada byte.
+/// Convierte a minúsculas la cadena ISO-8895-1 [p0, pe).
+void to_lower(char* p0, char* pe);
+
+/// Convierte a minúsculas, eliminando los acentos, la cadena ISO-8895-1
+/// [p0, pe).
+void to_lower_without_accents(char* p0, char* pe);
+
+inline std::string to_lower(std::string s)
+{
+    to_lower(s.data(), s.data() + s.size());
+    return s;
+}
+
+inline std::string to_lower_without_accents(std::string s)
+{
+    to_lower_without_accents(s.data(), s.data() + s.size());
+    return s;
+}
+
 }// namespace
 
 }// namespace
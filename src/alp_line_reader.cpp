@@ -0,0 +1,182 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "alp_line_reader.h"
+
+#include "alp_exception.h"
+#include "alp_string.h"	// num_lineas
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace alp{
+
+/***************************************************************************
+ *				Mapped_file
+ ***************************************************************************/
+Mapped_file::Mapped_file(const std::string& fname)
+{
+    int fd = ::open(fname.c_str(), O_RDONLY);
+    if (fd == -1)
+	throw File_cant_read{fname};
+
+    struct stat st;
+    if (::fstat(fd, &st) == -1){
+	::close(fd);
+	throw File_cant_read{fname};
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+
+    // mmap de 0 bytes no está permitido
+    if (size_ != 0){
+	void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (p == MAP_FAILED){
+	    ::close(fd);
+	    throw File_cant_read{fname};
+	}
+
+	// Lo normal es leerlo de principio a fin: que el kernel lea por
+	// delante.
+	::madvise(p, size_, MADV_SEQUENTIAL);
+
+	p0_ = static_cast<const char*>(p);
+    }
+
+    // El mapeo sigue siendo válido después de cerrar el fichero.
+    ::close(fd);
+}
+
+
+Mapped_file::~Mapped_file()
+{
+    if (p0_ != nullptr)
+	::munmap(const_cast<char*>(p0_), size_);
+}
+
+
+/***************************************************************************
+ *			    Buffered_line_reader
+ ***************************************************************************/
+Buffered_line_reader::Buffered_line_reader(std::istream& in,
+                                           size_t buffer_size,
+                                           bool prefetch)
+    : in_{in}, prefetch_{prefetch}
+{
+    buffer_[0].resize(buffer_size);
+    buffer_[1].resize(buffer_size);
+
+    size_t n = read_block(buffer_[actual_]);
+    p_ = buffer_[actual_].data();
+    pe_ = p_ + n;
+
+    if (prefetch_)
+	siguiente_ = std::async(std::launch::async, 
+			    &Buffered_line_reader::read_block, this, 
+			    std::ref(buffer_[1 - actual_]));
+}
+
+
+Buffered_line_reader::~Buffered_line_reader()
+{
+    // No podemos destruir los buffers mientras se está escribiendo en ellos.
+    if (siguiente_.valid())
+	siguiente_.wait();
+}
+
+
+size_t Buffered_line_reader::read_block(std::vector<char>& b)
+{
+    in_.read(b.data(), b.size());
+    return static_cast<size_t>(in_.gcount());
+}
+
+
+bool Buffered_line_reader::next_block()
+{
+    if (eof_)
+	return false;
+
+    size_t n = 0;
+
+    if (prefetch_){
+	n = siguiente_.get();
+	actual_ = 1 - actual_;
+
+	if (n != 0)
+	    siguiente_ = std::async(std::launch::async, 
+				&Buffered_line_reader::read_block, this, 
+				std::ref(buffer_[1 - actual_]));
+    }
+    else
+	n = read_block(buffer_[actual_]);
+
+    p_ = buffer_[actual_].data();
+    pe_ = p_ + n;
+
+    eof_ = (n == 0);
+
+    return !eof_;
+}
+
+
+bool Buffered_line_reader::getline(std::string_view& line)
+{
+    const char* q = find_eol(p_, pe_);
+    if (q != pe_){
+	line = std::string_view{p_, static_cast<size_t>(q - p_)};
+	p_ = q + 1;
+	return true;
+    }
+
+    // La línea está partida entre este bloque y los siguientes
+    partida_.assign(p_, pe_);
+
+    while (next_block()){
+	q = find_eol(p_, pe_);
+	partida_.append(p_, q);
+
+	if (q != pe_){
+	    p_ = q + 1;
+	    line = partida_;
+	    return true;
+	}
+    }
+
+    // EOF: la última línea no acaba en '\n'
+    if (partida_.empty())
+	return false;
+
+    line = partida_;
+
+    return true;
+}
+
+
+/***************************************************************************
+ *			    FUNCIONES
+ ***************************************************************************/
+size_t num_lineas_fichero(const std::string& fname)
+{
+    Mapped_file file{fname};
+    return num_lineas(file.begin(), file.end());
+}
+
+
+}// namespace
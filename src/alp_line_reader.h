@@ -0,0 +1,236 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_LINE_READER_H__
+#define __ALP_LINE_READER_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Lectura de ficheros de texto línea a línea, sin copiar
+ *	las líneas.
+ *
+ *  - COMENTARIOS: std::getline(in, str) copia cada línea en una
+ *	std::string. Para leer ficheros de varios GB eso es demasiado lento.
+ *	Los lectores de este fichero devuelven std::string_view que apuntan
+ *	directamente al fichero (Mapped_file) o a un buffer que se reutiliza
+ *	(Buffered_line_reader).
+ *
+ *	Todos los lectores tienen el mismo interfaz:
+ *	    bool getline(std::string_view& line);
+ *
+ *	La línea devuelta no incluye el '\n' y solo es válida hasta la
+ *	siguiente llamada a getline.
+ *
+ *	Ejemplo:
+ *	\code
+ *	    alp::Mapped_file file{"log.txt"};
+ *	    alp::Line_reader in{file};
+ *
+ *	    std::string_view line;
+ *	    while (in.getline(line))
+ *		...
+ *	\endcode
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <cstring>  // memchr
+#include <string>
+#include <string_view>
+#include <vector>
+#include <istream>
+#include <future>
+
+#include "alp_utf8.h"
+
+namespace alp{
+
+/***************************************************************************
+ *				Mapped_file
+ ***************************************************************************/
+/*!
+ *  \brief  Fichero mapeado en memoria (mmap) de solo lectura.
+ *
+ *  Es propietario del mapeo: al destruirse lo libera.
+ *
+ */
+class Mapped_file{
+public:
+    using const_iterator = const char*;
+
+    /// Mapea el fichero fname. Si no se puede lanza File_cant_read.
+    explicit Mapped_file(const std::string& fname);
+
+    ~Mapped_file();
+
+    Mapped_file(const Mapped_file&) = delete;
+    Mapped_file& operator=(const Mapped_file&) = delete;
+
+    const char* data() const {return p0_;}
+    size_t size() const {return size_;}
+    bool empty() const {return size_ == 0;}
+
+    const_iterator begin() const {return p0_;}
+    const_iterator end() const {return p0_ + size_;}
+
+private:
+    const char* p0_ = nullptr;
+    size_t size_    = 0;
+};
+
+
+/***************************************************************************
+ *				Line_reader
+ ***************************************************************************/
+/// Busca el primer '\n' de [p0, pe). Si no lo encuentra devuelve pe.
+inline const char* find_eol(const char* p0, const char* pe)
+{
+    const void* q = std::memchr(p0, '\n', pe - p0);
+    if (q == nullptr)
+	return pe;
+
+    return static_cast<const char*>(q);
+}
+
+
+/*!
+ *  \brief  Lee línea a línea la cadena [p0, pe) que está en memoria.
+ *
+ *  No copia nada: las líneas son views de [p0, pe).
+ *
+ */
+class Line_reader{
+public:
+    Line_reader(const char* p0, const char* pe) : p_{p0}, pe_{pe} {}
+
+    /// Lee el contenido de c (Mapped_file, std::string, std::vector<char>...)
+    template <typename Cont>
+    explicit Line_reader(const Cont& c)
+	: Line_reader{c.data(), c.data() + c.size()} {}
+
+    /// Lee la siguiente línea. Devuelve false si no quedan más líneas.
+    bool getline(std::string_view& line)
+    {
+	if (p_ == pe_)
+	    return false;
+
+	const char* q = find_eol(p_, pe_);
+	line = std::string_view{p_, static_cast<size_t>(q - p_)};
+
+	p_ = (q == pe_)? pe_ : q + 1;
+
+	return true;
+    }
+
+    /// Salta la siguiente línea.
+    bool skip_line()
+    {
+	std::string_view line;
+	return getline(line);
+    }
+
+    /// Lo que queda por leer.
+    std::string_view rest() const
+    { return std::string_view{p_, static_cast<size_t>(pe_ - p_)};}
+
+private:
+    const char* p_;	// siguiente caracter a leer
+    const char* pe_;
+};
+
+
+/***************************************************************************
+ *			    Buffered_line_reader
+ ***************************************************************************/
+/*!
+ *  \brief  Lee línea a línea un std::istream, por bloques.
+ *
+ *  Lee el flujo en bloques de buffer_size bytes, reutilizando siempre los
+ *  mismos buffers. Solo se copian las líneas que quedan partidas entre dos
+ *  bloques.
+ *
+ *  Si prefetch == true, mientras se procesa un bloque un thread lee el
+ *  siguiente. En ese caso no se puede usar el flujo hasta destruir el
+ *  lector.
+ *
+ */
+class Buffered_line_reader{
+public:
+    static constexpr size_t default_buffer_size = 1 << 20; // 1 MB
+
+    explicit Buffered_line_reader(std::istream& in,
+                                  size_t buffer_size = default_buffer_size,
+                                  bool prefetch      = false);
+
+    ~Buffered_line_reader();
+
+    Buffered_line_reader(const Buffered_line_reader&) = delete;
+    Buffered_line_reader& operator=(const Buffered_line_reader&) = delete;
+
+    /// Lee la siguiente línea. Devuelve false si no quedan más líneas.
+    bool getline(std::string_view& line);
+
+private:
+    std::istream& in_;
+    bool prefetch_;
+
+    std::vector<char> buffer_[2];
+    int actual_ = 0;	// buffer que estamos leyendo
+
+    const char* p_  = nullptr;	// siguiente caracter a leer de buffer_[actual_]
+    const char* pe_ = nullptr;
+
+    std::string partida_;   // línea partida entre dos bloques
+    bool eof_ = false;
+
+    std::future<size_t> siguiente_; // lectura en paralelo del siguiente bloque
+
+    // Lee en b un bloque de in_. Devuelve el número de bytes leídos.
+    size_t read_block(std::vector<char>& b);
+
+    // Pasa al siguiente bloque. Devuelve false si no hay más.
+    bool next_block();
+};
+
+
+/***************************************************************************
+ *			    FUNCIONES
+ ***************************************************************************/
+/// Lee la siguiente línea de in, guardándola en s (se reutiliza la
+/// memoria de s).
+template <typename Reader>
+    requires requires (Reader& in, std::string_view& line) {in.getline(line);}
+bool getline(Reader& in, utf8_string& s)
+{
+    std::string_view line;
+    if (!in.getline(line))
+	return false;
+
+    s.assign(line.data(), line.data() + line.size());
+    return true;
+}
+
+
+/// Cuenta el número de líneas que tiene el fichero fname.
+size_t num_lineas_fichero(const std::string& fname);
+
+}// namespace
+
+#endif
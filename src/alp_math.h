@@ -30,13 +30,22 @@
  *      12/03/2017 Escrito
  *      28/05/2020 Aproximado
  *      27/07/2020 Degree/Radian
+ *      18/10/2026 Conversiones a polares por bloques (Precision)
+ *      19/10/2026 Divisor, mcd binario y múltiplos en compilación.
  *
  ****************************************************************************/
 
 #include <algorithm>
 #include <iostream>
+#include <bit>
 #include <cmath>
+#include <concepts>
+#include <cstdint>
 #include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>	// in_range
 
 
 namespace alp{
@@ -119,11 +128,44 @@ inline T punto_medio(T n)
 //{ return n/2; }
 
 
+namespace impl_of{
+// Máximo común divisor binario (algoritmo de Stein): solo restas y
+// desplazamientos, sin divisiones.
+template <std::unsigned_integral U>
+constexpr U max_comun_divisor_binario(U a, U b)
+{
+    if (a == 0) return b;
+    if (b == 0) return a;
+
+    int k = std::countr_zero(a | b);
+    a >>= std::countr_zero(a);
+
+    while (b != 0){
+	b >>= std::countr_zero(b);
+	if (a > b)
+	    std::swap(a, b);
+
+	b -= a;
+    }
+
+    return a << k;
+}
+}// namespace impl_of
+
 /// Calcula el máximo común divisor.
-/// Versión de Stepanov (Elements of programming)
+/// Para enteros usa el algoritmo binario y el resultado siempre es >= 0.
+/// Para el resto de tipos, versión de Stepanov (Elements of programming).
 template <typename T>
-T max_comun_divisor(T a, T b)
+constexpr T max_comun_divisor(T a, T b)
 {
+    if constexpr (std::is_integral_v<T>){
+	using U = std::make_unsigned_t<T>;
+	U ua = (a < 0)? U(0) - static_cast<U>(a): static_cast<U>(a);
+	U ub = (b < 0)? U(0) - static_cast<U>(b): static_cast<U>(b);
+
+	return static_cast<T>(impl_of::max_comun_divisor_binario(ua, ub));
+    }
+
     while (true) {
         if (b == T{0})
             return a;
@@ -242,6 +284,235 @@ inline constexpr int resto(int D, int d)
 }
 
 
+/****************************************************************************
+ *
+ *   - CLASE: Divisor
+ *
+ *   - DESCRIPCIÓN: División entera entre un divisor d > 0 que solo se
+ *	    conoce en tiempo de ejecución, pero que se usa muchas veces.
+ *
+ *   - COMENTARIOS:
+ *	    Dividir es mucho más lento que multiplicar. Al construir el
+ *	    Divisor se precalcula el inverso de d (método de Granlund y
+ *	    Montgomery, el mismo de libdivide): cada división pasa a ser una
+ *	    multiplicación, una suma y dos desplazamientos. No hay ningún if,
+ *	    d puede ser potencia de 2 o no.
+ *
+ *	    Igual que cociente/resto, si D es negativo se redondea hacia
+ *	    -infinito: D = d·c + r, con 0 <= r < d.
+ *
+ *   - PRECONDICIÓN: d > 0 (si no, lanza std::invalid_argument)
+ *
+ *   - EJEMPLO:
+ *		alp::Divisor<int> d{ancho_tile};
+ *		for (...)
+ *		    int c = d.cociente(x);
+ *
+ ****************************************************************************/
+namespace impl_of{
+// Entero sin signo de 32 o 64 bits con el que operamos para Int
+template <std::integral Int>
+using Divisor_rep = std::conditional_t<(sizeof(Int) <= 4), uint32_t, uint64_t>;
+
+// Entero sin signo del doble de bits que U
+template <typename U>
+using Divisor_rep2 = std::conditional_t<std::is_same_v<U, uint32_t>,
+					uint64_t, unsigned __int128>;
+
+}// namespace impl_of
+
+template <std::integral Int>
+class Divisor{
+public:
+    using Rep = impl_of::Divisor_rep<Int>;
+
+    constexpr explicit Divisor(Int d);
+
+    constexpr Int divisor() const {return d_;}
+
+    /// Cociente de D entre d (redondeando hacia -infinito).
+    constexpr Int cociente(Int D) const;
+
+    /// Resto de D entre d: 0 <= resto(D) < d.
+    constexpr Int resto(Int D) const;
+
+    /// ¿d divide a D?
+    constexpr bool divide_a(Int D) const {return resto(D) == 0;}
+
+    /// Múltiplo de d mayor o igual a x.
+    /// Precondición: el resultado es representable en Int.
+    constexpr Int multiplo_mayor_que(Int x) const;
+
+    /// Múltiplo de d más próximo a x (como multiplo_de_mas_proximo_a).
+    /// Precondición: el resultado es representable en Int.
+    constexpr Int multiplo_mas_proximo_a(Int x) const;
+
+private:
+    static constexpr int N = 8 * sizeof(Rep);
+
+    Int d_;
+    Rep m_;	    // inverso de d
+    int sh1_;	    // desplazamientos
+    int sh2_;
+
+    // División de un número sin signo
+    constexpr Rep divide(Rep n) const;
+};
+
+template <std::integral Int>
+constexpr Divisor<Int>::Divisor(Int d) : d_{d}
+{
+    if (d <= 0)
+	throw std::invalid_argument{"Divisor: el divisor tiene que ser > 0"};
+
+    using Rep2 = impl_of::Divisor_rep2<Rep>;
+
+    // l = ceil(log2(d))
+    Rep ud = static_cast<Rep>(d);
+    int l = N - std::countl_zero(static_cast<Rep>(ud - 1));
+
+    // m = floor(2^N·(2^l - d)/d) + 1
+    Rep2 p = (Rep2{1} << l) - ud;
+    m_ = static_cast<Rep>((p << N) / ud + 1);
+
+    sh1_ = std::min(l, 1);
+    sh2_ = std::max(l - 1, 0);
+}
+
+template <std::integral Int>
+inline constexpr Divisor<Int>::Rep Divisor<Int>::divide(Rep n) const
+{
+    using Rep2 = impl_of::Divisor_rep2<Rep>;
+
+    Rep t = static_cast<Rep>((Rep2{m_} * n) >> N);
+    return (t + ((n - t) >> sh1_)) >> sh2_;
+}
+
+template <std::integral Int>
+inline constexpr Int Divisor<Int>::cociente(Int D) const
+{
+    if constexpr (std::is_unsigned_v<Int>)
+	return static_cast<Int>(divide(D));
+
+    else{
+	// Si D < 0, floor(D/d) = -floor((-D-1)/d) - 1 = ~(~D/d)
+	Rep mask = (D < 0)? ~Rep{0}: Rep{0};
+	Rep n    = static_cast<Rep>(D) ^ mask;
+
+	return static_cast<Int>(divide(n) ^ mask);
+    }
+}
+
+// cociente(D) * d puede no ser representable en Int (D = INT_MIN, por
+// ejemplo): las operaciones se hacen en Rep, que no desborda, y el resultado
+// sí es representable.
+template <std::integral Int>
+inline constexpr Int Divisor<Int>::resto(Int D) const
+{
+    Rep c = static_cast<Rep>(cociente(D));
+    return static_cast<Int>(static_cast<Rep>(D) - c * static_cast<Rep>(d_));
+}
+
+template <std::integral Int>
+inline constexpr Int Divisor<Int>::multiplo_mayor_que(Int x) const
+{
+    Int r = resto(x);
+    if (r == 0)
+	return x;
+
+    return static_cast<Int>(static_cast<Rep>(x) + static_cast<Rep>(d_ - r));
+}
+
+template <std::integral Int>
+inline constexpr Int Divisor<Int>::multiplo_mas_proximo_a(Int x) const
+{
+    Int r = resto(x);
+    if (r > d_ - r)
+	return static_cast<Int>(static_cast<Rep>(x) + static_cast<Rep>(d_ - r));
+
+    return static_cast<Int>(static_cast<Rep>(x) - static_cast<Rep>(r));
+}
+
+
+// Versiones con el divisor conocido en tiempo de compilación
+// ----------------------------------------------------------
+// Si d es potencia de 2 son desplazamientos y máscaras. Si no, el
+// compilador cambia la división entre una constante por una multiplicación.
+//
+// Ejemplo:
+//	int c = alp::cociente<8>(x);	    // = alp::cociente(x, 8)
+//	int y = alp::multiplo_de_mayor_que<16>(x);
+namespace impl_of{
+// d tiene que ser representable en Int: static_cast<Int>(d) lo truncaría
+template <auto d, typename Int>
+concept divisor_valido = std::integral<decltype(d)> and (d > 0) and
+			 (std::in_range<Int>(d));
+}
+
+template <auto d, std::integral Int>
+    requires impl_of::divisor_valido<d, Int>
+inline constexpr Int cociente(Int D)
+{
+    if constexpr (std::has_single_bit(static_cast<uint64_t>(d)))
+	return D >> std::countr_zero(static_cast<uint64_t>(d));
+
+    else if constexpr (std::is_unsigned_v<Int>)
+	return D / static_cast<Int>(d);
+
+    else{ // floor(D/d) como en Divisor::cociente
+	using U = std::make_unsigned_t<Int>;
+	U mask = (D < 0)? ~U{0}: U{0};
+	return static_cast<Int>(((static_cast<U>(D) ^ mask) / static_cast<U>(d))
+								    ^ mask);
+    }
+}
+
+template <auto d, std::integral Int>
+    requires impl_of::divisor_valido<d, Int>
+inline constexpr Int resto(Int D)
+{
+    if constexpr (std::has_single_bit(static_cast<uint64_t>(d)))
+	return D & static_cast<Int>(d - 1);
+
+    else{ // en U, igual que Divisor::resto
+	using U = std::make_unsigned_t<Int>;
+	U c = static_cast<U>(cociente<d>(D));
+	return static_cast<Int>(static_cast<U>(D) - c * static_cast<U>(d));
+    }
+}
+
+/// ¿D es múltiplo de d?
+template <auto d, std::integral Int>
+    requires impl_of::divisor_valido<d, Int>
+inline constexpr bool es_multiplo_de(Int D)
+{ return resto<d>(D) == 0; }
+
+template <auto d, std::integral Int>
+    requires impl_of::divisor_valido<d, Int>
+inline constexpr Int multiplo_de_mayor_que(Int x)
+{
+    if constexpr (std::has_single_bit(static_cast<uint64_t>(d))){
+	constexpr Int mask = static_cast<Int>(d - 1);
+	return (x + mask) & ~mask;
+    }
+
+    else{
+	Int r = resto<d>(x);
+	return (r == 0)? x: x + static_cast<Int>(static_cast<Int>(d) - r);
+    }
+}
+
+template <auto d, std::integral Int>
+    requires impl_of::divisor_valido<d, Int>
+inline constexpr Int multiplo_de_mas_proximo_a(Int x)
+{
+    Int r = resto<d>(x);
+    Int e = static_cast<Int>(static_cast<Int>(d) - r);
+    return (r > e)? x + e: x - r;
+}
+
+
+
 
 
 /*****************************************************************************
@@ -618,6 +889,360 @@ inline std::pair<double, double> polares2cartesianas(double r, const Degree& the
 }
 
 
+/***************************************************************************
+ *		    CONVERSIONES POR BLOQUES (polares)
+ ***************************************************************************/
+// Versiones de las funciones anteriores que convierten arrays enteros.
+// Los vectores se pasan en formato SoA (las x en un array y las y en otro)
+// o como un rango de estructuras con miembros x e y (Vector_xy...).
+// Los ángulos están en grados (como en angulo_eje_x).
+//
+// Se puede elegir la precisión:
+//	+ alta : std::atan2, std::sin, std::cos.
+//	+ media: polinomios; error < 0.0007 grados en los ángulos y < 3e-8
+//		 en senos y cosenos.
+//	+ baja : polinomios más cortos; error < 0.09 grados y < 4e-5.
+//
+// Con precisión media o baja los bucles no tienen saltos (solo
+// operaciones aritméticas y selecciones) y el compilador los vectoriza.
+enum class Precision{ baja, media, alta };
+
+namespace impl_of{
+
+// pi con la precisión de Real
+template <std::floating_point Real>
+inline constexpr Real pi_ = std::numbers::pi_v<Real>;
+
+// atan(a) para 0 <= a <= 1
+template <Precision p, std::floating_point Real>
+inline Real atan01(Real a)
+{
+    if constexpr (p == Precision::baja)
+	return a * (pi_<Real> / 4 - (a - 1) * (Real(0.2447) + Real(0.0663) * a));
+
+    else { // Abramowitz y Stegun 4.4.49
+	Real a2 = a * a;
+	return a * (Real(0.9998660) + a2 * (Real(-0.3302995) + 
+		a2 * (Real(0.1801410) + a2 * (Real(-0.0851330) + 
+		a2 * Real(0.0208351)))));
+    }
+}
+
+
+// Sin saltos
+// ----------
+// Para que el compilador vectorice los bucles no puede haber saltos. Las
+// comparaciones de números reales pueden lanzar excepciones de coma
+// flotante (con NaN), por lo que gcc no las convierte en selecciones si no
+// se compila con -fno-trapping-math. Por eso las comparaciones se hacen
+// con los bits (los reales positivos se ordenan igual que sus bits) y las
+// selecciones con máscaras.
+template <std::floating_point Real>
+using Bits_de = std::conditional_t<sizeof(Real) == 8, uint64_t, uint32_t>;
+
+// c? a : b
+template <std::floating_point Real>
+inline Real selecciona(bool c, Real a, Real b)
+{
+    using Bits = Bits_de<Real>;
+    Bits m = -static_cast<Bits>(c);
+
+    return std::bit_cast<Real>((std::bit_cast<Bits>(a) & m) | 
+			       (std::bit_cast<Bits>(b) & ~m));
+}
+
+
+// Igual que angulo_eje_x(x, y)
+template <Precision p, std::floating_point Real>
+inline Real angulo_eje_x(Real x, Real y)
+{
+    if constexpr (p == Precision::alta){
+	Real t = static_cast<Real>(radian2degree(std::atan2(y, x)));
+	return (t < 0)? t + Real(360) : t;
+    }
+
+    else{
+	using Bits = Bits_de<Real>;
+	constexpr Bits signo = Bits{1} << (8 * sizeof(Real) - 1);
+
+	Bits bx = std::bit_cast<Bits>(x);
+	Bits by = std::bit_cast<Bits>(y);
+	Bits ax = bx & ~signo;	// |x|
+	Bits ay = by & ~signo;	// |y|
+
+	bool y_mayor = ay > ax;
+	Real mx = std::bit_cast<Real>(y_mayor? ay : ax);
+	Real mn = std::bit_cast<Real>(y_mayor? ax : ay);
+
+	Real t = atan01<p>(mn / selecciona(mx == 0, Real(1), mx));
+	t = selecciona(y_mayor,	    pi_<Real> / 2 - t, t);
+	t = selecciona(bx > signo,  pi_<Real> - t, t);	    // x < 0
+	t = selecciona(by > signo,  2 * pi_<Real> - t, t);  // y < 0
+
+	t *= (180 / pi_<Real>);
+
+	return selecciona(std::bit_cast<Bits>(t) >= 
+			  std::bit_cast<Bits>(Real(360)), t - Real(360), t);
+    }
+}
+
+
+// Seno y coseno del ángulo theta en grados.
+// Reducimos el ángulo a [-45, 45] en grados: así los múltiplos de 90 son
+// exactos (sin(180) = 0).
+template <Precision p, std::floating_point Real>
+inline void sincosd(Real theta, Real& s, Real& c)
+{
+    if constexpr (p == Precision::alta){
+	Real t = static_cast<Real>(degree2radian(theta));
+	s = std::sin(t);
+	c = std::cos(t);
+    }
+
+    else {
+	using Bits = Bits_de<Real>;
+
+	// Sumando 1.5*2^52 (1.5*2^23 con float) se redondea al entero más
+	// próximo, que queda en los bits bajos de la mantisa.
+	constexpr Real redondea = (sizeof(Real) == 8)? Real(6755399441055744.0)
+						     : Real(12582912.0);
+
+	Real q = theta * Real(1.0/90) + redondea;
+	Bits n = std::bit_cast<Bits>(q);
+	q -= redondea;
+
+	Real r = (theta - q * Real(90)) * (pi_<Real> / 180);
+	Real r2 = r * r;
+
+	Real sr, cr;
+	if constexpr (p == Precision::baja){
+	    sr = r * (1 + r2 * (Real(-1.0/6) + r2 * Real(1.0/120)));
+	    cr = 1 + r2 * (Real(-0.5) + r2 * (Real(1.0/24) + 
+						r2 * Real(-1.0/720)));
+	}
+	else {
+	    sr = r * (1 + r2 * (Real(-1.0/6) + r2 * (Real(1.0/120) + 
+		    r2 * (Real(-1.0/5040) + r2 * Real(1.0/362880)))));
+	    cr = 1 + r2 * (Real(-0.5) + r2 * (Real(1.0/24) + 
+		    r2 * (Real(-1.0/720) + r2 * Real(1.0/40320))));
+	}
+
+	// Cuadrante
+	Real s0 = selecciona(n & 1, cr, sr);
+	Real c0 = selecciona(n & 1, sr, cr);
+	s = selecciona(n & 2,	    -s0, s0);
+	c = selecciona((n + 1) & 2, -c0, c0);
+    }
+}
+
+
+// Los bucles se hacen por bloques de N elementos copiados en arrays
+// locales: así el compilador sabe que los arrays no se solapan y que el
+// número de iteraciones es fijo, y los vectoriza también con -O2.
+inline constexpr size_t bloque_polares = 64;
+
+template <Precision p, std::floating_point Real>
+void angulo_eje_x(const Real* x0, const Real* xe, const Real* y0, Real* t0)
+{
+    constexpr size_t N = bloque_polares;
+    Real x[N]{};
+    Real y[N]{};
+    Real t[N];
+
+    while (x0 != xe){
+	size_t n = std::min<size_t>(N, xe - x0);
+	std::copy_n(x0, n, x);
+	std::copy_n(y0, n, y);
+
+	for (size_t i = 0; i < N; ++i)
+	    t[i] = angulo_eje_x<p>(x[i], y[i]);
+
+	std::copy_n(t, n, t0);
+
+	x0 += n;
+	y0 += n;
+	t0 += n;
+    }
+}
+
+
+template <Precision p, std::floating_point Real>
+void polares2cartesianas(const Real* r0, const Real* re, const Real* t0,
+			 Real* x0, Real* y0)
+{
+    constexpr size_t N = bloque_polares;
+    Real r[N]{};
+    Real t[N]{};
+    Real x[N];
+    Real y[N];
+
+    while (r0 != re){
+	size_t n = std::min<size_t>(N, re - r0);
+	std::copy_n(r0, n, r);
+	std::copy_n(t0, n, t);
+
+	for (size_t i = 0; i < N; ++i){
+	    sincosd<p>(t[i], y[i], x[i]);
+	    x[i] *= r[i];
+	    y[i] *= r[i];
+	}
+
+	std::copy_n(x, n, x0);
+	std::copy_n(y, n, y0);
+
+	r0 += n;
+	t0 += n;
+	x0 += n;
+	y0 += n;
+    }
+}
+
+
+template <Precision p, std::floating_point Real>
+void sincosd(const Real* t0, const Real* te, Real* s0, Real* c0)
+{
+    constexpr size_t N = bloque_polares;
+    Real t[N]{};
+    Real s[N];
+    Real c[N];
+
+    while (t0 != te){
+	size_t n = std::min<size_t>(N, te - t0);
+	std::copy_n(t0, n, t);
+
+	for (size_t i = 0; i < N; ++i)
+	    sincosd<p>(t[i], s[i], c[i]);
+
+	std::copy_n(s, n, s0);
+	std::copy_n(c, n, c0);
+
+	t0 += n;
+	s0 += n;
+	c0 += n;
+    }
+}
+
+
+// Para llamar a f<p>(args...) con p conocido en tiempo de compilación
+template <typename F>
+inline void con_precision(Precision p, F f)
+{
+    switch (p){
+	case Precision::baja : f.template operator()<Precision::baja>();  break;
+	case Precision::media: f.template operator()<Precision::media>(); break;
+	case Precision::alta : f.template operator()<Precision::alta>();  break;
+    }
+}
+
+}// namespace impl_of
+
+
+/// r[i] = módulo del vector (x[i], y[i]), para i = 0 .. xe - x0.
+template <std::floating_point Real>
+void modulo_vector(const Real* x0, const Real* xe, const Real* y0, Real* r0)
+{
+    for (; x0 != xe; ++x0, ++y0, ++r0)
+	*r0 = std::sqrt(*x0 * *x0 + *y0 * *y0);
+}
+
+
+/// theta[i] = ángulo en grados, en [0, 360), del vector (x[i], y[i]) con
+/// el eje x. El (0, 0) devuelve 0.
+template <std::floating_point Real>
+void angulo_eje_x(const Real* x0, const Real* xe, const Real* y0, 
+		  Real* theta0, Precision p = Precision::media)
+{
+    impl_of::con_precision(p, [&]<Precision q>() {
+	impl_of::angulo_eje_x<q>(x0, xe, y0, theta0);
+    });
+}
+
+
+/// s[i] = sin(theta[i]), c[i] = cos(theta[i]). Los ángulos en grados.
+template <std::floating_point Real>
+void sincosd(const Real* theta0, const Real* thetae, 
+	     Real* sin0, Real* cos0, Precision p = Precision::media)
+{
+    impl_of::con_precision(p, [&]<Precision q>() {
+	impl_of::sincosd<q>(theta0, thetae, sin0, cos0);
+    });
+}
+
+
+/// Pasa a polares los vectores (x[i], y[i]): (r[i], theta[i]).
+template <std::floating_point Real>
+void cartesianas2polares(const Real* x0, const Real* xe, const Real* y0,
+			 Real* r0, Real* theta0, 
+			 Precision p = Precision::media)
+{
+    modulo_vector(x0, xe, y0, r0);
+    angulo_eje_x(x0, xe, y0, theta0, p);
+}
+
+
+/// Pasa a cartesianas los vectores (r[i], theta[i]): (x[i], y[i]).
+template <std::floating_point Real>
+void polares2cartesianas(const Real* r0, const Real* re, const Real* theta0,
+			 Real* x0, Real* y0, 
+			 Precision p = Precision::media)
+{
+    impl_of::con_precision(p, [&]<Precision q>() {
+	impl_of::polares2cartesianas<q>(r0, re, theta0, x0, y0);
+    });
+}
+
+
+/// Igual que la anterior, pero los vectores son estructuras con miembros
+/// x e y (por ejemplo, Vector_xy). Se copian por bloques en arrays SoA.
+template <typename It, std::floating_point Real>
+    requires requires (It q) { q->x; q->y; }
+void cartesianas2polares(It p0, It pe, Real* r0, Real* theta0, 
+			 Precision p = Precision::media)
+{
+    constexpr size_t N = impl_of::bloque_polares;
+    Real x[N];
+    Real y[N];
+
+    while (p0 != pe){
+	size_t n = 0;
+	for (; n < N and p0 != pe; ++n, ++p0){
+	    x[n] = static_cast<Real>(p0->x);
+	    y[n] = static_cast<Real>(p0->y);
+	}
+
+	cartesianas2polares(x, x + n, y, r0, theta0, p);
+	r0 += n;
+	theta0 += n;
+    }
+}
+
+
+/// Igual que la anterior, pero escribe los vectores en estructuras con
+/// miembros x e y (por ejemplo, Vector_xy<double>).
+template <std::floating_point Real, typename It>
+    requires requires (It q) { q->x; q->y; }
+void polares2cartesianas(const Real* r0, const Real* re, const Real* theta0,
+			 It out, Precision p = Precision::media)
+{
+    constexpr size_t N = impl_of::bloque_polares;
+    Real x[N];
+    Real y[N];
+
+    while (r0 != re){
+	size_t n = std::min<size_t>(N, re - r0);
+	polares2cartesianas(r0, r0 + n, theta0, x, y, p);
+
+	for (size_t i = 0; i < n; ++i, ++out){
+	    out->x = static_cast<decltype(out->x)>(x[i]);
+	    out->y = static_cast<decltype(out->y)>(y[i]);
+	}
+
+	r0 += n;
+	theta0 += n;
+    }
+}
+
+
 
 /// Calcula la media de los valores [first, last).
 /// Precondición: first != last (el rango no está vacío)
@@ -23,15 +23,31 @@
  *
  *   - DESCRIPCION: Estudio del crecimiento y decrecimiento de una función.
  *
- *   - COMENTARIOS: 
+ *   - COMENTARIOS: Las relaciones solo dependen del incremento
+ *	y1 - y0. Al construir el estudio se "compilan" en una tabla que
+ *	asocia a cada incremento el conjunto de relaciones que lo cumplen
+ *	(una máscara de bits). El estudio clasifica todos los incrementos de
+ *	una pasada y luego recorre la tabla buscando las regiones.
  *
  *   - HISTORIA:
  *           Manuel Perez- 17/02/2019 Escrito
+ *	     18/10/2026 Tabla de clasificación. Estudio por filas de una
+ *			matriz.
  *
  ****************************************************************************/
-#include "alp_find.h"
 #include "alp_math.h"
+#include "alp_exception.h"
+#include "alp_concepts.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <future>
+#include <initializer_list>
 #include <ostream>
+#include <thread>
+#include <vector>
 
 namespace alp{
 /*!
@@ -76,13 +92,15 @@ public:
 	    :m{m0}, M{M0}, name{name0} {}
 
 	bool operator()(int y0, int y1) const 
+	{ return incr_pertenece(static_cast<long long>(y1) - y0); }
+
+	/// ¿Cumple la relación un incremento incr = y1 - y0?
+	bool incr_pertenece(long long incr) const
 	{
 	    if (m == M) // operator ==
-		return y0 == y1;
+		return incr == 0;
 
 	    // operator <
-	    int incr = y1 - y0;
-
 	    if (incr >= M or incr < m)
 		return false;
 
@@ -97,10 +115,16 @@ public:
 
     using Estudio = std::vector<Region>;
 
+    /// Estudio de cada una de las filas de una matriz.
+    using Estudio_2D = std::vector<Estudio>;
+
+    /// Como mucho se pueden usar max_relaciones relaciones.
+    static constexpr size_t max_relaciones = 32;
+
+    /// Las relaciones se usan en orden: en cada región se elige la primera
+    /// relación que cumplen los dos primeros elementos.
     Estudia_crecimiento_decrecimiento
-	(std::initializer_list<Relacion> rels)
-	:rels_{rels}
-	{}
+	(std::initializer_list<Relacion> rels);
 
     /*!
      *  \brief  Estudia el crecimiento decrecimiento de una función.
@@ -113,7 +137,34 @@ public:
      *	    Devuelve un vector con las distintas regiones de la función.
      */
     template <typename It, typename Size>
-    Estudio operator()(It p, Size ie);
+    Estudio operator()(It p, Size ie)
+    {
+	Estudio est;
+	estudia(p, ie, est, buffer_);
+	return est;
+    }
+
+    /// Igual que el anterior, pero reutiliza la memoria de est (si se
+    /// estudian muchas sucesiones seguidas no se reserva memoria).
+    template <typename It, typename Size>
+    void operator()(It p, Size ie, Estudio& est)
+    { estudia(p, ie, est, buffer_); }
+
+
+    /// Estudia cada una de las filas de la matriz m, guardando en res[i] el
+    /// estudio de la fila i. Reparte las filas entre num_threads threads
+    /// (0 = tantos como cores).
+    template <Contenedor_bidimensional Matrix2D>
+    void por_filas(const Matrix2D& m, Estudio_2D& res, 
+					unsigned num_threads = 0) const;
+
+    template <Contenedor_bidimensional Matrix2D>
+    Estudio_2D por_filas(const Matrix2D& m, unsigned num_threads = 0) const
+    {
+	Estudio_2D res;
+	por_filas(m, res, num_threads);
+	return res;
+    }
 
 
     /*!
@@ -150,56 +201,183 @@ public:
     
 
 private:
+// Types
+    // Bit k = 1 si se cumple la relación rels_[k]
+    using Mascara = uint32_t;
+
+    // Los incrementos pequeños (los de las imágenes de 8 bits) se
+    // clasifican directamente con una tabla.
+    static constexpr int max_incr_tabla = 255;
+
+// Data
     std::vector<Relacion> rels_;
 
-    // Determina qué relación existe entre x e y. Devuelve esa relación
-    // para poder continuar haciendo el estudio.
-    template <typename Value>
-    const Relacion& relacion_existente_entre(Value x, Value y)
+    // Tabla de clasificación:
+    //	    limite_ = valores en los que puede cambiar alguna relación,
+    //		      ordenados.
+    //	    mascara_[k] = relaciones que cumple un incremento del intervalo
+    //		      [limite_[k-1], limite_[k]).
+    std::vector<long long> limite_;
+    std::vector<Mascara> mascara_;
+    std::array<Mascara, 2*max_incr_tabla + 1> tabla_;
+
+    std::vector<Mascara> buffer_;   // para no reservar memoria cada vez
+
+// Functions
+    void compila();
+
+    Mascara clasifica(long long incr) const
+    {
+	if (-max_incr_tabla <= incr and incr <= max_incr_tabla)
+	    return tabla_[incr + max_incr_tabla];
+
+	return clasifica_intervalos(incr);
+    }
+
+    Mascara clasifica_intervalos(long long incr) const
     {
-	for (const auto& rel: rels_)
-	    if (rel(x, y)) 
-		return rel;
-
-        throw Imposible_llegar_aqui{
-            __FILE__,
-            __LINE__,
-            "Estudia_crecimiento_decrecimiento::relacion_existente_entre()"};
+	size_t k = 0;
+	for (auto x: limite_)
+	    k += (incr >= x);
+
+	return mascara_[k];
     }
 
+    // Estudia [p, p + ie) usando buf como memoria de trabajo.
+    template <typename It, typename Size>
+    void estudia(It p, Size ie, Estudio& est, 
+				std::vector<Mascara>& buf) const;
+
 };
 
 
+inline Estudia_crecimiento_decrecimiento::Estudia_crecimiento_decrecimiento
+	(std::initializer_list<Relacion> rels)
+	:rels_{rels}
+{
+    if (rels_.size() > max_relaciones)
+	throw Precondicion{__FILE__, __LINE__,
+	    "Estudia_crecimiento_decrecimiento", 
+	    "Demasiadas relaciones (como mucho 32)"};
+
+    compila();
+}
+
 
-template <typename It, typename Size>
-Estudia_crecimiento_decrecimiento::Estudio 
-	Estudia_crecimiento_decrecimiento::operator()(It p, Size ie)
+inline void Estudia_crecimiento_decrecimiento::compila()
 {
-    std::vector<Region> region;
+    auto mascara = [this](long long incr) {
+	Mascara res = 0;
+	for (size_t k = 0; k < rels_.size(); ++k)
+	    if (rels_[k].incr_pertenece(incr))
+		res |= Mascara{1} << k;
+
+	return res;
+    };
 
-    Size i0 = 0;
-    Size i1 = 1;
+    // Una relación solo cambia de valor en m, M, 0 y 1.
+    limite_.clear();
+    for (auto& r: rels_){
+	limite_.push_back(r.m);
+	limite_.push_back(r.M);
+    }
+    limite_.push_back(0);
+    limite_.push_back(1);
 
-    Region reg;
-    while (i1 < ie){
-	Relacion rel = relacion_existente_entre(p[i0], p[i1]);
-	
-	reg.i = i0;
+    std::sort(limite_.begin(), limite_.end());
+    limite_.erase(std::unique(limite_.begin(), limite_.end()), limite_.end());
 
-	std::tie(i0, i1) = find_pair_if_not_i(p, i0, ie, rel);
+    mascara_.clear();
+    mascara_.push_back(mascara(limite_.front() - 1));
+    for (auto x: limite_)
+	mascara_.push_back(mascara(x));
+
+    for (int incr = -max_incr_tabla; incr <= max_incr_tabla; ++incr)
+	tabla_[incr + max_incr_tabla] = clasifica_intervalos(incr);
+}
+
+
+template <typename It, typename Size>
+void Estudia_crecimiento_decrecimiento::estudia(It p, Size ie, Estudio& est,
+				    std::vector<Mascara>& buf) const
+{
+    est.clear();
+    if (ie < 2)
+	return;
+
+    size_t n = static_cast<size_t>(ie) - 1; // número de pares
+
+    // 1.- Clasificamos todos los incrementos
+    buf.resize(n);
+    for (size_t k = 0; k < n; ++k){
+	long long incr = static_cast<long long>(static_cast<int>(p[k + 1]))
+					      - static_cast<int>(p[k]);
+	buf[k] = clasifica(incr);
+    }
 
-	i1 = i0 + 1;
+    // 2.- Buscamos las regiones: [i, j] mientras se cumpla la relación
+    //     que cumplía el primer par.
+    size_t k = 0;
+    while (k < n){
+	if (buf[k] == 0)
+	    throw Imposible_llegar_aqui{
+		__FILE__,
+		__LINE__,
+		"Estudia_crecimiento_decrecimiento::estudia()"};
 
-	if (i0 == ie) --i0;
+	Mascara rel = buf[k] & (~buf[k] + 1); // primera relación que cumple
 
-	reg.j = i0;	// intervalo [i, j]
+	Region reg;
+	reg.i = static_cast<int>(k);
+
+	for (++k; k < n and (buf[k] & rel); ++k)
+	    ;
+
+	reg.j = static_cast<int>(k);	// intervalo [i, j]
 	reg.incr = p[reg.j] - p[reg.i];
-	reg.name = rel.name;
+	reg.name = rels_[std::countr_zero(rel)].name;
+
+	est.push_back(reg);
+    }
+}
+
+
+template <Contenedor_bidimensional Matrix2D>
+void Estudia_crecimiento_decrecimiento::por_filas(const Matrix2D& m,
+				Estudio_2D& res, unsigned num_threads) const
+{
+    size_t rows = static_cast<size_t>(m.rows());
+    res.resize(rows);
+
+    auto estudia_filas = [&](size_t i0, size_t ie) {
+	std::vector<Mascara> buf;
+	for (size_t i = i0; i < ie; ++i)
+	    estudia(m.row(i).begin(), m.cols(), res[i], buf);
+    };
+
+    if (num_threads == 0)
+	num_threads = std::max(1u, std::thread::hardware_concurrency());
 
-	region.push_back(reg);
+    num_threads = static_cast<unsigned>(
+			std::min<size_t>(num_threads, rows));
+
+    if (num_threads <= 1){
+	estudia_filas(0, rows);
+	return;
     }
 
-    return region;
+    // Cada thread estudia un bloque de filas seguidas
+    std::vector<std::future<void>> threads;
+    size_t bloque = rows / num_threads;
+    size_t i0 = 0;
+    for (unsigned t = 0; t + 1 < num_threads; ++t, i0 += bloque)
+	threads.push_back(std::async(std::launch::async, estudia_filas,
+							i0, i0 + bloque));
+
+    estudia_filas(i0, rows);
+
+    for (auto& t: threads)
+	t.get();
 }
 
 
@@ -37,6 +37,8 @@
  *       29/07/2022 y_symmetry, rotate_plus90, rotate_minus90
  *	 27/08/2022 h_differences, operator+ (a+b), operator- (a-b)
  *	 28/08/2022 rotate_180
+ *	 18/10/2026 read_matrix(Reader)
+ *	 18/10/2026 median_filter
  *
  ****************************************************************************/
 
@@ -46,11 +48,20 @@
 #include "alp_math.h"	// punto_medio
 #include "alp_type_traits.h"
 #include "alp_cast.h"	// narrow_cast 
+#include "alp_statistics.h"	// median_of
 
 #include <fstream>
 #include <sstream>
 #include <iterator>
 #include <numeric>
+#include <string_view>
+#include <charconv>	// from_chars
+#include <cctype>
+#include <array>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace alp{
 
@@ -191,6 +202,58 @@ Matrix<T, I> read_matrix(std::istream& in)
 
 
 
+/// Lee una matriz de un lector de líneas (Line_reader, Buffered_line_reader
+/// ...). Lee hasta encontrar una línea vacía o EOF.
+/// A diferencia de la versión con std::istream no crea una std::string por
+/// línea. Si T es aritmético los números se leen con std::from_chars.
+template <typename T, typename I = size_t, typename Reader>
+    requires requires (Reader& in, std::string_view& line) {in.getline(line);}
+Matrix<T, I> read_matrix(Reader& in)
+{
+    std::vector<T> file;
+    
+    std::size_t rows = 0;
+
+    std::string_view line;
+    while (in.getline(line)){
+	if (line.empty())
+	    break;
+
+	++rows;
+
+	if constexpr (std::is_arithmetic_v<T>){
+	    const char* p = line.data();
+	    const char* pe = p + line.size();
+
+	    while (true){
+		while (p != pe and std::isspace(static_cast<unsigned char>(*p)))
+		    ++p;
+
+		if (p == pe)
+		    break;
+
+		T tmp;
+		auto [q, ec] = std::from_chars(p, pe, tmp);
+		if (ec != std::errc{})
+		    throw Error_de_formato{as_str() << "read_matrix: no se "
+			"puede leer la línea " << rows << " [" << line << "]"};
+
+		file.push_back(tmp);
+		p = q;
+	    }
+	}
+	else{
+	    std::istringstream str{std::string{line}};
+	    T tmp;
+	    while (str >> tmp)
+		file.push_back(tmp);
+	}
+    }
+
+    return vector2matrix<T,I>(file, rows);
+}
+
+
 /// Lee una matriz de Ints desde un fichero.
 template <typename T, typename I = size_t>
 inline Matrix<T, I> read_matrix(const std::string& nom_fichero)
@@ -827,6 +890,394 @@ alrededor(const Matrix<I, S>& m, const typename Matrix<I, S>::Position& p)
 }
 
 
+/***************************************************************************
+ *			    FILTRO DE MEDIANA
+ ***************************************************************************/
+namespace impl_of{
+
+// Ventana de radio r centrada en i, recortada a [0, n): [i0, ie)
+template <typename I>
+inline std::pair<I, I> ventana(I i, I r, I n)
+{ return {(i < r)? I{0} : i - r, std::min<I>(i + r + 1, n)}; }
+
+
+// Calcula la mediana en (i, j) por selección (vale para cualquier T).
+template <typename T, typename I>
+void median_filter_pixel(const Matrix<T, I>& m, Matrix<T, I>& res, I r,
+			 I i, I j, std::vector<T>& buf)
+{
+    auto [i0, ie] = ventana(i, r, m.rows());
+    auto [j0, je] = ventana(j, r, m.cols());
+
+    buf.clear();
+    for (I a = i0; a < ie; ++a){
+	auto f = m.begin() + m.cols() * a;
+	buf.insert(buf.end(), f + j0, f + je);
+    }
+
+    res(i, j) = median_inplace(buf.begin(), buf.end());
+}
+
+
+template <typename T, typename I>
+void median_filter_seleccion(const Matrix<T, I>& m, Matrix<T, I>& res, I r)
+{
+    std::vector<T> buf;
+    for (I i = 0; i < m.rows(); ++i)
+	for (I j = 0; j < m.cols(); ++j)
+	    median_filter_pixel(m, res, r, i, j, buf);
+}
+
+
+// Ventanas de 3x3 y 5x5: en el interior usamos una red de ordenación,
+// calculando W medianas a la vez; en los bordes (la ventana está
+// recortada) selección.
+template <size_t r, typename T, typename I>
+void median_filter_red(const Matrix<T, I>& m, Matrix<T, I>& res)
+{
+    constexpr size_t n = 2 * r + 1;
+    constexpr size_t W = 32;
+    const I R = r;
+
+    std::vector<T> buf;
+    std::array<std::array<T, W>, n * n> v{};
+
+    for (I i = 0; i < m.rows(); ++i){
+	if (i < R or m.rows() <= i + R or m.cols() <= 2 * R){
+	    for (I j = 0; j < m.cols(); ++j)
+		median_filter_pixel(m, res, R, i, j, buf);
+
+	    continue;
+	}
+
+	for (I j = 0; j < R; ++j){
+	    median_filter_pixel(m, res, R, i, j, buf);
+	    median_filter_pixel(m, res, R, i, m.cols() - 1 - j, buf);
+	}
+
+	const I je = m.cols() - R;
+	for (I j = R; j < je; j += W){
+	    size_t num = std::min<size_t>(W, je - j);
+
+	    auto p = m.begin() + m.cols() * (i - R) + (j - R);
+	    for (size_t a = 0; a < n; ++a, p += m.cols())
+		for (size_t b = 0; b < n; ++b)
+		    std::copy_n(p + b, num, v[a * n + b].begin());
+
+	    median_of(v);
+
+	    std::copy_n(v[n * n / 2].begin(), num, &res(i, j));
+	}
+    }
+}
+
+
+// Filtros con histograma
+// ----------------------
+// Para enteros de 8 y 16 bits la mediana se puede buscar en un histograma.
+// El histograma tiene dos niveles: uno grueso (los bits altos del valor)
+// y otro fino. Para buscar la mediana se recorre el grueso y luego los
+// finos de un único elemento del grueso: 16 + 16 pasos con 8 bits y
+// 256 + 256 con 16 bits.
+template <typename T>
+concept Entero_histograma = std::is_integral_v<T> and 
+			    !std::is_same_v<T, bool> and sizeof(T) <= 2;
+
+// En el histograma guardamos x - min(T), que va de 0 a 2^bits - 1
+template <typename T>
+inline uint32_t bin(T x)
+{ 
+    return static_cast<uint32_t>(static_cast<int32_t>(x) - 
+			     static_cast<int32_t>(std::numeric_limits<T>::min()));
+}
+
+template <typename T>
+inline T valor_bin(uint32_t b)
+{ 
+    return static_cast<T>(static_cast<int32_t>(b) + 
+			     static_cast<int32_t>(std::numeric_limits<T>::min()));
+}
+
+
+template <size_t bits>
+struct Histograma_mediana{
+    static constexpr size_t ancho   = size_t{1} << (bits / 2);
+    static constexpr size_t gruesos = (size_t{1} << bits) / ancho;
+
+    std::array<uint32_t, gruesos> grueso{};
+    std::array<uint32_t, gruesos * ancho> fino{};
+
+    void add(uint32_t b)
+    {
+	++grueso[b / ancho];
+	++fino[b];
+    }
+
+    void remove(uint32_t b)
+    {
+	--grueso[b / ancho];
+	--fino[b];
+    }
+
+    // Estos bucles los vectoriza el compilador
+    Histograma_mediana& operator+=(const Histograma_mediana& h)
+    {
+	for (size_t i = 0; i < gruesos; ++i)
+	    grueso[i] += h.grueso[i];
+
+	for (size_t i = 0; i < fino.size(); ++i)
+	    fino[i] += h.fino[i];
+
+	return *this;
+    }
+
+    Histograma_mediana& operator-=(const Histograma_mediana& h)
+    {
+	for (size_t i = 0; i < gruesos; ++i)
+	    grueso[i] -= h.grueso[i];
+
+	for (size_t i = 0; i < fino.size(); ++i)
+	    fino[i] -= h.fino[i];
+
+	return *this;
+    }
+
+    void clear()
+    {
+	grueso.fill(0);
+	fino.fill(0);
+    }
+
+    // Devuelve el bin del elemento t-ésimo (empezando en 1).
+    // Precondición: 1 <= t <= número de elementos del histograma
+    uint32_t elemento(uint32_t t) const
+    {
+	size_t g = 0;
+	for (; t > grueso[g]; ++g)
+	    t -= grueso[g];
+
+	size_t b = g * ancho;
+	for (; t > fino[b]; ++b)
+	    t -= fino[b];
+
+	return static_cast<uint32_t>(b);
+    }
+};
+
+
+// 8 bits: algoritmo de Perreault y Hébert. Guardamos un histograma por
+// columna con las 2r+1 filas de la ventana; el histograma de la ventana se
+// actualiza sumando la columna que entra y restando la que sale.
+//
+// De la ventana solo se actualiza en cada pixel el nivel grueso (16
+// contadores). Los 16 contadores finos de un elemento del grueso se
+// actualizan solo cuando la mediana cae en él, sumando y restando las
+// columnas que han entrado y salido desde la última vez. El coste por
+// pixel no depende de r.
+template <typename T, typename I>
+void median_filter_columnas(const Matrix<T, I>& m, Matrix<T, I>& res, I r)
+{
+    constexpr size_t ancho = 16;
+
+    const I rows = m.rows();
+    const I cols = m.cols();
+
+    // Cada columna tiene como mucho 2r+1 elementos: basta con 16 bits
+    std::vector<std::array<uint16_t, ancho>> col_grueso(cols);
+    std::vector<std::array<uint16_t, ancho * ancho>> col_fino(cols);
+
+    auto add_fila = [&](I i) {
+	auto f = m.begin() + cols * i;
+	for (I j = 0; j < cols; ++j){
+	    uint32_t b = bin(f[j]);
+	    ++col_grueso[j][b / ancho];
+	    ++col_fino[j][b];
+	}
+    };
+
+    auto remove_fila = [&](I i) {
+	auto f = m.begin() + cols * i;
+	for (I j = 0; j < cols; ++j){
+	    uint32_t b = bin(f[j]);
+	    --col_grueso[j][b / ancho];
+	    --col_fino[j][b];
+	}
+    };
+
+    // Histograma de la ventana. fino[g*ancho, (g+1)*ancho) contiene las
+    // columnas [lo[g], hi[g]).
+    std::array<uint32_t, ancho> grueso;
+    std::array<uint32_t, ancho * ancho> fino;
+    std::array<I, ancho> lo;
+    std::array<I, ancho> hi;
+
+    auto suma_grueso = [&](I j) {
+	for (size_t g = 0; g < ancho; ++g)
+	    grueso[g] += col_grueso[j][g];
+    };
+
+    auto resta_grueso = [&](I j) {
+	for (size_t g = 0; g < ancho; ++g)
+	    grueso[g] -= col_grueso[j][g];
+    };
+
+    // Pasa los finos del elemento g a la ventana de columnas [j0, je)
+    auto actualiza_fino = [&](size_t g, I j0, I je) {
+	uint32_t* f = fino.data() + g * ancho;
+
+	if (hi[g] <= j0){ // no hay columnas en común
+	    std::fill_n(f, ancho, 0);
+	    lo[g] = hi[g] = j0;
+	}
+
+	for (I j = lo[g]; j < j0; ++j)
+	    for (size_t k = 0; k < ancho; ++k)
+		f[k] -= col_fino[j][g * ancho + k];
+
+	for (I j = hi[g]; j < je; ++j)
+	    for (size_t k = 0; k < ancho; ++k)
+		f[k] += col_fino[j][g * ancho + k];
+
+	lo[g] = j0;
+	hi[g] = je;
+    };
+
+    for (I i = 0; i < std::min(r, rows); ++i)
+	add_fila(i);
+
+    for (I i = 0; i < rows; ++i){
+	if (i + r < rows) add_fila(i + r);
+	if (i > r)	  remove_fila(i - r - 1);
+
+	auto [i0, ie] = ventana(i, r, rows);
+
+	grueso.fill(0);
+	lo.fill(0);
+	hi.fill(0);
+
+	for (I j = 0; j < std::min(r, cols); ++j)
+	    suma_grueso(j);
+
+	for (I j = 0; j < cols; ++j){
+	    if (j + r < cols) suma_grueso(j + r);
+	    if (j > r)	      resta_grueso(j - r - 1);
+
+	    auto [j0, je] = ventana(j, r, cols);
+	    auto t = static_cast<uint32_t>((ie - i0) * (je - j0) + 1) / 2;
+
+	    size_t g = 0;
+	    for (; t > grueso[g]; ++g)
+		t -= grueso[g];
+
+	    actualiza_fino(g, j0, je);
+
+	    size_t b = g * ancho;
+	    for (; t > fino[b]; ++b)
+		t -= fino[b];
+
+	    res(i, j) = valor_bin<T>(static_cast<uint32_t>(b));
+	}
+    }
+}
+
+
+// 16 bits: un histograma por columna ocuparía demasiado. Usamos el
+// algoritmo de Huang: al pasar de un pixel al siguiente se quitan del
+// histograma los 2r+1 elementos de la columna que sale y se añaden los
+// de la que entra.
+// (También lo usamos con 8 bits si las columnas no caben en 16 bits.)
+template <typename T, typename I>
+void median_filter_huang(const Matrix<T, I>& m, Matrix<T, I>& res, I r)
+{
+    const I rows = m.rows();
+    const I cols = m.cols();
+
+    auto h = std::make_unique<Histograma_mediana<8 * sizeof(T)>>();
+
+    for (I i = 0; i < rows; ++i){
+	auto [i0, ie] = ventana(i, r, rows);
+
+	auto add_col = [&](I j) {
+	    for (I a = i0; a < ie; ++a)
+		h->add(bin(m(a, j)));
+	};
+
+	auto remove_col = [&](I j) {
+	    for (I a = i0; a < ie; ++a)
+		h->remove(bin(m(a, j)));
+	};
+
+	for (I j = 0; j < std::min(r, cols); ++j)
+	    add_col(j);
+
+	for (I j = 0; j < cols; ++j){
+	    if (j + r < cols) add_col(j + r);
+	    if (j > r)	      remove_col(j - r - 1);
+
+	    auto [j0, je] = ventana(j, r, cols);
+	    auto n = static_cast<uint32_t>((ie - i0) * (je - j0));
+
+	    res(i, j) = valor_bin<T>(h->elemento((n + 1) / 2));
+	}
+
+	// Dejamos el histograma vacío para la siguiente fila
+	if (cols > 0)
+	    for (I j = ventana(cols - 1, r, cols).first; j < cols; ++j)
+		remove_col(j);
+    }
+}
+
+}// namespace impl_of
+
+
+/*!
+ *  \brief  Filtro de mediana.
+ *
+ *  Sustituye cada elemento de m por la mediana de la ventana de 
+ *  (2r+1) x (2r+1) centrada en él (quita el ruido de sal y pimienta).
+ *  En los bordes la ventana se recorta a la matriz; si la ventana tiene un
+ *  número par de elementos se toma el menor de los dos centrales.
+ *
+ *  Algoritmo:
+ *	+ r = 1, 2: redes de ordenación (median_of).
+ *	+ enteros de 8 bits: histogramas por columna, O(1) por pixel.
+ *	+ enteros de 16 bits: histograma deslizante, O(r) por pixel.
+ *	+ resto: selección (nth_element), O(r^2) por pixel.
+ *
+ */
+template <typename T, typename I>
+Matrix<T, I> median_filter(const Matrix<T, I>& m, std::type_identity_t<I> r)
+{
+    if (r == 0)
+	return m;
+
+    Matrix<T, I> res{m.rows(), m.cols()};
+
+    if constexpr (std::is_arithmetic_v<T>){
+	if (r == 1){
+	    impl_of::median_filter_red<1>(m, res);
+	    return res;
+	}
+
+	if (r == 2){
+	    impl_of::median_filter_red<2>(m, res);
+	    return res;
+	}
+    }
+
+    if constexpr (impl_of::Entero_histograma<T>){
+	if (sizeof(T) == 1 and std::min<size_t>(2 * r + 1, m.rows()) <= 0xFFFF)
+	    impl_of::median_filter_columnas(m, res, r);
+	else
+	    impl_of::median_filter_huang(m, res, r);
+    }
+    else 
+	impl_of::median_filter_seleccion(m, res, r);
+
+    return res;
+}
+
+
 }// namespace
 
 
@@ -0,0 +1,502 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_MATRIX_DISTANCE_H__
+#define __ALP_MATRIX_DISTANCE_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Transformadas de distancia: para cada pixel de una matriz
+ *	calcula la distancia al pixel "objeto" más próximo (y cuál es).
+ *
+ *  - COMENTARIOS: Los pixels objeto son los pixels x de la matriz que
+ *	cumplen pred(x) (por defecto, los diferentes de 0).
+ *
+ *	Hay dos transformadas:
+ *
+ *	1.- Distancia euclídea exacta (Felzenszwalb y Huttenlocher). Se hace
+ *	    en dos fases separables:
+ *	    a) edt_columns: para cada pixel calcula la fila del pixel objeto
+ *	       más próximo de su misma columna. Las columnas son
+ *	       independientes. Se recorre la matriz por filas (todas las
+ *	       columnas a la vez) para que los accesos sean consecutivos y
+ *	       se pueda vectorizar.
+ *	    b) edt_rows: para cada fila calcula la envolvente inferior de las
+ *	       parábolas (j - q)^2 + (i - fila(i, q))^2. Las filas son
+ *	       independientes.
+ *
+ *	    distance_transform2(..., num_threads) reparte bandas de columnas
+ *	    (fase a) y luego bandas de filas (fase b) entre varios threads.
+ *
+ *	    Las distancias se devuelven al cuadrado, como enteros (exactas).
+ *
+ *	2.- Distancia chamfer 3-4: aproximación de la distancia euclídea
+ *	    (3 = paso horizontal o vertical, 4 = paso en diagonal) en dos
+ *	    pasadas. Es la distancia de la matriz a lo largo de caminos de 8
+ *	    vecinos; dividirla por 3 para tener (aproximadamente) pixels.
+ *
+ *	Si no hay ningún pixel objeto la distancia es
+ *	std::numeric_limits<...>::max() y el pixel más próximo (-1, -1).
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    19/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "alp_rframe_ij.h"
+#include "alp_matrix.h"
+
+namespace alp{
+
+namespace impl_of{
+// Predicado por defecto: pixels diferentes de 0
+struct Distinto_de_cero{
+    template <typename T>
+    bool operator()(const T& x) const {return x != T{};}
+};
+
+template <typename M>
+using Ind_de = typename M::Ind;
+
+template <typename M>
+using Int_de = std::make_signed_t<typename M::Ind>;
+
+}// namespace impl_of
+
+
+/***************************************************************************
+ *			    DISTANCIA EUCLÍDEA
+ ***************************************************************************/
+namespace impl_of{
+// Las columnas se procesan por bloques de este tamaño
+inline constexpr ptrdiff_t bloque_distance = 64;
+
+// edt_columns para las n columnas que empiezan en j0 (n <= bloque).
+// Guardamos en arrays locales la última fila encontrada: así el
+// compilador sabe que no se solapan con fila y puede vectorizar.
+template <ptrdiff_t n, typename M, typename Pred, typename Int, typename Ind>
+void edt_columns_bloque(const M& m, Pred& pred, Matrix<Int, Ind>& fila,
+			Ind j0)
+{
+    Int rows = static_cast<Int>(m.rows());
+    Int ultima[n];
+
+    // Hacia abajo: último pixel objeto encontrado en cada columna
+    for (ptrdiff_t k = 0; k < n; ++k)
+	ultima[k] = -1;
+
+    for (Int i = 0; i < rows; ++i){
+	auto p = &m(static_cast<Ind>(i), j0);
+	Int* f = &fila(static_cast<Ind>(i), j0);
+
+	for (ptrdiff_t k = 0; k < n; ++k)
+	    ultima[k] = pred(p[k])? i: ultima[k];
+
+	for (ptrdiff_t k = 0; k < n; ++k)
+	    f[k] = ultima[k];
+    }
+
+    // Hacia arriba: nos quedamos con el más próximo de los dos
+    for (Int i = rows - 1; i >= 0; --i){
+	Int* f = &fila(static_cast<Ind>(i), j0);
+
+	for (ptrdiff_t k = 0; k < n; ++k){
+	    Int a = f[k];
+	    Int b = ultima[k];
+	    bool mejor = (b >= 0) and (a < 0 or b - i < i - a);
+	    ultima[k] = mejor? b: a;
+	}
+
+	for (ptrdiff_t k = 0; k < n; ++k)
+	    f[k] = ultima[k];
+    }
+}
+
+}// namespace impl_of
+
+
+/// Fase 1 de la transformada euclídea, para las columnas [j0, je).
+/// fila(i, j) = fila del pixel objeto de la columna j más próximo a (i, j)
+/// (-1 si en la columna no hay ninguno).
+/// fila tiene que tener el mismo tamaño que m.
+template <typename M, typename Pred, typename Int, typename Ind>
+void edt_columns(const M& m, Pred pred, Matrix<Int, Ind>& fila,
+		 Ind j0, Ind je)
+{
+    static_assert(std::is_signed_v<Int>);
+    constexpr ptrdiff_t B = impl_of::bloque_distance;
+
+    if (m.rows() == 0)
+	return;
+
+    ptrdiff_t j = static_cast<ptrdiff_t>(j0);
+    ptrdiff_t e = static_cast<ptrdiff_t>(je);
+
+    for (; j + B <= e; j += B)
+	impl_of::edt_columns_bloque<B>(m, pred, fila, static_cast<Ind>(j));
+
+    // Las últimas columnas de una en una
+    for (; j < e; ++j)
+	impl_of::edt_columns_bloque<1>(m, pred, fila, static_cast<Ind>(j));
+}
+
+
+/// Fase 2 de la transformada euclídea, para las filas [i0, ie).
+/// A partir de fila (calculada por edt_columns) calcula la distancia al
+/// cuadrado d2(i, j) y, si nearest != nullptr, el pixel objeto más próximo.
+/// d2 y nearest tienen que tener el mismo tamaño que fila.
+template <typename Int, typename Ind>
+void edt_rows(const Matrix<Int, Ind>& fila, Matrix<int64_t, Ind>& d2,
+	      Matrix<Vector_ij<Int>, Ind>* nearest, Ind i0, Ind ie)
+{
+    constexpr int64_t inf = std::numeric_limits<int64_t>::max();
+
+    Int cols = static_cast<Int>(fila.cols());
+    if (cols == 0)
+	return;
+
+    // Envolvente inferior: v[k] = vértice de la parábola k, que es la
+    // mínima en [z[k], z[k+1]).
+    std::vector<Int> v(cols);
+    std::vector<double> z(cols + 1);
+
+    for (Ind ii = i0; ii < ie; ++ii){
+	Int i = static_cast<Int>(ii);
+	const Int* f = &fila(ii, Ind{0});
+	int64_t* d = &d2(ii, Ind{0});
+
+	auto h = [&](Int q) {
+	    int64_t di = i - f[q];
+	    return di * di;
+	};
+
+	Int k = -1;
+	for (Int q = 0; q < cols; ++q){
+	    if (f[q] < 0)
+		continue;
+
+	    double fq = static_cast<double>(h(q)) + double(q) * q;
+	    double s = 0;
+	    while (k >= 0){
+		Int p = v[k];
+		double fp = static_cast<double>(h(p)) + double(p) * p;
+		s = (fq - fp) / (2.0 * (q - p));
+
+		if (s > z[k])
+		    break;
+
+		--k;
+	    }
+
+	    ++k;
+	    v[k] = q;
+	    z[k] = (k == 0)? -std::numeric_limits<double>::infinity(): s;
+	    z[k + 1] = std::numeric_limits<double>::infinity();
+	}
+
+	if (k < 0){ // no hay ningún pixel objeto
+	    std::fill(d, d + cols, inf);
+	    if (nearest){
+		Vector_ij<Int>* n = &(*nearest)(ii, Ind{0});
+		std::fill(n, n + cols, Vector_ij<Int>{-1, -1});
+	    }
+	    continue;
+	}
+
+	k = 0;
+	for (Int j = 0; j < cols; ++j){
+	    while (z[k + 1] < j)
+		++k;
+
+	    Int q = v[k];
+	    int64_t dj = j - q;
+	    d[j] = dj * dj + h(q);
+
+	    if (nearest)
+		(*nearest)(ii, static_cast<Ind>(j)) = Vector_ij<Int>{f[q], q};
+	}
+    }
+}
+
+
+namespace impl_of{
+// Llama a f(k0, ke) para bandas de [0, n), cada una en un thread (0 = un
+// thread por core). El tamaño de las bandas es múltiplo de min_banda.
+template <typename Ind, typename F>
+void distance_por_bandas(Ind n, Ind min_banda, unsigned num_threads, F f)
+{
+    if (num_threads == 0)
+	num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    Ind num_bandas = std::min(static_cast<Ind>(num_threads), n / min_banda);
+    if (num_bandas <= 1){
+	f(Ind{0}, n);
+	return;
+    }
+
+    std::vector<std::future<void>> threads;
+    Ind banda = n / num_bandas / min_banda * min_banda;
+    Ind k0 = 0;
+    for (Ind t = 0; t + 1 < num_bandas; ++t, k0 += banda)
+	threads.push_back(std::async(std::launch::async, f, k0, k0 + banda));
+
+    f(k0, n);
+
+    for (auto& t: threads)
+	t.get();
+}
+
+template <typename M, typename Pred>
+Matrix<int64_t, Ind_de<M>>
+    distance_transform2(const M& m, Pred pred,
+			Matrix<Vector_ij<Int_de<M>>, Ind_de<M>>* nearest,
+			unsigned num_threads)
+{
+    using Ind = Ind_de<M>;
+    using Int = Int_de<M>;
+
+    // Las bandas de columnas son múltiplos del bloque de edt_columns y las
+    // de filas tienen suficientes filas para que compense crear el thread.
+    constexpr Ind min_columnas = static_cast<Ind>(bloque_distance);
+    constexpr Ind min_filas = 16;
+
+    Matrix<Int, Ind> fila{m.rows(), m.cols()};
+    distance_por_bandas(static_cast<Ind>(m.cols()), min_columnas,
+			num_threads, [&](Ind j0, Ind je) {
+	edt_columns(m, pred, fila, j0, je);
+    });
+
+    Matrix<int64_t, Ind> d2{m.rows(), m.cols()};
+    if (nearest)
+	*nearest = Matrix<Vector_ij<Int>, Ind>{m.rows(), m.cols()};
+
+    distance_por_bandas(static_cast<Ind>(m.rows()), min_filas,
+			num_threads, [&](Ind i0, Ind ie) {
+	edt_rows(fila, d2, nearest, i0, ie);
+    });
+
+    return d2;
+}
+
+}// namespace impl_of
+
+
+/// Distancia euclídea al cuadrado de cada pixel de m al pixel objeto (que
+/// cumple pred) más próximo. En nearest devuelve cuál es ese pixel.
+template <typename M, typename Pred>
+inline Matrix<int64_t, impl_of::Ind_de<M>>
+    distance_transform2(const M& m, Pred pred,
+	Matrix<Vector_ij<impl_of::Int_de<M>>, impl_of::Ind_de<M>>& nearest)
+{ return impl_of::distance_transform2(m, pred, &nearest, 1); }
+
+
+/// Distancia euclídea al cuadrado de cada pixel de m al pixel objeto (que
+/// cumple pred) más próximo.
+template <typename M, typename Pred = impl_of::Distinto_de_cero>
+inline Matrix<int64_t, impl_of::Ind_de<M>>
+		    distance_transform2(const M& m, Pred pred = Pred{})
+{
+    using Nearest = Matrix<Vector_ij<impl_of::Int_de<M>>, impl_of::Ind_de<M>>;
+    return impl_of::distance_transform2(m, pred, 
+				    static_cast<Nearest*>(nullptr), 1);
+}
+
+
+/// Igual que distance_transform2(m, pred, nearest), repartiendo el trabajo
+/// entre num_threads threads (0 = un thread por core).
+template <typename M, typename Pred>
+inline Matrix<int64_t, impl_of::Ind_de<M>>
+    distance_transform2(const M& m, Pred pred,
+	Matrix<Vector_ij<impl_of::Int_de<M>>, impl_of::Ind_de<M>>& nearest,
+	unsigned num_threads)
+{ return impl_of::distance_transform2(m, pred, &nearest, num_threads); }
+
+
+/// Igual que distance_transform2(m, pred), repartiendo el trabajo entre
+/// num_threads threads (0 = un thread por core).
+template <typename M, typename Pred>
+inline Matrix<int64_t, impl_of::Ind_de<M>>
+    distance_transform2(const M& m, Pred pred, unsigned num_threads)
+{
+    using Nearest = Matrix<Vector_ij<impl_of::Int_de<M>>, impl_of::Ind_de<M>>;
+    return impl_of::distance_transform2(m, pred, 
+				    static_cast<Nearest*>(nullptr), num_threads);
+}
+
+
+/// Distancia euclídea de cada pixel de m al pixel objeto más próximo.
+template <typename M, typename Pred = impl_of::Distinto_de_cero>
+Matrix<double, impl_of::Ind_de<M>>
+		    distance_transform(const M& m, Pred pred = Pred{})
+{
+    constexpr int64_t inf = std::numeric_limits<int64_t>::max();
+
+    auto d2 = distance_transform2(m, pred);
+
+    Matrix<double, impl_of::Ind_de<M>> res{m.rows(), m.cols()};
+    std::transform(d2.begin(), d2.end(), res.begin(), [](int64_t x) {
+	return (x == inf)? std::numeric_limits<double>::infinity():
+			   std::sqrt(static_cast<double>(x));
+    });
+
+    return res;
+}
+
+
+
+
+/***************************************************************************
+ *			    DISTANCIA CHAMFER 3-4
+ ***************************************************************************/
+namespace impl_of{
+// Pasada de la transformada chamfer. di = +1 hacia abajo (de izquierda a
+// derecha), di = -1 hacia arriba (de derecha a izquierda).
+template <int di, typename Int, typename Ind>
+void chamfer_pasada(Matrix<int32_t, Ind>& d,
+		    Matrix<Vector_ij<Int>, Ind>* nearest)
+{
+    Int rows = static_cast<Int>(d.rows());
+    Int cols = static_cast<Int>(d.cols());
+
+    Int i0 = (di > 0)? 0: rows - 1;
+    Int ie = (di > 0)? rows: -1;
+
+    // Primero los 3 vecinos de la fila anterior (en la misma fila no
+    // dependen unos pixels de otros) y luego el vecino de la misma fila.
+    for (Int i = i0; i != ie; i += di){
+	int32_t* p = &d(static_cast<Ind>(i), Ind{0});
+	Vector_ij<Int>* n = nearest?
+		    &(*nearest)(static_cast<Ind>(i), Ind{0}): nullptr;
+
+	if (i != i0){
+	    const int32_t* a = &d(static_cast<Ind>(i - di), Ind{0});
+	    const Vector_ij<Int>* na = nearest?
+		    &(*nearest)(static_cast<Ind>(i - di), Ind{0}): nullptr;
+
+	    for (Int j = 0; j < cols; ++j){
+		int32_t m = a[j] + 3;
+		Int jm = j;
+		if (j > 0 and a[j - 1] + 4 < m){
+		    m = a[j - 1] + 4;
+		    jm = j - 1;
+		}
+		if (j + 1 < cols and a[j + 1] + 4 < m){
+		    m = a[j + 1] + 4;
+		    jm = j + 1;
+		}
+
+		if (m < p[j]){
+		    p[j] = m;
+		    if (n) n[j] = na[jm];
+		}
+	    }
+	}
+
+	if constexpr (di > 0){
+	    for (Int j = 1; j < cols; ++j)
+		if (p[j - 1] + 3 < p[j]){
+		    p[j] = p[j - 1] + 3;
+		    if (n) n[j] = n[j - 1];
+		}
+	}
+	else {
+	    for (Int j = cols - 2; j >= 0; --j)
+		if (p[j + 1] + 3 < p[j]){
+		    p[j] = p[j + 1] + 3;
+		    if (n) n[j] = n[j + 1];
+		}
+	}
+    }
+}
+
+
+template <typename M, typename Pred>
+Matrix<int32_t, Ind_de<M>> chamfer(const M& m, Pred pred,
+		       Matrix<Vector_ij<Int_de<M>>, Ind_de<M>>* nearest)
+{
+    using Ind = Ind_de<M>;
+    using Int = Int_de<M>;
+    constexpr int32_t inf = std::numeric_limits<int32_t>::max() / 2;
+
+    Matrix<int32_t, Ind> d{m.rows(), m.cols()};
+
+    Int rows = static_cast<Int>(m.rows());
+    Int cols = static_cast<Int>(m.cols());
+    if (rows == 0 or cols == 0)
+	return d;
+
+    for (Int i = 0; i < rows; ++i)
+	for (Int j = 0; j < cols; ++j){
+	    bool obj = pred(m(static_cast<Ind>(i), static_cast<Ind>(j)));
+	    d(static_cast<Ind>(i), static_cast<Ind>(j)) = obj? 0: inf;
+	    if (nearest)
+		(*nearest)(static_cast<Ind>(i), static_cast<Ind>(j)) =
+		    obj? Vector_ij<Int>{i, j}: Vector_ij<Int>{-1, -1};
+	}
+
+    chamfer_pasada<+1>(d, nearest);
+    chamfer_pasada<-1>(d, nearest);
+
+    for (auto& x: d)
+	if (x >= inf)
+	    x = std::numeric_limits<int32_t>::max();
+
+    return d;
+}
+
+}// namespace impl_of
+
+
+/// Distancia chamfer 3-4 de cada pixel de m al pixel objeto más próximo.
+template <typename M, typename Pred = impl_of::Distinto_de_cero>
+inline Matrix<int32_t, impl_of::Ind_de<M>>
+			chamfer_distance(const M& m, Pred pred = Pred{})
+{
+    using Ind = impl_of::Ind_de<M>;
+    using Int = impl_of::Int_de<M>;
+    return impl_of::chamfer(m, pred,
+		    static_cast<Matrix<Vector_ij<Int>, Ind>*>(nullptr));
+}
+
+
+/// Distancia chamfer 3-4 de cada pixel de m al pixel objeto más próximo. En
+/// nearest devuelve el pixel objeto desde el que se ha llegado.
+template <typename M, typename Pred>
+Matrix<int32_t, impl_of::Ind_de<M>>
+    chamfer_distance(const M& m, Pred pred,
+	Matrix<Vector_ij<impl_of::Int_de<M>>, impl_of::Ind_de<M>>& nearest)
+{
+    nearest = Matrix<Vector_ij<impl_of::Int_de<M>>, impl_of::Ind_de<M>>
+							{m.rows(), m.cols()};
+    return impl_of::chamfer(m, pred, &nearest);
+}
+
+
+}// namespace
+
+#endif
@@ -0,0 +1,601 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_MATRIX_MATCH_H__
+#define __ALP_MATRIX_MATCH_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Búsqueda de un patrón (template matching) dentro de una
+ *	matriz.
+ *
+ *  - COMENTARIOS: Se desliza el patrón tpl sobre la imagen img y para cada
+ *	posición (i, j) (esquina superior izquierda del patrón dentro de img)
+ *	se calcula lo que se parecen:
+ *	    + sad: suma de |img - tpl|	    (menor es mejor, 0 = iguales)
+ *	    + ssd: suma de (img - tpl)^2    (menor es mejor, 0 = iguales)
+ *	    + ncc: correlación normalizada  (mayor es mejor, en [-1, 1])
+ *
+ *	img y tpl pueden ser cualquier contenedor bidimensional de la
+ *	librería (Matrix, Matrix_view, Submatrix) de tipos aritméticos. Se
+ *	supone que las filas son contiguas.
+ *
+ *	Para que se pueda vectorizar, las filas se comparan por bloques de
+ *	tamaño fijo. Para la ncc las sumas de img y de img^2 de cada ventana se
+ *	calculan con imágenes integrales (coste constante por posición).
+ *
+ *	find_best_matches abandona el cálculo de sad/ssd de una posición en
+ *	cuanto la suma parcial supera a la peor de las k mejores encontradas
+ *	(early termination).
+ *
+ *	find_best_match busca primero en imágenes reducidas (pirámide) y va
+ *	refinando alrededor de los mejores candidatos (coarse-to-fine). Es
+ *	mucho más rápido pero puede no encontrar el óptimo si el patrón tiene
+ *	detalles más pequeños que el nivel más reducido.
+ *
+ *	Todas las posiciones son independientes: match_map_rows calcula una
+ *	banda de filas del mapa. match_map y find_best_matches admiten un
+ *	número de threads entre los que reparten bandas de filas.
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    19/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "alp_rframe_ij.h"
+#include "alp_matrix.h"
+
+namespace alp{
+
+enum class Match_metric{ sad, ssd, ncc };
+
+/// Posición (esquina superior izquierda) en la que se ha encontrado el
+/// patrón y lo que se parece.
+template <typename Int>
+struct Match_ij{
+    Vector_ij<Int> pos;
+    double score;
+};
+
+
+/// ¿Es el valor a mejor que b para la métrica m?
+inline bool es_mejor(Match_metric m, double a, double b)
+{ return (m == Match_metric::ncc)? a > b: a < b; }
+
+
+namespace impl_of{
+template <typename M>
+using Value_de = std::remove_cvref_t<decltype(std::declval<const M&>()(0, 0))>;
+
+// Tipo con el que acumulamos: enteros para tipos enteros.
+template <typename T1, typename T2>
+using Acumulador = std::conditional_t<std::is_integral_v<T1> and
+				      std::is_integral_v<T2>, int64_t, double>;
+
+// Las filas se comparan por bloques de este tamaño.
+inline constexpr ptrdiff_t bloque_match = 16;
+
+// Devuelve suma de |a - b| (sad) o de (a - b)^2 (ssd) de la fila
+template <Match_metric met, typename Acc, typename T1, typename T2>
+Acc diferencia_fila(const T1* a, const T2* b, ptrdiff_t n)
+{
+    constexpr ptrdiff_t B = bloque_match;
+
+    // Con enteros pequeños acumulamos cada bloque en 32 bits: con 8 bits
+    // la ssd de un bloque es como mucho 16·255^2. Con 16 bits solo la sad
+    // (16·2^17); el cuadrado de una diferencia ya no cabe en 32 bits.
+    constexpr size_t max_bytes = (met == Match_metric::sad)? 2: 1;
+    using Acc_bloque = std::conditional_t<(std::is_integral_v<T1> and
+					   sizeof(T1) <= max_bytes and
+					   std::is_integral_v<T2> and
+					   sizeof(T2) <= max_bytes), int32_t, Acc>;
+
+    auto d = [](Acc_bloque x, Acc_bloque y) {
+	Acc_bloque t = x - y;
+	if constexpr (met == Match_metric::sad)
+	    return (t < 0)? -t: t;
+	else
+	    return t * t;
+    };
+
+    Acc s = 0;
+    ptrdiff_t k = 0;
+    for (; k + B <= n; k += B){
+	Acc_bloque t = 0;
+	for (ptrdiff_t u = 0; u < B; ++u)
+	    t += d(static_cast<Acc_bloque>(a[k + u]),
+		   static_cast<Acc_bloque>(b[k + u]));
+	s += t;
+    }
+
+    for (; k < n; ++k)
+	s += d(static_cast<Acc_bloque>(a[k]), static_cast<Acc_bloque>(b[k]));
+
+    return s;
+}
+
+
+// Producto escalar de las filas a y b
+template <typename Acc, typename T1, typename T2>
+Acc producto_fila(const T1* a, const T2* b, ptrdiff_t n)
+{
+    constexpr ptrdiff_t B = bloque_match;
+
+    Acc s = 0;
+    ptrdiff_t k = 0;
+    for (; k + B <= n; k += B){
+	Acc t = 0;
+	for (ptrdiff_t u = 0; u < B; ++u)
+	    t += static_cast<Acc>(a[k + u]) * static_cast<Acc>(b[k + u]);
+	s += t;
+    }
+
+    for (; k < n; ++k)
+	s += static_cast<Acc>(a[k]) * static_cast<Acc>(b[k]);
+
+    return s;
+}
+
+
+// Calcula la puntuación del patrón tpl en cualquier posición de img.
+template <typename M1, typename M2>
+class Comparador{
+public:
+    using T1  = Value_de<M1>;
+    using T2  = Value_de<M2>;
+    using Acc = Acumulador<T1, T2>;
+
+    Comparador(const M1& img, const M2& tpl, Match_metric met);
+
+    Match_metric metric() const {return met_;}
+
+    // Número de posiciones en las que se puede colocar el patrón
+    ptrdiff_t rows() const {return rows_;}
+    ptrdiff_t cols() const {return cols_;}
+
+    // Puntuación del patrón en la posición (i, j). Si es sad/ssd y la suma
+    // supera limite se devuelve un valor > limite (no el valor exacto).
+    double score(ptrdiff_t i, ptrdiff_t j,
+		 double limite = std::numeric_limits<double>::infinity()) const;
+
+private:
+    const M1& img_;
+    const M2& tpl_;
+    Match_metric met_;
+
+    ptrdiff_t tr_, tc_;	    // dimensiones del patrón
+    ptrdiff_t rows_, cols_;
+
+    // ncc
+    double n_;			    // número de pixels del patrón
+    double media_tpl_, norma_tpl_;  // norma = sqrt(sum (tpl - media)^2)
+    std::vector<double> s1_, s2_;   // imágenes integrales de img y img^2
+
+    double integral(const std::vector<double>& s,
+		    ptrdiff_t i, ptrdiff_t j) const
+    {
+	auto S = [&](ptrdiff_t a, ptrdiff_t b)
+			{ return s[a * (img_.cols() + 1) + b]; };
+
+	return S(i + tr_, j + tc_) - S(i, j + tc_) - S(i + tr_, j) + S(i, j);
+    }
+
+    void calcula_integrales();
+
+    template <Match_metric met>
+    double diferencia(ptrdiff_t i, ptrdiff_t j, double limite) const;
+
+    double ncc(ptrdiff_t i, ptrdiff_t j) const;
+};
+
+
+template <typename M1, typename M2>
+Comparador<M1, M2>::Comparador(const M1& img, const M2& tpl,
+						    Match_metric met)
+    : img_{img}, tpl_{tpl}, met_{met},
+      tr_{static_cast<ptrdiff_t>(tpl.rows())},
+      tc_{static_cast<ptrdiff_t>(tpl.cols())}
+{
+    if (tr_ == 0 or tc_ == 0)
+	throw std::invalid_argument{"template matching: patrón vacío"};
+
+    rows_ = std::max<ptrdiff_t>(static_cast<ptrdiff_t>(img.rows()) - tr_ + 1, 0);
+    cols_ = std::max<ptrdiff_t>(static_cast<ptrdiff_t>(img.cols()) - tc_ + 1, 0);
+
+    if (met_ != Match_metric::ncc or rows_ == 0 or cols_ == 0)
+	return;
+
+    n_ = static_cast<double>(tr_ * tc_);
+
+    double s = 0, s2 = 0;
+    for (ptrdiff_t i = 0; i < tr_; ++i)
+	for (ptrdiff_t j = 0; j < tc_; ++j){
+	    double x = static_cast<double>(tpl(i, j));
+	    s  += x;
+	    s2 += x * x;
+	}
+
+    media_tpl_ = s / n_;
+    norma_tpl_ = std::sqrt(std::max(s2 - s * media_tpl_, 0.0));
+
+    calcula_integrales();
+}
+
+
+template <typename M1, typename M2>
+void Comparador<M1, M2>::calcula_integrales()
+{
+    ptrdiff_t R = static_cast<ptrdiff_t>(img_.rows());
+    ptrdiff_t C = static_cast<ptrdiff_t>(img_.cols());
+
+    s1_.assign((R + 1) * (C + 1), 0.0);
+    s2_.assign((R + 1) * (C + 1), 0.0);
+
+    for (ptrdiff_t i = 0; i < R; ++i){
+	const T1* p = &img_(i, 0);
+	const double* a1 = &s1_[i * (C + 1)];
+	const double* a2 = &s2_[i * (C + 1)];
+	double* b1 = &s1_[(i + 1) * (C + 1)];
+	double* b2 = &s2_[(i + 1) * (C + 1)];
+
+	double f1 = 0, f2 = 0;	// suma de la fila hasta j
+	for (ptrdiff_t j = 0; j < C; ++j){
+	    double x = static_cast<double>(p[j]);
+	    f1 += x;
+	    f2 += x * x;
+	    b1[j + 1] = a1[j + 1] + f1;
+	    b2[j + 1] = a2[j + 1] + f2;
+	}
+    }
+}
+
+
+template <typename M1, typename M2>
+template <Match_metric met>
+double Comparador<M1, M2>::diferencia(ptrdiff_t i, ptrdiff_t j,
+						    double limite) const
+{
+    Acc s = 0;
+    for (ptrdiff_t r = 0; r < tr_; ++r){
+	s += diferencia_fila<met, Acc>(&img_(i + r, j), &tpl_(r, 0), tc_);
+
+	if (static_cast<double>(s) > limite)
+	    break;
+    }
+
+    return static_cast<double>(s);
+}
+
+
+template <typename M1, typename M2>
+double Comparador<M1, M2>::ncc(ptrdiff_t i, ptrdiff_t j) const
+{
+    Acc s = 0;
+    for (ptrdiff_t r = 0; r < tr_; ++r)
+	s += producto_fila<Acc>(&img_(i + r, j), &tpl_(r, 0), tc_);
+
+    double s1 = integral(s1_, i, j);
+    double s2 = integral(s2_, i, j);
+
+    // sum (img - media_img)·(tpl - media_tpl) = sum img·tpl - s1·media_tpl
+    double num = static_cast<double>(s) - s1 * media_tpl_;
+    double var = s2 - s1 * s1 / n_;
+    if (var <= 0 or norma_tpl_ == 0)
+	return 0;
+
+    return num / (std::sqrt(var) * norma_tpl_);
+}
+
+
+template <typename M1, typename M2>
+inline double Comparador<M1, M2>::score(ptrdiff_t i, ptrdiff_t j,
+						    double limite) const
+{
+    switch (met_){
+	case Match_metric::sad:
+	    return diferencia<Match_metric::sad>(i, j, limite);
+
+	case Match_metric::ssd:
+	    return diferencia<Match_metric::ssd>(i, j, limite);
+
+	default:
+	    return ncc(i, j);
+    }
+}
+
+
+// Las k mejores puntuaciones, ordenadas de mejor a peor.
+template <typename Int>
+class Mejores{
+public:
+    Mejores(Match_metric met, size_t k) : met_{met}, k_{k} { }
+
+    // Peor puntuación que merece la pena calcular
+    double limite() const
+    {
+	if (res_.size() < k_)
+	    return (met_ == Match_metric::ncc)?
+		    -std::numeric_limits<double>::infinity():
+		     std::numeric_limits<double>::infinity();
+
+	return res_.back().score;
+    }
+
+    void add(Int i, Int j, double score)
+    {
+	if (k_ == 0 or (res_.size() == k_ and !es_mejor(met_, score, limite())))
+	    return;
+
+	auto p = std::find_if(res_.begin(), res_.end(), [&](const auto& m)
+				{ return es_mejor(met_, score, m.score); });
+	res_.insert(p, Match_ij<Int>{Vector_ij<Int>{i, j}, score});
+
+	if (res_.size() > k_)
+	    res_.pop_back();
+    }
+
+    std::vector<Match_ij<Int>>& resultado() {return res_;}
+
+private:
+    Match_metric met_;
+    size_t k_;
+    std::vector<Match_ij<Int>> res_;
+};
+
+
+// Reduce la matriz m a la mitad (media de cada bloque de 2 x 2)
+template <typename M>
+Matrix<double, ptrdiff_t> reduce(const M& m)
+{
+    ptrdiff_t R = static_cast<ptrdiff_t>(m.rows()) / 2;
+    ptrdiff_t C = static_cast<ptrdiff_t>(m.cols()) / 2;
+
+    Matrix<double, ptrdiff_t> res{R, C};
+    for (ptrdiff_t i = 0; i < R; ++i)
+	for (ptrdiff_t j = 0; j < C; ++j)
+	    res(i, j) = (static_cast<double>(m(2*i, 2*j))
+			+ static_cast<double>(m(2*i, 2*j + 1))
+			+ static_cast<double>(m(2*i + 1, 2*j))
+			+ static_cast<double>(m(2*i + 1, 2*j + 1))) / 4;
+
+    return res;
+}
+
+
+// Número de bandas de filas en las que repartimos rows filas entre
+// num_threads threads (0 = un thread por core).
+inline ptrdiff_t match_num_bandas(ptrdiff_t rows, unsigned num_threads)
+{
+    // Con bandas muy pequeñas no compensa crear el thread
+    constexpr ptrdiff_t min_filas = 8;
+
+    if (num_threads == 0)
+	num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    return std::max<ptrdiff_t>(1, std::min<ptrdiff_t>(num_threads,
+						      rows / min_filas));
+}
+
+// Llama a f(b, i0, ie) para cada una de las num_bandas bandas de filas
+// [i0, ie) de [0, rows), cada una en un thread.
+template <typename F>
+void match_por_bandas(ptrdiff_t rows, ptrdiff_t num_bandas, F f)
+{
+    std::vector<std::future<void>> threads;
+    ptrdiff_t banda = rows / num_bandas;
+    ptrdiff_t i0 = 0;
+    for (ptrdiff_t b = 0; b + 1 < num_bandas; ++b, i0 += banda)
+	threads.push_back(std::async(std::launch::async, f, b, i0, i0 + banda));
+
+    f(num_bandas - 1, i0, rows);
+
+    for (auto& t: threads)
+	t.get();
+}
+
+}// namespace impl_of
+
+
+/// Calcula las filas [i0, ie) del mapa de puntuaciones: map(i, j) es la
+/// puntuación del patrón tpl colocado en la posición (i, j) de img.
+/// map tiene que tener (img.rows() - tpl.rows() + 1) filas y
+/// (img.cols() - tpl.cols() + 1) columnas.
+template <typename M1, typename M2, typename I>
+void match_map_rows(const M1& img, const M2& tpl, Match_metric met,
+		    Matrix<double, I>& map, I i0, I ie)
+{
+    impl_of::Comparador<M1, M2> c{img, tpl, met};
+
+    ptrdiff_t e = std::min<ptrdiff_t>(static_cast<ptrdiff_t>(ie), c.rows());
+    for (ptrdiff_t i = static_cast<ptrdiff_t>(i0); i < e; ++i)
+	for (ptrdiff_t j = 0; j < c.cols(); ++j)
+	    map(static_cast<I>(i), static_cast<I>(j)) = c.score(i, j);
+}
+
+
+/// Mapa de puntuaciones: map(i, j) es la puntuación del patrón tpl
+/// colocado en la posición (i, j) de img. Las filas del mapa se reparten
+/// entre num_threads threads (0 = un thread por core).
+template <typename M1, typename M2>
+Matrix<double, typename M1::Ind> match_map(const M1& img, const M2& tpl,
+				    Match_metric met, unsigned num_threads = 1)
+{
+    using Ind = typename M1::Ind;
+
+    Ind rows = (img.rows() >= static_cast<Ind>(tpl.rows()))?
+		    static_cast<Ind>(img.rows() - tpl.rows() + 1): Ind{0};
+    Ind cols = (img.cols() >= static_cast<Ind>(tpl.cols()))?
+		    static_cast<Ind>(img.cols() - tpl.cols() + 1): Ind{0};
+
+    Matrix<double, Ind> map{rows, cols};
+
+    // Un único comparador para todos los threads: con ncc calcula las
+    // imágenes integrales de toda img.
+    impl_of::Comparador<M1, M2> c{img, tpl, met};
+    ptrdiff_t n = impl_of::match_num_bandas(c.rows(), num_threads);
+    impl_of::match_por_bandas(c.rows(), n, 
+				    [&](ptrdiff_t, ptrdiff_t i0, ptrdiff_t ie) {
+	for (ptrdiff_t i = i0; i < ie; ++i)
+	    for (ptrdiff_t j = 0; j < c.cols(); ++j)
+		map(static_cast<Ind>(i), static_cast<Ind>(j)) = c.score(i, j);
+    });
+
+    return map;
+}
+
+
+/// Devuelve las k posiciones de img en las que mejor encaja tpl,
+/// ordenadas de mejor a peor. Búsqueda exhaustiva.
+/// Las filas se reparten entre num_threads threads (0 = un thread por
+/// core); cada thread busca sus k mejores y luego se juntan.
+template <typename M1, typename M2>
+std::vector<Match_ij<std::make_signed_t<typename M1::Ind>>>
+    find_best_matches(const M1& img, const M2& tpl, Match_metric met,
+				    size_t k = 1, unsigned num_threads = 1)
+{
+    using Int = std::make_signed_t<typename M1::Ind>;
+
+    impl_of::Comparador<M1, M2> c{img, tpl, met};
+
+    ptrdiff_t n = impl_of::match_num_bandas(c.rows(), num_threads);
+    std::vector<impl_of::Mejores<Int>> banda(static_cast<size_t>(n),
+					     impl_of::Mejores<Int>{met, k});
+
+    impl_of::match_por_bandas(c.rows(), n, 
+				    [&](ptrdiff_t b, ptrdiff_t i0, ptrdiff_t ie) {
+	auto& mejores = banda[static_cast<size_t>(b)];
+	for (ptrdiff_t i = i0; i < ie; ++i)
+	    for (ptrdiff_t j = 0; j < c.cols(); ++j)
+		mejores.add(static_cast<Int>(i), static_cast<Int>(j),
+			    c.score(i, j, mejores.limite()));
+    });
+
+    // Añadiendo las bandas en orden, en caso de empate gana la primera
+    // posición, igual que con un thread.
+    for (size_t b = 1; b < banda.size(); ++b)
+	for (const auto& m: banda[b].resultado())
+	    banda[0].add(m.pos.i, m.pos.j, m.score);
+
+    return std::move(banda[0].resultado());
+}
+
+
+/// Devuelve la posición de img en la que mejor encaja tpl buscando primero
+/// en imágenes reducidas niveles - 1 veces a la mitad (niveles = 1 es
+/// búsqueda exhaustiva). En cada nivel se refinan los num_candidatos
+/// mejores del nivel anterior.
+/// Precondición: tpl cabe en img, num_candidatos > 0.
+template <typename M1, typename M2>
+Match_ij<std::make_signed_t<typename M1::Ind>>
+    find_best_match(const M1& img, const M2& tpl, Match_metric met,
+		    int niveles = 3, size_t num_candidatos = 3)
+{
+    using Int = std::make_signed_t<typename M1::Ind>;
+    using M = Matrix<double, ptrdiff_t>;
+
+    if (img.rows() < static_cast<typename M1::Ind>(tpl.rows()) or
+	img.cols() < static_cast<typename M1::Ind>(tpl.cols()))
+	throw std::invalid_argument{"find_best_match: el patrón no cabe "
+				    "en la imagen"};
+
+    if (num_candidatos == 0)
+	throw std::invalid_argument{"find_best_match: num_candidatos "
+				    "tiene que ser > 0"};
+
+    if (niveles <= 1)
+	return find_best_matches(img, tpl, met).front();
+
+    // Pirámides: pimg[n - 1] = nivel n. El nivel 0 son img y tpl tal cual,
+    // sin pasarlos a double, para comparar con los acumuladores enteros.
+    // No reducimos patrones de menos de 4 pixels de lado.
+    std::vector<M> pimg, ptpl;
+    if (tpl.rows() >= 8 and tpl.cols() >= 8){
+	pimg.push_back(impl_of::reduce(img));
+	ptpl.push_back(impl_of::reduce(tpl));
+    }
+
+    for (int n = 2; n < niveles and !ptpl.empty(); ++n){
+	const M& t = ptpl.back();
+	if (t.rows() < 8 or t.cols() < 8)
+	    break;
+
+	M ri = impl_of::reduce(pimg.back());
+	M rt = impl_of::reduce(t);
+	pimg.push_back(std::move(ri));
+	ptpl.push_back(std::move(rt));
+    }
+
+    if (pimg.empty())
+	return find_best_matches(img, tpl, met).front();
+
+    // Nivel más reducido: búsqueda exhaustiva
+    auto cand = find_best_matches(pimg.back(), ptpl.back(), met, 
+							num_candidatos);
+
+    // Refinamos alrededor de los candidatos (las posiciones se duplican
+    // al pasar al nivel siguiente, +-2 por el redondeo)
+    auto refina = [&](const auto& c, size_t k) {
+	impl_of::Mejores<ptrdiff_t> mejores{met, k};
+
+	for (const auto& m: cand){
+	    ptrdiff_t i0 = std::max<ptrdiff_t>(2 * m.pos.i - 2, 0);
+	    ptrdiff_t ie = std::min<ptrdiff_t>(2 * m.pos.i + 3, c.rows());
+	    ptrdiff_t j0 = std::max<ptrdiff_t>(2 * m.pos.j - 2, 0);
+	    ptrdiff_t je = std::min<ptrdiff_t>(2 * m.pos.j + 3, c.cols());
+
+	    for (ptrdiff_t i = i0; i < ie; ++i)
+		for (ptrdiff_t j = j0; j < je; ++j){
+		    bool repetido = false;
+		    for (const auto& r: mejores.resultado())
+			if (r.pos.i == i and r.pos.j == j)
+			    repetido = true;
+
+		    if (!repetido)
+			mejores.add(i, j, c.score(i, j, mejores.limite()));
+		}
+	}
+
+	cand = std::move(mejores.resultado());
+    };
+
+    for (size_t n = pimg.size() - 1; n > 0; --n)
+	refina(impl_of::Comparador<M, M>{pimg[n - 1], ptpl[n - 1], met},
+							    num_candidatos);
+
+    refina(impl_of::Comparador<M1, M2>{img, tpl, met}, 1);
+
+    const auto& m = cand.front();
+    return Match_ij<Int>{Vector_ij<Int>{static_cast<Int>(m.pos.i),
+					static_cast<Int>(m.pos.j)}, m.score};
+}
+
+
+}// namespace
+
+#endif
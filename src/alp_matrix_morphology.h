@@ -0,0 +1,709 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_MATRIX_MORPHOLOGY_H__
+#define __ALP_MATRIX_MORPHOLOGY_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Morfología matemática: erosión, dilatación, apertura y
+ *	cierre de una matriz con un elemento estructurante rectangular.
+ *
+ *  - COMENTARIOS: El elemento estructurante es un rectángulo de se.rows x
+ *	se.cols pixels centrado en el pixel (para tamaños pares el centro es
+ *	(se.rows / 2, se.cols / 2)).
+ *
+ *	    erosión   : mínimo de los pixels del rectángulo.
+ *	    dilatación: máximo de los pixels del rectángulo reflejado.
+ *	    apertura  : erosión seguida de dilatación.
+ *	    cierre    : dilatación seguida de erosión.
+ *
+ *	Los pixels de fuera de la matriz no cuentan (son el neutro del mínimo
+ *	o del máximo), así que los bordes ni se erosionan ni se dilatan.
+ *
+ *	Un rectángulo es separable: se hace primero una pasada por filas y
+ *	luego otra por columnas. Cada pasada usa el algoritmo de van Herk,
+ *	Gil y Werman: se divide la línea en bloques del tamaño de la ventana y
+ *	se calculan los mínimos (máximos) acumulados hacia delante (g) y hacia
+ *	atrás (h) dentro de cada bloque. La ventana que empieza en i es
+ *	op(h[i], g[i + w - 1]): 3 operaciones por pixel sea cual sea el
+ *	tamaño de la ventana.
+ *
+ *	La pasada por columnas se hace por bloques de columnas recorriendo la
+ *	matriz por filas (accesos consecutivos, vectorizable).
+ *
+ *	Las funciones que reciben un Morphology_buffer trabajan in situ: la
+ *	pasada por filas escribe en el buffer y la de columnas vuelve a
+ *	escribir en la matriz (ping-pong). Reutilizando el buffer (por
+ *	ejemplo, uno por cámara) no se reserva memoria en cada frame.
+ *
+ *	Las funciones binary_xxx son para máscaras: un pixel vale 1 si es
+ *	diferente de T{} y el resultado es T{1} ó T{}. Internamente empaquetan
+ *	la máscara en bits (64 pixels por palabra) y operan palabra a
+ *	palabra: en las filas con desplazamientos (log(w) operaciones por
+ *	palabra), en las columnas con van Herk-Gil-Werman sobre palabras.
+ *	Con un Bit_matrix se opera directamente sobre sus palabras, sin
+ *	empaquetar ni desempaquetar.
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    19/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "alp_rframe_ij.h"
+#include "alp_matrix.h"
+#include "alp_bit_matrix.h"
+
+namespace alp{
+
+/// Memoria auxiliar de las operaciones morfológicas. Reutilizarlo evita
+/// reservar memoria en cada llamada.
+template <typename T>
+struct Morphology_buffer{
+// Uso interno
+    std::vector<T> tmp;		// resultado de la pasada por filas
+    std::vector<T> g, h;	// acumulados de van Herk-Gil-Werman
+
+    // Máscaras empaquetadas
+    std::vector<uint64_t> bits, bits2;
+    std::vector<uint64_t> hb;
+    std::vector<uint64_t> r, u, t;	// una fila empaquetada
+};
+
+
+namespace impl_of{
+// Las columnas se procesan por bloques de este tamaño
+inline constexpr ptrdiff_t bloque_morphology = 64;
+
+template <typename T>
+struct Minimo{
+    static constexpr T neutro()
+    {
+	if constexpr (std::numeric_limits<T>::has_infinity)
+	    return std::numeric_limits<T>::infinity();
+	else
+	    return std::numeric_limits<T>::max();
+    }
+
+    T operator()(T a, T b) const {return (b < a)? b: a;}
+};
+
+template <typename T>
+struct Maximo{
+    static constexpr T neutro()
+    {
+	if constexpr (std::numeric_limits<T>::has_infinity)
+	    return -std::numeric_limits<T>::infinity();
+	else
+	    return std::numeric_limits<T>::lowest();
+    }
+
+    T operator()(T a, T b) const {return (a < b)? b: a;}
+};
+
+// Mínimo y máximo de 64 pixels binarios a la vez
+struct Y_bits{
+    static constexpr uint64_t neutro() {return ~uint64_t{0};}
+    uint64_t operator()(uint64_t a, uint64_t b) const {return a & b;}
+};
+
+struct O_bits{
+    static constexpr uint64_t neutro() {return uint64_t{0};}
+    uint64_t operator()(uint64_t a, uint64_t b) const {return a | b;}
+};
+
+
+// Centro del rectángulo de tamaño w. Para la dilatación se usa el
+// rectángulo reflejado.
+inline ptrdiff_t centro(ptrdiff_t w, bool reflejado)
+{ return reflejado? w - 1 - w / 2: w / 2; }
+
+
+// y[i] = op(x[i - a], ..., x[i - a + w - 1]) para i en [0, n)
+// (los x de fuera de [0, n) son el neutro).
+// g y h tienen que tener n + w - 1 elementos.
+template <typename T, typename Op>
+void vhgw_fila(const T* x, ptrdiff_t n, ptrdiff_t w, ptrdiff_t a,
+	       T* y, T* g, T* h, Op op)
+{
+    ptrdiff_t L = n + w - 1;
+
+    auto ext = [&](ptrdiff_t k) {
+	k -= a;
+	return (0 <= k and k < n)? x[k]: Op::neutro();
+    };
+
+    for (ptrdiff_t k = 0; k < L; ++k)
+	g[k] = (k % w == 0)? ext(k): op(g[k - 1], ext(k));
+
+    h[L - 1] = ext(L - 1);
+    for (ptrdiff_t k = L - 1; k-- > 0; )
+	h[k] = ((k + 1) % w == 0)? ext(k): op(h[k + 1], ext(k));
+
+    for (ptrdiff_t i = 0; i < n; ++i)
+	y[i] = op(h[i], g[i + w - 1]);
+}
+
+
+// Lo mismo que vhgw_fila para las n columnas consecutivas que empiezan en
+// x, todas a la vez. sx y sy son las distancias entre filas de x e y.
+// h tiene que tener (rows + w - 1) * n elementos. Los acumulados g se
+// guardan en un array local: así el compilador sabe que no se solapan con
+// x, y ni h y puede vectorizar.
+template <ptrdiff_t n, typename T, typename Op>
+void vhgw_columnas_bloque(const T* x, ptrdiff_t sx, ptrdiff_t rows,
+			  ptrdiff_t w, ptrdiff_t a,
+			  T* y, ptrdiff_t sy, T* h, Op op)
+{
+    ptrdiff_t L = rows + w - 1;
+
+    T neutro[n];
+    T acc[n];
+    for (ptrdiff_t u = 0; u < n; ++u)
+	neutro[u] = acc[u] = Op::neutro();
+
+    auto ext = [&](ptrdiff_t k) -> const T* {
+	k -= a;
+	return (0 <= k and k < rows)? x + k * sx: neutro;
+    };
+
+    // h: hacia atrás
+    for (ptrdiff_t k = L; k-- > 0; ){
+	const T* e = ext(k);
+
+	if (k == L - 1 or (k + 1) % w == 0)
+	    for (ptrdiff_t u = 0; u < n; ++u)
+		acc[u] = e[u];
+	else
+	    for (ptrdiff_t u = 0; u < n; ++u)
+		acc[u] = op(acc[u], e[u]);
+
+	T* hk = h + k * n;
+	for (ptrdiff_t u = 0; u < n; ++u)
+	    hk[u] = acc[u];
+    }
+
+    // g: hacia delante. Con g[k] ya tenemos la ventana que acaba en k.
+    T res[n];
+    for (ptrdiff_t k = 0; k < L; ++k){
+	const T* e = ext(k);
+
+	if (k % w == 0)
+	    for (ptrdiff_t u = 0; u < n; ++u)
+		acc[u] = e[u];
+	else
+	    for (ptrdiff_t u = 0; u < n; ++u)
+		acc[u] = op(acc[u], e[u]);
+
+	ptrdiff_t i = k - (w - 1);
+	if (i >= 0){
+	    const T* hi = h + i * n;
+	    for (ptrdiff_t u = 0; u < n; ++u)
+		res[u] = op(hi[u], acc[u]);
+
+	    T* yi = y + i * sy;
+	    for (ptrdiff_t u = 0; u < n; ++u)
+		yi[u] = res[u];
+	}
+    }
+}
+
+
+// Pasada por filas de x (rows x cols) a y con ventanas de tamaño w
+template <typename T, typename Op>
+void morphology_filas(const T* x, ptrdiff_t rows, ptrdiff_t cols,
+		      ptrdiff_t w, ptrdiff_t a, T* y,
+		      std::vector<T>& g, std::vector<T>& h, Op op)
+{
+    if (w == 1){
+	std::copy(x, x + rows * cols, y);
+	return;
+    }
+
+    g.resize(cols + w - 1);
+    h.resize(cols + w - 1);
+
+    for (ptrdiff_t i = 0; i < rows; ++i)
+	vhgw_fila(x + i * cols, cols, w, a, y + i * cols,
+		  g.data(), h.data(), op);
+}
+
+
+// Pasada por columnas de x (rows x cols) a y con ventanas de tamaño w
+template <typename T, typename Op>
+void morphology_columnas(const T* x, ptrdiff_t rows, ptrdiff_t cols,
+			 ptrdiff_t w, ptrdiff_t a, T* y,
+			 std::vector<T>& h, Op op)
+{
+    constexpr ptrdiff_t B = bloque_morphology;
+
+    if (w == 1){
+	std::copy(x, x + rows * cols, y);
+	return;
+    }
+
+    h.resize((rows + w - 1) * B);
+
+    ptrdiff_t j = 0;
+    for (; j + B <= cols; j += B)
+	vhgw_columnas_bloque<B>(x + j, cols, rows, w, a, y + j, cols,
+				h.data(), op);
+
+    // Las últimas columnas de una en una
+    for (; j < cols; ++j)
+	vhgw_columnas_bloque<1>(x + j, cols, rows, w, a, y + j, cols,
+				h.data(), op);
+}
+
+
+// Erosión (Minimo) o dilatación (Maximo, reflejado) de m in situ
+template <typename T, typename I, typename Op>
+void morphology(Matrix<T, I>& m, const Size_ij<I>& se, bool reflejado,
+		Morphology_buffer<T>& buf, Op op)
+{
+    ptrdiff_t rows = static_cast<ptrdiff_t>(m.rows());
+    ptrdiff_t cols = static_cast<ptrdiff_t>(m.cols());
+    ptrdiff_t hs   = static_cast<ptrdiff_t>(se.rows);
+    ptrdiff_t ws   = static_cast<ptrdiff_t>(se.cols);
+
+    if (hs <= 0 or ws <= 0)
+	throw std::invalid_argument{"morphology: elemento estructurante "
+				    "vacío"};
+
+    if (rows == 0 or cols == 0)
+	return;
+
+    T* p = &m(I{0}, I{0});
+    buf.tmp.resize(rows * cols);
+
+    morphology_filas(p, rows, cols, ws, centro(ws, reflejado),
+		     buf.tmp.data(), buf.g, buf.h, op);
+    morphology_columnas(buf.tmp.data(), rows, cols, hs, centro(hs, reflejado),
+			p, buf.h, op);
+}
+
+
+/***************************************************************************
+ *			    MÁSCARAS EMPAQUETADAS
+ ***************************************************************************/
+// Número de palabras de una fila de cols pixels
+inline ptrdiff_t num_words(ptrdiff_t cols) { return (cols + 63) / 64; }
+
+// Bits de la última palabra de la fila que no son pixels
+inline uint64_t bits_de_relleno(ptrdiff_t cols)
+{
+    int r = static_cast<int>(cols % 64);
+    return (r == 0)? uint64_t{0}: ~uint64_t{0} << r;
+}
+
+// y[j] = x[j + s] (el bit j de la fila es el bit j % 64 de la palabra
+// j / 64). Los bits de fuera de x valen fill.
+inline void desplaza(const uint64_t* x, ptrdiff_t nw, ptrdiff_t s,
+		     uint64_t fill, uint64_t* y)
+{
+    ptrdiff_t q = (s >= 0)? s / 64: -((-s + 63) / 64);
+    int r = static_cast<int>(s - q * 64);	// 0 <= r < 64
+
+    auto X = [&](ptrdiff_t t) { return (0 <= t and t < nw)? x[t]: fill; };
+
+    if (r == 0)
+	for (ptrdiff_t k = 0; k < nw; ++k)
+	    y[k] = X(k + q);
+
+    else
+	for (ptrdiff_t k = 0; k < nw; ++k)
+	    y[k] = (X(k + q) >> r) | (X(k + q + 1) << (64 - r));
+}
+
+
+// r[j] = op(x[j], x[j + d], ..., x[j + (len - 1) d]), con d = 1 ó -1.
+// Se calcula doblando la longitud de la ventana: los bits de fuera de la
+// fila son el neutro, así que no se pierde nada al desplazar.
+template <typename Op>
+void ventana_bits(const uint64_t* x, ptrdiff_t nw, ptrdiff_t len,
+		  ptrdiff_t d, uint64_t* r, uint64_t* t, Op op)
+{
+    constexpr uint64_t neutro = Op::neutro();
+
+    std::copy(x, x + nw, r);
+
+    ptrdiff_t n = 1;
+    for (; 2 * n <= len; n *= 2){
+	desplaza(r, nw, n * d, neutro, t);
+	for (ptrdiff_t k = 0; k < nw; ++k)
+	    r[k] = op(r[k], t[k]);
+    }
+
+    if (n < len){
+	desplaza(r, nw, (len - n) * d, neutro, t);
+	for (ptrdiff_t k = 0; k < nw; ++k)
+	    r[k] = op(r[k], t[k]);
+    }
+}
+
+
+// Pasada por filas in situ de la fila empaquetada x de cols pixels:
+// x[j] = op(x[j - a], ..., x[j - a + w - 1]).
+// La ventana se divide en [j, j + w - 1 - a] y [j - a, j].
+template <typename Op>
+void bits_fila(uint64_t* x, ptrdiff_t cols, ptrdiff_t w, ptrdiff_t a,
+	       uint64_t* r, uint64_t* u, uint64_t* t, Op op)
+{
+    ptrdiff_t nw = num_words(cols);
+
+    uint64_t relleno = bits_de_relleno(cols);
+    x[nw - 1] = (x[nw - 1] & ~relleno) | (Op::neutro() & relleno);
+
+    ventana_bits(x, nw, w - a, 1, r, t, op);
+    ventana_bits(x, nw, a + 1, -1, u, t, op);
+
+    for (ptrdiff_t k = 0; k < nw; ++k)
+	x[k] = op(r[k], u[k]);
+}
+
+
+template <typename T, typename I>
+void empaqueta(const Matrix<T, I>& m, std::vector<uint64_t>& bits)
+{
+    ptrdiff_t rows = static_cast<ptrdiff_t>(m.rows());
+    ptrdiff_t cols = static_cast<ptrdiff_t>(m.cols());
+    ptrdiff_t nw   = num_words(cols);
+
+    bits.assign(rows * nw, 0);
+
+    for (ptrdiff_t i = 0; i < rows; ++i){
+	const T* p = &m(static_cast<I>(i), I{0});
+	uint64_t* b = &bits[i * nw];
+
+	for (ptrdiff_t j = 0; j < cols; ++j)
+	    b[j / 64] |= static_cast<uint64_t>(p[j] != T{}) << (j % 64);
+    }
+}
+
+
+template <typename T, typename I>
+void desempaqueta(const std::vector<uint64_t>& bits, Matrix<T, I>& m)
+{
+    ptrdiff_t rows = static_cast<ptrdiff_t>(m.rows());
+    ptrdiff_t cols = static_cast<ptrdiff_t>(m.cols());
+    ptrdiff_t nw   = num_words(cols);
+
+    for (ptrdiff_t i = 0; i < rows; ++i){
+	T* p = &m(static_cast<I>(i), I{0});
+	const uint64_t* b = &bits[i * nw];
+
+	for (ptrdiff_t j = 0; j < cols; ++j)
+	    p[j] = ((b[j / 64] >> (j % 64)) & 1)? T{1}: T{};
+    }
+}
+
+
+// Erosión (Y_bits) o dilatación (O_bits, reflejado) in situ de la
+// máscara empaquetada bits de rows x cols pixels.
+template <typename T, typename Op>
+void bits_morphology(uint64_t* bits, ptrdiff_t rows, ptrdiff_t cols,
+		     ptrdiff_t hs, ptrdiff_t ws, bool reflejado,
+		     Morphology_buffer<T>& buf, Op op)
+{
+    ptrdiff_t nw = num_words(cols);
+
+    buf.r.resize(nw);
+    buf.u.resize(nw);
+    buf.t.resize(nw);
+
+    if (ws > 1)
+	for (ptrdiff_t i = 0; i < rows; ++i)
+	    bits_fila(bits + i * nw, cols, ws, centro(ws, reflejado),
+		      buf.r.data(), buf.u.data(), buf.t.data(), op);
+
+    if (hs > 1){
+	buf.bits2.resize(rows * nw);
+	morphology_columnas(bits, rows, nw, hs, centro(hs, reflejado),
+			    buf.bits2.data(), buf.hb, op);
+	std::copy(buf.bits2.begin(), buf.bits2.end(), bits);
+    }
+}
+
+
+// Aplica in situ a la máscara empaquetada bits una erosión (true) o una
+// dilatación (false) por cada elemento de erosion, en orden. Al acabar los
+// bits de relleno valen 0.
+template <typename T, size_t N>
+void bits_morphology(uint64_t* bits, ptrdiff_t rows, ptrdiff_t cols,
+		     ptrdiff_t hs, ptrdiff_t ws,
+		     const bool (&erosion)[N], Morphology_buffer<T>& buf)
+{
+    if (hs <= 0 or ws <= 0)
+	throw std::invalid_argument{"morphology: elemento estructurante "
+				    "vacío"};
+
+    if (rows == 0 or cols == 0)
+	return;
+
+    for (bool e: erosion){
+	if (e)
+	    bits_morphology(bits, rows, cols, hs, ws, false, buf, Y_bits{});
+	else
+	    bits_morphology(bits, rows, cols, hs, ws, true, buf, O_bits{});
+    }
+
+    ptrdiff_t nw = num_words(cols);
+    uint64_t relleno = bits_de_relleno(cols);
+    for (ptrdiff_t i = 0; i < rows; ++i)
+	bits[i * nw + nw - 1] &= ~relleno;
+}
+
+
+template <typename T, typename I, size_t N>
+void binary_morphology(Matrix<T, I>& m, const Size_ij<I>& se,
+		       const bool (&erosion)[N], Morphology_buffer<T>& buf)
+{
+    ptrdiff_t rows = static_cast<ptrdiff_t>(m.rows());
+    ptrdiff_t cols = static_cast<ptrdiff_t>(m.cols());
+
+    empaqueta(m, buf.bits);
+    bits_morphology(buf.bits.data(), rows, cols,
+		    static_cast<ptrdiff_t>(se.rows),
+		    static_cast<ptrdiff_t>(se.cols), erosion, buf);
+    desempaqueta(buf.bits, m);
+}
+
+
+template <typename I, size_t N>
+void binary_morphology(Bit_matrix<I>& m, const Size_ij<I>& se,
+		       const bool (&erosion)[N], Morphology_buffer<bool>& buf)
+{
+    bits_morphology(m.data(), static_cast<ptrdiff_t>(m.rows()),
+		    static_cast<ptrdiff_t>(m.cols()),
+		    static_cast<ptrdiff_t>(se.rows),
+		    static_cast<ptrdiff_t>(se.cols), erosion, buf);
+}
+
+}// namespace impl_of
+
+
+/***************************************************************************
+ *			    ESCALA DE GRISES
+ ***************************************************************************/
+/// Erosión in situ de m con el rectángulo se.
+template <typename T, typename I>
+inline void erode(Matrix<T, I>& m, const Size_ij<I>& se,
+		  Morphology_buffer<T>& buf)
+{ impl_of::morphology(m, se, false, buf, impl_of::Minimo<T>{}); }
+
+/// Dilatación in situ de m con el rectángulo se.
+template <typename T, typename I>
+inline void dilate(Matrix<T, I>& m, const Size_ij<I>& se,
+		   Morphology_buffer<T>& buf)
+{ impl_of::morphology(m, se, true, buf, impl_of::Maximo<T>{}); }
+
+/// Apertura in situ de m con el rectángulo se.
+template <typename T, typename I>
+inline void open(Matrix<T, I>& m, const Size_ij<I>& se,
+		 Morphology_buffer<T>& buf)
+{
+    erode(m, se, buf);
+    dilate(m, se, buf);
+}
+
+/// Cierre in situ de m con el rectángulo se.
+template <typename T, typename I>
+inline void close(Matrix<T, I>& m, const Size_ij<I>& se,
+		  Morphology_buffer<T>& buf)
+{
+    dilate(m, se, buf);
+    erode(m, se, buf);
+}
+
+
+template <typename T, typename I>
+Matrix<T, I> erode(const Matrix<T, I>& m, const Size_ij<I>& se)
+{
+    Matrix<T, I> res{m};
+    Morphology_buffer<T> buf;
+    erode(res, se, buf);
+    return res;
+}
+
+template <typename T, typename I>
+Matrix<T, I> dilate(const Matrix<T, I>& m, const Size_ij<I>& se)
+{
+    Matrix<T, I> res{m};
+    Morphology_buffer<T> buf;
+    dilate(res, se, buf);
+    return res;
+}
+
+template <typename T, typename I>
+Matrix<T, I> open(const Matrix<T, I>& m, const Size_ij<I>& se)
+{
+    Matrix<T, I> res{m};
+    Morphology_buffer<T> buf;
+    open(res, se, buf);
+    return res;
+}
+
+template <typename T, typename I>
+Matrix<T, I> close(const Matrix<T, I>& m, const Size_ij<I>& se)
+{
+    Matrix<T, I> res{m};
+    Morphology_buffer<T> buf;
+    close(res, se, buf);
+    return res;
+}
+
+
+/***************************************************************************
+ *				MÁSCARAS
+ ***************************************************************************/
+/// Erosión in situ de la máscara m (pixels != T{}) con el rectángulo se.
+template <typename T, typename I>
+inline void binary_erode(Matrix<T, I>& m, const Size_ij<I>& se,
+			 Morphology_buffer<T>& buf)
+{ impl_of::binary_morphology(m, se, {true}, buf); }
+
+/// Dilatación in situ de la máscara m con el rectángulo se.
+template <typename T, typename I>
+inline void binary_dilate(Matrix<T, I>& m, const Size_ij<I>& se,
+			  Morphology_buffer<T>& buf)
+{ impl_of::binary_morphology(m, se, {false}, buf); }
+
+/// Apertura in situ de la máscara m con el rectángulo se.
+template <typename T, typename I>
+inline void binary_open(Matrix<T, I>& m, const Size_ij<I>& se,
+			Morphology_buffer<T>& buf)
+{ impl_of::binary_morphology(m, se, {true, false}, buf); }
+
+/// Cierre in situ de la máscara m con el rectángulo se.
+template <typename T, typename I>
+inline void binary_close(Matrix<T, I>& m, const Size_ij<I>& se,
+			 Morphology_buffer<T>& buf)
+{ impl_of::binary_morphology(m, se, {false, true}, buf); }
+
+
+template <typename T, typename I>
+Matrix<T, I> binary_erode(const Matrix<T, I>& m, const Size_ij<I>& se)
+{
+    Matrix<T, I> res{m};
+    Morphology_buffer<T> buf;
+    binary_erode(res, se, buf);
+    return res;
+}
+
+template <typename T, typename I>
+Matrix<T, I> binary_dilate(const Matrix<T, I>& m, const Size_ij<I>& se)
+{
+    Matrix<T, I> res{m};
+    Morphology_buffer<T> buf;
+    binary_dilate(res, se, buf);
+    return res;
+}
+
+template <typename T, typename I>
+Matrix<T, I> binary_open(const Matrix<T, I>& m, const Size_ij<I>& se)
+{
+    Matrix<T, I> res{m};
+    Morphology_buffer<T> buf;
+    binary_open(res, se, buf);
+    return res;
+}
+
+template <typename T, typename I>
+Matrix<T, I> binary_close(const Matrix<T, I>& m, const Size_ij<I>& se)
+{
+    Matrix<T, I> res{m};
+    Morphology_buffer<T> buf;
+    binary_close(res, se, buf);
+    return res;
+}
+
+
+
+// Bit_matrix
+// ----------
+/// Erosión in situ de la máscara m con el rectángulo se.
+template <typename I>
+inline void binary_erode(Bit_matrix<I>& m, const Size_ij<I>& se,
+			 Morphology_buffer<bool>& buf)
+{ impl_of::binary_morphology(m, se, {true}, buf); }
+
+/// Dilatación in situ de la máscara m con el rectángulo se.
+template <typename I>
+inline void binary_dilate(Bit_matrix<I>& m, const Size_ij<I>& se,
+			  Morphology_buffer<bool>& buf)
+{ impl_of::binary_morphology(m, se, {false}, buf); }
+
+/// Apertura in situ de la máscara m con el rectángulo se.
+template <typename I>
+inline void binary_open(Bit_matrix<I>& m, const Size_ij<I>& se,
+			Morphology_buffer<bool>& buf)
+{ impl_of::binary_morphology(m, se, {true, false}, buf); }
+
+/// Cierre in situ de la máscara m con el rectángulo se.
+template <typename I>
+inline void binary_close(Bit_matrix<I>& m, const Size_ij<I>& se,
+			 Morphology_buffer<bool>& buf)
+{ impl_of::binary_morphology(m, se, {false, true}, buf); }
+
+
+template <typename I>
+Bit_matrix<I> binary_erode(const Bit_matrix<I>& m, const Size_ij<I>& se)
+{
+    Bit_matrix<I> res{m};
+    Morphology_buffer<bool> buf;
+    binary_erode(res, se, buf);
+    return res;
+}
+
+template <typename I>
+Bit_matrix<I> binary_dilate(const Bit_matrix<I>& m, const Size_ij<I>& se)
+{
+    Bit_matrix<I> res{m};
+    Morphology_buffer<bool> buf;
+    binary_dilate(res, se, buf);
+    return res;
+}
+
+template <typename I>
+Bit_matrix<I> binary_open(const Bit_matrix<I>& m, const Size_ij<I>& se)
+{
+    Bit_matrix<I> res{m};
+    Morphology_buffer<bool> buf;
+    binary_open(res, se, buf);
+    return res;
+}
+
+template <typename I>
+Bit_matrix<I> binary_close(const Bit_matrix<I>& m, const Size_ij<I>& se)
+{
+    Bit_matrix<I> res{m};
+    Morphology_buffer<bool> buf;
+    binary_close(res, se, buf);
+    return res;
+}
+
+}// namespace
+
+#endif
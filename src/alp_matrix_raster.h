@@ -0,0 +1,579 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_MATRIX_RASTER_H__
+#define __ALP_MATRIX_RASTER_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Dibujo de segmentos, rectángulos, polígonos y círculos
+ *	en matrices.
+ *
+ *  - COMENTARIOS: Todo se hace con enteros (no hay ni un double).
+ *
+ *	Hay dos niveles:
+ *	1.- raster_xxx(figura, clip, f): calculan los pixels de la figura
+ *	    que están dentro del rango clip y llaman a f(i, j0, je) por cada
+ *	    tramo horizontal [j0, je) de la fila i. Los tramos de una misma
+ *	    figura no se solapan. Con ellos se pueden hacer rellenos de
+ *	    bloques (memset, mezclas...) en lugar de pintar pixel a pixel.
+ *
+ *	2.- draw_xxx/fill_xxx(m, figura, valor): pintan la figura en la
+ *	    matriz m (Matrix, Matrix_view o Submatrix, recortando con
+ *	    su extensión) o en un Matrix_xy_base (en ese caso la figura se da
+ *	    en coordenadas (x, y)).
+ *
+ *	Igual que en Range_ij, en los rellenos de polígonos no se pintan los
+ *	pixels del borde derecho e inferior: así dos polígonos que comparten
+ *	un lado no se solapan, y el polígono de vértices (0,0), (0,4), (4,4),
+ *	(4,0) es el rango [0,4) x [0,4).
+ *
+ *	Las coordenadas de las figuras tienen que ser enteros con signo
+ *	(pueden estar fuera de la matriz).
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    19/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "alp_rframe_ij.h"
+#include "alp_rframe_xy.h"
+#include "alp_matrix_view.h"
+
+namespace alp{
+
+namespace impl_of{
+// División entera redondeando hacia -infinito / +infinito (d > 0)
+inline int64_t div_floor(int64_t n, int64_t d)
+{
+    int64_t q = n / d;
+    return (n % d != 0 and n < 0)? q - 1: q;
+}
+
+inline int64_t div_ceil(int64_t n, int64_t d)
+{ return -div_floor(-n, d); }
+
+
+// Llama a f con el tramo [j0, je) de la fila i recortado a clip
+template <typename Int, typename F>
+inline void tramo(const Range_ij<Int>& clip, Int i, Int j0, Int je, F& f)
+{
+    if (i < clip.i0 or i >= clip.ie)
+	return;
+
+    j0 = std::max(j0, clip.j0);
+    je = std::min(je, clip.je);
+
+    if (j0 < je)
+	f(i, j0, je);
+}
+
+}// namespace impl_of
+
+
+/***************************************************************************
+ *			    RASTERIZADORES (tramos)
+ ***************************************************************************/
+/// Tramos del segmento [A, B] (incluidos los dos extremos), dentro de clip.
+/// Son los mismos pixels que calcula el algoritmo de Bresenham. Los pixels
+/// fuera de clip no se recorren: el coste es proporcional a la parte
+/// visible del segmento.
+template <std::signed_integral Int, typename F>
+void raster_segment(const Segment_ij<Int>& s, const Range_ij<Int>& clip, F f)
+{
+    // Parametrizamos el segmento por el eje en el que avanza más (eje a):
+    //	    a(t) = a0 + sa·t,	b(t) = b0 + sb·floor((2·t·m + n)/(2n))
+    // con t = 0, 1, ..., n.
+    int64_t di = int64_t{s.B.i} - s.A.i;
+    int64_t dj = int64_t{s.B.j} - s.A.j;
+
+    bool horizontal = (std::abs(dj) >= std::abs(di)); // eje a = j
+    int64_t a0 = horizontal? s.A.j: s.A.i;
+    int64_t b0 = horizontal? s.A.i: s.A.j;
+    int64_t da = horizontal? dj: di;
+    int64_t db = horizontal? di: dj;
+
+    int64_t sa = (da < 0)? -1: 1;
+    int64_t sb = (db < 0)? -1: 1;
+    int64_t n  = std::abs(da);
+    int64_t m  = std::abs(db);
+
+    int64_t ca0 = horizontal? clip.j0: clip.i0; // clip en el eje a: [ca0, cae)
+    int64_t cae = horizontal? clip.je: clip.ie;
+    int64_t cb0 = horizontal? clip.i0: clip.j0;
+    int64_t cbe = horizontal? clip.ie: clip.je;
+
+    if (ca0 >= cae or cb0 >= cbe)
+	return;
+
+    // Valores de t para los que a(t) está dentro de clip
+    int64_t t0 = 0, te = n;	// [t0, te]
+    if (sa > 0){
+	t0 = std::max(t0, ca0 - a0);
+	te = std::min(te, cae - 1 - a0);
+    }
+    else{
+	t0 = std::max(t0, a0 - (cae - 1));
+	te = std::min(te, a0 - ca0);
+    }
+
+    // Valores del desplazamiento o = floor((2tm + n)/(2n)) en el eje b
+    int64_t o0 = (sb > 0)? cb0 - b0: b0 - (cbe - 1);
+    int64_t oe = (sb > 0)? cbe - 1 - b0: b0 - cb0;
+
+    if (m == 0){
+	if (o0 > 0 or oe < 0)
+	    return;
+    }
+    else{
+	// o(t) >= o0 <=> t >= ceil((2n·o0 - n)/(2m))
+	// o(t) <= oe <=> t <= floor((2n·(oe + 1) - n - 1)/(2m))
+	t0 = std::max(t0, impl_of::div_ceil(2*n*o0 - n, 2*m));
+	te = std::min(te, impl_of::div_floor(2*n*(oe + 1) - n - 1, 2*m));
+    }
+
+    if (t0 > te)
+	return;
+
+    // Recorremos [t0, te] con el error de Bresenham: e = (2tm + n) mod 2n
+    int64_t dos_n = std::max<int64_t>(2*n, 1);
+    int64_t o = (2*t0*m + n) / dos_n;
+    int64_t e = (2*t0*m + n) % dos_n;
+
+    if (horizontal){ // agrupamos los pixels de la misma fila en un tramo
+	int64_t t = t0;
+	while (t <= te){
+	    int64_t t1 = t;	// último t con el mismo o
+	    // e + 2m·k < 2n  =>  k < (2n - e)/(2m)
+	    if (m == 0)
+		t1 = te;
+	    else
+		t1 = std::min(te, t + (dos_n - e - 1) / (2*m));
+
+	    int64_t j_a = a0 + sa*t;
+	    int64_t j_b = a0 + sa*t1;
+	    Int i = static_cast<Int>(b0 + sb*o);
+	    f(i, static_cast<Int>(std::min(j_a, j_b)),
+		 static_cast<Int>(std::max(j_a, j_b) + 1));
+
+	    e += 2*m*(t1 - t + 1);
+	    o += e / dos_n;
+	    e %= dos_n;
+	    t = t1 + 1;
+	}
+    }
+    else{
+	for (int64_t t = t0; t <= te; ++t){
+	    Int i = static_cast<Int>(a0 + sa*t);
+	    Int j = static_cast<Int>(b0 + sb*o);
+	    f(i, j, static_cast<Int>(j + 1));
+
+	    e += 2*m;
+	    if (e >= dos_n){
+		e -= dos_n;
+		++o;
+	    }
+	}
+    }
+}
+
+
+/// Tramos del rectángulo r relleno, dentro de clip.
+template <std::signed_integral Int, typename F>
+void raster_rectangle(const Range_ij<Int>& r, const Range_ij<Int>& clip, F f)
+{
+    Int i0 = std::max(r.i0, clip.i0);
+    Int ie = std::min(r.ie, clip.ie);
+
+    for (Int i = i0; i < ie; ++i)
+	impl_of::tramo(clip, i, r.j0, r.je, f);
+}
+
+
+/// Tramos del borde (de 1 pixel de grosor) del rectángulo r, dentro de
+/// clip.
+template <std::signed_integral Int, typename F>
+void raster_rectangle_border(const Range_ij<Int>& r, const Range_ij<Int>& clip,
+			     F f)
+{
+    if (r.empty())
+	return;
+
+    impl_of::tramo(clip, r.i0, r.j0, r.je, f);
+
+    if (r.rows() > 1)
+	impl_of::tramo(clip, static_cast<Int>(r.ie - 1), r.j0, r.je, f);
+
+    Int i0 = std::max(static_cast<Int>(r.i0 + 1), clip.i0);
+    Int ie = std::min(static_cast<Int>(r.ie - 1), clip.ie);
+
+    for (Int i = i0; i < ie; ++i){
+	impl_of::tramo(clip, i, r.j0, static_cast<Int>(r.j0 + 1), f);
+
+	if (r.cols() > 1)
+	    impl_of::tramo(clip, i, static_cast<Int>(r.je - 1), r.je, f);
+    }
+}
+
+
+/// Tramos del polígono de vértices p relleno (regla par-impar), dentro de
+/// clip. Se pintan los pixels (i, j) con x_k <= j < x_{k+1}, siendo x_k los
+/// cortes de la fila i con los lados (ordenados).
+template <std::signed_integral Int, typename F>
+void raster_polygon(const std::vector<Vector_ij<Int>>& p,
+		    const Range_ij<Int>& clip, F f)
+{
+    if (p.size() < 3)
+	return;
+
+    // Lados no horizontales, orientados hacia abajo: [i0, ie)
+    struct Lado{
+	int64_t i0, ie;	    // filas que corta
+	int64_t j0;	    // j en la fila i0
+	int64_t dj, di;	    // pendiente
+    };
+
+    std::vector<Lado> lado;
+    lado.reserve(p.size());
+
+    for (size_t k = 0; k < p.size(); ++k){
+	auto a = p[k];
+	auto b = p[(k + 1) % p.size()];
+
+	if (a.i == b.i)
+	    continue;
+
+	if (b.i < a.i)
+	    std::swap(a, b);
+
+	lado.push_back(Lado{a.i, b.i, a.j, int64_t{b.j} - a.j,
+						    int64_t{b.i} - a.i});
+    }
+
+    if (lado.empty())
+	return;
+
+    std::sort(lado.begin(), lado.end(),
+		    [](const Lado& x, const Lado& y) { return x.i0 < y.i0; });
+
+    int64_t i_min = lado.front().i0;
+    int64_t i_max = i_min;
+    for (auto& l: lado)
+	i_max = std::max(i_max, l.ie);
+
+    int64_t i0 = std::max<int64_t>(i_min, clip.i0);
+    int64_t ie = std::min<int64_t>(i_max, clip.ie);
+
+    std::vector<const Lado*> activo;	// lados que cortan la fila i
+    std::vector<int64_t> x;
+    size_t sig = 0;	// siguiente lado que todavía no está activo
+
+    for (int64_t i = i0; i < ie; ++i){
+	while (sig < lado.size() and lado[sig].i0 <= i){
+	    activo.push_back(&lado[sig]);
+	    ++sig;
+	}
+
+	std::erase_if(activo, [i](const Lado* l) { return l->ie <= i; });
+
+	// El corte en la fila i es j0 + (i - i0)·dj/di. Como se pinta
+	// j >= corte, nos basta con ceil.
+	x.clear();
+	for (const Lado* l: activo)
+	    x.push_back(l->j0 + impl_of::div_ceil((i - l->i0) * l->dj, l->di));
+
+	std::sort(x.begin(), x.end());
+
+	for (size_t k = 0; k + 1 < x.size(); k += 2)
+	    impl_of::tramo(clip, static_cast<Int>(i), static_cast<Int>(x[k]),
+			   static_cast<Int>(x[k + 1]), f);
+    }
+}
+
+
+namespace impl_of{
+// Semiancho de las filas del círculo de centro 0 y radio r: la fila di
+// tiene los pixels |dj| <= w[|di|], con di² + dj² <= r² + r.
+// (r² + r en lugar de r² para que el contorno no tenga picos en los ejes)
+inline std::vector<int64_t> semiancho_circulo(int64_t r)
+{
+    std::vector<int64_t> w(r + 1);
+
+    int64_t r2 = r * r + r;
+    int64_t x  = r;
+    for (int64_t di = 0; di <= r; ++di){
+	while (x * x > r2 - di * di)
+	    --x;
+
+	w[di] = x;
+    }
+
+    return w;
+}
+}// namespace impl_of
+
+
+/// Tramos del círculo relleno de centro c y radio r, dentro de clip.
+template <std::signed_integral Int, typename F>
+void raster_circle(const Vector_ij<Int>& c, Int r, const Range_ij<Int>& clip,
+		   F f)
+{
+    if (r < 0)
+	return;
+
+    int64_t i0 = std::max<int64_t>(int64_t{c.i} - r, clip.i0);
+    int64_t ie = std::min<int64_t>(int64_t{c.i} + r + 1, clip.ie);
+    if (i0 >= ie)
+	return;
+
+    auto w = impl_of::semiancho_circulo(r);
+
+    for (int64_t i = i0; i < ie; ++i){
+	int64_t x = w[std::abs(i - c.i)];
+	impl_of::tramo(clip, static_cast<Int>(i), static_cast<Int>(c.j - x),
+			     static_cast<Int>(c.j + x + 1), f);
+    }
+}
+
+
+/// Tramos de la circunferencia (de 1 pixel de grosor) de centro c y radio
+/// r, dentro de clip. Son los pixels del círculo raster_circle(c, r) que
+/// tienen algún vecino (arriba, abajo, izquierda o derecha) fuera del
+/// círculo.
+template <std::signed_integral Int, typename F>
+void raster_circumference(const Vector_ij<Int>& c, Int r,
+			  const Range_ij<Int>& clip, F f)
+{
+    if (r < 0)
+	return;
+
+    int64_t i0 = std::max<int64_t>(int64_t{c.i} - r, clip.i0);
+    int64_t ie = std::min<int64_t>(int64_t{c.i} + r + 1, clip.ie);
+    if (i0 >= ie)
+	return;
+
+    auto w = impl_of::semiancho_circulo(r);
+    auto semiancho = [&](int64_t di) -> int64_t {
+	di = std::abs(di);
+	return (di <= r)? w[di]: -1;
+    };
+
+    for (int64_t i = i0; i < ie; ++i){
+	int64_t di = i - c.i;
+	int64_t x  = semiancho(di);
+
+	// Los pixels |dj| <= m tienen todos sus vecinos dentro
+	int64_t m = std::min({x - 1, semiancho(di - 1), semiancho(di + 1)});
+
+	if (m < 0)
+	    impl_of::tramo(clip, static_cast<Int>(i), static_cast<Int>(c.j - x),
+				 static_cast<Int>(c.j + x + 1), f);
+	else{
+	    impl_of::tramo(clip, static_cast<Int>(i), static_cast<Int>(c.j - x),
+				 static_cast<Int>(c.j - m), f);
+	    impl_of::tramo(clip, static_cast<Int>(i), static_cast<Int>(c.j + m + 1),
+				 static_cast<Int>(c.j + x + 1), f);
+	}
+    }
+}
+
+
+
+/***************************************************************************
+ *			    DIBUJO EN MATRICES
+ ***************************************************************************/
+namespace impl_of{
+// Contenedores bidimensionales en coordenadas (i, j): Matrix, Matrix_view,
+// Submatrix. (Matrix_xy_base no tiene extension).
+template <typename M>
+concept Matriz_ij = requires (M& m) {
+    m.rows();
+    m.cols();
+    m.extension();
+    m(0, 0);
+};
+
+template <std::signed_integral Int, typename M>
+inline Range_ij<Int> clip_de(const M& m)
+{ return Range_ij<Int>{0, static_cast<Int>(m.rows()),
+		       0, static_cast<Int>(m.cols())}; }
+
+// Pinta el tramo [j0, je) de la fila i de m con el valor v.
+template <typename M, typename T>
+struct Pinta_tramo{
+    M& m;
+    const T& v;
+
+    template <typename Int>
+    void operator()(Int i, Int j0, Int je)
+    {
+	using Ind = typename M::Ind;
+
+	// Las filas de Matrix, Matrix_view y Submatrix son contiguas
+	auto p = &m(static_cast<Ind>(i), static_cast<Ind>(j0));
+	std::fill(p, p + (je - j0), v);
+    }
+};
+
+template <typename M, typename T>
+Pinta_tramo(M&, const T&) -> Pinta_tramo<M, T>;
+
+}// namespace impl_of
+
+
+/// Dibuja el segmento s en m.
+template <impl_of::Matriz_ij M, std::signed_integral Int, typename T>
+inline void draw_segment(M& m, const Segment_ij<Int>& s, const T& v)
+{ raster_segment(s, impl_of::clip_de<Int>(m), impl_of::Pinta_tramo{m, v}); }
+
+/// Dibuja el borde del rectángulo r en m.
+template <impl_of::Matriz_ij M, std::signed_integral Int, typename T>
+inline void draw_rectangle(M& m, const Range_ij<Int>& r, const T& v)
+{ raster_rectangle_border(r, impl_of::clip_de<Int>(m),
+					    impl_of::Pinta_tramo{m, v}); }
+
+/// Rellena el rectángulo r de m.
+template <impl_of::Matriz_ij M, std::signed_integral Int, typename T>
+inline void fill_rectangle(M& m, const Range_ij<Int>& r, const T& v)
+{ raster_rectangle(r, impl_of::clip_de<Int>(m), impl_of::Pinta_tramo{m, v}); }
+
+/// Dibuja los lados del polígono de vértices p en m.
+template <impl_of::Matriz_ij M, std::signed_integral Int, typename T>
+void draw_polygon(M& m, const std::vector<Vector_ij<Int>>& p, const T& v)
+{
+    for (size_t k = 0; k < p.size(); ++k)
+	draw_segment(m, Segment_ij<Int>{p[k], p[(k + 1) % p.size()]}, v);
+}
+
+/// Rellena el polígono de vértices p de m.
+template <impl_of::Matriz_ij M, std::signed_integral Int, typename T>
+inline void fill_polygon(M& m, const std::vector<Vector_ij<Int>>& p,
+			 const T& v)
+{ raster_polygon(p, impl_of::clip_de<Int>(m), impl_of::Pinta_tramo{m, v}); }
+
+/// Dibuja la circunferencia de centro c y radio r en m.
+template <impl_of::Matriz_ij M, std::signed_integral Int, typename T>
+inline void draw_circle(M& m, const Vector_ij<Int>& c, Int r, const T& v)
+{ raster_circumference(c, r, impl_of::clip_de<Int>(m),
+					    impl_of::Pinta_tramo{m, v}); }
+
+/// Rellena el círculo de centro c y radio r de m.
+template <impl_of::Matriz_ij M, std::signed_integral Int, typename T>
+inline void fill_circle(M& m, const Vector_ij<Int>& c, Int r, const T& v)
+{ raster_circle(c, r, impl_of::clip_de<Int>(m), impl_of::Pinta_tramo{m, v}); }
+
+
+
+// Matrix_xy
+// ---------
+// Las figuras se dan en coordenadas (x, y): las pasamos a (i, j) y las
+// dibujamos en la matriz.
+namespace impl_of{
+template <std::signed_integral Int, typename M, int xs, int ys>
+inline Vector_ij<Int> a_ij(const Matrix_xy_base<M, xs, ys>& m,
+			   const Vector_xy<Int>& p)
+{
+    using Ind = typename Matrix_xy_base<M, xs, ys>::Ind;
+    return Vector_ij<Int>{static_cast<Int>(m.i(static_cast<Ind>(p.y))),
+			  static_cast<Int>(m.j(static_cast<Ind>(p.x)))};
+}
+
+template <std::signed_integral Int, typename M, int xs, int ys>
+inline Range_ij<Int> a_ij(const Matrix_xy_base<M, xs, ys>& m,
+			  const Rectangle_xy<Int>& r)
+{
+    if (r.empty())
+	return Range_ij<Int>{};
+
+    // Según el sentido de los ejes las esquinas pueden quedar cambiadas
+    Vector_ij<Int> p = a_ij(m, r.bottom_left_corner());
+    Vector_ij<Int> q = a_ij(m, r.upper_right_corner());
+
+    return Range_ij<Int>{std::min(p.i, q.i), static_cast<Int>(std::max(p.i, q.i) + 1),
+			 std::min(p.j, q.j), static_cast<Int>(std::max(p.j, q.j) + 1)};
+}
+
+template <std::signed_integral Int, typename M, int xs, int ys>
+std::vector<Vector_ij<Int>> a_ij(const Matrix_xy_base<M, xs, ys>& m,
+				 const std::vector<Vector_xy<Int>>& p)
+{
+    std::vector<Vector_ij<Int>> res;
+    res.reserve(p.size());
+    for (auto& x: p)
+	res.push_back(a_ij(m, x));
+
+    return res;
+}
+}// namespace impl_of
+
+
+/// Dibuja el segmento [A, B] en m.
+template <typename M, int xs, int ys, std::signed_integral Int, typename T>
+inline void draw_segment(Matrix_xy_base<M, xs, ys>& m, const Vector_xy<Int>& A,
+			 const Vector_xy<Int>& B, const T& v)
+{
+    draw_segment(m.matrix(), Segment_ij<Int>{impl_of::a_ij(m, A),
+					     impl_of::a_ij(m, B)}, v);
+}
+
+/// Dibuja el borde del rectángulo r en m.
+template <typename M, int xs, int ys, std::signed_integral Int, typename T>
+inline void draw_rectangle(Matrix_xy_base<M, xs, ys>& m,
+			   const Rectangle_xy<Int>& r, const T& v)
+{ draw_rectangle(m.matrix(), impl_of::a_ij(m, r), v); }
+
+/// Rellena el rectángulo r de m.
+template <typename M, int xs, int ys, std::signed_integral Int, typename T>
+inline void fill_rectangle(Matrix_xy_base<M, xs, ys>& m,
+			   const Rectangle_xy<Int>& r, const T& v)
+{ fill_rectangle(m.matrix(), impl_of::a_ij(m, r), v); }
+
+/// Dibuja los lados del polígono de vértices p en m.
+template <typename M, int xs, int ys, std::signed_integral Int, typename T>
+inline void draw_polygon(Matrix_xy_base<M, xs, ys>& m,
+			 const std::vector<Vector_xy<Int>>& p, const T& v)
+{ draw_polygon(m.matrix(), impl_of::a_ij(m, p), v); }
+
+/// Rellena el polígono de vértices p de m.
+template <typename M, int xs, int ys, std::signed_integral Int, typename T>
+inline void fill_polygon(Matrix_xy_base<M, xs, ys>& m,
+			 const std::vector<Vector_xy<Int>>& p, const T& v)
+{ fill_polygon(m.matrix(), impl_of::a_ij(m, p), v); }
+
+/// Dibuja la circunferencia de centro c y radio r en m.
+template <typename M, int xs, int ys, std::signed_integral Int, typename T>
+inline void draw_circle(Matrix_xy_base<M, xs, ys>& m, const Vector_xy<Int>& c,
+			Int r, const T& v)
+{ draw_circle(m.matrix(), impl_of::a_ij(m, c), r, v); }
+
+/// Rellena el círculo de centro c y radio r de m.
+template <typename M, int xs, int ys, std::signed_integral Int, typename T>
+inline void fill_circle(Matrix_xy_base<M, xs, ys>& m, const Vector_xy<Int>& c,
+			Int r, const T& v)
+{ fill_circle(m.matrix(), impl_of::a_ij(m, c), r, v); }
+
+
+}// namespace
+
+#endif
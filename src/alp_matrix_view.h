@@ -26,6 +26,7 @@
  *    Manuel Perez
  *       23/03/2019 Escrito
  *       28/11/2020 Migro Matrix_xy de Imagen_xy y añado sentido de ejes.
+ *       19/10/2026 Recorrido de Matrix_xy por filas.
  *
  ****************************************************************************/
 
@@ -432,6 +433,39 @@ public:
     }
 
 
+// Recorrido por filas
+// -------------------
+// Cuando se recorren muchos pixeles es muy costoso llamar a operator()(x,y)
+// para cada uno de ellos: cada acceso cambia de coordenadas. Las siguientes
+// funciones calculan la dirección del primer pixel de la fila y avanzan
+// sobre ella (x crece en +1 o en -1 según x_sign).
+
+    /// Llama a f(x, pixel) para los puntos (x, y) con x en [x0, xe).
+    /// Precondición: los puntos tienen que estar dentro de la matriz.
+    template <typename F>
+    void for_each_in_row(Ind y, Ind x0, Ind xe, F f);
+
+    template <typename F>
+    void for_each_in_row(Ind y, Ind x0, Ind xe, F f) const;
+
+    /// Llama a f(x, pixel) para todos los puntos de la fila y.
+    template <typename F>
+    void for_each_in_row(Ind y, F f)
+    { for_each_in_row(y, x_min(), x_max() + 1, f); }
+
+    template <typename F>
+    void for_each_in_row(Ind y, F f) const
+    { for_each_in_row(y, x_min(), x_max() + 1, f); }
+
+    /// Llama a f(x, y, pixel) para todos los pixeles de la matriz. Se recorre
+    /// la matriz en el orden en el que está almacenada.
+    template <typename F>
+    void for_each(F f);
+
+    template <typename F>
+    void for_each(F f) const;
+
+
     /// Acceso a la matriz 
     Matrix_type& matrix() {return *img_;}
 
@@ -444,9 +478,89 @@ private:
     // Coordenadas de matriz (i, j) del origen del sistema de referencia.
     Ind i0_, j0_;
 
+// Helpers
+    // Si la view es const no se puede modificar la matriz.
+    static Matrix_type& matrix_de(Matrix_xy_base& m) {return *m.img_;}
+    static const Matrix_type& matrix_de(const Matrix_xy_base& m)
+    {return *m.img_;}
+
+    template <typename M, typename F>
+    static void recorre_fila(M& m, Ind y, Ind x0, Ind xe, F& f);
+
+    template <typename M, typename F>
+    static void recorre(M& m, F& f);
 };
 
 
+template <typename It, int xs, int ys>
+template <typename M, typename F>
+void Matrix_xy_base<It,xs,ys>::recorre_fila(M& m, Ind y, Ind x0, Ind xe,
+								    F& f)
+{
+    if (xe <= x0)
+	return;
+
+    auto p = &matrix_de(m)(m.i(y), m.j(x0));
+    for (Ind x = x0; x != xe; ++x){
+	f(x, *p);
+
+	if constexpr (xs > 0) ++p;
+	else		      --p;
+    }
+}
+
+
+template <typename It, int xs, int ys>
+template <typename M, typename F>
+void Matrix_xy_base<It,xs,ys>::recorre(M& m, F& f)
+{
+    Ind rows = m.rows();
+    Ind cols = m.cols();
+
+    if (rows == 0 or cols == 0)
+	return;
+
+    // Recorremos la matriz en orden (i, j) creciente: y, x avanzan en el
+    // sentido que indican los ejes.
+    constexpr Ind dx = (xs > 0? 1: -1);
+    constexpr Ind dy = (ys > 0? -1: 1);
+
+    auto p = &matrix_de(m)(0, 0);
+    Ind y = m.y(0);
+    for (Ind i = 0; i < rows; ++i, y += dy){
+	Ind x = m.x(0);
+	for (Ind j = 0; j < cols; ++j, x += dx, ++p)
+	    f(x, y, *p);
+    }
+}
+
+
+template <typename It, int xs, int ys>
+template <typename F>
+inline void Matrix_xy_base<It,xs,ys>::for_each_in_row(Ind y, Ind x0, Ind xe,
+									F f)
+{ recorre_fila(*this, y, x0, xe, f); }
+
+
+template <typename It, int xs, int ys>
+template <typename F>
+inline void Matrix_xy_base<It,xs,ys>::for_each_in_row(Ind y, Ind x0, Ind xe,
+								F f) const
+{ recorre_fila(*this, y, x0, xe, f); }
+
+
+template <typename It, int xs, int ys>
+template <typename F>
+inline void Matrix_xy_base<It,xs,ys>::for_each(F f)
+{ recorre(*this, f); }
+
+
+template <typename It, int xs, int ys>
+template <typename F>
+inline void Matrix_xy_base<It,xs,ys>::for_each(F f) const
+{ recorre(*this, f); }
+
+
 // Fijamos el origen de coordenadas. Después de la llamada de esta
 // función cualquier acceso usará este nuevo origen.
 template <typename It, int xs, int ys>
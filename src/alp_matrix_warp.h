@@ -0,0 +1,755 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_MATRIX_WARP_H__
+#define __ALP_MATRIX_WARP_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Transformaciones geométricas de matrices (imágenes):
+ *	afines (giros, escalados, traslaciones...) y proyectivas
+ *	(homografías).
+ *
+ *  - COMENTARIOS:
+ *	Las transformaciones se definen en coordenadas (x, y) de pixel: el
+ *	pixel (i, j) de la matriz es el punto x = j, y = i. El eje y va
+ *	hacia abajo, por lo que Affine_xy::rotation(alpha) gira en el sentido
+ *	de las agujas del reloj. En cambio rotate(m, alpha) gira la imagen en
+ *	sentido contrario a las agujas del reloj (como rotate_plus90).
+ *
+ *	warp(src, dst, t) calcula dst(i, j) = src(t^{-1}(j, i)): para cada
+ *	pixel de dst busca el punto de src del que viene y lo muestrea
+ *	(nearest o bilinear). Si ese punto está fuera de src se aplica la
+ *	política de borde (Border).
+ *
+ *	No se multiplica la matriz de la transformación por cada pixel: para
+ *	cada fila se calcula el punto del primer pixel y el incremento al
+ *	avanzar una columna; las coordenadas se calculan por bloques de tamaño
+ *	fijo para que el compilador pueda vectorizar.
+ *
+ *	Para matrices de uint8_t la interpolación bilineal se hace en punto
+ *	fijo (pesos de 8 bits) sin usar double.
+ *
+ *	Cada fila de dst se calcula de forma independiente. 
+ *	warp(src, dst, t, p, num_threads) reparte bandas de filas entre
+ *	varios threads; cada uno llama a warp_rows con su banda.
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    19/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "alp_math.h"	// Radian
+#include "alp_rframe_xy.h"
+#include "alp_matrix.h"
+
+namespace alp{
+
+/***************************************************************************
+ *			    TRANSFORMACIONES
+ ***************************************************************************/
+/*!
+ *  \brief  Transformación afín del plano.
+ *
+ *	(x, y) --> (a x + b y + c, d x + e y + f)
+ *
+ */
+template <std::floating_point Real = double>
+struct Affine_xy{
+// Data
+    Real a = 1, b = 0, c = 0;
+    Real d = 0, e = 1, f = 0;
+
+// Constructors
+    /// Identidad.
+    constexpr Affine_xy() = default;
+
+    constexpr Affine_xy(Real a0, Real b0, Real c0, Real d0, Real e0, Real f0)
+	: a{a0}, b{b0}, c{c0}, d{d0}, e{e0}, f{f0} { }
+
+    /// Traslación de vector v.
+    static Affine_xy translation(const Vector_xy<Real>& v)
+    { return Affine_xy{1, 0, v.x, 0, 1, v.y}; }
+
+    /// Escalado respecto del origen.
+    static Affine_xy scale(Real sx, Real sy)
+    { return Affine_xy{sx, 0, 0, 0, sy, 0}; }
+
+    /// Escalado respecto del punto centro.
+    static Affine_xy scale(Real sx, Real sy, const Vector_xy<Real>& centro);
+
+    /// Giro de angle radianes respecto del origen.
+    static Affine_xy rotation(const Radian& angle);
+
+    /// Giro de angle radianes respecto del punto centro.
+    static Affine_xy rotation(const Radian& angle,
+			      const Vector_xy<Real>& centro);
+
+// Operations
+    /// Imagen del punto p.
+    constexpr Vector_xy<Real> operator()(const Vector_xy<Real>& p) const
+    { return Vector_xy<Real>{a * p.x + b * p.y + c, d * p.x + e * p.y + f}; }
+
+    constexpr Real det() const {return a * e - b * d;}
+
+    /// Transformación inversa. Si no es invertible lanza
+    /// std::invalid_argument.
+    Affine_xy inverse() const;
+};
+
+
+/// Composición: (t * s)(p) = t(s(p))
+template <typename Real>
+constexpr Affine_xy<Real> operator*(const Affine_xy<Real>& t,
+				    const Affine_xy<Real>& s)
+{
+    return Affine_xy<Real>{t.a * s.a + t.b * s.d,
+			   t.a * s.b + t.b * s.e,
+			   t.a * s.c + t.b * s.f + t.c,
+			   t.d * s.a + t.e * s.d,
+			   t.d * s.b + t.e * s.e,
+			   t.d * s.c + t.e * s.f + t.f};
+}
+
+
+template <std::floating_point Real>
+Affine_xy<Real> Affine_xy<Real>::scale(Real sx, Real sy,
+				       const Vector_xy<Real>& centro)
+{
+    return translation(centro) * scale(sx, sy) *
+	   translation(Vector_xy<Real>{-centro.x, -centro.y});
+}
+
+
+template <std::floating_point Real>
+Affine_xy<Real> Affine_xy<Real>::rotation(const Radian& angle)
+{
+    Real cs = static_cast<Real>(std::cos(angle.value()));
+    Real sn = static_cast<Real>(std::sin(angle.value()));
+
+    return Affine_xy{cs, -sn, 0, sn, cs, 0};
+}
+
+
+template <std::floating_point Real>
+Affine_xy<Real> Affine_xy<Real>::rotation(const Radian& angle,
+					  const Vector_xy<Real>& centro)
+{
+    return translation(centro) * rotation(angle) *
+	   translation(Vector_xy<Real>{-centro.x, -centro.y});
+}
+
+
+template <std::floating_point Real>
+Affine_xy<Real> Affine_xy<Real>::inverse() const
+{
+    Real D = det();
+    if (D == 0)
+	throw std::invalid_argument{"Affine_xy: transformación no invertible"};
+
+    Real ia =  e / D, ib = -b / D;
+    Real id = -d / D, ie =  a / D;
+
+    return Affine_xy{ia, ib, -(ia * c + ib * f),
+		     id, ie, -(id * c + ie * f)};
+}
+
+
+
+
+/*!
+ *  \brief  Transformación proyectiva (homografía) del plano.
+ *
+ *	(x, y) --> ((h0 x + h1 y + h2) / w, (h3 x + h4 y + h5) / w)
+ *
+ *	con w = h6 x + h7 y + h8.
+ *
+ */
+template <std::floating_point Real = double>
+struct Homography_xy{
+// Data
+    std::array<Real, 9> h = {1, 0, 0,
+			     0, 1, 0,
+			     0, 0, 1};
+
+// Constructors
+    /// Identidad.
+    constexpr Homography_xy() = default;
+
+    constexpr explicit Homography_xy(const std::array<Real, 9>& h0) : h{h0} { }
+
+    constexpr Homography_xy(const Affine_xy<Real>& t)
+	: h{t.a, t.b, t.c,
+	    t.d, t.e, t.f,
+	    0,	 0,   1} { }
+
+    /// Homografía que lleva los puntos src[k] a los puntos dst[k].
+    /// Si 3 de los puntos están alineados lanza std::invalid_argument.
+    static Homography_xy from_points(const std::array<Vector_xy<Real>, 4>& src,
+				     const std::array<Vector_xy<Real>, 4>& dst);
+
+// Operations
+    /// Imagen del punto p. (No se comprueba que w != 0)
+    constexpr Vector_xy<Real> operator()(const Vector_xy<Real>& p) const
+    {
+	Real w = h[6] * p.x + h[7] * p.y + h[8];
+	return Vector_xy<Real>{(h[0] * p.x + h[1] * p.y + h[2]) / w,
+			       (h[3] * p.x + h[4] * p.y + h[5]) / w};
+    }
+
+    /// Transformación inversa. Si no es invertible lanza
+    /// std::invalid_argument.
+    Homography_xy inverse() const;
+};
+
+
+/// Composición: (t * s)(p) = t(s(p))
+template <typename Real>
+constexpr Homography_xy<Real> operator*(const Homography_xy<Real>& t,
+					const Homography_xy<Real>& s)
+{
+    std::array<Real, 9> r;
+    for (int i = 0; i < 3; ++i)
+	for (int j = 0; j < 3; ++j)
+	    r[3*i + j] = t.h[3*i] * s.h[j] + t.h[3*i + 1] * s.h[3 + j]
+						+ t.h[3*i + 2] * s.h[6 + j];
+
+    return Homography_xy<Real>{r};
+}
+
+
+template <std::floating_point Real>
+Homography_xy<Real> Homography_xy<Real>::inverse() const
+{
+    // Adjunta traspuesta / determinante
+    std::array<Real, 9> r = {
+	h[4] * h[8] - h[5] * h[7], h[2] * h[7] - h[1] * h[8], h[1] * h[5] - h[2] * h[4],
+	h[5] * h[6] - h[3] * h[8], h[0] * h[8] - h[2] * h[6], h[2] * h[3] - h[0] * h[5],
+	h[3] * h[7] - h[4] * h[6], h[1] * h[6] - h[0] * h[7], h[0] * h[4] - h[1] * h[3]};
+
+    Real D = h[0] * r[0] + h[1] * r[3] + h[2] * r[6];
+    if (D == 0)
+	throw std::invalid_argument{"Homography_xy: transformación no invertible"};
+
+    for (auto& x: r)
+	x /= D;
+
+    return Homography_xy{r};
+}
+
+
+template <std::floating_point Real>
+Homography_xy<Real> Homography_xy<Real>::from_points(
+			    const std::array<Vector_xy<Real>, 4>& src,
+			    const std::array<Vector_xy<Real>, 4>& dst)
+{
+    // Sistema de 8 ecuaciones con 8 incógnitas (h8 = 1):
+    //	h0 x + h1 y + h2 - h6 x u - h7 y u = u
+    //	h3 x + h4 y + h5 - h6 x v - h7 y v = v
+    constexpr int N = 8;
+    Real A[N][N + 1];
+
+    for (int k = 0; k < 4; ++k){
+	Real x = src[k].x, y = src[k].y;
+	Real u = dst[k].x, v = dst[k].y;
+
+	Real* f = A[2*k];
+	f[0] = x; f[1] = y; f[2] = 1; f[3] = 0; f[4] = 0; f[5] = 0;
+	f[6] = -x * u; f[7] = -y * u; f[8] = u;
+
+	f = A[2*k + 1];
+	f[0] = 0; f[1] = 0; f[2] = 0; f[3] = x; f[4] = y; f[5] = 1;
+	f[6] = -x * v; f[7] = -y * v; f[8] = v;
+    }
+
+    // Gauss con pivote parcial
+    for (int c = 0; c < N; ++c){
+	int p = c;
+	for (int i = c + 1; i < N; ++i)
+	    if (std::abs(A[i][c]) > std::abs(A[p][c]))
+		p = i;
+
+	if (std::abs(A[p][c]) < std::numeric_limits<Real>::epsilon())
+	    throw std::invalid_argument{"Homography_xy::from_points: "
+					"puntos degenerados"};
+
+	if (p != c)
+	    for (int j = 0; j <= N; ++j)
+		std::swap(A[p][j], A[c][j]);
+
+	for (int i = c + 1; i < N; ++i){
+	    Real m = A[i][c] / A[c][c];
+	    for (int j = c; j <= N; ++j)
+		A[i][j] -= m * A[c][j];
+	}
+    }
+
+    std::array<Real, 9> h;
+    h[8] = 1;
+    for (int i = N - 1; i >= 0; --i){
+	Real s = A[i][N];
+	for (int j = i + 1; j < N; ++j)
+	    s -= A[i][j] * h[j];
+
+	h[i] = s / A[i][i];
+    }
+
+    return Homography_xy{h};
+}
+
+
+
+
+/***************************************************************************
+ *				WARP
+ ***************************************************************************/
+enum class Interpolation{ nearest, bilinear };
+
+/// Qué hacer con los puntos que caen fuera de la matriz origen.
+///	constant   : valen border_value
+///	replicate  : valen lo que el pixel del borde más próximo (aaa|abc)
+///	reflect    : se refleja la matriz respecto del borde (cba|abc)
+///	transparent: no se modifica el pixel de la matriz destino
+enum class Border{ constant, replicate, reflect, transparent };
+
+template <typename T>
+struct Warp_params{
+    Interpolation interpolation = Interpolation::bilinear;
+    Border border		= Border::constant;
+    T border_value{};
+};
+
+
+namespace impl_of{
+// Las coordenadas se calculan por bloques de este tamaño.
+inline constexpr ptrdiff_t bloque_warp = 64;
+
+// Índice k (fuera de [0, n)) reflejado respecto de los bordes. n > 0.
+inline ptrdiff_t refleja(ptrdiff_t k, ptrdiff_t n)
+{
+    ptrdiff_t p = 2 * n;
+    k %= p;
+    if (k < 0)
+	k += p;
+
+    return (k < n)? k: p - 1 - k;
+}
+
+
+// Convierte el valor interpolado x al tipo T
+template <typename T, typename Real>
+inline T a_tipo(Real x)
+{
+    if constexpr (std::is_integral_v<T>){
+	x = std::round(x);
+	x = std::clamp<Real>(x, std::numeric_limits<T>::lowest(),
+				std::numeric_limits<T>::max());
+    }
+
+    return static_cast<T>(x);
+}
+
+
+// Muestrea la matriz src en puntos (x, y) cualesquiera.
+template <typename T, typename I>
+class Muestreador{
+public:
+    Muestreador(const Matrix<T, I>& src, const Warp_params<T>& p)
+	: m_{src}, p_{p},
+	  rows_{static_cast<ptrdiff_t>(src.rows())},
+	  cols_{static_cast<ptrdiff_t>(src.cols())}
+    { }
+
+    // Los dos devuelven false si no hay que escribir el pixel destino.
+    template <typename Real>
+    bool nearest(Real x, Real y, T& v) const;
+
+    template <typename Real>
+    bool bilinear(Real x, Real y, T& v) const;
+
+private:
+    const Matrix<T, I>& m_;
+    const Warp_params<T>& p_;
+    ptrdiff_t rows_, cols_;
+
+    // Límite de las coordenadas que consideramos (evitamos desbordar al
+    // convertir a entero y descartamos NaN e infinitos)
+    static constexpr double lim = 1 << 30;
+
+    bool dentro(ptrdiff_t i, ptrdiff_t j) const
+    { return 0 <= i and i < rows_ and 0 <= j and j < cols_; }
+
+    const T& at(ptrdiff_t i, ptrdiff_t j) const
+    { return m_(static_cast<I>(i), static_cast<I>(j)); }
+
+    // Pixel (i, j) aplicando la política de borde.
+    T pixel(ptrdiff_t i, ptrdiff_t j) const;
+
+    // Punto sin muestra (fuera de los límites o no finito)
+    bool sin_muestra(T& v) const
+    {
+	if (p_.border == Border::transparent)
+	    return false;
+
+	v = p_.border_value;
+	return true;
+    }
+
+    template <typename Real>
+    static bool valido(Real x, Real y)
+    { return (-lim < x and x < lim and -lim < y and y < lim); }
+};
+
+
+template <typename T, typename I>
+T Muestreador<T, I>::pixel(ptrdiff_t i, ptrdiff_t j) const
+{
+    if (dentro(i, j))
+	return at(i, j);
+
+    if (rows_ == 0 or cols_ == 0)
+	return p_.border_value;
+
+    switch (p_.border){
+	case Border::constant:
+	    return p_.border_value;
+
+	case Border::reflect:
+	    return at(refleja(i, rows_), refleja(j, cols_));
+
+	default: // replicate, transparent (vecinos de un punto de dentro)
+	    return at(std::clamp<ptrdiff_t>(i, 0, rows_ - 1),
+		      std::clamp<ptrdiff_t>(j, 0, cols_ - 1));
+    }
+}
+
+
+template <typename T, typename I>
+template <typename Real>
+bool Muestreador<T, I>::nearest(Real x, Real y, T& v) const
+{
+    if (!valido(x, y))
+	return sin_muestra(v);
+
+    ptrdiff_t i = static_cast<ptrdiff_t>(std::floor(y + Real{0.5}));
+    ptrdiff_t j = static_cast<ptrdiff_t>(std::floor(x + Real{0.5}));
+
+    if (p_.border == Border::transparent and !dentro(i, j))
+	return false;
+
+    v = pixel(i, j);
+    return true;
+}
+
+
+template <typename T, typename I>
+template <typename Real>
+bool Muestreador<T, I>::bilinear(Real x, Real y, T& v) const
+{
+    if (!valido(x, y))
+	return sin_muestra(v);
+
+    Real fi = std::floor(y);
+    Real fj = std::floor(x);
+    ptrdiff_t i = static_cast<ptrdiff_t>(fi);
+    ptrdiff_t j = static_cast<ptrdiff_t>(fj);
+    Real dy = y - fi;
+    Real dx = x - fj;
+
+    if (p_.border == Border::transparent and
+	!dentro(i + (dy >= Real{0.5}), j + (dx >= Real{0.5})))
+	return false;
+
+    T p00, p01, p10, p11;
+    if (0 <= i and i + 1 < rows_ and 0 <= j and j + 1 < cols_){
+	const T* q = &at(i, j);
+	p00 = q[0];
+	p01 = q[1];
+	q = &at(i + 1, j);
+	p10 = q[0];
+	p11 = q[1];
+    }
+    else {
+	p00 = pixel(i, j);
+	p01 = pixel(i, j + 1);
+	p10 = pixel(i + 1, j);
+	p11 = pixel(i + 1, j + 1);
+    }
+
+    if constexpr (std::is_same_v<T, uint8_t>){
+	// Punto fijo: pesos en [0, 256]
+	int32_t wx = static_cast<int32_t>(dx * 256 + Real{0.5});
+	int32_t wy = static_cast<int32_t>(dy * 256 + Real{0.5});
+
+	int32_t s = p00 * (256 - wx) + p01 * wx;
+	int32_t t = p10 * (256 - wx) + p11 * wx;
+
+	v = static_cast<uint8_t>((s * (256 - wy) + t * wy + (1 << 15)) >> 16);
+    }
+    else {
+	Real s = p00 + (p01 - p00) * dx;
+	Real t = p10 + (p11 - p10) * dx;
+	v = a_tipo<T>(s + (t - s) * dy);
+    }
+
+    return true;
+}
+
+
+// Coordenadas en src de los pixels (i, j0 + k) de dst, k en [0, bloque).
+// Como las transformaciones son lineales (o cociente de lineales) basta con
+// sumar k veces el incremento por columna.
+template <typename Real0>
+struct Coordenadas_afin{
+    using Real = Real0;
+    Affine_xy<Real> t;	// dst --> src
+
+    void operator()(ptrdiff_t i, ptrdiff_t j0, Real* x, Real* y) const
+    {
+	Real x0 = t.a * j0 + t.b * i + t.c;
+	Real y0 = t.d * j0 + t.e * i + t.f;
+
+	// (k int: la conversión int64 --> double no se vectoriza)
+	for (int k = 0; k < bloque_warp; ++k){
+	    Real rk = static_cast<Real>(k);
+	    x[k] = x0 + t.a * rk;
+	    y[k] = y0 + t.d * rk;
+	}
+    }
+};
+
+
+template <typename Real0>
+struct Coordenadas_proyectivas{
+    using Real = Real0;
+    Homography_xy<Real> t;	// dst --> src
+
+    void operator()(ptrdiff_t i, ptrdiff_t j0, Real* x, Real* y) const
+    {
+	const auto& h = t.h;
+	Real u0 = h[0] * j0 + h[1] * i + h[2];
+	Real v0 = h[3] * j0 + h[4] * i + h[5];
+	Real w0 = h[6] * j0 + h[7] * i + h[8];
+
+	for (int k = 0; k < bloque_warp; ++k){
+	    Real rk = static_cast<Real>(k);
+	    Real w = w0 + h[6] * rk;
+	    x[k] = (u0 + h[0] * rk) / w;
+	    y[k] = (v0 + h[3] * rk) / w;
+	}
+
+	// Los puntos con w <= 0 no tienen imagen (o están en el infinito).
+	// Como w es lineal en k basta con mirar los extremos del bloque.
+	Real we = w0 + h[6] * (bloque_warp - 1);
+	if (w0 <= 0 or we <= 0){
+	    for (int k = 0; k < bloque_warp; ++k)
+		if (!(w0 + h[6] * static_cast<Real>(k) > 0))
+		    x[k] = y[k] = std::numeric_limits<Real>::infinity();
+	}
+    }
+};
+
+
+template <typename T, typename I, typename Coordenadas>
+void warp_rows(const Matrix<T, I>& src, Matrix<T, I>& dst,
+	       ptrdiff_t i0, ptrdiff_t ie,
+	       const Coordenadas& coordenadas, const Warp_params<T>& p)
+{
+    using Real = typename Coordenadas::Real;
+
+    if constexpr (!std::is_arithmetic_v<T>){
+	if (p.interpolation == Interpolation::bilinear)
+	    throw std::invalid_argument{"warp: la interpolación bilineal "
+				    "solo se puede usar con tipos aritméticos"};
+    }
+
+    constexpr ptrdiff_t B = bloque_warp;
+    Real x[B], y[B];
+
+    Muestreador<T, I> s{src, p};
+
+    ptrdiff_t cols = static_cast<ptrdiff_t>(dst.cols());
+    i0 = std::max<ptrdiff_t>(i0, 0);
+    ie = std::min<ptrdiff_t>(ie, static_cast<ptrdiff_t>(dst.rows()));
+
+    for (ptrdiff_t i = i0; i < ie; ++i){
+	for (ptrdiff_t j0 = 0; j0 < cols; j0 += B){
+	    coordenadas(i, j0, x, y);
+
+	    ptrdiff_t n = std::min(B, cols - j0);
+	    T* q = &dst(static_cast<I>(i), static_cast<I>(j0));
+
+	    if constexpr (std::is_arithmetic_v<T>){
+		if (p.interpolation == Interpolation::bilinear){
+		    for (ptrdiff_t k = 0; k < n; ++k)
+			s.bilinear(x[k], y[k], q[k]);
+
+		    continue;
+		}
+	    }
+
+	    for (ptrdiff_t k = 0; k < n; ++k)
+		s.nearest(x[k], y[k], q[k]);
+	}
+    }
+}
+
+// Calcula dst repartiendo bandas de filas entre num_threads threads (0 =
+// un thread por core). Cada banda la calcula warp_rows(banda_i0, banda_ie).
+template <typename I, typename Warp_rows>
+void warp_por_bandas(I rows, unsigned num_threads, Warp_rows warp_rows)
+{
+    // Con bandas muy pequeñas no compensa crear el thread
+    constexpr I min_filas = 16;
+
+    if (num_threads == 0)
+	num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    num_threads = static_cast<unsigned>(std::max<I>(1, 
+		    std::min<I>(static_cast<I>(num_threads), rows / min_filas)));
+
+    if (num_threads <= 1){
+	warp_rows(I{0}, rows);
+	return;
+    }
+
+    std::vector<std::future<void>> threads;
+    I banda = rows / static_cast<I>(num_threads);
+    I i0 = 0;
+    for (unsigned t = 0; t + 1 < num_threads; ++t, i0 += banda)
+	threads.push_back(std::async(std::launch::async, warp_rows,
+							i0, i0 + banda));
+
+    warp_rows(i0, rows);
+
+    for (auto& t: threads)
+	t.get();
+}
+
+}// namespace impl_of
+
+
+/// Calcula las filas [i0, ie) de dst = src transformada por t. Las filas
+/// de dst son independientes: varios threads pueden calcular a la vez
+/// bandas de filas diferentes.
+/// t lleva puntos de src a puntos de dst.
+template <typename T, typename I, typename Real>
+void warp_rows(const Matrix<T, I>& src, Matrix<T, I>& dst,
+	       const Affine_xy<Real>& t, I i0, I ie,
+	       const Warp_params<T>& p = {})
+{
+    impl_of::warp_rows(src, dst, static_cast<ptrdiff_t>(i0),
+		       static_cast<ptrdiff_t>(ie),
+		       impl_of::Coordenadas_afin<Real>{t.inverse()}, p);
+}
+
+
+template <typename T, typename I, typename Real>
+void warp_rows(const Matrix<T, I>& src, Matrix<T, I>& dst,
+	       const Homography_xy<Real>& t, I i0, I ie,
+	       const Warp_params<T>& p = {})
+{
+    impl_of::warp_rows(src, dst, static_cast<ptrdiff_t>(i0),
+		       static_cast<ptrdiff_t>(ie),
+		       impl_of::Coordenadas_proyectivas<Real>{t.inverse()}, p);
+}
+
+
+/// dst = src transformada por t (t lleva puntos de src a puntos de dst).
+/// dst tiene que tener ya el tamaño deseado.
+template <typename T, typename I, typename Real>
+inline void warp(const Matrix<T, I>& src, Matrix<T, I>& dst,
+		 const Affine_xy<Real>& t, const Warp_params<T>& p = {})
+{ warp_rows(src, dst, t, I{0}, dst.rows(), p); }
+
+template <typename T, typename I, typename Real>
+inline void warp(const Matrix<T, I>& src, Matrix<T, I>& dst,
+		 const Homography_xy<Real>& t, const Warp_params<T>& p = {})
+{ warp_rows(src, dst, t, I{0}, dst.rows(), p); }
+
+
+/// Igual que warp(src, dst, t, p), repartiendo las filas de dst entre
+/// num_threads threads (0 = un thread por core).
+template <typename T, typename I, typename Real>
+void warp(const Matrix<T, I>& src, Matrix<T, I>& dst,
+	  const Affine_xy<Real>& t, const Warp_params<T>& p,
+	  unsigned num_threads)
+{
+    impl_of::Coordenadas_afin<Real> coordenadas{t.inverse()};
+    impl_of::warp_por_bandas(dst.rows(), num_threads, [&](I i0, I ie) {
+	impl_of::warp_rows(src, dst, static_cast<ptrdiff_t>(i0),
+			   static_cast<ptrdiff_t>(ie), coordenadas, p);
+    });
+}
+
+template <typename T, typename I, typename Real>
+void warp(const Matrix<T, I>& src, Matrix<T, I>& dst,
+	  const Homography_xy<Real>& t, const Warp_params<T>& p,
+	  unsigned num_threads)
+{
+    impl_of::Coordenadas_proyectivas<Real> coordenadas{t.inverse()};
+    impl_of::warp_por_bandas(dst.rows(), num_threads, [&](I i0, I ie) {
+	impl_of::warp_rows(src, dst, static_cast<ptrdiff_t>(i0),
+			   static_cast<ptrdiff_t>(ie), coordenadas, p);
+    });
+}
+
+
+/// Devuelve la matriz src transformada por t, del mismo tamaño que src.
+template <typename T, typename I, typename Transformation>
+Matrix<T, I> warp(const Matrix<T, I>& src, const Transformation& t,
+		  const Warp_params<T>& p = {})
+{
+    Matrix<T, I> res{src.rows(), src.cols()};
+    warp(src, res, t, p);
+
+    return res;
+}
+
+
+/// Gira la matriz m angle radianes respecto de su centro (en sentido
+/// contrario a las agujas del reloj). La matriz devuelta tiene el mismo
+/// tamaño que m.
+template <typename T, typename I>
+Matrix<T, I> rotate(const Matrix<T, I>& m, const Radian& angle,
+		    const Warp_params<T>& p = {})
+{
+    Vector_xy<double> centro{(static_cast<double>(m.cols()) - 1) / 2,
+			     (static_cast<double>(m.rows()) - 1) / 2};
+
+    Radian a = angle;
+    return warp(m, Affine_xy<double>::rotation(-a, centro), p);
+}
+
+
+}// namespace
+
+#endif
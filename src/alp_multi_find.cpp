@@ -0,0 +1,267 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "alp_multi_find.h"
+#include "alp_iso88591.h"
+
+#include <stdexcept>
+#include <limits>
+
+namespace alp{
+
+Multi_find::Multi_find(const std::vector<std::string>& patrones,
+		       bool ignore_case)
+    : patron_{patrones}, ignore_case_{ignore_case}
+{
+    for (auto& p: patron_)
+	if (p.empty())
+	    throw std::invalid_argument{"Multi_find: patrón vacío"};
+
+    if (patron_.size() > static_cast<size_t>(
+				std::numeric_limits<int32_t>::max()))
+	throw std::invalid_argument{"Multi_find: demasiados patrones"};
+
+    crea_tabla_minusculas();
+    crea_clases();
+    crea_trie();
+    crea_dfa();
+    crea_prefiltro();
+}
+
+
+void Multi_find::crea_tabla_minusculas()
+{
+    for (int c = 0; c < 256; ++c){
+	minuscula_[0][c] = static_cast<unsigned char>(c);
+	minuscula_[1][c] = static_cast<unsigned char>(c);
+    }
+
+    if (!ignore_case_)
+	return;
+
+    // ASCII
+    for (int c = 0; c < 0x80; ++c){
+	minuscula_[0][c] = iso88951::to_lower(c);
+	minuscula_[1][c] = iso88951::to_lower(c);
+    }
+
+    // Latin-1: los caracteres 0xC0-0xFF se codifican en UTF-8 como
+    // C3 80-C3 BF (el segundo byte es c - 0x40).
+    for (int c = 0x80; c < 0xC0; ++c){
+	unsigned char l = iso88951::to_lower(c + 0x40);
+	minuscula_[1][c] = l - 0x40;
+    }
+}
+
+
+void Multi_find::crea_clases()
+{
+    // La clase 0 la forman todos los bytes que no están en ningún patrón
+    clase_.fill(0);
+    num_clases_ = 1;
+
+    for (auto& p: patron_){
+	unsigned char anterior = 0;
+	for (char x: p){
+	    unsigned char c = fold(static_cast<unsigned char>(x), anterior);
+	    anterior = static_cast<unsigned char>(x);
+
+	    if (clase_[c] == 0)
+		clase_[c] = num_clases_++;
+	}
+    }
+}
+
+
+void Multi_find::crea_trie()
+{
+    Estado n = num_clases_;
+
+    sig_.assign(n, indefinido);
+    primer_patron_.assign(1, -1);
+    otro_patron_.assign(patron_.size(), -1);
+
+    for (size_t i = 0; i < patron_.size(); ++i){
+	Estado s = 0;
+	unsigned char anterior = 0;
+
+	for (char x: patron_[i]){
+	    unsigned char c = fold(static_cast<unsigned char>(x), anterior);
+	    anterior = static_cast<unsigned char>(x);
+
+	    Estado& t = sig_[s + clase_[c]];
+	    if (t == indefinido){
+		if (sig_.size() + n >= con_salida)
+		    throw std::length_error{"Multi_find: demasiados estados"};
+
+		t = static_cast<Estado>(sig_.size());
+		sig_.resize(sig_.size() + n, indefinido);
+		primer_patron_.push_back(-1);
+	    }
+
+	    s = sig_[s + clase_[c]];  // resize invalida t
+	}
+
+	// Los patrones repetidos terminan en el mismo estado
+	otro_patron_[i] = primer_patron_[s / n];
+	primer_patron_[s / n] = static_cast<int32_t>(i);
+    }
+}
+
+
+// Recorremos el trie en anchura. Al procesar un estado, el estado de fallo
+// (que es menos profundo) ya tiene todas sus transiciones calculadas: las
+// transiciones que no existen en el trie son las del estado de fallo.
+void Multi_find::crea_dfa()
+{
+    Estado n = num_clases_;
+    size_t num_estados = primer_patron_.size();
+
+    std::vector<Estado> fallo(num_estados, 0);
+    enlace_salida_.assign(num_estados, 0);
+
+    std::vector<Estado> cola;
+    cola.reserve(num_estados);
+
+    for (Estado c = 0; c < n; ++c){
+	Estado& t = sig_[c];
+	if (t == indefinido)
+	    t = 0;
+	else
+	    cola.push_back(t);
+    }
+
+    for (size_t k = 0; k < cola.size(); ++k){
+	Estado s = cola[k];
+	Estado f = fallo[s / n];
+
+	for (Estado c = 0; c < n; ++c){
+	    Estado& t = sig_[s + c];
+	    if (t == indefinido)
+		t = sig_[f + c];
+
+	    else {
+		Estado ft = sig_[f + c];
+		fallo[t / n] = ft;
+		enlace_salida_[t / n] = (primer_patron_[ft / n] >= 0)? 
+						ft : enlace_salida_[ft / n];
+		cola.push_back(t);
+	    }
+	}
+    }
+
+    // Marcamos los estados con salida
+    auto tiene_salida = [&](Estado s) {
+	return primer_patron_[s / n] >= 0 or enlace_salida_[s / n] != 0;
+    };
+
+    for (auto& t: sig_)
+	if (tiene_salida(t))
+	    t |= con_salida;
+}
+
+
+void Multi_find::crea_prefiltro()
+{
+    num_inicio_ = 0;
+
+    for (int c = 0; c < 256; ++c){
+	unsigned char x = static_cast<unsigned char>(c);
+
+	// Un patrón nunca empieza por un byte de continuación UTF-8, así
+	// que aquí da igual cuál sea el byte anterior.
+	if ((sig_[clase_[fold(x, 0)]] & ~con_salida) != 0){
+	    if (num_inicio_ == static_cast<int>(inicio_.size())){
+		num_inicio_ = 0;    // demasiados: no merece la pena
+		return;
+	    }
+
+	    inicio_[num_inicio_++] = x;
+	}
+    }
+}
+
+
+namespace {
+constexpr uint64_t unos = 0x0101010101010101ull;
+constexpr uint64_t bit7 = 0x8080808080808080ull;
+
+inline uint64_t lee_8_bytes(const char* p)
+{
+    uint64_t x;
+    std::memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+// ¿Alguno de los 8 bytes de x es 0?
+inline bool tiene_cero(uint64_t x)
+{ return ((x - unos) & ~x & bit7) != 0; }
+
+inline bool tiene_byte(uint64_t x, unsigned char c)
+{ return tiene_cero(x ^ (unos * c)); }
+
+}// namespace
+
+
+const char* Multi_find::salta(const char* p, const char* pe) const
+{
+    if (num_inicio_ == 1){
+	const void* q = std::memchr(p, inicio_[0], pe - p);
+	return q? static_cast<const char*>(q) : pe;
+    }
+
+    // Descartamos de 8 en 8 bytes
+    while (pe - p >= 8){
+	uint64_t x = lee_8_bytes(p);
+
+	bool esta = false;
+	for (int i = 0; i < num_inicio_; ++i)
+	    esta = esta or tiene_byte(x, inicio_[i]);
+
+	if (esta)
+	    break;
+
+	p += 8;
+    }
+
+    for (; p != pe; ++p){
+	unsigned char c = static_cast<unsigned char>(*p);
+	for (int i = 0; i < num_inicio_; ++i)
+	    if (c == inicio_[i])
+		return p;
+    }
+
+    return pe;
+}
+
+
+std::vector<Match> Multi_find::find_all(std::string_view s) const
+{
+    std::vector<Match> res;
+    for_each_match(s, [&](const Match& m) { res.push_back(m); });
+
+    return res;
+}
+
+
+bool Multi_find::contains(std::string_view s) const
+{
+    return !for_each_match(s, [](const Match&) { return false; });
+}
+
+
+}// namespace
@@ -0,0 +1,329 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_MULTI_FIND_H__
+#define __ALP_MULTI_FIND_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Búsqueda simultánea de muchas cadenas en un texto
+ *	(Aho-Corasick).
+ *
+ *  - COMENTARIOS: Los patrones y el texto son cadenas de bytes (UTF-8). Se
+ *	construye un autómata determinista (DFA) con todos los patrones y
+ *	se recorre el texto una única vez, independientemente del número de
+ *	patrones.
+ *
+ *	Para que la tabla de transiciones sea pequeña los bytes se agrupan
+ *	en clases: todos los bytes que no aparecen en ningún patrón son la
+ *	misma clase. La tabla tiene num_estados x num_clases entradas.
+ *
+ *	Si se ignoran mayúsculas/minúsculas, el texto se pasa a minúsculas
+ *	byte a byte según ISO-8859-1 (ver alp_iso88591.h): las letras ASCII
+ *	y los caracteres de Latin-1 codificados en UTF-8 (á, Ñ, ü...).
+ *
+ *	Si los patrones empiezan por pocos bytes diferentes (<= 3) mientras
+ *	el autómata está en el estado inicial se salta el texto buscando
+ *	esos bytes (con memchr o de 8 en 8 bytes).
+ *
+ *	Ejemplo:
+ *	\code
+ *	    alp::Multi_find mf{{"he", "she", "his", "hers"}};
+ *
+ *	    for (auto m: mf.find_all("ushers"))
+ *		std::cout << mf.patron(m.patron) << " en " << m.pos << '\n';
+ *	\endcode
+ *
+ *	Para buscar en un flujo leído por bloques usar Multi_find::Stream:
+ *	encuentra también las apariciones partidas entre dos bloques.
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <type_traits>
+
+#include "alp_utf8.h"
+
+namespace alp{
+
+/// Aparición de un patrón en el texto.
+struct Match{
+    size_t pos;	    // posición del primer byte (desde el principio del texto)
+    size_t size;    // número de bytes
+    size_t patron;  // índice del patrón encontrado
+
+    friend bool operator==(const Match&, const Match&) = default;
+};
+
+
+/*!
+ *  \brief  Busca simultáneamente varios patrones en un texto.
+ *
+ *  Se encuentran todas las apariciones, aunque se solapen. Se devuelven
+ *  ordenadas por el byte en el que terminan; si varias terminan en el
+ *  mismo byte primero la más larga.
+ *
+ */
+class Multi_find{
+public:
+    class Stream;
+
+    /// Construye el autómata que busca los patrones indicados.
+    /// Si algún patrón es vacío lanza std::invalid_argument.
+    explicit Multi_find(const std::vector<std::string>& patrones,
+			bool ignore_case = false);
+
+    size_t num_patrones() const {return patron_.size();}
+    const std::string& patron(size_t i) const {return patron_[i];}
+    bool ignore_case() const {return ignore_case_;}
+
+    /// Número de estados del autómata.
+    size_t num_estados() const {return primer_patron_.size();}
+
+    /// Llama a f(const Match&) por cada aparición de un patrón en [p0, pe).
+    /// Si f devuelve bool, la búsqueda se para en cuanto f devuelva false.
+    /// Devuelve false si la búsqueda se ha parado.
+    template <typename F>
+    bool for_each_match(const char* p0, const char* pe, F f) const;
+
+    template <typename F>
+    bool for_each_match(std::string_view s, F f) const
+    { return for_each_match(s.data(), s.data() + s.size(), f); }
+
+    /// Devuelve todas las apariciones de los patrones en s.
+    std::vector<Match> find_all(std::string_view s) const;
+
+    // (template para que "abc" no se pueda convertir a utf8_string)
+    template <typename S>
+	requires std::is_same_v<S, utf8_string>
+    std::vector<Match> find_all(const S& s) const
+    { return find_all(std::string_view{s.data(), s.num_bytes()}); }
+
+    /// ¿Aparece algún patrón en s?
+    bool contains(std::string_view s) const;
+
+private:
+// Types
+    // Los estados los guardamos ya multiplicados por num_clases_ (es la fila
+    // de sig_ correspondiente). El bit más alto indica si el estado tiene
+    // salida: así no hace falta mirar otra tabla para cada byte.
+    using Estado = uint32_t;
+    static constexpr Estado con_salida = 0x80000000u;
+    static constexpr Estado indefinido = 0xFFFFFFFFu;
+
+// Data
+    std::vector<std::string> patron_;
+    bool ignore_case_;
+
+    std::array<uint16_t, 256> clase_;	// byte -> clase
+    Estado num_clases_;
+
+    std::vector<Estado> sig_;	// sig_[s + clase] = estado siguiente
+
+    std::vector<int32_t> primer_patron_;// patrón que termina en el estado
+    std::vector<int32_t> otro_patron_;  // siguiente patrón igual
+    std::vector<Estado> enlace_salida_; // sufijo más largo con salida
+
+    // Pasar a minúsculas: minuscula_[0] si el byte anterior no es 0xC3 y
+    // minuscula_[1] si lo es (á = C3 A1, Á = C3 81).
+    std::array<std::array<unsigned char, 256>, 2> minuscula_;
+
+    // Prefiltro: bytes por los que puede empezar una aparición
+    std::array<unsigned char, 3> inicio_;
+    int num_inicio_ = 0;    // 0 = no hay prefiltro
+
+
+// Construcción
+    void crea_tabla_minusculas();
+    void crea_clases();
+    void crea_trie();
+    void crea_dfa();
+    void crea_prefiltro();
+
+    unsigned char fold(unsigned char c, unsigned char anterior) const
+    { return minuscula_[anterior == 0xC3][c]; }
+
+// Búsqueda
+    // Salta los bytes de [p, pe) por los que no puede empezar un patrón.
+    const char* salta(const char* p, const char* pe) const;
+
+    // Busca en [p0, pe) empezando en el estado s. fin0 es la posición de
+    // p0 desde el principio del texto.
+    template <bool ic, typename F>
+    bool search(const char* p0, const char* pe, Estado& s,
+		unsigned char& anterior, size_t fin0, F& f) const;
+
+    // Informa de todas las apariciones que terminan en el estado s
+    template <typename F>
+    bool report(Estado s, size_t fin, F& f) const;
+};
+
+
+/*!
+ *  \brief  Búsqueda de un Multi_find en un texto que se lee por bloques.
+ *
+ *  Las posiciones de los Match son desde el principio del flujo, por lo que
+ *  pueden referirse a bloques anteriores.
+ *
+ *  Ejemplo:
+ *  \code
+ *	Multi_find::Stream st{mf};
+ *	while (in.read(buf, n) or in.gcount())
+ *	    st.feed(buf, buf + in.gcount(), f);
+ *  \endcode
+ */
+class Multi_find::Stream{
+public:
+    explicit Stream(const Multi_find& mf) : mf_{mf} {}
+
+    /// Busca en el siguiente bloque del texto. f como en for_each_match.
+    template <typename F>
+    bool feed(const char* p0, const char* pe, F f);
+
+    template <typename F>
+    bool feed(std::string_view s, F f)
+    { return feed(s.data(), s.data() + s.size(), f); }
+
+    /// Vuelve a empezar un nuevo texto.
+    void reset()
+    {
+	s_ = 0;
+	anterior_ = 0;
+	pos_ = 0;
+    }
+
+    /// Número de bytes procesados.
+    size_t pos() const {return pos_;}
+
+private:
+    const Multi_find& mf_;
+    Estado s_ = 0;
+    unsigned char anterior_ = 0;
+    size_t pos_ = 0;
+};
+
+
+// Implementación
+// --------------
+template <typename F>
+bool Multi_find::report(Estado s, size_t fin, F& f) const
+{
+    Estado n = num_clases_;
+
+    s &= ~con_salida;
+    if (primer_patron_[s / n] < 0)
+	s = enlace_salida_[s / n];
+
+    while (s != 0){
+	for (int32_t i = primer_patron_[s / n]; i >= 0; i = otro_patron_[i]){
+	    Match m{fin - patron_[i].size(), patron_[i].size(),
+						static_cast<size_t>(i)};
+
+	    if constexpr (std::is_same_v<std::invoke_result_t<F&, Match&>,
+					 bool>){
+		if (!f(m))
+		    return false;
+	    }
+	    else
+		f(m);
+	}
+
+	s = enlace_salida_[s / n];
+    }
+
+    return true;
+}
+
+
+template <bool ic, typename F>
+bool Multi_find::search(const char* p0, const char* pe, Estado& s,
+			unsigned char& anterior, size_t fin0, F& f) const
+{
+    const char* p = p0;
+
+    while (p != pe){
+	if (s == 0 and num_inicio_ != 0){
+	    const char* q = salta(p, pe);
+	    if (q != p){
+		anterior = static_cast<unsigned char>(q[-1]);
+		p = q;
+
+		if (p == pe)
+		    break;
+	    }
+	}
+
+	unsigned char c = static_cast<unsigned char>(*p);
+	++p;
+
+	if constexpr (ic){
+	    unsigned char a = anterior;
+	    anterior = c;
+	    c = fold(c, a);
+	}
+
+	s = sig_[(s & ~con_salida) + clase_[c]];
+
+	if (s & con_salida){
+	    if (!report(s, fin0 + (p - p0), f))
+		return false;
+	}
+    }
+
+    return true;
+}
+
+
+template <typename F>
+bool Multi_find::for_each_match(const char* p0, const char* pe, F f) const
+{
+    Estado s = 0;
+    unsigned char anterior = 0;
+
+    if (ignore_case_)
+	return search<true>(p0, pe, s, anterior, 0, f);
+    else
+	return search<false>(p0, pe, s, anterior, 0, f);
+}
+
+
+template <typename F>
+bool Multi_find::Stream::feed(const char* p0, const char* pe, F f)
+{
+    bool res;
+    if (mf_.ignore_case_)
+	res = mf_.search<true>(p0, pe, s_, anterior_, pos_, f);
+    else
+	res = mf_.search<false>(p0, pe, s_, anterior_, pos_, f);
+
+    pos_ += pe - p0;
+
+    return res;
+}
+
+}// namespace
+
+#endif
@@ -0,0 +1,717 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_POINT_CLOUD_H__
+#define __ALP_POINT_CLOUD_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Nubes de puntos (Vector_xy, Vector_ij, Vector_xyz)
+ *	guardadas por componentes.
+ *
+ *  - COMENTARIOS: Un std::vector<Vector_xyz<T>> guarda los puntos seguidos
+ *	(x0 y0 z0 x1 y1 z1 ...: array of structures). Para operar con muchos
+ *	puntos a la vez es mejor guardar cada componente en su propio array
+ *	(x0 x1 x2 ..., y0 y1 y2 ..., z0 z1 z2 ...: structure of arrays): así
+ *	el compilador puede vectorizar las operaciones.
+ *
+ *	Point_cloud<V> guarda los puntos de tipo V por componentes. Su
+ *	operator[] devuelve un proxy (Point_cloud<V>::reference) que tiene los
+ *	mismos miembros que V (x, y, z o i, j) pero que son referencias a los
+ *	arrays. Recorriendo la nube con begin/end se ve como si fuera un
+ *	contenedor de V sin copiar nada.
+ *
+ *	Las operaciones en bloque (translate, scale, rotate, dot_product,
+ *	cross_product, modulo, bounding_box) se hacen por bloques de tamaño
+ *	fijo en arrays locales, igual que las conversiones a polares de
+ *	alp_math.h, para que el compilador las vectorice con -O2.
+ *
+ *	Ejemplo:
+ *	\code
+ *	    alp::Point_cloud<alp::Vector_xyz<double>> p{puntos}; // AoS -> SoA
+ *	    alp::rotate(p, R);
+ *	    alp::translate(p, t);
+ *	    std::vector<double> d = alp::modulo(p);
+ *	\endcode
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    19/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "alp_math.h"
+#include "alp_rframe_ij.h"
+#include "alp_rframe_xy.h"
+#include "alp_rframe_xyz.h"
+
+namespace alp{
+
+namespace impl_of{
+/***************************************************************************
+ *			    COMPONENTES DE LOS VECTORES
+ ***************************************************************************/
+// Para cada tipo de vector:
+//	+ value_type y N (número de componentes).
+//	+ get(v, k): componente k de v.
+//	+ make(c): vector con componentes c[0], c[1]...
+//	+ Ref<Q>: proxy con los mismos miembros que el vector, referencias a Q.
+template <typename V>
+struct Componentes_de;
+
+template <typename T>
+struct Componentes_de<Vector_xy<T>>{
+    using Vector     = Vector_xy<T>;
+    using value_type = T;
+    static constexpr size_t N = 2;
+
+    static T get(const Vector& v, size_t k) {return (k == 0)? v.x: v.y;}
+    static Vector make(const std::array<T, N>& c) {return Vector{c[0], c[1]};}
+
+    template <typename Q>
+    struct Ref{
+	Q& x;
+	Q& y;
+
+	operator Vector() const {return Vector{x, y};}
+
+	const Ref& operator=(const Vector& v) const
+	{
+	    x = v.x;
+	    y = v.y;
+	    return *this;
+	}
+    };
+
+    template <typename Q>
+    static Ref<Q> ref(const std::array<Q*, N>& p, size_t i)
+    { return Ref<Q>{p[0][i], p[1][i]}; }
+};
+
+template <typename T>
+struct Componentes_de<Vector_ij<T>>{
+    using Vector     = Vector_ij<T>;
+    using value_type = T;
+    static constexpr size_t N = 2;
+
+    static T get(const Vector& v, size_t k) {return (k == 0)? v.i: v.j;}
+    static Vector make(const std::array<T, N>& c) {return Vector{c[0], c[1]};}
+
+    template <typename Q>
+    struct Ref{
+	Q& i;
+	Q& j;
+
+	operator Vector() const {return Vector{i, j};}
+
+	const Ref& operator=(const Vector& v) const
+	{
+	    i = v.i;
+	    j = v.j;
+	    return *this;
+	}
+    };
+
+    template <typename Q>
+    static Ref<Q> ref(const std::array<Q*, N>& p, size_t i)
+    { return Ref<Q>{p[0][i], p[1][i]}; }
+};
+
+template <typename T>
+struct Componentes_de<Vector_xyz<T>>{
+    using Vector     = Vector_xyz<T>;
+    using value_type = T;
+    static constexpr size_t N = 3;
+
+    static T get(const Vector& v, size_t k)
+    { return (k == 0)? v.x: (k == 1)? v.y: v.z; }
+
+    static Vector make(const std::array<T, N>& c)
+    { return Vector{c[0], c[1], c[2]}; }
+
+    template <typename Q>
+    struct Ref{
+	Q& x;
+	Q& y;
+	Q& z;
+
+	operator Vector() const {return Vector{x, y, z};}
+
+	const Ref& operator=(const Vector& v) const
+	{
+	    x = v.x;
+	    y = v.y;
+	    z = v.z;
+	    return *this;
+	}
+    };
+
+    template <typename Q>
+    static Ref<Q> ref(const std::array<Q*, N>& p, size_t i)
+    { return Ref<Q>{p[0][i], p[1][i], p[2][i]}; }
+};
+
+
+/***************************************************************************
+ *				BLOQUES
+ ***************************************************************************/
+inline constexpr size_t bloque_soa = 64;
+
+// Recorre los arrays in[k][0..n) por bloques de bloque_soa elementos. Para
+// cada bloque copia las entradas en arrays locales a[k], llama a f(a, b) y
+// copia b[k] en out[k]. f tiene que operar siempre sobre los bloque_soa
+// elementos: así el bucle tiene un número fijo de iteraciones y no hay
+// aliasing, y el compilador lo vectoriza.
+template <typename TI, size_t NI, typename TO, size_t NO, typename F>
+void por_bloques(size_t n, const std::array<const TI*, NI>& in,
+		 const std::array<TO*, NO>& out, F f)
+{
+    constexpr size_t B = bloque_soa;
+    TI a[NI][B]{};
+    TO b[NO][B];
+
+    for (size_t i0 = 0; i0 < n; i0 += B){
+	size_t m = std::min(B, n - i0);
+
+	for (size_t k = 0; k < NI; ++k)
+	    std::copy_n(in[k] + i0, m, a[k]);
+
+	f(a, b);
+
+	for (size_t k = 0; k < NO; ++k)
+	    std::copy_n(b[k], m, out[k] + i0);
+    }
+}
+
+}// namespace impl_of
+
+
+
+/***************************************************************************
+ *				Point_cloud
+ ***************************************************************************/
+/*!
+ *  \brief  Nube de puntos de tipo V guardada por componentes.
+ *
+ *  V puede ser Vector_xy<T>, Vector_ij<T> o Vector_xyz<T>.
+ *
+ */
+template <typename V>
+class Point_cloud{
+    using Comp = impl_of::Componentes_de<V>;
+
+public:
+// Types
+    using Vector     = V;
+    using value_type = typename Comp::value_type;   // tipo de las componentes
+    static constexpr size_t N = Comp::N;	    // número de componentes
+
+    using reference       = typename Comp::template Ref<value_type>;
+    using const_reference = typename Comp::template Ref<const value_type>;
+
+    template <bool is_const>
+    class Iterator;
+
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+// Construction
+    Point_cloud() = default;
+
+    /// Nube de n puntos con todas sus componentes a 0.
+    explicit Point_cloud(size_t n) { resize(n); }
+
+    /// Copia los puntos v (AoS -> SoA).
+    explicit Point_cloud(std::span<const V> v) { assign(v.begin(), v.end()); }
+
+    explicit Point_cloud(const std::vector<V>& v)
+	: Point_cloud{std::span<const V>{v}} {}
+
+    /// Copia los puntos [p0, pe).
+    template <std::input_iterator It>
+    void assign(It p0, It pe);
+
+// Dimensions
+    size_t size() const {return c_[0].size();}
+    bool empty() const {return size() == 0;}
+
+    void reserve(size_t n) { for (auto& c: c_) c.reserve(n); }
+    void resize(size_t n) { for (auto& c: c_) c.resize(n); }
+    void clear() { for (auto& c: c_) c.clear(); }
+
+    void push_back(const V& v)
+    {
+	for (size_t k = 0; k < N; ++k)
+	    c_[k].push_back(Comp::get(v, k));
+    }
+
+// Access
+    reference operator[](size_t i) {return Comp::ref(data(), i);}
+    const_reference operator[](size_t i) const {return Comp::ref(data(), i);}
+
+    /// Array con la componente k de todos los puntos.
+    std::span<value_type> component(size_t k) {return c_[k];}
+    std::span<const value_type> component(size_t k) const {return c_[k];}
+
+    /// Punteros al principio de los arrays de cada componente.
+    std::array<value_type*, N> data();
+    std::array<const value_type*, N> data() const;
+
+    /// Vista AoS (sin copiar): el valor de *it es el proxy reference.
+    iterator begin() {return iterator{data(), 0};}
+    iterator end() {return iterator{data(), size()};}
+    const_iterator begin() const {return const_iterator{data(), 0};}
+    const_iterator end() const {return const_iterator{data(), size()};}
+
+    /// Copia los puntos en out (SoA -> AoS). Devuelve el final de out.
+    template <std::output_iterator<V> Out>
+    Out copy(Out out) const;
+
+    std::vector<V> as_vector() const
+    {
+	std::vector<V> res;
+	res.reserve(size());
+	copy(std::back_inserter(res));
+	return res;
+    }
+
+private:
+    std::array<std::vector<value_type>, N> c_;
+};
+
+
+/*!
+ *  \brief  Iterador de Point_cloud: ve la nube como un contenedor de V.
+ *
+ */
+template <typename V>
+template <bool is_const>
+class Point_cloud<V>::Iterator{
+public:
+    using Q = std::conditional_t<is_const, const typename Comp::value_type,
+					   typename Comp::value_type>;
+
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = V;
+    using difference_type   = std::ptrdiff_t;
+    using reference  = typename Comp::template Ref<Q>;
+    using pointer    = void;
+
+    Iterator() = default;
+    Iterator(const std::array<Q*, N>& p, size_t i) : p_{p}, i_{i} {}
+
+    reference operator*() const {return Comp::ref(p_, i_);}
+    reference operator[](difference_type n) const
+    { return Comp::ref(p_, i_ + n); }
+
+    Iterator& operator++() {++i_; return *this;}
+    Iterator operator++(int) {auto tmp = *this; ++i_; return tmp;}
+    Iterator& operator--() {--i_; return *this;}
+    Iterator operator--(int) {auto tmp = *this; --i_; return tmp;}
+
+    Iterator& operator+=(difference_type n) {i_ += n; return *this;}
+    Iterator& operator-=(difference_type n) {i_ -= n; return *this;}
+
+    friend Iterator operator+(Iterator a, difference_type n) {return a += n;}
+    friend Iterator operator+(difference_type n, Iterator a) {return a += n;}
+    friend Iterator operator-(Iterator a, difference_type n) {return a -= n;}
+
+    friend difference_type operator-(const Iterator& a, const Iterator& b)
+    { return static_cast<difference_type>(a.i_) -
+	     static_cast<difference_type>(b.i_); }
+
+    friend bool operator==(const Iterator& a, const Iterator& b)
+    { return a.i_ == b.i_; }
+
+    friend auto operator<=>(const Iterator& a, const Iterator& b)
+    { return a.i_ <=> b.i_; }
+
+private:
+    std::array<Q*, N> p_{};
+    size_t i_ = 0;
+};
+
+
+template <typename V>
+template <std::input_iterator It>
+void Point_cloud<V>::assign(It p0, It pe)
+{
+    clear();
+    if constexpr (std::forward_iterator<It>)
+	reserve(std::distance(p0, pe));
+
+    for (; p0 != pe; ++p0)
+	push_back(*p0);
+}
+
+template <typename V>
+inline std::array<typename Point_cloud<V>::value_type*, Point_cloud<V>::N>
+						    Point_cloud<V>::data()
+{
+    std::array<value_type*, N> p;
+    for (size_t k = 0; k < N; ++k)
+	p[k] = c_[k].data();
+
+    return p;
+}
+
+template <typename V>
+inline
+std::array<const typename Point_cloud<V>::value_type*, Point_cloud<V>::N>
+					    Point_cloud<V>::data() const
+{
+    std::array<const value_type*, N> p;
+    for (size_t k = 0; k < N; ++k)
+	p[k] = c_[k].data();
+
+    return p;
+}
+
+template <typename V>
+template <std::output_iterator<V> Out>
+Out Point_cloud<V>::copy(Out out) const
+{
+    std::array<value_type, N> c;
+    for (size_t i = 0; i < size(); ++i){
+	for (size_t k = 0; k < N; ++k)
+	    c[k] = c_[k][i];
+
+	*out = Comp::make(c);
+	++out;
+    }
+
+    return out;
+}
+
+
+
+/***************************************************************************
+ *			    OPERACIONES EN BLOQUE
+ ***************************************************************************/
+/// Suma el vector d a todos los puntos.
+template <typename V>
+void translate(Point_cloud<V>& p, const V& d)
+{
+    using T = typename Point_cloud<V>::value_type;
+    using Comp = impl_of::Componentes_de<V>;
+    constexpr size_t B = impl_of::bloque_soa;
+
+    for (size_t k = 0; k < Point_cloud<V>::N; ++k){
+	T* x = p.component(k).data();
+	T dk = Comp::get(d, k);
+
+	impl_of::por_bloques(p.size(), std::array<const T*, 1>{x},
+			     std::array<T*, 1>{x},
+			     [dk](auto& a, auto& b) {
+		for (size_t i = 0; i < B; ++i)
+		    b[0][i] = a[0][i] + dk;
+	});
+    }
+}
+
+/// Multiplica todos los puntos por a.
+template <typename V>
+void scale(Point_cloud<V>& p, typename Point_cloud<V>::value_type s)
+{
+    using T = typename Point_cloud<V>::value_type;
+    constexpr size_t B = impl_of::bloque_soa;
+
+    for (size_t k = 0; k < Point_cloud<V>::N; ++k){
+	T* x = p.component(k).data();
+
+	impl_of::por_bloques(p.size(), std::array<const T*, 1>{x},
+			     std::array<T*, 1>{x},
+			     [s](auto& a, auto& b) {
+		for (size_t i = 0; i < B; ++i)
+		    b[0][i] = a[0][i] * s;
+	});
+    }
+}
+
+
+/// Gira todos los puntos el ángulo a. Las componentes tienen que ser
+/// float o double.
+template <std::floating_point T>
+void rotate(Point_cloud<Vector_xy<T>>& p, const Radian& angle)
+{
+    constexpr size_t B = impl_of::bloque_soa;
+    T c = static_cast<T>(cos(angle));
+    T s = static_cast<T>(sin(angle));
+
+    auto [x, y] = p.data();
+    impl_of::por_bloques(p.size(), std::array<const T*, 2>{x, y},
+			 std::array<T*, 2>{x, y}, [c, s](auto& a, auto& b) {
+	for (size_t i = 0; i < B; ++i){
+	    b[0][i] = c * a[0][i] - s * a[1][i];
+	    b[1][i] = s * a[0][i] + c * a[1][i];
+	}
+    });
+}
+
+/// Gira todos los puntos el giro r (en punto fijo, ver Rotation_deg).
+template <std::integral T>
+inline void rotate(Point_cloud<Vector_xy<T>>& p, const Rotation_deg& r)
+{
+    auto [x, y] = p.data();
+    rotate(x, y, p.size(), x, y, r);
+}
+
+/// Gira todos los puntos `angle` grados. Si las componentes son enteras
+/// cada punto se gira como rotate(Vector_xy, Degree), en double. Para
+/// girarlos en punto fijo usar Rotation_deg.
+template <typename T>
+void rotate(Point_cloud<Vector_xy<T>>& p, const Degree& angle)
+{
+    if constexpr (std::is_floating_point_v<T>)
+	rotate(p, Radian{angle});
+
+    else{
+	for (auto q: p)
+	    q = rotate(static_cast<Vector_xy<T>>(q), angle);
+    }
+}
+
+
+/// Multiplica todos los puntos por la matriz R (3 x 3, por filas):
+/// p = R·p. Las componentes tienen que ser float o double.
+template <std::floating_point T>
+void rotate(Point_cloud<Vector_xyz<T>>& p,
+	    const std::array<std::array<T, 3>, 3>& R)
+{
+    constexpr size_t B = impl_of::bloque_soa;
+
+    auto [x, y, z] = p.data();
+    impl_of::por_bloques(p.size(), std::array<const T*, 3>{x, y, z},
+			 std::array<T*, 3>{x, y, z}, [&R](auto& a, auto& b) {
+	for (size_t k = 0; k < 3; ++k){
+	    T r0 = R[k][0], r1 = R[k][1], r2 = R[k][2];
+	    for (size_t i = 0; i < B; ++i)
+		b[k][i] = r0 * a[0][i] + r1 * a[1][i] + r2 * a[2][i];
+	}
+    });
+}
+
+
+namespace impl_of{
+// res[i] = dot(u_i, v_i). u y v son los punteros a las componentes.
+template <typename T, size_t N>
+void dot_product(size_t n, const std::array<const T*, N>& u,
+		 const std::array<const T*, N>& v, T* res)
+{
+    constexpr size_t B = bloque_soa;
+
+    std::array<const T*, 2 * N> in;
+    for (size_t k = 0; k < N; ++k){
+	in[k]     = u[k];
+	in[N + k] = v[k];
+    }
+
+    por_bloques(n, in, std::array<T*, 1>{res}, [](auto& a, auto& b) {
+	for (size_t i = 0; i < B; ++i)
+	    b[0][i] = a[0][i] * a[N][i];
+
+	for (size_t k = 1; k < N; ++k)
+	    for (size_t i = 0; i < B; ++i)
+		b[0][i] += a[k][i] * a[N + k][i];
+    });
+}
+}// namespace impl_of
+
+/// res[i] = dot_product(u[i], v[i])
+/// Precondición: u.size() == v.size() == res.size()
+template <typename V>
+inline void dot_product(const Point_cloud<V>& u, const Point_cloud<V>& v,
+			std::span<typename Point_cloud<V>::value_type> res)
+{ impl_of::dot_product(u.size(), u.data(), v.data(), res.data()); }
+
+/// res[i] = dot_product(u[i], v)
+/// Precondición: u.size() == res.size()
+template <typename V>
+void dot_product(const Point_cloud<V>& u, const V& v,
+		 std::span<typename Point_cloud<V>::value_type> res)
+{
+    using T = typename Point_cloud<V>::value_type;
+    using Comp = impl_of::Componentes_de<V>;
+    constexpr size_t N = Point_cloud<V>::N;
+    constexpr size_t B = impl_of::bloque_soa;
+
+    std::array<T, N> c;
+    for (size_t k = 0; k < N; ++k)
+	c[k] = Comp::get(v, k);
+
+    impl_of::por_bloques(u.size(), u.data(), std::array<T*, 1>{res.data()},
+			 [&c](auto& a, auto& b) {
+	for (size_t i = 0; i < B; ++i)
+	    b[0][i] = c[0] * a[0][i];
+
+	for (size_t k = 1; k < N; ++k)
+	    for (size_t i = 0; i < B; ++i)
+		b[0][i] += c[k] * a[k][i];
+    });
+}
+
+template <typename V, typename W>
+    requires std::is_same_v<W, V> or std::is_same_v<W, Point_cloud<V>>
+std::vector<typename Point_cloud<V>::value_type>
+			    dot_product(const Point_cloud<V>& u, const W& v)
+{
+    std::vector<typename Point_cloud<V>::value_type> res(u.size());
+    dot_product(u, v, std::span{res});
+    return res;
+}
+
+
+/// res[i] = |u[i]|²
+/// Precondición: u.size() == res.size()
+template <typename V>
+inline void modulo2(const Point_cloud<V>& u,
+		    std::span<typename Point_cloud<V>::value_type> res)
+{ impl_of::dot_product(u.size(), u.data(), u.data(), res.data()); }
+
+/// res[i] = |u[i]| (en double)
+/// Precondición: u.size() == res.size()
+template <typename V>
+void modulo(const Point_cloud<V>& u, std::span<double> res)
+{
+    constexpr size_t N = Point_cloud<V>::N;
+    constexpr size_t B = impl_of::bloque_soa;
+
+    impl_of::por_bloques(u.size(), u.data(), std::array<double*, 1>{res.data()},
+			 [](auto& a, auto& b) {
+	for (size_t i = 0; i < B; ++i){
+	    double s = 0;
+	    for (size_t k = 0; k < N; ++k)
+		s += static_cast<double>(a[k][i]) * static_cast<double>(a[k][i]);
+	    b[0][i] = std::sqrt(s);
+	}
+    });
+}
+
+template <typename V>
+std::vector<double> modulo(const Point_cloud<V>& u)
+{
+    std::vector<double> res(u.size());
+    modulo(u, std::span{res});
+    return res;
+}
+
+
+/// Producto vectorial punto a punto: res[i] = u[i] x v[i].
+/// Precondición: u.size() == v.size()
+template <typename T>
+Point_cloud<Vector_xyz<T>> cross_product(const Point_cloud<Vector_xyz<T>>& u,
+				         const Point_cloud<Vector_xyz<T>>& v)
+{
+    constexpr size_t B = impl_of::bloque_soa;
+
+    Point_cloud<Vector_xyz<T>> res(u.size());
+
+    auto [ux, uy, uz] = u.data();
+    auto [vx, vy, vz] = v.data();
+    impl_of::por_bloques(u.size(),
+			 std::array<const T*, 6>{ux, uy, uz, vx, vy, vz},
+			 res.data(), [](auto& a, auto& b) {
+	for (size_t i = 0; i < B; ++i){
+	    b[0][i] = a[1][i] * a[5][i] - a[2][i] * a[4][i];
+	    b[1][i] = a[2][i] * a[3][i] - a[0][i] * a[5][i];
+	    b[2][i] = a[0][i] * a[4][i] - a[1][i] * a[3][i];
+	}
+    });
+
+    return res;
+}
+
+/// res[i] = u[i] x v.
+template <typename T>
+Point_cloud<Vector_xyz<T>> cross_product(const Point_cloud<Vector_xyz<T>>& u,
+				         const Vector_xyz<T>& v)
+{
+    constexpr size_t B = impl_of::bloque_soa;
+
+    Point_cloud<Vector_xyz<T>> res(u.size());
+
+    T vx = v.x, vy = v.y, vz = v.z;
+    impl_of::por_bloques(u.size(), u.data(), res.data(),
+			 [vx, vy, vz](auto& a, auto& b) {
+	for (size_t i = 0; i < B; ++i){
+	    b[0][i] = a[1][i] * vz - a[2][i] * vy;
+	    b[1][i] = a[2][i] * vx - a[0][i] * vz;
+	    b[2][i] = a[0][i] * vy - a[1][i] * vx;
+	}
+    });
+
+    return res;
+}
+
+
+/// Menor caja que contiene a todos los puntos: devuelve los vectores
+/// {mínimos, máximos} (componente a componente).
+/// Precondición: !p.empty()
+template <typename V>
+std::pair<V, V> bounding_box(const Point_cloud<V>& p)
+{
+    using T = typename Point_cloud<V>::value_type;
+    using Comp = impl_of::Componentes_de<V>;
+    constexpr size_t N = Point_cloud<V>::N;
+    constexpr size_t B = impl_of::bloque_soa;
+
+    std::array<T, N> min, max;
+
+    for (size_t k = 0; k < N; ++k){
+	const T* x = p.component(k).data();
+	size_t n = p.size();
+
+	// Mínimos y máximos parciales de B en B (bucle vectorizable)
+	T mn[B], mx[B];
+	std::fill_n(mn, B, x[0]);
+	std::fill_n(mx, B, x[0]);
+
+	size_t i0 = 0;
+	for (; i0 + B <= n; i0 += B){
+	    for (size_t i = 0; i < B; ++i){
+		mn[i] = std::min(mn[i], x[i0 + i]);
+		mx[i] = std::max(mx[i], x[i0 + i]);
+	    }
+	}
+
+	for (size_t i = i0; i < n; ++i){
+	    mn[i - i0] = std::min(mn[i - i0], x[i]);
+	    mx[i - i0] = std::max(mx[i - i0], x[i]);
+	}
+
+	min[k] = *std::min_element(mn, mn + B);
+	max[k] = *std::max_element(mx, mx + B);
+    }
+
+    return {Comp::make(min), Comp::make(max)};
+}
+
+
+}// namespace
+
+#endif
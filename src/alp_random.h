@@ -23,29 +23,700 @@
  *
  *   - DESCRIPCION: Funciones para generar cosas aleatorias
  *
+ *   - COMENTARIOS: std::mt19937 es lento y ocupa 5 KB de estado. Aquí
+ *	definimos dos generadores rápidos con un estado pequeño que cumplen
+ *	UniformRandomBitGenerator (se pueden usar con <random>):
+ *
+ *	+ Xoshiro256pp: xoshiro256++ (Blackman y Vigna), 64 bits. Tiene
+ *	  jump() para saltar 2^128 números: cada thread usa una subsecuencia
+ *	  que no se solapa con la de los demás.
+ *
+ *	+ Pcg32: PCG-XSH-RR (O'Neill), 32 bits. Se pueden elegir 2^63
+ *	  secuencias (streams) diferentes y avanzar n números en O(log n).
+ *
+ *	Las distribuciones (Uniform_int, Uniform_real, Normal, Exponential,
+ *	Bernoulli) tienen fill(g, span) para generar muchos números de
+ *	golpe: primero se generan los bits aleatorios en un bloque y luego
+ *	se convierten en un bucle sin saltos que el compilador vectoriza.
+ *
+ *	Para que una simulación en paralelo sea reproducible:
+ *	\code
+ *	    // El thread i usa
+ *	    auto g = alp::Xoshiro256pp::stream(semilla, i);
+ *	\endcode
+ *
  *   - HISTORIA:
  *           Manuel Perez- 07/04/2019 Escrito
+ *		 18/10/2026 Xoshiro256pp, Pcg32, distribuciones con fill.
  *
  ****************************************************************************/
 #include <random>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
 
 namespace alp{
-/// Genera un número aleatorio entre [min, max]. 
+
+namespace impl_of{
+
+// Siguiente número de splitmix64. Lo usamos para inicializar el estado de
+// los generadores a partir de una semilla de 64 bits.
+inline uint64_t splitmix64(uint64_t& x)
+{
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+}// namespace impl_of
+
+
+/// Devuelve una semilla diferente en cada llamada (también entre threads).
+/// Solo se lee std::random_device la primera vez.
+inline uint64_t random_seed()
+{
+    static const uint64_t base = []{
+	std::random_device dev;
+	return (uint64_t{dev()} << 32) | dev();
+    }();
+
+    static std::atomic<uint64_t> n{0};
+
+    uint64_t x = base + n.fetch_add(1, std::memory_order_relaxed);
+    return impl_of::splitmix64(x);
+}
+
+
+/***************************************************************************
+ *				GENERADORES
+ ***************************************************************************/
+/*!
+ *  \brief  Generador xoshiro256++.
+ *
+ *  Periodo 2^256 - 1. Genera 64 bits por llamada.
+ *
+ */
+class Xoshiro256pp{
+public:
+    using result_type = uint64_t;
+
+    static constexpr result_type min() {return 0;}
+    static constexpr result_type max()
+    {return std::numeric_limits<result_type>::max();}
+
+    /// Inicializa el estado con splitmix64(seed).
+    explicit Xoshiro256pp(uint64_t seed = 0) { this->seed(seed); }
+
+    /// Estado inicial. Precondición: no todos cero.
+    explicit Xoshiro256pp(const std::array<uint64_t, 4>& s) : s_{s} {}
+
+    /// Generador que usará el thread i: el de seed después de i saltos.
+    static Xoshiro256pp stream(uint64_t seed, size_t i)
+    {
+	Xoshiro256pp g{seed};
+	for (; i > 0; --i)
+	    g.jump();
+
+	return g;
+    }
+
+    void seed(uint64_t seed)
+    {
+	for (auto& x: s_)
+	    x = impl_of::splitmix64(seed);
+    }
+
+    result_type operator()()
+    {
+	uint64_t res = std::rotl(s_[0] + s_[3], 23) + s_[0];
+	uint64_t t = s_[1] << 17;
+
+	s_[2] ^= s_[0];
+	s_[3] ^= s_[1];
+	s_[1] ^= s_[2];
+	s_[0] ^= s_[3];
+	s_[2] ^= t;
+	s_[3] = std::rotl(s_[3], 45);
+
+	return res;
+    }
+
+    /// Rellena x con los siguientes números.
+    void fill(std::span<uint64_t> x)
+    {
+	// Copiamos el estado a variables locales para que estén en registros
+	Xoshiro256pp g = *this;
+	for (auto& y: x)
+	    y = g();
+
+	*this = g;
+    }
+
+    /// Equivale a 2^128 llamadas.
+    void jump()
+    {
+	salta({0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+	       0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull});
+    }
+
+    /// Equivale a 2^192 llamadas.
+    void long_jump()
+    {
+	salta({0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull,
+	       0x77710069854EE241ull, 0x39109BB02ACBE635ull});
+    }
+
+    const std::array<uint64_t, 4>& state() const {return s_;}
+
+    friend bool operator==(const Xoshiro256pp&, const Xoshiro256pp&) = default;
+
+private:
+    std::array<uint64_t, 4> s_;
+
+    // Multiplica el estado por el polinomio de salto p
+    void salta(const std::array<uint64_t, 4>& p)
+    {
+	std::array<uint64_t, 4> s{};
+	for (uint64_t w: p)
+	    for (int b = 0; b < 64; ++b){
+		if (w & (uint64_t{1} << b))
+		    for (int i = 0; i < 4; ++i)
+			s[i] ^= s_[i];
+
+		(*this)();
+	    }
+
+	s_ = s;
+    }
+};
+
+
+
+/*!
+ *  \brief  Generador PCG32 (PCG-XSH-RR 64/32).
+ *
+ *  Periodo 2^64 por secuencia. Genera 32 bits por llamada.
+ *
+ */
+class Pcg32{
+public:
+    using result_type = uint32_t;
+
+    static constexpr result_type min() {return 0;}
+    static constexpr result_type max()
+    {return std::numeric_limits<result_type>::max();}
+
+    /// seq elige la secuencia: con distinto seq las secuencias son
+    /// independientes aunque la semilla sea la misma.
+    explicit Pcg32(uint64_t seed = 0x853C49E6748FEA9Bull,
+		   uint64_t seq  = 0xDA3E39CB94B95BDBull)
+    { this->seed(seed, seq); }
+
+    /// Generador que usará el thread i: secuencia i.
+    static Pcg32 stream(uint64_t seed, size_t i) {return Pcg32{seed, i};}
+
+    void seed(uint64_t seed, uint64_t seq = 0xDA3E39CB94B95BDBull)
+    {
+	state_ = 0;
+	inc_   = (seq << 1) | 1;
+	(*this)();
+	state_ += seed;
+	(*this)();
+    }
+
+    result_type operator()()
+    {
+	uint64_t old = state_;
+	state_ = old * mult + inc_;
+
+	auto x = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+	auto rot = static_cast<int>(old >> 59);
+
+	return std::rotr(x, rot);
+    }
+
+    void fill(std::span<uint32_t> x)
+    {
+	Pcg32 g = *this;
+	for (auto& y: x)
+	    y = g();
+
+	*this = g;
+    }
+
+    /// Equivale a n llamadas. Coste O(log n).
+    void advance(uint64_t n)
+    {
+	uint64_t mult_acc = 1;
+	uint64_t inc_acc  = 0;
+	uint64_t m = mult;
+	uint64_t c = inc_;
+
+	for (; n > 0; n /= 2){
+	    if (n & 1){
+		mult_acc *= m;
+		inc_acc = inc_acc * m + c;
+	    }
+
+	    c = (m + 1) * c;
+	    m *= m;
+	}
+
+	state_ = mult_acc * state_ + inc_acc;
+    }
+
+    void discard(uint64_t n) {advance(n);}
+
+    friend bool operator==(const Pcg32&, const Pcg32&) = default;
+
+private:
+    static constexpr uint64_t mult = 6364136223846793005ull;
+
+    uint64_t state_;
+    uint64_t inc_;
+};
+
+
+
+/***************************************************************************
+ *			    DISTRIBUCIONES
+ ***************************************************************************/
+namespace impl_of{
+
+// Los fill generan los bits en bloques de este tamaño
+inline constexpr size_t bloque_random = 256;
+
+// 64 bits aleatorios
+template <typename G>
+inline uint64_t bits64(G& g)
+{
+    static_assert(G::min() == 0);
+
+    if constexpr (G::max() >= std::numeric_limits<uint64_t>::max())
+	return static_cast<uint64_t>(g());
+    else {
+	static_assert(G::max() == std::numeric_limits<uint32_t>::max(),
+		      "Generador no soportado");
+
+	uint64_t a = g();
+	return (a << 32) | static_cast<uint32_t>(g());
+    }
+}
+
+// Rellena x con bits aleatorios
+template <typename G>
+void bits64(G& g, std::span<uint64_t> x)
+{
+    if constexpr (requires (std::span<uint64_t> y) {g.fill(y);})
+	g.fill(x);
+
+    else if constexpr (requires (std::span<uint32_t> y) {g.fill(y);}){
+	std::array<uint32_t, 2 * bloque_random> a;
+	for (size_t i = 0; i < x.size(); i += bloque_random){
+	    size_t n = std::min(bloque_random, x.size() - i);
+	    g.fill(std::span{a.data(), 2 * n});
+	    std::memcpy(x.data() + i, a.data(), n * sizeof(uint64_t));
+	}
+    }
+
+    else
+	for (auto& y: x)
+	    y = bits64(g);
+}
+
+
+// Convierte bits aleatorios en un número en [0, 1): ponemos los bits altos
+// en la mantisa de un número en [1, 2) y restamos 1. Solo usa operaciones
+// de enteros y una resta: se vectoriza.
+template <std::floating_point Real>
+inline Real uniforme01(uint64_t x)
+{
+    if constexpr (sizeof(Real) == sizeof(uint64_t))
+	return std::bit_cast<Real>((x >> 12) | 0x3FF0000000000000ull) - Real{1};
+    else
+	return std::bit_cast<Real>(static_cast<uint32_t>(x >> 41) |
+					0x3F800000u) - Real{1};
+}
+
+// Para usar en log: (0, 1]
+template <std::floating_point Real>
+inline Real uniforme01_abierto(uint64_t x)
+{ return Real{1} - uniforme01<Real>(x); }
+
+}// namespace impl_of
+
+
+/*!
+ *  \brief  Enteros uniformemente distribuidos en [a, b].
+ *
+ *  Usa el método de Lemire (una multiplicación, sin divisiones salvo en
+ *  los casos que hay que rechazar). No tiene sesgo. A diferencia de
+ *  std::uniform_int_distribution admite cualquier tipo entero (uint8_t,
+ *  char...).
+ *
+ */
+template <std::integral Int>
+class Uniform_int{
+public:
+    using result_type = Int;
+
+    /// Precondición: a <= b
+    Uniform_int(Int a, Int b) : a_{a}, b_{b}
+    {
+	if (b < a)
+	    throw std::invalid_argument{"Uniform_int: b < a"};
+
+	// rango_ = b - a (sin desbordamiento)
+	rango_ = static_cast<uint64_t>(static_cast<U>(b) - static_cast<U>(a));
+
+	if (rango_ < 0xFFFFFFFFull){
+	    auto r = static_cast<uint32_t>(rango_ + 1);
+	    umbral_ = static_cast<uint32_t>(-r) % r;
+	}
+    }
+
+    Int a() const {return a_;}
+    Int b() const {return b_;}
+
+    template <typename G>
+    Int operator()(G& g) const
+    {
+	if (rango_ < 0xFFFFFFFFull)
+	    return suma(genera32(g));
+
+	return suma(genera64(g));
+    }
+
+    template <typename G>
+    void fill(G& g, std::span<Int> x) const;
+
+private:
+    using U = std::make_unsigned_t<Int>;
+
+    Int a_;
+    Int b_;
+    uint64_t rango_;	    // b - a
+    uint32_t umbral_ = 0;   // 2^32 mod (b - a + 1)
+
+    Int suma(uint64_t d) const
+    { return static_cast<Int>(static_cast<U>(static_cast<U>(a_) + d)); }
+
+    // Rango de 32 bits (Lemire)
+    template <typename G>
+    uint64_t genera32(G& g) const
+    {
+	auto r = static_cast<uint32_t>(rango_ + 1);
+	uint64_t m = (impl_of::bits64(g) >> 32) * r;
+
+	while (static_cast<uint32_t>(m) < umbral_)
+	    m = (impl_of::bits64(g) >> 32) * r;
+
+	return m >> 32;
+    }
+
+    // Rango de más de 32 bits
+    template <typename G>
+    uint64_t genera64(G& g) const
+    {
+	uint64_t x = impl_of::bits64(g);
+	if (rango_ == std::numeric_limits<uint64_t>::max())
+	    return x;
+
+	uint64_t r = rango_ + 1;
+	uint64_t umbral = -r % r;
+
+	unsigned __int128 m = static_cast<unsigned __int128>(x) * r;
+	while (static_cast<uint64_t>(m) < umbral){
+	    x = impl_of::bits64(g);
+	    m = static_cast<unsigned __int128>(x) * r;
+	}
+
+	return static_cast<uint64_t>(m >> 64);
+    }
+};
+
+
+template <std::integral Int>
+template <typename G>
+void Uniform_int<Int>::fill(G& g, std::span<Int> x) const
+{
+    if (rango_ >= 0xFFFFFFFFull){
+	for (auto& y: x)
+	    y = suma(genera64(g));
+
+	return;
+    }
+
+    // Cada número de 64 bits da dos de 32 bits
+    constexpr size_t N = impl_of::bloque_random;
+    std::array<uint64_t, N> b;
+    std::array<uint32_t, 2 * N> a;
+
+    auto r = static_cast<uint32_t>(rango_ + 1);
+
+    for (size_t i = 0; i < x.size(); i += 2 * N){
+	size_t n = std::min(2 * N, x.size() - i);
+	impl_of::bits64(g, std::span{b.data(), (n + 1) / 2});
+	std::memcpy(a.data(), b.data(), n * sizeof(uint32_t));
+
+	Int* y = x.data() + i;
+	uint32_t rechazar = 0;
+	for (size_t j = 0; j < n; ++j){
+	    uint64_t m = uint64_t{a[j]} * r;
+	    y[j] = suma(m >> 32);
+	    rechazar |= (static_cast<uint32_t>(m) < umbral_);
+	}
+
+	// Muy poco probable: los que caen en la zona con sesgo se repiten
+	if (rechazar)
+	    for (size_t j = 0; j < n; ++j)
+		if (static_cast<uint32_t>(uint64_t{a[j]} * r) < umbral_)
+		    y[j] = suma(genera32(g));
+    }
+}
+
+
+/*!
+ *  \brief  Números reales uniformemente distribuidos en [a, b).
+ *
+ *  Con double se usan 52 bits aleatorios; con float 23.
+ *
+ */
+template <std::floating_point Real = double>
+class Uniform_real{
+public:
+    using result_type = Real;
+
+    Uniform_real(Real a = 0, Real b = 1) : a_{a}, d_{b - a} {}
+
+    Real a() const {return a_;}
+    Real b() const {return a_ + d_;}
+
+    template <typename G>
+    Real operator()(G& g) const
+    { return a_ + d_ * impl_of::uniforme01<Real>(impl_of::bits64(g)); }
+
+    template <typename G>
+    void fill(G& g, std::span<Real> x) const
+    {
+	constexpr size_t N = impl_of::bloque_random;
+	std::array<uint64_t, N> b;
+
+	for (size_t i = 0; i < x.size(); i += N){
+	    size_t n = std::min(N, x.size() - i);
+	    impl_of::bits64(g, std::span{b.data(), n});
+
+	    Real* y = x.data() + i;
+	    for (size_t j = 0; j < n; ++j)
+		y[j] = a_ + d_ * impl_of::uniforme01<Real>(b[j]);
+	}
+    }
+
+private:
+    Real a_;
+    Real d_;	// b - a
+};
+
+
+/*!
+ *  \brief  Distribución normal N(media, sigma).
+ *
+ *  Usa Box-Muller: cada dos números uniformes dan dos normales. El segundo
+ *  se guarda para la siguiente llamada, por eso operator() no es const.
+ *
+ */
+template <std::floating_point Real = double>
+class Normal{
+public:
+    using result_type = Real;
+
+    Normal(Real media = 0, Real sigma = 1) : media_{media}, sigma_{sigma} {}
+
+    Real mean() const {return media_;}
+    Real stddev() const {return sigma_;}
+
+    template <typename G>
+    Real operator()(G& g)
+    {
+	if (hay_siguiente_){
+	    hay_siguiente_ = false;
+	    return siguiente_;
+	}
+
+	auto [z0, z1] = box_muller(impl_of::bits64(g), impl_of::bits64(g));
+	siguiente_ = z1;
+	hay_siguiente_ = true;
+
+	return z0;
+    }
+
+    template <typename G>
+    void fill(G& g, std::span<Real> x) const
+    {
+	constexpr size_t N = impl_of::bloque_random;
+	std::array<uint64_t, N> b;
+
+	for (size_t i = 0; i < x.size(); i += N){
+	    size_t n = std::min(N, x.size() - i);
+	    impl_of::bits64(g, std::span{b.data(), n + n % 2});
+
+	    Real* y = x.data() + i;
+	    for (size_t j = 0; j + 1 < n; j += 2){
+		auto [z0, z1] = box_muller(b[j], b[j + 1]);
+		y[j]     = z0;
+		y[j + 1] = z1;
+	    }
+
+	    if (n % 2)
+		y[n - 1] = box_muller(b[n - 1], b[n]).first;
+	}
+    }
+
+private:
+    Real media_;
+    Real sigma_;
+
+    Real siguiente_{};
+    bool hay_siguiente_ = false;
+
+    std::pair<Real, Real> box_muller(uint64_t x, uint64_t y) const
+    {
+	Real r = sigma_ * std::sqrt(Real{-2} *
+			    std::log(impl_of::uniforme01_abierto<Real>(x)));
+	Real a = 2 * std::numbers::pi_v<Real> * impl_of::uniforme01<Real>(y);
+
+	return {media_ + r * std::cos(a), media_ + r * std::sin(a)};
+    }
+};
+
+
+/*!
+ *  \brief  Distribución exponencial de parámetro lambda (media 1/lambda).
+ *
+ */
+template <std::floating_point Real = double>
+class Exponential{
+public:
+    using result_type = Real;
+
+    /// Precondición: lambda > 0
+    explicit Exponential(Real lambda = 1) : lambda_{lambda} {}
+
+    Real lambda() const {return lambda_;}
+
+    template <typename G>
+    Real operator()(G& g) const
+    { return transforma(impl_of::bits64(g)); }
+
+    template <typename G>
+    void fill(G& g, std::span<Real> x) const
+    {
+	constexpr size_t N = impl_of::bloque_random;
+	std::array<uint64_t, N> b;
+
+	for (size_t i = 0; i < x.size(); i += N){
+	    size_t n = std::min(N, x.size() - i);
+	    impl_of::bits64(g, std::span{b.data(), n});
+
+	    Real* y = x.data() + i;
+	    for (size_t j = 0; j < n; ++j)
+		y[j] = transforma(b[j]);
+	}
+    }
+
+private:
+    Real lambda_;
+
+    Real transforma(uint64_t x) const
+    { return -std::log(impl_of::uniforme01_abierto<Real>(x)) / lambda_; }
+};
+
+
+/*!
+ *  \brief  Devuelve true con probabilidad p.
+ *
+ *  Compara directamente los 64 bits aleatorios con p * 2^64.
+ *
+ */
+class Bernoulli{
+public:
+    using result_type = bool;
+
+    /// Precondición: 0 <= p <= 1
+    explicit Bernoulli(double p = 0.5) : p_{p}
+    {
+	if (!(0 <= p and p <= 1))
+	    throw std::invalid_argument{"Bernoulli: p tiene que estar en [0, 1]"};
+
+	siempre_ = (p == 1);
+	umbral_ = siempre_? 0 : static_cast<uint64_t>(std::ldexp(p, 64));
+    }
+
+    double p() const {return p_;}
+
+    template <typename G>
+    bool operator()(G& g) const
+    { return siempre_ or impl_of::bits64(g) < umbral_; }
+
+    template <typename G>
+    void fill(G& g, std::span<bool> x) const
+    {
+	constexpr size_t N = impl_of::bloque_random;
+	std::array<uint64_t, N> b;
+
+	for (size_t i = 0; i < x.size(); i += N){
+	    size_t n = std::min(N, x.size() - i);
+	    impl_of::bits64(g, std::span{b.data(), n});
+
+	    bool* y = x.data() + i;
+	    for (size_t j = 0; j < n; ++j)
+		y[j] = siempre_ | (b[j] < umbral_);
+	}
+    }
+
+private:
+    double p_;
+    uint64_t umbral_;
+    bool siempre_;
+};
+
+
+
+/***************************************************************************
+ *			    Random_number
+ ***************************************************************************/
+/// Genera un número aleatorio entre [min, max].
 /// Distribución uniforme.
 template <typename Int>
 class Random_number{
 public:
     Random_number(Int min, Int max)
-	: gen{dev()}, num{min, max}
-    {
-    }
-    
+	: Random_number{min, max, random_seed()}
+    { }
+
+    /// Con la misma semilla genera siempre la misma secuencia.
+    Random_number(Int min, Int max, uint64_t seed)
+	: gen{seed}, num{min, max}
+    { }
+
     Int operator()() {return num(gen);}
 
+    /// Rellena x con números aleatorios.
+    void fill(std::span<Int> x) {num.fill(gen, x);}
+
 private:
-    std::random_device dev;
-    std::mt19937 gen;
-    std::uniform_int_distribution<Int> num;
+    Xoshiro256pp gen;
+    Uniform_int<Int> num;
 };
 
 
@@ -0,0 +1,521 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_REGION_IJ_H__
+#define __ALP_REGION_IJ_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Regiones (conjuntos de pixels cualesquiera) en coordenadas
+ *	(i, j).
+ *
+ *  - COMENTARIOS: Range_ij solo puede representar rectángulos. Region_ij
+ *	representa cualquier conjunto de pixels como una lista de tramos
+ *	horizontales (run-length): [j0, je) de la fila i.
+ *
+ *	Los tramos se guardan ordenados por (i, j0), sin solaparse y sin
+ *	tocarse (dos tramos de la misma fila siempre tienen un hueco entre
+ *	ellos). Así cada región tiene una única representación y las
+ *	operaciones de conjuntos (unión, intersección, diferencia) se hacen
+ *	recorriendo a la vez los tramos de las dos regiones, sin mirar los
+ *	pixels uno a uno.
+ *
+ *	La memoria y el tiempo son proporcionales al número de tramos y no al
+ *	área: una máscara de una región pequeña dentro de una imagen grande
+ *	ocupa muy poco.
+ *
+ *	Ejemplo:
+ *	\code
+ *	    Region_ij<int> r = Region_ij<int>::from_mask(m);
+ *	    r &= Region_ij<int>{Range_ij<int>{10, 20, 0, 50}};
+ *	    fill(img, r, 255);	// pinta solo los pixels de r
+ *	\endcode
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    19/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "alp_rframe_ij.h"
+
+namespace alp{
+
+/// Tramo [j0, je) de la fila i.
+template <typename Int>
+struct Run_ij{
+    Int i;
+    Int j0, je;
+
+    constexpr Int size() const {return je - j0;}
+
+    friend constexpr bool operator==(const Run_ij&, const Run_ij&) = default;
+};
+
+
+template <typename Int>
+inline std::ostream& operator<<(std::ostream& out, const Run_ij<Int>& r)
+{ return out << r.i << ": [" << r.j0 << ", " << r.je << ')'; }
+
+
+
+
+/*!
+ *  \brief  Conjunto de pixels representado como tramos horizontales.
+ *
+ */
+template <std::signed_integral Int = int>
+class Region_ij{
+public:
+// Types
+    using Ind		 = Int;
+    using Position	 = Vector_ij<Int>;
+    using Range2D	 = Range_ij<Int>;
+    using Run		 = Run_ij<Int>;
+    using const_iterator = typename std::vector<Run>::const_iterator;
+
+// Constructors
+    /// Región vacía.
+    Region_ij() = default;
+
+    /// Región formada por los pixels del rango r.
+    explicit Region_ij(const Range2D& r);
+
+    /// Región formada por la unión de los tramos indicados (pueden estar
+    /// desordenados y solaparse).
+    static Region_ij from_runs(std::vector<Run> runs);
+
+    /// Región formada por los pixels (i, j) de m que cumplen pred(m(i, j)).
+    template <typename M, typename Pred>
+    static Region_ij from_mask(const M& m, Pred pred);
+
+    /// Región formada por los pixels de m diferentes de 0 (T{}).
+    template <typename M>
+    static Region_ij from_mask(const M& m);
+
+
+// Info
+    bool empty() const {return run_.empty();}
+
+    /// Número de tramos.
+    size_t num_runs() const {return run_.size();}
+
+    /// Número de pixels de la región.
+    size_t area() const;
+
+    /// Menor rango que contiene la región.
+    Range2D bounding_box() const;
+
+    /// ¿Pertenece el pixel p a la región?
+    bool contains(const Position& p) const;
+
+// Tramos
+    const std::vector<Run>& runs() const {return run_;}
+
+    const_iterator begin() const {return run_.begin();}
+    const_iterator end() const {return run_.end();}
+
+// Operations
+    Region_ij& operator|=(const Region_ij& b);	// unión
+    Region_ij& operator&=(const Region_ij& b);	// intersección
+    Region_ij& operator-=(const Region_ij& b);	// diferencia
+
+    /// Desplaza la región el vector v.
+    Region_ij& translate(const Position& v);
+
+    friend bool operator==(const Region_ij&, const Region_ij&) = default;
+
+private:
+    std::vector<Run> run_;
+
+    // Combina las regiones a y b: un pixel está en el resultado si
+    // op(está en a, está en b).
+    template <typename Op>
+    static Region_ij combina(const Region_ij& a, const Region_ij& b, Op op);
+
+    // Añade a res los tramos de la fila de [a0, ae) op [b0, be)
+    template <typename Op>
+    static void combina_fila(const Run* a0, const Run* ae,
+			     const Run* b0, const Run* be, Op op,
+			     std::vector<Run>& res);
+
+    // Añade el tramo [j0, je) de la fila i uniéndolo con el último si se
+    // tocan. Los tramos tienen que añadirse ordenados.
+    static void push_back(std::vector<Run>& v, Int i, Int j0, Int je);
+};
+
+
+template <std::signed_integral Int>
+inline void Region_ij<Int>::push_back(std::vector<Run>& v, Int i,
+							Int j0, Int je)
+{
+    if (!v.empty() and v.back().i == i and v.back().je >= j0)
+	v.back().je = std::max(v.back().je, je);
+    else
+	v.push_back(Run{i, j0, je});
+}
+
+
+template <std::signed_integral Int>
+Region_ij<Int>::Region_ij(const Range2D& r)
+{
+    if (r.empty())
+	return;
+
+    run_.reserve(r.rows());
+    for (Int i = r.i0; i < r.ie; ++i)
+	run_.push_back(Run{i, r.j0, r.je});
+}
+
+
+template <std::signed_integral Int>
+Region_ij<Int> Region_ij<Int>::from_runs(std::vector<Run> runs)
+{
+    std::sort(runs.begin(), runs.end(), [](const Run& a, const Run& b)
+	{ return (a.i < b.i) or (a.i == b.i and a.j0 < b.j0); });
+
+    Region_ij res;
+    res.run_.reserve(runs.size());
+
+    for (const Run& r: runs)
+	if (r.j0 < r.je)
+	    push_back(res.run_, r.i, r.j0, r.je);
+
+    return res;
+}
+
+
+template <std::signed_integral Int>
+template <typename M, typename Pred>
+Region_ij<Int> Region_ij<Int>::from_mask(const M& m, Pred pred)
+{
+    Region_ij res;
+
+    Int rows = static_cast<Int>(m.rows());
+    Int cols = static_cast<Int>(m.cols());
+
+    for (Int i = 0; i < rows; ++i){
+	if (cols == 0)
+	    break;
+
+	// Las filas de Matrix, Matrix_view y Submatrix son contiguas
+	auto p = &m(i, 0);
+	Int j = 0;
+	while (j < cols){
+	    while (j < cols and !pred(p[j]))
+		++j;
+
+	    Int j0 = j;
+	    while (j < cols and pred(p[j]))
+		++j;
+
+	    if (j0 < j)
+		res.run_.push_back(Run{i, j0, j});
+	}
+    }
+
+    return res;
+}
+
+
+template <std::signed_integral Int>
+template <typename M>
+inline Region_ij<Int> Region_ij<Int>::from_mask(const M& m)
+{
+    using T = std::remove_cvref_t<decltype(m(0, 0))>;
+    return from_mask(m, [](const T& x) { return x != T{}; });
+}
+
+
+template <std::signed_integral Int>
+size_t Region_ij<Int>::area() const
+{
+    size_t res = 0;
+    for (const Run& r: run_)
+	res += static_cast<size_t>(r.je - r.j0);
+
+    return res;
+}
+
+
+template <std::signed_integral Int>
+Range_ij<Int> Region_ij<Int>::bounding_box() const
+{
+    if (run_.empty())
+	return Range2D{};
+
+    Int j0 = std::numeric_limits<Int>::max();
+    Int je = std::numeric_limits<Int>::lowest();
+    for (const Run& r: run_){
+	j0 = std::min(j0, r.j0);
+	je = std::max(je, r.je);
+    }
+
+    return Range2D{run_.front().i, static_cast<Int>(run_.back().i + 1), j0, je};
+}
+
+
+template <std::signed_integral Int>
+bool Region_ij<Int>::contains(const Position& p) const
+{
+    // Primer tramo que está después de p
+    auto q = std::upper_bound(run_.begin(), run_.end(), p,
+	    [](const Position& p, const Run& r)
+	    { return (p.i < r.i) or (p.i == r.i and p.j < r.j0); });
+
+    if (q == run_.begin())
+	return false;
+
+    --q;
+    return q->i == p.i and p.j < q->je;
+}
+
+
+template <std::signed_integral Int>
+Region_ij<Int>& Region_ij<Int>::translate(const Position& v)
+{
+    for (Run& r: run_){
+	r.i  += v.i;
+	r.j0 += v.j;
+	r.je += v.j;
+    }
+
+    return *this;
+}
+
+
+template <std::signed_integral Int>
+template <typename Op>
+void Region_ij<Int>::combina_fila(const Run* a, const Run* ae,
+				  const Run* b, const Run* be, Op op,
+				  std::vector<Run>& res)
+{
+    // Recorremos de izquierda a derecha los extremos de los tramos de a y
+    // de b. Entre dos extremos consecutivos el pixel está o no en a y en b.
+    constexpr Int inf = std::numeric_limits<Int>::max();
+
+    Int i = (a != ae)? a->i: b->i;
+    bool en_a = false, en_b = false, en_res = false;
+    Int j0 = 0;
+
+    while (true){
+	Int xa = (a == ae)? inf: (en_a? a->je: a->j0);
+	Int xb = (b == be)? inf: (en_b? b->je: b->j0);
+	Int x = std::min(xa, xb);
+
+	if (x == inf)
+	    break;
+
+	if (xa == x){
+	    if (en_a) ++a;
+	    en_a = !en_a;
+	}
+
+	if (xb == x){
+	    if (en_b) ++b;
+	    en_b = !en_b;
+	}
+
+	bool r = op(en_a, en_b);
+	if (r != en_res){
+	    if (r)
+		j0 = x;
+	    else
+		res.push_back(Run{i, j0, x});
+
+	    en_res = r;
+	}
+    }
+}
+
+
+template <std::signed_integral Int>
+template <typename Op>
+Region_ij<Int> Region_ij<Int>::combina(const Region_ij& ra,
+				       const Region_ij& rb, Op op)
+{
+    Region_ij res;
+    res.run_.reserve(ra.run_.size() + rb.run_.size());
+
+    const Run* a  = ra.run_.data();
+    const Run* ae = a + ra.run_.size();
+    const Run* b  = rb.run_.data();
+    const Run* be = b + rb.run_.size();
+
+    auto fin_de_fila = [](const Run* p, const Run* pe) {
+	Int i = p->i;
+	while (p != pe and p->i == i)
+	    ++p;
+	return p;
+    };
+
+    while (a != ae or b != be){
+	// Filas que solo están en una de las dos regiones
+	if (b == be or (a != ae and a->i < b->i)){
+	    const Run* a1 = fin_de_fila(a, ae);
+	    if (op(true, false))
+		res.run_.insert(res.run_.end(), a, a1);
+	    a = a1;
+	}
+	else if (a == ae or b->i < a->i){
+	    const Run* b1 = fin_de_fila(b, be);
+	    if (op(false, true))
+		res.run_.insert(res.run_.end(), b, b1);
+	    b = b1;
+	}
+
+	else {
+	    const Run* a1 = fin_de_fila(a, ae);
+	    const Run* b1 = fin_de_fila(b, be);
+	    combina_fila(a, a1, b, b1, op, res.run_);
+	    a = a1;
+	    b = b1;
+	}
+    }
+
+    return res;
+}
+
+
+template <std::signed_integral Int>
+inline Region_ij<Int>& Region_ij<Int>::operator|=(const Region_ij& b)
+{
+    *this = combina(*this, b, [](bool x, bool y) {return x or y;});
+    return *this;
+}
+
+
+template <std::signed_integral Int>
+inline Region_ij<Int>& Region_ij<Int>::operator&=(const Region_ij& b)
+{
+    *this = combina(*this, b, [](bool x, bool y) {return x and y;});
+    return *this;
+}
+
+
+template <std::signed_integral Int>
+inline Region_ij<Int>& Region_ij<Int>::operator-=(const Region_ij& b)
+{
+    *this = combina(*this, b, [](bool x, bool y) {return x and !y;});
+    return *this;
+}
+
+
+template <typename Int>
+inline Region_ij<Int> operator|(Region_ij<Int> a, const Region_ij<Int>& b)
+{ return a |= b; }
+
+template <typename Int>
+inline Region_ij<Int> operator&(Region_ij<Int> a, const Region_ij<Int>& b)
+{ return a &= b; }
+
+template <typename Int>
+inline Region_ij<Int> operator-(Region_ij<Int> a, const Region_ij<Int>& b)
+{ return a -= b; }
+
+
+template <typename Int>
+std::ostream& operator<<(std::ostream& out, const Region_ij<Int>& r)
+{
+    out << '{';
+    for (const auto& t: r)
+	out << ' ' << t;
+
+    return out << " }";
+}
+
+
+
+
+/***************************************************************************
+ *			    REGIONES Y MATRICES
+ ***************************************************************************/
+/// Llama a f(i, j0, je) por cada tramo de r dentro de clip.
+template <typename Int, typename F>
+void for_each_run(const Region_ij<Int>& r, const Range_ij<Int>& clip, F f)
+{
+    // Saltamos directamente a la primera fila de clip
+    auto p = std::lower_bound(r.begin(), r.end(), clip.i0,
+		    [](const Run_ij<Int>& t, Int i) { return t.i < i; });
+
+    for (; p != r.end() and p->i < clip.ie; ++p){
+	Int j0 = std::max(p->j0, clip.j0);
+	Int je = std::min(p->je, clip.je);
+
+	if (j0 < je)
+	    f(p->i, j0, je);
+    }
+}
+
+
+namespace impl_of{
+template <typename Int, typename M>
+inline Range_ij<Int> clip_region(const M& m)
+{ return Range_ij<Int>{0, static_cast<Int>(m.rows()),
+		       0, static_cast<Int>(m.cols())}; }
+}// namespace impl_of
+
+
+/// Llama a f(x) por cada pixel x de m que está en la región r.
+/// Los pixels que quedan fuera de m se ignoran.
+template <typename M, typename Int, typename F>
+void for_each(M& m, const Region_ij<Int>& r, F f)
+{
+    using Ind = typename M::Ind;
+
+    for_each_run(r, impl_of::clip_region<Int>(m), [&](Int i, Int j0, Int je){
+	auto p = &m(static_cast<Ind>(i), static_cast<Ind>(j0));
+	for (auto pe = p + (je - j0); p != pe; ++p)
+	    f(*p);
+    });
+}
+
+
+/// Da el valor v a los pixels de m que están en la región r.
+template <typename M, typename Int, typename T>
+void fill(M& m, const Region_ij<Int>& r, const T& v)
+{
+    using Ind = typename M::Ind;
+
+    for_each_run(r, impl_of::clip_region<Int>(m), [&](Int i, Int j0, Int je){
+	auto p = &m(static_cast<Ind>(i), static_cast<Ind>(j0));
+	std::fill(p, p + (je - j0), v);
+    });
+}
+
+
+/// Convierte la región r en una máscara: los pixels de m que están en r
+/// valen dentro y el resto fuera.
+template <typename M, typename Int, typename T>
+void to_mask(const Region_ij<Int>& r, M& m, const T& dentro, const T& fuera)
+{
+    std::fill(m.begin(), m.end(), fuera);
+    fill(m, r, dentro);
+}
+
+
+}// namespace
+
+#endif
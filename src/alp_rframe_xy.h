@@ -57,10 +57,15 @@
  *	14/10/2017 Reescrito
  *	22/02/2019 Generalizo Rectangulo y notación.
  *	31/07/2020 Reestructurado. 
+ *	19/10/2026 Giros de un número entero de grados (Rotation_deg).
  *
  ****************************************************************************/
 
 #include <iostream>
+#include <array>
+#include <cstdint>
+#include <numbers>
+#include <type_traits>
 
 
 #include "alp_math.h"	// Radian/Degree
@@ -224,12 +229,167 @@ Vector_xy<Int> rotate(const Vector_xy<Int>& v, const Radian& angle)
     return res;
 }
 
+
+
+/***************************************************************************
+ *		    GIROS DE UN NÚMERO ENTERO DE GRADOS
+ ***************************************************************************/
+// Cuando los vectores son enteros y el ángulo un número entero de grados no
+// hace falta calcular sin/cos en double para cada vector: se sacan de una
+// tabla generada en tiempo de compilación y el giro se hace en punto fijo.
+namespace impl_of{
+// Número de bits de la parte fraccionaria de las tablas: sin/cos en Q16.
+inline constexpr int rotacion_bits = 16;
+
+// sin(x) con x en [0, pi/2], por la serie de Taylor (solo en compilación)
+constexpr long double sin_taylor(long double x)
+{
+    long double res = 0;
+    long double t   = x;
+    for (int n = 1; n < 40; n += 2){
+	res += t;
+	t *= -x * x / ((n + 1) * (n + 2));
+    }
+
+    return res;
+}
+
+// sin(g) para g = 0, 1, ..., 359 grados en Q16. Calculamos solo el primer
+// cuadrante y el resto por simetría, para que 0, 90, 180 y 270 sean exactos.
+constexpr std::array<int32_t, 360> genera_tabla_sin()
+{
+    std::array<int32_t, 360> t{};
+    constexpr long double uno = 1L << rotacion_bits;
+
+    for (int g = 0; g <= 90; ++g){
+	long double s = sin_taylor(g * std::numbers::pi_v<long double> / 180);
+	t[g] = static_cast<int32_t>(s * uno + 0.5L);
+    }
+
+    for (int g = 91; g < 180; ++g)
+	t[g] = t[180 - g];
+
+    for (int g = 180; g < 360; ++g)
+	t[g] = -t[g - 180];
+
+    return t;
+}
+
+inline constexpr std::array<int32_t, 360> tabla_sin = genera_tabla_sin();
+
+// Redondea x / 2^rotacion_bits al entero más próximo (los .5 se alejan del
+// 0, como std::round).
+constexpr int64_t redondea_q16(int64_t x)
+{
+    constexpr int64_t medio = int64_t{1} << (rotacion_bits - 1);
+    return (x >= 0)?  ((x + medio) >> rotacion_bits)
+		   : -((-x + medio) >> rotacion_bits);
+}
+
+}// namespace impl_of
+
+/// Reduce g grados a [0, 360).
+inline constexpr int normalize_degree(int g)
+{
+    g %= 360;
+    return (g < 0)? g + 360: g;
+}
+
+/// sin(g) en punto fijo Q16 (65536 = 1), con g en grados.
+inline constexpr int32_t sin_q16(int g)
+{ return impl_of::tabla_sin[normalize_degree(g)]; }
+
+/// cos(g) en punto fijo Q16 (65536 = 1), con g en grados.
+inline constexpr int32_t cos_q16(int g)
+{ return impl_of::tabla_sin[normalize_degree(g + 90)]; }
+
+
+/*!
+ *  \brief  Giro de un número entero de grados de vectores enteros.
+ *
+ *  El sin/cos se buscan una única vez en la tabla al construir el giro. Cada
+ *  giro son 4 multiplicaciones enteras de 64 bits, redondeando al entero
+ *  más próximo. El error respecto al giro exacto es menor que
+ *  0.5 + (|x| + |y|)/2^17.
+ *
+ *  Como el resultado puede diferir en 1 del giro en double, rotate(v, Degree)
+ *  no lo usa: hay que pedirlo explícitamente.
+ *
+ *  Ejemplo:
+ *  \code
+ *	alp::Rotation_deg r{30};
+ *	for (auto& p: puntos)
+ *	    p = r(p);
+ *  \endcode
+ */
+class Rotation_deg{
+public:
+    constexpr explicit Rotation_deg(int grados)
+	: sin_{alp::sin_q16(grados)}, cos_{alp::cos_q16(grados)} { }
+
+    constexpr int32_t sin_q16() const {return sin_;}
+    constexpr int32_t cos_q16() const {return cos_;}
+
+    /// Gira el vector v.
+    template <typename Int>
+	requires std::is_integral_v<Int>
+    constexpr Vector_xy<Int> operator()(const Vector_xy<Int>& v) const
+    {
+	int64_t x = v.x;
+	int64_t y = v.y;
+
+	return Vector_xy<Int>{
+		static_cast<Int>(impl_of::redondea_q16(x * cos_ - y * sin_)),
+		static_cast<Int>(impl_of::redondea_q16(x * sin_ + y * cos_))};
+    }
+
+private:
+    int64_t sin_;
+    int64_t cos_;
+};
+
+
+/// Gira los vectores [p0, pe) el mismo giro r, escribiendo el resultado en
+/// out (puede ser out == p0). Devuelve el final de out.
+template <typename It, typename Out>
+Out rotate(It p0, It pe, Out out, const Rotation_deg& r)
+{
+    for (; p0 != pe; ++p0, ++out)
+	*out = r(*p0);
+
+    return out;
+}
+
+/// Gira los vectores (x[i], y[i]), i = 0..n-1, el mismo giro r. Los
+/// resultados se escriben en (xr[i], yr[i]) (puede ser xr == x, yr == y).
+template <typename Int>
+    requires std::is_integral_v<Int>
+void rotate(const Int* x, const Int* y, size_t n, Int* xr, Int* yr,
+	    const Rotation_deg& r)
+{
+    int64_t s = r.sin_q16();
+    int64_t c = r.cos_q16();
+
+    for (size_t i = 0; i < n; ++i){
+	int64_t a = x[i];
+	int64_t b = y[i];
+
+	Int u = static_cast<Int>(impl_of::redondea_q16(a * c - b * s));
+	Int v = static_cast<Int>(impl_of::redondea_q16(a * s + b * c));
+
+	xr[i] = u;
+	yr[i] = v;
+    }
+}
+
+
 /// Gira el vector `v`, `angle` grados.
 template <typename I>
 inline Vector_xy<I> rotate(const Vector_xy<I>& v, const Degree& angle)
 { return rotate(v, Radian{angle}); }
 
 
+
 /*!
  *  \brief  Rectángulo en un sistema de coordenadas (x,y)
  *
@@ -33,11 +33,14 @@
  *  - HISTORIA:
  *    Manuel Perez
  *    29/07/2020 v0.0
+ *    19/10/2026 Conversiones de arrays de vectores.
  *
  ****************************************************************************/
 
 #include <iostream>
 #include <utility>  // std::swap
+#include <vector>
+#include <cstddef>
 
 #include "alp_rframe_xy.h"
 #include "alp_rframe_ij.h"
@@ -200,6 +203,33 @@ constexpr Vector_xy_in<N, I>::Vector_xy_in(const Vector_ij_in<N, I>& p)
 /***************************************************************************
  *			    REFERENCE FRAMES
  ***************************************************************************/
+namespace impl_of{
+// Las conversiones de arrays se hacen por bloques de este tamaño.
+inline constexpr size_t bloque_rframes = 64;
+
+// xr[k] = x[k] + d, para k en [0, n). xr puede ser x.
+template <typename Int>
+void suma(const Int* x, size_t n, Int d, Int* xr)
+{
+    constexpr size_t B = bloque_rframes;
+    Int t[B];
+
+    size_t k = 0;
+    for (; k + B <= n; k += B){
+	for (size_t i = 0; i < B; ++i)
+	    t[i] = x[k + i] + d;
+
+	for (size_t i = 0; i < B; ++i)
+	    xr[k + i] = t[i];
+    }
+
+    for (; k < n; ++k)
+	xr[k] = x[k] + d;
+}
+
+}// impl_of
+
+
 template <typename Int = int>
 struct _Reference_frame_xy_origin{
     Int x, y;
@@ -226,18 +256,24 @@ public:
     // Positiones del origen respecto del sistema de referencia absoluto.
     inline static Origin origin[num_reference_frames];
 
+    /// Vector que hay que sumar a las coordenadas de un punto en N1 para
+    /// obtener sus coordenadas en N2.
     template <int N2, int N1>
-    static Vector_xy_in<N2, Int> convert(const Vector_xy_in<N1, Int>& p)
+    static Vector_xy<Int> offset()
     {
 	static_assert (0 <= N1 and N1 < num_reference_frames);
 	static_assert (0 <= N2 and N2 < num_reference_frames);
 
-	Vector_xy_in<N2> q;
+	return Vector_xy<Int>{origin[N1].x - origin[N2].x,
+			      origin[N1].y - origin[N2].y};
+    }
 
-	q.x = origin[N1].x - origin[N2].x + p.x;
-	q.y = origin[N1].y - origin[N2].y + p.y;
+    template <int N2, int N1>
+    static Vector_xy_in<N2, Int> convert(const Vector_xy_in<N1, Int>& p)
+    {
+	Vector_xy<Int> d = offset<N2, N1>();
 
-	return q;
+	return Vector_xy_in<N2, Int>{p.x + d.x, p.y + d.y};
     }
 
     template <int N2, int N1>
@@ -245,9 +281,93 @@ public:
     { return convert<N2, N1> (Vector_xy_in{p}); }
 
 
+    /// Convierte los puntos [p0, pe) del sistema N1 al N2 escribiéndolos en
+    /// out. Devuelve el final de out.
+    /// El desplazamiento entre los dos sistemas se calcula una única vez.
+    template <int N2, int N1>
+    static Vector_xy_in<N2, Int>* convert(const Vector_xy_in<N1, Int>* p0,
+					  const Vector_xy_in<N1, Int>* pe,
+					  Vector_xy_in<N2, Int>* out);
+
+    template <int N2, int N1>
+    static std::vector<Vector_xy_in<N2, Int>>
+		convert(const std::vector<Vector_xy_in<N1, Int>>& p);
+
+    /// Convierte los n puntos (x[k], y[k]), dados en N1, al sistema N2
+    /// escribiéndolos en (xr[k], yr[k]). Es la versión para arrays de
+    /// coordenadas (por ejemplo, las componentes de un Point_cloud).
+    /// xr, yr pueden ser x, y (conversión in situ).
+    template <int N2, int N1>
+    static void convert(const Int* x, const Int* y, size_t n,
+			Int* xr, Int* yr);
 };
 
 
+template <int nrf, typename Int>
+template <int N2, int N1>
+Vector_xy_in<N2, Int>* Reference_frames_xy<nrf, Int>::convert(
+					const Vector_xy_in<N1, Int>* p0,
+					const Vector_xy_in<N1, Int>* pe,
+					Vector_xy_in<N2, Int>* out)
+{
+    const Vector_xy<Int> d = offset<N2, N1>();
+    const Int dx = d.x;
+    const Int dy = d.y;
+
+    // Por bloques de tamaño fijo en un array local para que el compilador
+    // pueda vectorizar sin comprobar si p0 y out se solapan.
+    constexpr size_t B = impl_of::bloque_rframes;
+    Int t[2 * B];
+
+    size_t n = pe - p0;
+    size_t k = 0;
+    for (; k + B <= n; k += B){
+	for (size_t i = 0; i < B; ++i){
+	    t[2*i]     = p0[k + i].x + dx;
+	    t[2*i + 1] = p0[k + i].y + dy;
+	}
+
+	for (size_t i = 0; i < B; ++i){
+	    out[k + i].x = t[2*i];
+	    out[k + i].y = t[2*i + 1];
+	}
+    }
+
+    for (; k < n; ++k){
+	out[k].x = p0[k].x + dx;
+	out[k].y = p0[k].y + dy;
+    }
+
+    return out + n;
+}
+
+
+template <int nrf, typename Int>
+template <int N2, int N1>
+std::vector<Vector_xy_in<N2, Int>> Reference_frames_xy<nrf, Int>::convert(
+				const std::vector<Vector_xy_in<N1, Int>>& p)
+{
+    std::vector<Vector_xy_in<N2, Int>> res(p.size());
+    convert<N2, N1>(p.data(), p.data() + p.size(), res.data());
+
+    return res;
+}
+
+
+template <int nrf, typename Int>
+template <int N2, int N1>
+void Reference_frames_xy<nrf, Int>::convert(const Int* x, const Int* y,
+					    size_t n, Int* xr, Int* yr)
+{
+    const Vector_xy<Int> d = offset<N2, N1>();
+    const Int dx = d.x;
+    const Int dy = d.y;
+
+    impl_of::suma(x, n, dx, xr);
+    impl_of::suma(y, n, dy, yr);
+}
+
+
 
 
 /***************************************************************************
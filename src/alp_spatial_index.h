@@ -0,0 +1,566 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_SPATIAL_INDEX_H__
+#define __ALP_SPATIAL_INDEX_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Índice espacial de rangos (Range_ij) o rectángulos
+ *	(Rectangle_xy).
+ *
+ *  - COMENTARIOS: Es un R-tree empaquetado (Sort-Tile-Recursive): los
+ *	rectángulos se ordenan por franjas y se agrupan de 16 en 16 en las
+ *	hojas; los nodos se vuelven a agrupar de la misma forma hasta llegar
+ *	a la raíz. Todos los nodos están seguidos en un std::vector.
+ *
+ *	Un R-tree empaquetado no admite inserciones. Los rectángulos que se
+ *	insertan se guardan en una lista que se recorre linealmente en cada
+ *	búsqueda, y los que se borran se marcan como borrados. Cuando hay
+ *	demasiados de alguno de los dos se vuelve a construir el árbol (coste
+ *	amortizado O(log n) por inserción).
+ *
+ *	Cada rectángulo tiene un identificador (un size_t) que es su índice
+ *	en el vector con el que se construye el índice, o el que devuelve
+ *	insert. Los identificadores no se reutilizan.
+ *
+ *	Ejemplo:
+ *	\code
+ *	    alp::Spatial_index<alp::Range_ij<int>> index{botones};
+ *
+ *	    for (size_t id: index.containing(alp::Vector_ij<int>{i, j}))
+ *		...
+ *	\endcode
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    19/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+#include "alp_rframe_ij.h"
+#include "alp_rframe_xy.h"
+
+namespace alp{
+
+namespace impl_of{
+// Caja [a0, ae) x [b0, be) con la que trabaja el índice
+template <typename Int>
+struct Caja{
+    Int a0, ae;
+    Int b0, be;
+
+    bool empty() const {return a0 == ae or b0 == be;}
+
+    // Menor caja que contiene a *this y a c
+    void une(const Caja& c)
+    {
+	a0 = std::min(a0, c.a0);
+	ae = std::max(ae, c.ae);
+	b0 = std::min(b0, c.b0);
+	be = std::max(be, c.be);
+    }
+
+    bool contiene(Int a, Int b) const
+    { return a0 <= a and a < ae and b0 <= b and b < be; }
+
+    // ¿Tienen algún punto en común?
+    bool corta(const Caja& c) const
+    {
+	return a0 < c.ae and c.a0 < ae and b0 < c.be and c.b0 < be
+	    and !empty() and !c.empty();
+    }
+
+    // ¿*this es subconjunto de c? (igual que es_subconjunto)
+    bool dentro_de(const Caja& c) const
+    { return c.a0 <= a0 and ae <= c.ae and c.b0 <= b0 and be <= c.be; }
+
+    // ¿Se tocan las cajas cerradas [a0, ae] x [b0, be]?
+    bool toca(const Caja& c) const
+    { return a0 <= c.ae and c.a0 <= ae and b0 <= c.be and c.b0 <= be; }
+
+    // Distancia al cuadrado del punto (a, b) al punto de la caja más
+    // próximo. Si la caja está vacía devuelve infinito.
+    double distancia2(Int a, Int b) const
+    {
+	if (empty())
+	    return std::numeric_limits<double>::infinity();
+
+	double da = (a < a0)? double(a0) - a: (a >= ae)? double(a) - (ae - 1): 0;
+	double db = (b < b0)? double(b0) - b: (b >= be)? double(b) - (be - 1): 0;
+
+	return da * da + db * db;
+    }
+
+    // Doble del centro (para no dividir)
+    Int centro2_a() const {return a0 + ae;}
+    Int centro2_b() const {return b0 + be;}
+};
+
+
+// Traduce los rectángulos y puntos de cada sistema de referencia a Caja
+template <typename Rect>
+struct Caja_de;
+
+template <std::integral Int>
+struct Caja_de<Range_ij<Int>>{
+    using Ind   = Int;
+    using Point = Vector_ij<Int>;
+
+    static Caja<Int> caja(const Range_ij<Int>& r)
+    { return {r.i0, r.ie, r.j0, r.je}; }
+
+    static Int a(const Point& p) {return p.i;}
+    static Int b(const Point& p) {return p.j;}
+};
+
+template <std::integral Int>
+struct Caja_de<Rectangle_xy<Int>>{
+    using Ind   = Int;
+    using Point = Vector_xy<Int>;
+
+    // El rectángulo contiene los puntos [x, x + width) x [y, y + height)
+    static Caja<Int> caja(const Rectangle_xy<Int>& r)
+    {
+	Point p = r.bottom_left_corner();
+	return {p.x, p.x + r.width(), p.y, p.y + r.height()};
+    }
+
+    static Int a(const Point& p) {return p.x;}
+    static Int b(const Point& p) {return p.y;}
+};
+
+}// namespace impl_of
+
+
+
+/*!
+ *  \brief  Índice espacial de Range_ij<Int> o Rectangle_xy<Int>.
+ *
+ *  Todas las búsquedas usan las mismas relaciones que rframe_ij:
+ *	+ containing(p): los rectángulos a los que p pertenece
+ *	  (belongs(p).to(r)).
+ *	+ intersecting(r): los rectángulos que tienen algún punto en común
+ *	  con r.
+ *	+ inside(r): los rectángulos que son subconjunto de r
+ *	  (es_subconjunto(x).de(r)).
+ *	+ nearest(p, k): los k rectángulos más próximos a p.
+ *
+ *  Las búsquedas devuelven los identificadores sin ningún orden (salvo
+ *  nearest, que los devuelve ordenados por distancia).
+ *
+ */
+template <typename Rect>
+class Spatial_index{
+public:
+// Types
+    using Rectangle = Rect;
+    using Ind       = typename impl_of::Caja_de<Rect>::Ind;
+    using Point     = typename impl_of::Caja_de<Rect>::Point;
+
+    /// Número máximo de hijos de cada nodo.
+    static constexpr uint32_t fanout = 16;
+
+// Construction
+    Spatial_index() = default;
+
+    /// Carga en bloque los rectángulos v. El identificador de v[i] es i.
+    explicit Spatial_index(const std::vector<Rect>& v);
+
+    /// Añade el rectángulo r. Devuelve su identificador.
+    size_t insert(const Rect& r);
+
+    /// Borra el rectángulo id. Devuelve false si no existía.
+    bool remove(size_t id);
+
+    /// Reconstruye el árbol (después de muchos insert/remove).
+    void rebuild();
+
+// Observers
+    /// Número de rectángulos.
+    size_t size() const {return num_vivos_;}
+    bool empty() const {return num_vivos_ == 0;}
+
+    /// ¿Existe el rectángulo id (no se ha borrado)?
+    bool contains(size_t id) const
+    { return id < estado_.size() and estado_[id] != borrado; }
+
+    /// Rectángulo id. Precondición: contains(id)
+    const Rect& operator[](size_t id) const {return region_[id];}
+
+// Búsquedas
+    /// Llama a f(id) por cada rectángulo al que pertenece p.
+    template <typename F>
+    void for_each_containing(const Point& p, F f) const;
+
+    /// Llama a f(id) por cada rectángulo que corta a r.
+    template <typename F>
+    void for_each_intersecting(const Rect& r, F f) const;
+
+    /// Llama a f(id) por cada rectángulo que es subconjunto de r.
+    template <typename F>
+    void for_each_inside(const Rect& r, F f) const;
+
+    std::vector<size_t> containing(const Point& p) const
+    { return as_vector([&](auto f) { for_each_containing(p, f); }); }
+
+    std::vector<size_t> intersecting(const Rect& r) const
+    { return as_vector([&](auto f) { for_each_intersecting(r, f); }); }
+
+    std::vector<size_t> inside(const Rect& r) const
+    { return as_vector([&](auto f) { for_each_inside(r, f); }); }
+
+    /// Los k rectángulos más próximos a p, ordenados por distancia (a
+    /// igual distancia por identificador). La distancia es la distancia
+    /// euclídea de p al punto más próximo del rectángulo (0 si p pertenece
+    /// al rectángulo). Los rectángulos vacíos no se devuelven nunca.
+    std::vector<size_t> nearest(const Point& p, size_t k) const;
+
+private:
+// Types
+    using Adaptador = impl_of::Caja_de<Rect>;
+    using Caja      = impl_of::Caja<Ind>;
+
+    struct Entrada{
+	Caja caja;
+	size_t id;
+    };
+
+    // Si es hoja, sus hijos son entrada_[primero, primero + num); si no,
+    // nodo_[primero, primero + num)
+    struct Nodo{
+	Caja caja;
+	uint32_t primero;
+	uint32_t num;
+	bool hoja;
+    };
+
+    enum Estado : unsigned char { borrado, en_arbol, pendiente };
+
+// Data
+    std::vector<Rect> region_;		// region_[id]
+    std::vector<Estado> estado_;	// estado_[id]
+    size_t num_vivos_ = 0;
+
+    std::vector<Entrada> entrada_;	// hojas del árbol
+    std::vector<Nodo> nodo_;		// la raíz es nodo_.back()
+    size_t num_borrados_arbol_ = 0;	// entradas del árbol borradas
+
+    std::vector<size_t> pendiente_;	// insertados que no están en el árbol
+
+// Helpers
+    Caja caja(size_t id) const {return Adaptador::caja(region_[id]);}
+
+    // Ordena v según el algoritmo STR
+    template <typename T>
+    static void ordena_str(typename std::vector<T>::iterator p0,
+			   typename std::vector<T>::iterator pe);
+
+    // Recorre los nodos que cumplen baja(caja) y llama a f(id) por cada
+    // rectángulo vivo que cumpla cumple(caja).
+    template <typename Baja, typename Cumple, typename F>
+    void busca(Baja baja, Cumple cumple, F& f) const;
+
+    template <typename G>
+    static std::vector<size_t> as_vector(G g)
+    {
+	std::vector<size_t> res;
+	g([&](size_t id) { res.push_back(id); });
+	return res;
+    }
+};
+
+
+template <typename R>
+Spatial_index<R>::Spatial_index(const std::vector<R>& v)
+    : region_{v}, estado_(v.size(), en_arbol), num_vivos_{v.size()}
+{ rebuild(); }
+
+
+template <typename R>
+size_t Spatial_index<R>::insert(const R& r)
+{
+    size_t id = region_.size();
+    region_.push_back(r);
+    estado_.push_back(pendiente);
+    pendiente_.push_back(id);
+    ++num_vivos_;
+
+    if (pendiente_.size() > std::max<size_t>(32, entrada_.size() / 8))
+	rebuild();
+
+    return id;
+}
+
+
+template <typename R>
+bool Spatial_index<R>::remove(size_t id)
+{
+    if (!contains(id))
+	return false;
+
+    if (estado_[id] == pendiente){
+	auto p = std::find(pendiente_.begin(), pendiente_.end(), id);
+	*p = pendiente_.back();
+	pendiente_.pop_back();
+    }
+    else
+	++num_borrados_arbol_;
+
+    estado_[id] = borrado;
+    --num_vivos_;
+
+    if (num_borrados_arbol_ > 32 and 2 * num_borrados_arbol_ > entrada_.size())
+	rebuild();
+
+    return true;
+}
+
+
+template <typename R>
+template <typename T>
+void Spatial_index<R>::ordena_str(typename std::vector<T>::iterator p0,
+				  typename std::vector<T>::iterator pe)
+{
+    size_t n = pe - p0;
+    if (n <= fanout)
+	return;
+
+    // Franjas verticales de S·fanout elementos, con S = sqrt(num nodos)
+    size_t num_nodos = (n + fanout - 1) / fanout;
+    size_t S = static_cast<size_t>(std::ceil(std::sqrt(double(num_nodos))));
+    size_t franja = S * fanout;
+
+    std::sort(p0, pe, [](const T& x, const T& y)
+		    { return x.caja.centro2_a() < y.caja.centro2_a(); });
+
+    for (auto p = p0; p < pe; ){
+	auto q = (size_t(pe - p) > franja)? p + franja: pe;
+	std::sort(p, q, [](const T& x, const T& y)
+		    { return x.caja.centro2_b() < y.caja.centro2_b(); });
+	p = q;
+    }
+}
+
+
+template <typename R>
+void Spatial_index<R>::rebuild()
+{
+    entrada_.clear();
+    nodo_.clear();
+    pendiente_.clear();
+    num_borrados_arbol_ = 0;
+
+    for (size_t id = 0; id < region_.size(); ++id){
+	if (estado_[id] != borrado){
+	    entrada_.push_back(Entrada{caja(id), id});
+	    estado_[id] = en_arbol;
+	}
+    }
+
+    if (entrada_.empty())
+	return;
+
+    if (entrada_.size() > std::numeric_limits<uint32_t>::max())
+	throw std::length_error{"Spatial_index: demasiados rectángulos"};
+
+    // Hojas
+    ordena_str<Entrada>(entrada_.begin(), entrada_.end());
+
+    for (uint32_t i = 0; i < entrada_.size(); i += fanout){
+	uint32_t n = std::min<uint32_t>(fanout, entrada_.size() - i);
+	Nodo nd{entrada_[i].caja, i, n, true};
+	for (uint32_t k = 1; k < n; ++k)
+	    nd.caja.une(entrada_[i + k].caja);
+
+	nodo_.push_back(nd);
+    }
+
+    // Niveles superiores: el nivel actual es nodo_[n0, ne)
+    size_t n0 = 0;
+    size_t ne = nodo_.size();
+    while (ne - n0 > 1){
+	ordena_str<Nodo>(nodo_.begin() + n0, nodo_.begin() + ne);
+
+	for (size_t i = n0; i < ne; i += fanout){
+	    uint32_t n = std::min<size_t>(fanout, ne - i);
+	    Nodo nd{nodo_[i].caja, static_cast<uint32_t>(i), n, false};
+	    for (uint32_t k = 1; k < n; ++k)
+		nd.caja.une(nodo_[i + k].caja);
+
+	    nodo_.push_back(nd);
+	}
+
+	n0 = ne;
+	ne = nodo_.size();
+    }
+}
+
+
+template <typename R>
+template <typename Baja, typename Cumple, typename F>
+void Spatial_index<R>::busca(Baja baja, Cumple cumple, F& f) const
+{
+    for (size_t id: pendiente_){
+	if (cumple(caja(id)))
+	    f(id);
+    }
+
+    if (nodo_.empty())
+	return;
+
+    // Como mucho hay fanout nodos por nivel en la pila y, con menos de 2^32
+    // entradas, hay 8 niveles como mucho.
+    uint32_t pila[8 * fanout + 1];
+    int n = 0;
+
+    if (baja(nodo_.back().caja))
+	pila[n++] = static_cast<uint32_t>(nodo_.size() - 1);
+
+    while (n > 0){
+	const Nodo& nd = nodo_[pila[--n]];
+
+	if (nd.hoja){
+	    for (uint32_t k = nd.primero; k < nd.primero + nd.num; ++k){
+		const Entrada& e = entrada_[k];
+		if (cumple(e.caja) and estado_[e.id] == en_arbol)
+		    f(e.id);
+	    }
+	}
+
+	else{
+	    for (uint32_t k = nd.primero; k < nd.primero + nd.num; ++k){
+		if (baja(nodo_[k].caja))
+		    pila[n++] = k;
+	    }
+	}
+    }
+}
+
+
+template <typename R>
+template <typename F>
+void Spatial_index<R>::for_each_containing(const Point& p, F f) const
+{
+    Ind a = Adaptador::a(p);
+    Ind b = Adaptador::b(p);
+
+    auto contiene = [a, b](const Caja& c) { return c.contiene(a, b); };
+    busca(contiene, contiene, f);
+}
+
+
+template <typename R>
+template <typename F>
+void Spatial_index<R>::for_each_intersecting(const R& r, F f) const
+{
+    Caja cr = Adaptador::caja(r);
+
+    auto corta = [&cr](const Caja& c) { return c.corta(cr); };
+    busca(corta, corta, f);
+}
+
+
+template <typename R>
+template <typename F>
+void Spatial_index<R>::for_each_inside(const R& r, F f) const
+{
+    Caja cr = Adaptador::caja(r);
+
+    busca([&cr](const Caja& c) { return c.toca(cr); },
+	  [&cr](const Caja& c) { return c.dentro_de(cr); }, f);
+}
+
+
+template <typename R>
+std::vector<size_t> Spatial_index<R>::nearest(const Point& p, size_t k) const
+{
+    Ind a = Adaptador::a(p);
+    Ind b = Adaptador::b(p);
+
+    // Búsqueda "best first": sacamos siempre lo más próximo. Si es un
+    // rectángulo ya no puede haber ninguno más próximo.
+    struct Candidato{
+	double d2;
+	bool es_nodo;
+	size_t i;   // índice del nodo o identificador del rectángulo
+
+	bool operator>(const Candidato& c) const
+	{
+	    if (d2 != c.d2) return d2 > c.d2;
+	    // A igual distancia primero los nodos: así, cuando se saca un
+	    // rectángulo, ya están en la cola todos los que están a la misma
+	    // distancia y salen ordenados por identificador.
+	    if (es_nodo != c.es_nodo) return !es_nodo;
+	    return i > c.i;
+	}
+    };
+
+    std::priority_queue<Candidato, std::vector<Candidato>,
+						std::greater<Candidato>> cola;
+
+    auto add_rectangulo = [&](const Caja& c, size_t id) {
+	double d2 = c.distancia2(a, b);
+	if (d2 != std::numeric_limits<double>::infinity())
+	    cola.push(Candidato{d2, false, id});
+    };
+
+    for (size_t id: pendiente_)
+	add_rectangulo(caja(id), id);
+
+    if (!nodo_.empty())
+	cola.push(Candidato{nodo_.back().caja.distancia2(a, b), true,
+							nodo_.size() - 1});
+
+    std::vector<size_t> res;
+    while (res.size() < k and !cola.empty()){
+	Candidato c = cola.top();
+	cola.pop();
+
+	if (!c.es_nodo){
+	    res.push_back(c.i);
+	    continue;
+	}
+
+	const Nodo& nd = nodo_[c.i];
+	for (uint32_t h = nd.primero; h < nd.primero + nd.num; ++h){
+	    if (nd.hoja){
+		const Entrada& e = entrada_[h];
+		if (estado_[e.id] == en_arbol)
+		    add_rectangulo(e.caja, e.id);
+	    }
+	    else
+		cola.push(Candidato{nodo_[h].caja.distancia2(a, b), true, h});
+	}
+    }
+
+    return res;
+}
+
+
+}// namespace
+
+#endif
@@ -28,12 +28,35 @@
  *   - HISTORIA:
  *    Manuel Perez
  *	19/09/2017 Escrito
+ *	18/10/2026 Online_statistics, Online_covariance
+ *		   percentile, median(p0, pe), median_of (redes de ordenación)
+ *		   unique_count_unsorted, most_frequent
+ *		   Sketches: Quantile_sketch, Hyperloglog, Count_min_sketch,
+ *		   Top_k
  *
  ****************************************************************************/
 #include <iostream>
 #include <map>
 #include <algorithm>
 #include <vector>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <memory>	// to_address
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>	// index_sequence
+
+#include "alp_exception.h"
 
 namespace alp{
 
@@ -62,6 +85,201 @@ inline Int median(const Int& a, const Int& b, const Int& c)
 }
 
 
+/***************************************************************************
+ *			    MEDIANA Y PERCENTILES
+ ***************************************************************************/
+// Las funciones _inplace desordenan [p0, pe) (usan std::nth_element, O(n)).
+// Las demás copian los datos en un buffer: sirven para cualquier iterador
+// (por ejemplo, para una Submatrix).
+//
+// El percentil q es el elemento que ocupa la posición ceil(q*n) (empezando
+// en 1) en los datos ordenados. Si n es par la mediana es el menor de los
+// dos elementos centrales (así la mediana de enteros es un entero).
+namespace impl_of{
+
+// Posición (empezando en 0) del percentil q en un rango de n elementos.
+inline size_t posicion_percentil(size_t n, double q)
+{
+    if (n == 0)
+	throw std::logic_error{"percentile: no hay elementos"};
+
+    if (!(0 <= q and q <= 1))
+	throw std::invalid_argument{"percentile: q tiene que estar en [0, 1]"};
+
+    auto k = static_cast<size_t>(std::ceil(q * static_cast<double>(n)));
+
+    return (k == 0)? 0 : std::min(k, n) - 1;
+}
+
+}// namespace impl_of
+
+
+/// Devuelve el percentil q (0 <= q <= 1) de [p0, pe), desordenándolo.
+/// Precondición: p0 != pe
+template <std::random_access_iterator It>
+    requires std::sortable<It>
+std::iter_value_t<It> percentile_inplace(It p0, It pe, double q)
+{
+    It k = p0 + impl_of::posicion_percentil(pe - p0, q);
+    std::nth_element(p0, k, pe);
+
+    return *k;
+}
+
+
+/// Devuelve la mediana de [p0, pe), desordenándolo.
+template <std::random_access_iterator It>
+    requires std::sortable<It>
+inline std::iter_value_t<It> median_inplace(It p0, It pe)
+{ return percentile_inplace(p0, pe, 0.5); }
+
+
+/// Devuelve el percentil q de [p0, pe) usando buf como memoria auxiliar.
+/// Reutilizando buf no se reserva memoria en cada llamada.
+template <typename It>
+typename std::iterator_traits<It>::value_type 
+    percentile(It p0, It pe, double q, 
+	       std::vector<typename std::iterator_traits<It>::value_type>& buf)
+{
+    buf.assign(p0, pe);
+    return percentile_inplace(buf.begin(), buf.end(), q);
+}
+
+
+template <typename It>
+inline typename std::iterator_traits<It>::value_type 
+				    percentile(It p0, It pe, double q)
+{
+    std::vector<typename std::iterator_traits<It>::value_type> buf;
+    return percentile(p0, pe, q, buf);
+}
+
+
+template <typename It>
+inline typename std::iterator_traits<It>::value_type 
+    median(It p0, It pe, 
+	   std::vector<typename std::iterator_traits<It>::value_type>& buf)
+{ return percentile(p0, pe, 0.5, buf); }
+
+
+template <typename It>
+inline typename std::iterator_traits<It>::value_type median(It p0, It pe)
+{ return percentile(p0, pe, 0.5); }
+
+
+// Redes de ordenación
+// -------------------
+// Para pocos elementos (ventanas de 3x3 o 5x5) es más rápido usar una red
+// de comparadores: una secuencia fija de min/max, sin saltos, que el
+// compilador puede desenrollar entera.
+//
+// La red se genera en tiempo de compilación (odd-even merge sort de
+// Batcher) y se eliminan los comparadores que no influyen en el elemento
+// central: para 9 elementos quedan 24 comparadores, para 25 quedan 113.
+namespace impl_of{
+
+struct Comparador{
+    uint8_t a, b;   // a < b
+};
+
+template <size_t N>
+struct Red_mediana{
+    std::array<Comparador, 256> c{};
+    size_t size = 0;
+};
+
+template <size_t N>
+constexpr Red_mediana<N> genera_red_mediana()
+{
+    static_assert(N % 2 == 1 and N <= 32);
+
+    Red_mediana<N> red;
+    for (size_t p = 1; p < N; p += p)
+	for (size_t k = p; k > 0; k /= 2)
+	    for (size_t j = k % p; j + k < N; j += k + k)
+		for (size_t i = 0; i < k and i + j + k < N; ++i)
+		    if ((i + j) / (p + p) == (i + j + k) / (p + p))
+			red.c[red.size++] = Comparador{
+			    static_cast<uint8_t>(i + j), 
+			    static_cast<uint8_t>(i + j + k)};
+
+    // Nos quedamos con los comparadores que influyen en el central
+    std::array<bool, N> usado{};
+    usado[N / 2] = true;
+
+    std::array<bool, 256> queda{};
+    size_t n = 0;
+    for (size_t i = red.size; i-- > 0; ){
+	auto [a, b] = red.c[i];
+	if (usado[a] or usado[b]){
+	    usado[a] = usado[b] = true;
+	    queda[i] = true;
+	    ++n;
+	}
+    }
+
+    Red_mediana<N> res;
+    for (size_t i = 0; i < red.size; ++i)
+	if (queda[i])
+	    res.c[res.size++] = red.c[i];
+
+    return res;
+}
+
+// Comparador: deja en x el menor y en y el mayor, sin saltos.
+template <typename T>
+inline void ordena2(T& x, T& y)
+{
+    T a = std::min(x, y);
+    y = std::max(x, y);
+    x = a;
+}
+
+template <typename T, size_t W>
+inline void ordena2(std::array<T, W>& x, std::array<T, W>& y)
+{
+    for (size_t w = 0; w < W; ++w)
+	ordena2(x[w], y[w]);
+}
+
+template <size_t N>
+inline constexpr Red_mediana<N> red_mediana = genera_red_mediana<N>();
+
+}// namespace impl_of
+
+
+/// Mediana de N elementos (N impar) usando una red de comparadores.
+/// Ejemplo: median_of(std::array<uint8_t, 9>{...}) para ventanas de 3x3.
+template <typename T, size_t N>
+    requires (N % 2 == 1)
+T median_of(std::array<T, N> v)
+{
+    constexpr auto& red = impl_of::red_mediana<N>;
+
+    [&]<size_t... i>(std::index_sequence<i...>){
+	(impl_of::ordena2(v[red.c[i].a], v[red.c[i].b]), ...);
+    }(std::make_index_sequence<red.size>{});
+
+    return v[N / 2];
+}
+
+
+/// Calcula a la vez W medianas de N elementos: v[k][w] es el elemento k de
+/// la mediana w. Las medianas quedan en v[N / 2].
+/// Como cada comparador se aplica a W elementos seguidos, el compilador
+/// lo vectoriza (min/max de 16 o 32 bytes a la vez).
+template <typename T, size_t N, size_t W>
+    requires (N % 2 == 1)
+void median_of(std::array<std::array<T, W>, N>& v)
+{
+    constexpr auto& red = impl_of::red_mediana<N>;
+
+    [&]<size_t... i>(std::index_sequence<i...>){
+	(impl_of::ordena2(v[red.c[i].a], v[red.c[i].b]), ...);
+    }(std::make_index_sequence<red.size>{});
+}
+
+
 
 
 /*!
@@ -99,6 +317,10 @@ public:
     /// Sumamos 1 a la frecuencia absoluta del elemento x.
     void add(const value_type& x) { ++est_[x]; }
 
+    /// Sumamos n a la frecuencia absoluta del elemento x (por ejemplo,
+    /// para añadir lo que devuelve unique_count_unsorted).
+    void add(const value_type& x, size_t n) { est_[x] += n; }
+
     std::ostream& print(std::ostream& out);
 
 // Data
@@ -121,6 +343,10 @@ public:
     std::vector<std::pair<T,size_t>> as_sorted_vector() const
     { return as_sorted_vector(std::greater<size_t>{}); }
 
+    /// Devuelve los k elementos más frecuentes, de mayor a menor
+    /// frecuencia. Solo copia y ordena k elementos (O(n log k)).
+    std::vector<std::pair<T,size_t>> most_frequent(size_t k) const;
+
 
 private:
     std::map<value_type, size_t> est_;
@@ -133,7 +359,7 @@ std::vector<std::pair<T, size_t>>
 {
     std::vector<std::pair<T,size_t>> res{est_.begin(), est_.end()};
 
-    std::sort(begin(res), end(res), [&comp](auto x1, auto x2){
+    std::sort(begin(res), end(res), [&comp](const auto& x1, const auto& x2){
 	    return comp(x1.second, x2.second);
 	    });
 
@@ -141,6 +367,42 @@ std::vector<std::pair<T, size_t>>
 }
 
 
+template <typename T>
+std::vector<std::pair<T, size_t>> 
+		    Frequency_table<T>::most_frequent(size_t k) const
+{
+    using Elemento = typename std::map<T, size_t>::const_pointer;
+
+    // Montículo con los k más frecuentes: en la cima el menos frecuente
+    auto menos_frecuente = [](Elemento a, Elemento b) 
+				    { return a->second > b->second; };
+
+    std::vector<Elemento> heap;
+    heap.reserve(std::min(k, est_.size()) + 1);
+
+    for (const auto& x: est_){
+	if (heap.size() < k){
+	    heap.push_back(&x);
+	    std::push_heap(heap.begin(), heap.end(), menos_frecuente);
+	}
+	else if (k > 0 and x.second > heap.front()->second){
+	    std::pop_heap(heap.begin(), heap.end(), menos_frecuente);
+	    heap.back() = &x;
+	    std::push_heap(heap.begin(), heap.end(), menos_frecuente);
+	}
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), menos_frecuente);
+
+    std::vector<std::pair<T, size_t>> res;
+    res.reserve(heap.size());
+    for (auto p: heap)
+	res.push_back(*p);
+
+    return res;
+}
+
+
 
 template <typename T> 
 std::ostream& Frequency_table<T>::print(std::ostream& out)
@@ -194,8 +456,1586 @@ unique_count(Iterator p0, Iterator pe)
 }
 
 
-}// namespace
+/***************************************************************************
+ *			CONTAR SIN ORDENAR
+ ***************************************************************************/
+namespace impl_of{
 
-#endif
+template <typename T>
+concept Entero_radix = std::is_integral_v<T> and !std::is_same_v<T, bool>;
+
+// Clave sin signo que se ordena igual que x
+template <Entero_radix T>
+inline std::make_unsigned_t<T> clave_radix(T x)
+{
+    using U = std::make_unsigned_t<T>;
+
+    if constexpr (std::is_signed_v<T>)
+	return static_cast<U>(static_cast<U>(x) ^ (U{1} << (8 * sizeof(T) - 1)));
+    else
+	return x;
+}
+
+template <Entero_radix T>
+inline T valor_radix(std::make_unsigned_t<T> k)
+{
+    using U = std::make_unsigned_t<T>;
+
+    if constexpr (std::is_signed_v<T>)
+	return static_cast<T>(static_cast<U>(k ^ (U{1} << (8 * sizeof(T) - 1))));
+    else
+	return k;
+}
+
+
+// Ordena v con radix sort LSD, 8 bits por pasada. Se saltan las pasadas en
+// las que todos los elementos tienen el mismo byte.
+template <Entero_radix T>
+void radix_sort(std::vector<T>& v, std::vector<T>& buf)
+{
+    buf.resize(v.size());
+
+    for (size_t d = 0; d < 8 * sizeof(T); d += 8){
+	std::array<size_t, 256> pos{};
+	for (auto x: v)
+	    ++pos[(clave_radix(x) >> d) & 0xFF];
+
+	if (std::find(pos.begin(), pos.end(), v.size()) != pos.end())
+	    continue;
+
+	size_t s = 0;
+	for (auto& p: pos)
+	    s += std::exchange(p, s);
+
+	for (auto x: v)
+	    buf[pos[(clave_radix(x) >> d) & 0xFF]++] = x;
+
+	v.swap(buf);
+    }
+}
+
+
+// Une dos resultados de unique_count (ordenados por valor) sumando las
+// frecuencias de los valores repetidos.
+template <typename T>
+std::vector<std::pair<T, size_t>> 
+	merge_count(const std::vector<std::pair<T, size_t>>& a,
+		    const std::vector<std::pair<T, size_t>>& b)
+{
+    std::vector<std::pair<T, size_t>> res;
+    res.reserve(a.size() + b.size());
+
+    auto p = a.begin();
+    auto q = b.begin();
+    while (p != a.end() and q != b.end()){
+	if (p->first < q->first)
+	    res.push_back(*p++);
+
+	else if (q->first < p->first)
+	    res.push_back(*q++);
+
+	else {
+	    res.emplace_back(p->first, p->second + q->second);
+	    ++p;
+	    ++q;
+	}
+    }
+
+    res.insert(res.end(), p, a.end());
+    res.insert(res.end(), q, b.end());
+
+    return res;
+}
+
+
+// Llama a f(q0, qe) para cada bloque de [p0, pe), cada uno en un thread, y
+// devuelve los resultados. Los bloques tienen como mínimo min_bloque
+// elementos. Si num_threads == 0 usa un thread por core.
+template <typename It, typename F>
+auto por_bloques(It p0, It pe, unsigned num_threads, F f)
+			    -> std::vector<std::invoke_result_t<F&, It, It>>
+{
+    using Res = std::invoke_result_t<F&, It, It>;
+    constexpr size_t min_bloque = 1 << 16;
+
+    std::vector<Res> res;
+
+    if constexpr (!std::random_access_iterator<It>)
+	res.push_back(f(p0, pe));
+
+    else {
+	auto n = static_cast<size_t>(pe - p0);
+
+	if (num_threads == 0)
+	    num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+	num_threads = static_cast<unsigned>(
+		std::max<size_t>(1, std::min<size_t>(num_threads, 
+						     n / min_bloque)));
+
+	size_t bloque = n / num_threads;
+
+	std::vector<std::future<Res>> threads;
+	It q = p0;
+	for (unsigned t = 0; t + 1 < num_threads; ++t, q += bloque)
+	    threads.push_back(std::async(std::launch::async, f, q, q + bloque));
+
+	Res ultimo = f(q, pe);  // el último bloque en este thread
+
+	res.reserve(num_threads);
+	for (auto& t: threads)
+	    res.push_back(t.get());
+
+	res.push_back(std::move(ultimo));
+    }
+
+    return res;
+}
+
+
+// Enteros de 8 y 16 bits: contamos directamente en un array.
+template <typename T, typename It>
+std::vector<std::pair<T, size_t>> unique_count_histograma(It p0, It pe, 
+						    unsigned num_threads)
+{
+    constexpr size_t num_valores = size_t{1} << (8 * sizeof(T));
+    using Histograma = std::vector<size_t>;
+
+    auto h = por_bloques(p0, pe, num_threads, [](It q0, It qe) {
+	Histograma h(num_valores, 0);
+	for (; q0 != qe; ++q0)
+	    ++h[clave_radix(static_cast<T>(*q0))];
+	return h;
+    });
+
+    for (size_t t = 1; t < h.size(); ++t)
+	for (size_t i = 0; i < num_valores; ++i)
+	    h[0][i] += h[t][i];
+
+    std::vector<std::pair<T, size_t>> res;
+    for (size_t i = 0; i < num_valores; ++i)
+	if (h[0][i] != 0)
+	    res.emplace_back(valor_radix<T>(
+		    static_cast<std::make_unsigned_t<T>>(i)), h[0][i]);
+
+    return res;
+}
+
+
+// Resto de enteros: cada thread ordena su bloque con radix sort y cuenta.
+template <typename T, typename It>
+std::vector<std::pair<T, size_t>> unique_count_radix(It p0, It pe,
+						     unsigned num_threads)
+{
+    auto c = por_bloques(p0, pe, num_threads, [](It q0, It qe) {
+	std::vector<T> v(q0, qe);
+	std::vector<T> buf;
+	radix_sort(v, buf);
+	return unique_count(v.begin(), v.end());
+    });
+
+    // Unimos por parejas: log2(num_threads) pasadas
+    for (size_t paso = 1; paso < c.size(); paso *= 2)
+	for (size_t i = 0; i + paso < c.size(); i += 2 * paso)
+	    c[i] = merge_count(c[i], c[i + paso]);
+
+    return std::move(c[0]);
+}
+
+
+// Cualquier otro tipo: tabla hash por thread.
+template <typename T, typename It>
+std::vector<std::pair<T, size_t>> unique_count_hash(It p0, It pe,
+						    unsigned num_threads)
+{
+    using Tabla = std::unordered_map<T, size_t>;
+
+    auto t = por_bloques(p0, pe, num_threads, [](It q0, It qe) {
+	Tabla t;
+	for (; q0 != qe; ++q0)
+	    ++t[*q0];
+	return t;
+    });
+
+    // Añadimos el resto de tablas a la mayor
+    auto mayor = std::max_element(t.begin(), t.end(), 
+		    [](const Tabla& a, const Tabla& b) 
+				    { return a.size() < b.size(); });
+    std::swap(*mayor, t.front());
+
+    for (size_t i = 1; i < t.size(); ++i)
+	for (auto& [x, n]: t[i])
+	    t[0][x] += n;
+
+    return {t[0].begin(), t[0].end()};
+}
+
+}// namespace impl_of
+
+
+/*!
+ *  \brief  Igual que unique_count pero [p0, pe) no tiene que estar 
+ *	    ordenado.
+ *
+ *  Reparte [p0, pe) en bloques que se cuentan en paralelo (num_threads;
+ *  0 = un thread por core) y luego une los resultados:
+ *	+ Enteros de 8 y 16 bits: cuenta en un array. Resultado ordenado por
+ *	  valor.
+ *	+ Resto de enteros: radix sort + unique_count. Resultado ordenado por
+ *	  valor.
+ *	+ Otros tipos: tabla hash (necesita std::hash<T>). El resultado no
+ *	  está ordenado.
+ *
+ */
+template <typename Iterator>
+std::vector<
+    std::pair<typename std::iterator_traits<Iterator>::value_type, size_t>> 
+unique_count_unsorted(Iterator p0, Iterator pe, unsigned num_threads = 0)
+{
+    using T = typename std::iterator_traits<Iterator>::value_type;
+
+    if constexpr (impl_of::Entero_radix<T>){
+	if constexpr (sizeof(T) <= 2)
+	    return impl_of::unique_count_histograma<T>(p0, pe, num_threads);
+	else
+	    return impl_of::unique_count_radix<T>(p0, pe, num_threads);
+    }
+    else
+	return impl_of::unique_count_hash<T>(p0, pe, num_threads);
+}
+
+
+/// Se queda con los k elementos de v de mayor frecuencia (second),
+/// ordenados de mayor a menor. Solo ordena esos k elementos.
+template <typename T>
+void most_frequent(std::vector<std::pair<T, size_t>>& v, size_t k)
+{
+    k = std::min(k, v.size());
+
+    std::partial_sort(v.begin(), v.begin() + k, v.end(), 
+	    [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    v.erase(v.begin() + k, v.end());
+}
+
+
+/***************************************************************************
+ *			    ESTADÍSTICA ONLINE
+ ***************************************************************************/
+/*!
+ *  \brief  Estadísticos de una muestra calculados sin guardar la muestra.
+ *
+ *  Se van añadiendo los valores uno a uno (o por bloques) y en todo
+ *  momento se conoce el número de elementos, la media, la varianza, el
+ *  mínimo, el máximo, la asimetría y la curtosis.
+ *
+ *  Para que no se pierda precisión no se guardan las sumas de x, x^2...
+ *  sino los momentos centrales (algoritmo de Welford, generalizado por
+ *  Terriberry y Pébay para los momentos de orden 3 y 4).
+ *
+ *  Dos Online_statistics se pueden unir (merge): cada thread puede
+ *  calcular los estadísticos de una parte de los datos y al final se
+ *  unen.
+ *
+ *  Ejemplo:
+ *  \code
+ *	Online_statistics<> st;
+ *	while (sensor.read(x))
+ *	    st.add(x);
+ *
+ *	std::cout << st.mean() << " +/- " << st.stddev() << '\n';
+ *  \endcode
+ */
+template <typename Real = double>
+class Online_statistics{
+public:
+    static_assert(std::is_floating_point_v<Real>);
+
+    using value_type = Real;
+    using size_t = ::std::size_t;
+
+    Online_statistics() = default;
+
+    /// Estadísticos de los valores [p0, pe).
+    template <typename It>
+    Online_statistics(It p0, It pe) { add(p0, pe); }
+
+// Añadir datos
+    /// Añade el valor x.
+    void add(Real x);
+
+    /// Añade los valores [p0, pe). Si los valores están seguidos en
+    /// memoria se procesan por bloques (ver add_block).
+    template <typename It>
+    void add(It p0, It pe);
+
+    /// Añade todas las filas de la matriz (o submatriz) m.
+    template <typename Container2D>
+    void add_rows(const Container2D& m)
+    {
+	for (auto f = m.row_begin(); f != m.row_end(); ++f)
+	    add((*f).begin(), (*f).end());
+    }
+
+    /// Une los estadísticos de st con estos.
+    void merge(const Online_statistics& st);
+
+    Online_statistics& operator+=(const Online_statistics& st)
+    {
+	merge(st);
+	return *this;
+    }
+
+    friend Online_statistics operator+(Online_statistics a, 
+				       const Online_statistics& b)
+    { return a += b; }
+
+    void clear() { *this = Online_statistics{}; }
+
+// Estadísticos
+    /// Número de elementos.
+    size_t count() const {return n_;}
+    bool empty() const {return n_ == 0;}
+
+    Real sum() const {return mean_ * static_cast<Real>(n_);}
+
+    // Precondición: !empty(). 
+    // En caso contrario lanzan una excepción.
+    Real mean() const	{no_vacio("mean"); return mean_;}
+    Real min() const	{no_vacio("min"); return min_;}
+    Real max() const	{no_vacio("max"); return max_;}
+
+    /// Varianza de la población (dividiendo entre n).
+    Real variance() const {no_vacio("variance"); return m2_ / n_;}
+
+    /// Cuasivarianza (dividiendo entre n - 1).
+    /// Precondición: count() >= 2
+    Real sample_variance() const 
+    {
+	if (n_ < 2)
+	    throw std::logic_error{
+		"Online_statistics::sample_variance: menos de 2 elementos"};
+
+	return m2_ / (n_ - 1);
+    }
+
+    Real stddev() const {return std::sqrt(variance());}
+
+    /// Coeficiente de asimetría de Fisher.
+    Real skewness() const;
+
+    /// Curtosis (exceso de curtosis: la de la normal es 0).
+    Real kurtosis() const;
+
+private:
+    size_t n_ = 0;
+    Real mean_ = 0;
+    Real m2_ = 0;   // suma de (x - mean)^2
+    Real m3_ = 0;   // suma de (x - mean)^3
+    Real m4_ = 0;   // suma de (x - mean)^4
+    Real min_ = std::numeric_limits<Real>::infinity();
+    Real max_ = -std::numeric_limits<Real>::infinity();
+
+    void no_vacio(const char* funcion) const
+    {
+	if (n_ == 0)
+	    throw std::logic_error{std::string{"Online_statistics::"} + 
+		    funcion + ": no hay elementos"};
+    }
+
+    // Calcula los estadísticos del bloque [p, p + n) y los une con estos.
+    template <typename T>
+    void add_block(const T* p, size_t n);
+};
+
+
+template <typename Real>
+void Online_statistics<Real>::add(Real x)
+{
+    Real n1 = static_cast<Real>(n_);
+    ++n_;
+    Real n = static_cast<Real>(n_);
+
+    Real d  = x - mean_;
+    Real dn = d / n;
+    Real dn2 = dn * dn;
+    Real t = d * dn * n1;
+
+    mean_ += dn;
+    m4_ += t * dn2 * (n*n - 3*n + 3) + 6 * dn2 * m2_ - 4 * dn * m3_;
+    m3_ += t * dn * (n - 2) - 3 * dn * m2_;
+    m2_ += t;
+
+    if (x < min_) min_ = x;
+    if (x > max_) max_ = x;
+}
+
+
+template <typename Real>
+template <typename It>
+void Online_statistics<Real>::add(It p0, It pe)
+{
+    using T = typename std::iterator_traits<It>::value_type;
+
+    if constexpr (std::contiguous_iterator<It> and std::is_arithmetic_v<T>){
+	constexpr size_t bloque = 256;
+
+	const T* p = std::to_address(p0);
+	size_t n = static_cast<size_t>(pe - p0);
+
+	for (; n >= bloque; n -= bloque, p += bloque)
+	    add_block(p, bloque);
+
+	if (n > 0)
+	    add_block(p, n);
+    }
+    else {
+	for (; p0 != pe; ++p0)
+	    add(static_cast<Real>(*p0));
+    }
+}
+
+
+// El bloque cabe en la caché, así que lo recorremos dos veces: una para
+// calcular la media y otra para los momentos centrales. Usamos 4
+// acumuladores independientes para que el compilador pueda vectorizar.
+template <typename Real>
+template <typename T>
+void Online_statistics<Real>::add_block(const T* p, size_t n)
+{
+    constexpr size_t L = 4;
+    size_t n4 = n - n % L;
+
+    std::array<Real, L> s{};
+    std::array<Real, L> mn, mx;
+    mn.fill(std::numeric_limits<Real>::infinity());
+    mx.fill(-std::numeric_limits<Real>::infinity());
+
+    for (size_t i = 0; i < n4; i += L)
+	for (size_t k = 0; k < L; ++k){
+	    Real x = static_cast<Real>(p[i + k]);
+	    s[k] += x;
+	    mn[k] = std::min(mn[k], x);
+	    mx[k] = std::max(mx[k], x);
+	}
+
+    for (size_t i = n4; i < n; ++i){
+	Real x = static_cast<Real>(p[i]);
+	s[0] += x;
+	mn[0] = std::min(mn[0], x);
+	mx[0] = std::max(mx[0], x);
+    }
+
+    Online_statistics b;
+    b.n_ = n;
+    b.mean_ = (s[0] + s[1] + s[2] + s[3]) / static_cast<Real>(n);
+    b.min_ = *std::min_element(mn.begin(), mn.end());
+    b.max_ = *std::max_element(mx.begin(), mx.end());
+
+    std::array<Real, L> m2{}, m3{}, m4{};
+    for (size_t i = 0; i < n4; i += L)
+	for (size_t k = 0; k < L; ++k){
+	    Real d = static_cast<Real>(p[i + k]) - b.mean_;
+	    Real d2 = d * d;
+	    m2[k] += d2;
+	    m3[k] += d2 * d;
+	    m4[k] += d2 * d2;
+	}
+
+    for (size_t i = n4; i < n; ++i){
+	Real d = static_cast<Real>(p[i]) - b.mean_;
+	Real d2 = d * d;
+	m2[0] += d2;
+	m3[0] += d2 * d;
+	m4[0] += d2 * d2;
+    }
+
+    b.m2_ = m2[0] + m2[1] + m2[2] + m2[3];
+    b.m3_ = m3[0] + m3[1] + m3[2] + m3[3];
+    b.m4_ = m4[0] + m4[1] + m4[2] + m4[3];
+
+    merge(b);
+}
+
+
+// Fórmulas de Chan y Pébay para unir los momentos de dos muestras.
+template <typename Real>
+void Online_statistics<Real>::merge(const Online_statistics& b)
+{
+    if (b.n_ == 0)
+	return;
+
+    if (n_ == 0){
+	*this = b;
+	return;
+    }
+
+    Real na = static_cast<Real>(n_);
+    Real nb = static_cast<Real>(b.n_);
+    Real n  = na + nb;
+
+    Real d  = b.mean_ - mean_;
+    Real d2 = d * d;
+    Real nab = na * nb;
 
+    Real m2 = m2_ + b.m2_ + d2 * nab / n;
 
+    Real m3 = m3_ + b.m3_ + d * d2 * nab * (na - nb) / (n * n)
+		  + 3 * d * (na * b.m2_ - nb * m2_) / n;
+
+    Real m4 = m4_ + b.m4_ 
+		  + d2 * d2 * nab * (na*na - nab + nb*nb) / (n * n * n)
+		  + 6 * d2 * (na*na * b.m2_ + nb*nb * m2_) / (n * n)
+		  + 4 * d * (na * b.m3_ - nb * m3_) / n;
+
+    n_ += b.n_;
+    mean_ += d * nb / n;
+    m2_ = m2;
+    m3_ = m3;
+    m4_ = m4;
+    min_ = std::min(min_, b.min_);
+    max_ = std::max(max_, b.max_);
+}
+
+
+template <typename Real>
+Real Online_statistics<Real>::skewness() const
+{
+    no_vacio("skewness");
+
+    if (m2_ == 0)
+	return 0;
+
+    return std::sqrt(static_cast<Real>(n_)) * m3_ / std::pow(m2_, Real{1.5});
+}
+
+
+template <typename Real>
+Real Online_statistics<Real>::kurtosis() const
+{
+    no_vacio("kurtosis");
+
+    if (m2_ == 0)
+	return 0;
+
+    return static_cast<Real>(n_) * m4_ / (m2_ * m2_) - 3;
+}
+
+
+
+/*!
+ *  \brief  Covarianza de dos variables calculada sin guardar la muestra.
+ *
+ *  Igual que Online_statistics, se puede unir con otras (merge).
+ *
+ */
+template <typename Real = double>
+class Online_covariance{
+public:
+    static_assert(std::is_floating_point_v<Real>);
+
+    using value_type = Real;
+    using size_t = ::std::size_t;
+
+    /// Añade la pareja (x, y)
+    void add(Real x, Real y)
+    {
+	++n_;
+	Real n = static_cast<Real>(n_);
+
+	Real dx = x - mean_x_;
+	mean_x_ += dx / n;
+	Real dy = y - mean_y_;
+	mean_y_ += dy / n;
+
+	m2x_ += dx * (x - mean_x_);
+	m2y_ += dy * (y - mean_y_);
+	c_   += dx * (y - mean_y_);
+    }
+
+    /// Añade las parejas (x[i], y[i]) con x en [x0, xe).
+    template <typename It1, typename It2>
+    void add(It1 x0, It1 xe, It2 y0)
+    {
+	for (; x0 != xe; ++x0, ++y0)
+	    add(static_cast<Real>(*x0), static_cast<Real>(*y0));
+    }
+
+    void merge(const Online_covariance& b);
+
+    Online_covariance& operator+=(const Online_covariance& b)
+    {
+	merge(b);
+	return *this;
+    }
+
+    size_t count() const {return n_;}
+    bool empty() const {return n_ == 0;}
+
+    // Precondición: !empty()
+    Real mean_x() const {no_vacio("mean_x"); return mean_x_;}
+    Real mean_y() const {no_vacio("mean_y"); return mean_y_;}
+
+    /// Covarianza de la población (dividiendo entre n).
+    Real covariance() const {no_vacio("covariance"); return c_ / n_;}
+
+    /// Covarianza muestral (dividiendo entre n - 1).
+    /// Precondición: count() >= 2
+    Real sample_covariance() const 
+    {
+	if (n_ < 2)
+	    throw std::logic_error{
+		"Online_covariance::sample_covariance: menos de 2 elementos"};
+
+	return c_ / (n_ - 1);
+    }
+
+    /// Coeficiente de correlación de Pearson.
+    Real correlation() const
+    {
+	no_vacio("correlation");
+	return c_ / std::sqrt(m2x_ * m2y_);
+    }
+
+private:
+    size_t n_ = 0;
+    Real mean_x_ = 0;
+    Real mean_y_ = 0;
+    Real m2x_ = 0;  // suma de (x - mean_x)^2
+    Real m2y_ = 0;  // suma de (y - mean_y)^2
+    Real c_ = 0;    // suma de (x - mean_x)*(y - mean_y)
+
+    void no_vacio(const char* funcion) const
+    {
+	if (n_ == 0)
+	    throw std::logic_error{std::string{"Online_covariance::"} + 
+		    funcion + ": no hay elementos"};
+    }
+};
+
+
+template <typename Real>
+void Online_covariance<Real>::merge(const Online_covariance& b)
+{
+    if (b.n_ == 0)
+	return;
+
+    if (n_ == 0){
+	*this = b;
+	return;
+    }
+
+    Real na = static_cast<Real>(n_);
+    Real nb = static_cast<Real>(b.n_);
+    Real n  = na + nb;
+
+    Real dx = b.mean_x_ - mean_x_;
+    Real dy = b.mean_y_ - mean_y_;
+    Real f = na * nb / n;
+
+    m2x_ += b.m2x_ + dx * dx * f;
+    m2y_ += b.m2y_ + dy * dy * f;
+    c_   += b.c_   + dx * dy * f;
+
+    mean_x_ += dx * nb / n;
+    mean_y_ += dy * nb / n;
+    n_ += b.n_;
+}
+
+
+/***************************************************************************
+ *				SKETCHES
+ ***************************************************************************/
+// Los sketches resumen un flujo de datos en una cantidad de memoria fija,
+// a cambio de dar resultados aproximados. Todos se pueden unir (merge) y
+// guardar/leer en formato binario (save/load).
+//
+//  + Quantile_sketch	= cuantiles (mediana, p99...) (KLL).
+//  + Hyperloglog	= número de elementos diferentes.
+//  + Count_min_sketch	= frecuencia aproximada de cada elemento.
+//  + Top_k		= los k elementos más frecuentes (heavy hitters).
+namespace impl_of{
+
+/// Mezcla los bits de x (finalizador de splitmix64).
+inline uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+/// Hash de 64 bits. std::hash de los enteros suele ser la identidad, por
+/// eso mezclamos los bits.
+template <typename T>
+inline uint64_t hash64(const T& x)
+{ return mix64(static_cast<uint64_t>(std::hash<T>{}(x))); }
+
+
+// Formato binario: los tipos trivialmente copiables se guardan tal cual
+// (con el endianness de la máquina); las strings como size + bytes.
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+inline void write_binary(std::ostream& out, const T& x)
+{ out.write(reinterpret_cast<const char*>(&x), sizeof(T)); }
+
+inline void write_binary(std::ostream& out, const std::string& s)
+{
+    write_binary(out, static_cast<uint64_t>(s.size()));
+    out.write(s.data(), s.size());
+}
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+inline void read_binary(std::istream& in, T& x)
+{
+    if (!in.read(reinterpret_cast<char*>(&x), sizeof(T)))
+	throw Error_de_formato{"read_binary: fin de fichero inesperado"};
+}
+
+// Los tamaños que leemos vienen del fichero y no nos podemos fiar de
+// ellos: leemos por bloques para que un tamaño corrupto acabe en
+// Error_de_formato al llegar al fin de fichero, en lugar de reservar
+// memoria de más.
+inline constexpr uint64_t read_bloque = 1 << 16;
+
+inline void read_binary(std::istream& in, std::string& s)
+{
+    uint64_t n;
+    read_binary(in, n);
+
+    s.clear();
+    for (uint64_t i0 = 0; i0 < n; ){
+	uint64_t m = std::min(read_bloque, n - i0);
+	s.resize(i0 + m);
+	if (!in.read(s.data() + i0, m))
+	    throw Error_de_formato{"read_binary: fin de fichero inesperado"};
+
+	i0 += m;
+    }
+}
+
+template <typename A, typename B>
+inline void read_binary(std::istream& in, std::pair<A, B>& x)
+{
+    read_binary(in, x.first);
+    read_binary(in, x.second);
+}
+
+// Lee n elementos en v.
+template <typename T>
+void read_binary(std::istream& in, std::vector<T>& v, uint64_t n)
+{
+    v.clear();
+    for (uint64_t i0 = 0; i0 < n; ){
+	uint64_t m = std::min(read_bloque, n - i0);
+	v.resize(i0 + m);
+
+	if constexpr (std::is_trivially_copyable_v<T>){
+	    if (!in.read(reinterpret_cast<char*>(v.data() + i0), 
+							m * sizeof(T)))
+		throw Error_de_formato{
+				"read_binary: fin de fichero inesperado"};
+	}
+	else{
+	    for (uint64_t i = i0; i < i0 + m; ++i)
+		read_binary(in, v[i]);
+	}
+
+	i0 += m;
+    }
+}
+
+// Cada sketch empieza con una marca para detectar que se lee lo que no es
+inline void write_marca(std::ostream& out, uint32_t marca)
+{ write_binary(out, marca); }
+
+inline void read_marca(std::istream& in, uint32_t marca, const char* nombre)
+{
+    uint32_t m;
+    read_binary(in, m);
+    if (m != marca)
+	throw Error_de_formato{std::string{nombre} + 
+				    "::load: formato desconocido"};
+}
+
+}// namespace impl_of
+
+
+/*!
+ *  \brief  Cuantiles aproximados de un flujo de datos (sketch KLL).
+ *
+ *  Guarda O(k) elementos. El error en el rango de un cuantil es del orden
+ *  de 1.7/k (con k = 200, menos del 1%).
+ *
+ *  Los elementos se guardan en niveles: los del nivel h pesan 2^h. Cuando
+ *  un nivel se llena se ordena y se pasa al siguiente nivel uno de cada
+ *  dos elementos (elegidos al azar los pares o los impares).
+ *
+ *  Ejemplo:
+ *  \code
+ *	Quantile_sketch<double> q;
+ *	for (auto x: latencias)
+ *	    q.add(x);
+ *
+ *	std::cout << "p50 = " << q.quantile(0.5) 
+ *		  << "; p99 = " << q.quantile(0.99) << '\n';
+ *  \endcode
+ */
+template <typename T>
+class Quantile_sketch{
+public:
+    using value_type = T;
+    using size_t = ::std::size_t;
+
+    /// k = precisión (a mayor k, más precisión y más memoria).
+    explicit Quantile_sketch(uint32_t k = 200);
+
+    void add(const T& x);
+
+    template <typename It>
+    void add(It p0, It pe)
+    {
+	for (; p0 != pe; ++p0)
+	    add(*p0);
+    }
+
+    /// Precondición: k() == q.k()
+    void merge(const Quantile_sketch& q);
+
+    Quantile_sketch& operator+=(const Quantile_sketch& q)
+    {
+	merge(q);
+	return *this;
+    }
+
+    /// Número de elementos añadidos.
+    uint64_t count() const {return n_;}
+    bool empty() const {return n_ == 0;}
+    uint32_t k() const {return k_;}
+
+    /// Número de elementos que se guardan.
+    size_t num_retained() const {return size_;}
+
+    // Precondición: !empty()
+    T min() const {no_vacio("min"); return min_;}
+    T max() const {no_vacio("max"); return max_;}
+
+    /// Devuelve el valor x tal que el q * 100% de los datos son <= x.
+    /// Precondición: 0 <= q <= 1, !empty()
+    T quantile(double q) const;
+
+    /// Fracción de los datos que son <= x.
+    double rank(const T& x) const;
+
+    void save(std::ostream& out) const;
+    void load(std::istream& in);
+
+private:
+    static constexpr uint32_t marca = 0x4B4C4C31; // "KLL1"
+
+    uint32_t k_;
+    uint64_t n_ = 0;
+    T min_{};
+    T max_{};
+
+    std::vector<std::vector<T>> nivel_;
+    size_t size_ = 0;	    // número de elementos en nivel_
+    size_t max_size_ = 0;   // suma de las capacidades de los niveles
+
+    uint64_t random_ = 0x2545F4914F6CDD1Dull;	// xorshift
+
+    size_t capacidad(size_t h) const;
+    void actualiza_max_size();
+    void compacta();
+
+    bool random_bit()
+    {
+	random_ ^= random_ << 13;
+	random_ ^= random_ >> 7;
+	random_ ^= random_ << 17;
+	return random_ & 1;
+    }
+
+    void no_vacio(const char* funcion) const
+    {
+	if (n_ == 0)
+	    throw std::logic_error{std::string{"Quantile_sketch::"} + 
+		    funcion + ": no hay elementos"};
+    }
+
+    // Elementos guardados con su peso, ordenados.
+    std::vector<std::pair<T, uint64_t>> ordenados() const;
+};
+
+
+template <typename T>
+Quantile_sketch<T>::Quantile_sketch(uint32_t k)
+    : k_{k}
+{
+    if (k_ < 8)
+	throw std::invalid_argument{"Quantile_sketch: k tiene que ser >= 8"};
+
+    nivel_.resize(1);
+    actualiza_max_size();
+}
+
+
+// La capacidad decrece geométricamente (c = 2/3) desde el nivel más alto
+// hacia el 0.
+template <typename T>
+std::size_t Quantile_sketch<T>::capacidad(size_t h) const
+{
+    size_t prof = nivel_.size() - 1 - h;
+    double c = static_cast<double>(k_) * std::pow(2.0/3.0, prof);
+
+    return std::max<size_t>(2, static_cast<size_t>(std::ceil(c)));
+}
+
+
+template <typename T>
+void Quantile_sketch<T>::actualiza_max_size()
+{
+    max_size_ = 0;
+    for (size_t h = 0; h < nivel_.size(); ++h)
+	max_size_ += capacidad(h);
+}
+
+
+template <typename T>
+void Quantile_sketch<T>::add(const T& x)
+{
+    if (n_ == 0)
+	min_ = max_ = x;
+    else{
+	if (x < min_) min_ = x;
+	if (max_ < x) max_ = x;
+    }
+
+    ++n_;
+    nivel_[0].push_back(x);
+    ++size_;
+
+    if (size_ >= max_size_)
+	compacta();
+}
+
+
+// Compacta el primer nivel lleno.
+template <typename T>
+void Quantile_sketch<T>::compacta()
+{
+    for (size_t h = 0; h < nivel_.size(); ++h){
+	if (nivel_[h].size() < capacidad(h))
+	    continue;
+
+	if (h + 1 == nivel_.size()){
+	    nivel_.emplace_back();
+	    actualiza_max_size();
+	}
+
+	auto& v = nivel_[h];
+	std::sort(v.begin(), v.end());
+
+	// Si hay un número impar de elementos el primero se queda
+	size_t i0 = v.size() % 2;
+	for (size_t i = i0 + random_bit(); i < v.size(); i += 2)
+	    nivel_[h + 1].push_back(v[i]);
+
+	size_t antes = v.size();
+	v.resize(i0);
+	size_ -= antes - i0 - (antes - i0) / 2;
+
+	return;
+    }
+}
+
+
+template <typename T>
+void Quantile_sketch<T>::merge(const Quantile_sketch& q)
+{
+    if (q.k_ != k_)
+	throw std::invalid_argument{"Quantile_sketch::merge: k diferentes"};
+
+    if (q.n_ == 0)
+	return;
+
+    if (n_ == 0){
+	min_ = q.min_;
+	max_ = q.max_;
+    }
+    else {
+	if (q.min_ < min_) min_ = q.min_;
+	if (max_ < q.max_) max_ = q.max_;
+    }
+
+    if (nivel_.size() < q.nivel_.size()){
+	nivel_.resize(q.nivel_.size());
+	actualiza_max_size();
+    }
+
+    for (size_t h = 0; h < q.nivel_.size(); ++h)
+	nivel_[h].insert(nivel_[h].end(), q.nivel_[h].begin(), 
+					  q.nivel_[h].end());
+
+    n_ += q.n_;
+    size_ += q.size_;
+
+    while (size_ >= max_size_)
+	compacta();
+}
+
+
+template <typename T>
+std::vector<std::pair<T, uint64_t>> Quantile_sketch<T>::ordenados() const
+{
+    std::vector<std::pair<T, uint64_t>> res;
+    res.reserve(size_);
+
+    for (size_t h = 0; h < nivel_.size(); ++h)
+	for (auto& x: nivel_[h])
+	    res.push_back({x, uint64_t{1} << h});
+
+    std::sort(res.begin(), res.end(), 
+	    [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    return res;
+}
+
+
+template <typename T>
+T Quantile_sketch<T>::quantile(double q) const
+{
+    no_vacio("quantile");
+
+    if (q <= 0) return min_;
+    if (q >= 1) return max_;
+
+    auto v = ordenados();
+
+    double objetivo = q * static_cast<double>(n_);
+    uint64_t acumulado = 0;
+    for (auto& [x, peso]: v){
+	acumulado += peso;
+	if (static_cast<double>(acumulado) >= objetivo)
+	    return x;
+    }
+
+    return max_;
+}
+
+
+template <typename T>
+double Quantile_sketch<T>::rank(const T& x) const
+{
+    if (n_ == 0)
+	return 0;
+
+    uint64_t r = 0;
+    for (size_t h = 0; h < nivel_.size(); ++h)
+	for (auto& y: nivel_[h])
+	    if (!(x < y))
+		r += uint64_t{1} << h;
+
+    return static_cast<double>(r) / static_cast<double>(n_);
+}
+
+
+template <typename T>
+void Quantile_sketch<T>::save(std::ostream& out) const
+{
+    impl_of::write_marca(out, marca);
+    impl_of::write_binary(out, k_);
+    impl_of::write_binary(out, n_);
+    impl_of::write_binary(out, min_);
+    impl_of::write_binary(out, max_);
+    impl_of::write_binary(out, static_cast<uint64_t>(nivel_.size()));
+
+    for (auto& v: nivel_){
+	impl_of::write_binary(out, static_cast<uint64_t>(v.size()));
+	for (auto& x: v)
+	    impl_of::write_binary(out, x);
+    }
+}
+
+
+template <typename T>
+void Quantile_sketch<T>::load(std::istream& in)
+{
+    impl_of::read_marca(in, marca, "Quantile_sketch");
+
+    Quantile_sketch q{8};
+    impl_of::read_binary(in, q.k_);
+    impl_of::read_binary(in, q.n_);
+    impl_of::read_binary(in, q.min_);
+    impl_of::read_binary(in, q.max_);
+
+    uint64_t num_niveles;
+    impl_of::read_binary(in, num_niveles);
+    if (q.k_ < 8 or num_niveles == 0 or num_niveles > 64)
+	throw Error_de_formato{"Quantile_sketch::load: formato incorrecto"};
+
+    q.nivel_.resize(num_niveles);
+    q.actualiza_max_size();
+
+    // Después de add o merge siempre se cumple size_ < max_size_
+    q.size_ = 0;
+    for (auto& v: q.nivel_){
+	uint64_t n;
+	impl_of::read_binary(in, n);
+	if (n >= q.max_size_ - q.size_)
+	    throw Error_de_formato{"Quantile_sketch::load: formato incorrecto"};
+
+	impl_of::read_binary(in, v, n);
+	q.size_ += n;
+    }
+
+    if (q.size_ > q.n_)
+	throw Error_de_formato{"Quantile_sketch::load: formato incorrecto"};
+
+    *this = std::move(q);
+}
+
+
+
+/*!
+ *  \brief  Número aproximado de elementos diferentes (HyperLogLog).
+ *
+ *  Usa 2^p bytes. El error relativo es del orden de 1.04/sqrt(2^p) (con
+ *  p = 14, 16 KB y un error del 0.8%).
+ *
+ *  Ejemplo:
+ *  \code
+ *	Hyperloglog hll;
+ *	for (auto& user: eventos)
+ *	    hll.add(user);
+ *
+ *	std::cout << "Usuarios diferentes: " << hll.estimate() << '\n';
+ *  \endcode
+ */
+class Hyperloglog{
+public:
+    /// Precondición: 4 <= p <= 18
+    explicit Hyperloglog(uint8_t p = 14)
+	: p_{p}
+    {
+	if (p < 4 or p > 18)
+	    throw std::invalid_argument{
+		"Hyperloglog: la precisión tiene que estar en [4, 18]"};
+
+	reg_.assign(size_t{1} << p_, 0);
+    }
+
+    template <typename T>
+    void add(const T& x) { add_hash(impl_of::hash64(x)); }
+
+    /// Añade un elemento del que ya conocemos su hash de 64 bits.
+    void add_hash(uint64_t h)
+    {
+	size_t i = h >> (64 - p_);
+	// El bit de guarda garantiza que el resultado es <= 64 - p + 1
+	uint64_t w = (h << p_) | (uint64_t{1} << (p_ - 1));
+	uint8_t r = static_cast<uint8_t>(std::countl_zero(w) + 1);
+
+	if (r > reg_[i])
+	    reg_[i] = r;
+    }
+
+    /// Precondición: p() == h.p()
+    void merge(const Hyperloglog& h)
+    {
+	if (h.p_ != p_)
+	    throw std::invalid_argument{
+			    "Hyperloglog::merge: precisiones diferentes"};
+
+	for (size_t i = 0; i < reg_.size(); ++i)
+	    reg_[i] = std::max(reg_[i], h.reg_[i]);
+    }
+
+    Hyperloglog& operator+=(const Hyperloglog& h)
+    {
+	merge(h);
+	return *this;
+    }
+
+    uint8_t p() const {return p_;}
+
+    /// Número aproximado de elementos diferentes.
+    double estimate() const
+    {
+	double m = static_cast<double>(reg_.size());
+
+	double suma = 0;
+	size_t ceros = 0;
+	for (auto r: reg_){
+	    suma += std::ldexp(1.0, -r);
+	    ceros += (r == 0);
+	}
+
+	double e = alfa() * m * m / suma;
+
+	// Para pocos elementos es mejor contar los registros vacíos
+	if (e <= 2.5 * m and ceros != 0)
+	    return m * std::log(m / static_cast<double>(ceros));
+
+	return e;
+    }
+
+    void save(std::ostream& out) const
+    {
+	impl_of::write_marca(out, marca);
+	impl_of::write_binary(out, p_);
+	out.write(reinterpret_cast<const char*>(reg_.data()), reg_.size());
+    }
+
+    void load(std::istream& in)
+    {
+	impl_of::read_marca(in, marca, "Hyperloglog");
+
+	uint8_t p;
+	impl_of::read_binary(in, p);
+	if (p < 4 or p > 18)
+	    throw Error_de_formato{"Hyperloglog::load: precisión incorrecta"};
+
+	Hyperloglog h{p};
+
+	if (!in.read(reinterpret_cast<char*>(h.reg_.data()), h.reg_.size()))
+	    throw Error_de_formato{"Hyperloglog::load: fin de fichero"};
+
+	// add_hash nunca guarda un valor mayor que 64 - p + 1
+	for (auto r: h.reg_)
+	    if (r > 64 - p + 1)
+		throw Error_de_formato{"Hyperloglog::load: formato incorrecto"};
+
+	*this = std::move(h);
+    }
+
+private:
+    static constexpr uint32_t marca = 0x484C4C31; // "HLL1"
+
+    uint8_t p_;
+    std::vector<uint8_t> reg_;
+
+    // Constante de corrección del sesgo (Flajolet et al.). La fórmula
+    // general solo es válida para m >= 128.
+    double alfa() const
+    {
+	switch (reg_.size()){
+	    case 16: return 0.673;
+	    case 32: return 0.697;
+	    case 64: return 0.709;
+	}
+
+	double m = static_cast<double>(reg_.size());
+	return 0.7213 / (1 + 1.079 / m);
+    }
+};
+
+
+
+/*!
+ *  \brief  Frecuencia aproximada de cada elemento (Count-Min sketch).
+ *
+ *  Tabla de depth x width contadores. La frecuencia estimada nunca es
+ *  menor que la real, y con probabilidad 1 - e^-depth el error es menor
+ *  que e/width * count().
+ *
+ */
+template <typename T>
+class Count_min_sketch{
+public:
+    using value_type = T;
+    using size_t = ::std::size_t;
+
+    explicit Count_min_sketch(uint32_t width = 2048, uint32_t depth = 4)
+	: width_{width}, depth_{depth}, tabla_(size_t{width} * depth, 0)
+    {
+	if (width == 0 or depth == 0)
+	    throw std::invalid_argument{
+		"Count_min_sketch: width y depth tienen que ser > 0"};
+    }
+
+    /// Suma c a la frecuencia de x.
+    void add(const T& x, uint64_t c = 1)
+    {
+	uint64_t h = impl_of::hash64(x);
+	for (uint32_t i = 0; i < depth_; ++i)
+	    tabla_[indice(h, i)] += c;
+
+	n_ += c;
+    }
+
+    /// Frecuencia aproximada de x (>= frecuencia real).
+    uint64_t estimate(const T& x) const
+    {
+	uint64_t h = impl_of::hash64(x);
+	uint64_t res = tabla_[indice(h, 0)];
+	for (uint32_t i = 1; i < depth_; ++i)
+	    res = std::min(res, tabla_[indice(h, i)]);
+
+	return res;
+    }
+
+    /// Precondición: width() == c.width() and depth() == c.depth()
+    void merge(const Count_min_sketch& c)
+    {
+	if (c.width_ != width_ or c.depth_ != depth_)
+	    throw std::invalid_argument{
+		    "Count_min_sketch::merge: dimensiones diferentes"};
+
+	for (size_t i = 0; i < tabla_.size(); ++i)
+	    tabla_[i] += c.tabla_[i];
+
+	n_ += c.n_;
+    }
+
+    Count_min_sketch& operator+=(const Count_min_sketch& c)
+    {
+	merge(c);
+	return *this;
+    }
+
+    uint32_t width() const {return width_;}
+    uint32_t depth() const {return depth_;}
+
+    /// Suma de todas las frecuencias.
+    uint64_t count() const {return n_;}
+
+    void save(std::ostream& out) const
+    {
+	impl_of::write_marca(out, marca);
+	impl_of::write_binary(out, width_);
+	impl_of::write_binary(out, depth_);
+	impl_of::write_binary(out, n_);
+	out.write(reinterpret_cast<const char*>(tabla_.data()), 
+					tabla_.size() * sizeof(uint64_t));
+    }
+
+    void load(std::istream& in)
+    {
+	impl_of::read_marca(in, marca, "Count_min_sketch");
+
+	uint32_t w, d;
+	impl_of::read_binary(in, w);
+	impl_of::read_binary(in, d);
+	if (w == 0 or d == 0)
+	    throw Error_de_formato{
+			"Count_min_sketch::load: dimensiones incorrectas"};
+
+	// No reservamos la tabla hasta haberla leído
+	Count_min_sketch c{1, 1};
+	c.width_ = w;
+	c.depth_ = d;
+	impl_of::read_binary(in, c.n_);
+	impl_of::read_binary(in, c.tabla_, uint64_t{w} * d);
+
+	*this = std::move(c);
+    }
+
+private:
+    static constexpr uint32_t marca = 0x434D5331; // "CMS1"
+
+    uint32_t width_;
+    uint32_t depth_;
+    uint64_t n_ = 0;
+    std::vector<uint64_t> tabla_;
+
+    // Las depth funciones hash se obtienen de una: h1 + i*h2
+    size_t indice(uint64_t h, uint32_t i) const
+    {
+	uint32_t h1 = static_cast<uint32_t>(h);
+	uint32_t h2 = static_cast<uint32_t>(h >> 32) | 1;
+
+	return size_t{i} * width_ + (h1 + i * h2) % width_;
+    }
+};
+
+
+
+/*!
+ *  \brief  Los k elementos más frecuentes de un flujo (heavy hitters).
+ *
+ *  Usa un Count_min_sketch para estimar las frecuencias y guarda los k
+ *  candidatos con mayor frecuencia estimada.
+ *
+ *  Ejemplo:
+ *  \code
+ *	Top_k<std::string> top{10};
+ *	for (auto& url: peticiones)
+ *	    top.add(url);
+ *
+ *	for (auto& [url, n]: top.as_sorted_vector())
+ *	    std::cout << url << " = " << n << '\n';
+ *  \endcode
+ */
+template <typename T>
+class Top_k{
+public:
+    using value_type = T;
+    using size_t = ::std::size_t;
+
+    /// Precondición: k > 0
+    explicit Top_k(size_t k, uint32_t width = 2048, uint32_t depth = 4)
+	: k_{k}, cms_{width, depth} 
+    { 
+	if (k == 0)
+	    throw std::invalid_argument{"Top_k: k tiene que ser > 0"};
+
+	candidato_.reserve(k + 1); 
+    }
+
+    void add(const T& x, uint64_t c = 1)
+    {
+	cms_.add(x, c);
+	actualiza(x, cms_.estimate(x));
+    }
+
+    void merge(const Top_k& t);
+
+    Top_k& operator+=(const Top_k& t)
+    {
+	merge(t);
+	return *this;
+    }
+
+    size_t k() const {return k_;}
+
+    /// Frecuencia aproximada de x.
+    uint64_t estimate(const T& x) const {return cms_.estimate(x);}
+
+    /// Suma de todas las frecuencias.
+    uint64_t count() const {return cms_.count();}
+
+    /// Los (como mucho) k elementos más frecuentes, ordenados de mayor a
+    /// menor frecuencia (igual que Frequency_table::as_sorted_vector).
+    std::vector<std::pair<T, size_t>> as_sorted_vector() const;
+
+    void save(std::ostream& out) const;
+    void load(std::istream& in);
+
+private:
+    static constexpr uint32_t marca = 0x544F504B; // "TOPK"
+
+    size_t k_;
+    Count_min_sketch<T> cms_;
+
+    // Candidatos con su frecuencia estimada. Como k es pequeño basta con
+    // un vector.
+    std::vector<std::pair<T, uint64_t>> candidato_;
+    uint64_t min_ = 0;	// frecuencia mínima de los candidatos
+
+    void actualiza(const T& x, uint64_t f);
+    void calcula_min();
+};
+
+
+template <typename T>
+void Top_k<T>::calcula_min()
+{
+    min_ = candidato_.empty()? 0 : candidato_.front().second;
+    for (auto& c: candidato_)
+	min_ = std::min(min_, c.second);
+}
+
+
+template <typename T>
+void Top_k<T>::actualiza(const T& x, uint64_t f)
+{
+    if (candidato_.size() == k_ and f <= min_)
+	return;
+
+    auto p = std::find_if(candidato_.begin(), candidato_.end(),
+			[&](const auto& c) { return c.first == x; });
+
+    if (p != candidato_.end())
+	p->second = f;
+
+    else if (candidato_.size() < k_)
+	candidato_.push_back({x, f});
+
+    else {// sustituimos al de menor frecuencia
+	auto q = std::min_element(candidato_.begin(), candidato_.end(),
+		[](const auto& a, const auto& b) { return a.second < b.second; });
+	*q = {x, f};
+    }
+
+    calcula_min();
+}
+
+
+template <typename T>
+void Top_k<T>::merge(const Top_k& t)
+{
+    cms_.merge(t.cms_);
+
+    // Las frecuencias de los candidatos de los dos hay que reestimarlas
+    auto candidatos = std::move(candidato_);
+    candidatos.insert(candidatos.end(), t.candidato_.begin(), 
+					t.candidato_.end());
+
+    candidato_.clear();
+    min_ = 0;
+    for (auto& c: candidatos)
+	actualiza(c.first, cms_.estimate(c.first));
+}
+
+
+template <typename T>
+std::vector<std::pair<T, std::size_t>> Top_k<T>::as_sorted_vector() const
+{
+    std::vector<std::pair<T, size_t>> res{candidato_.begin(), 
+					  candidato_.end()};
+
+    std::sort(res.begin(), res.end(), [](const auto& a, const auto& b) {
+					    return a.second > b.second; });
+    return res;
+}
+
+
+template <typename T>
+void Top_k<T>::save(std::ostream& out) const
+{
+    impl_of::write_marca(out, marca);
+    impl_of::write_binary(out, static_cast<uint64_t>(k_));
+    cms_.save(out);
+
+    impl_of::write_binary(out, static_cast<uint64_t>(candidato_.size()));
+    for (auto& [x, f]: candidato_){
+	impl_of::write_binary(out, x);
+	impl_of::write_binary(out, f);
+    }
+}
+
+
+template <typename T>
+void Top_k<T>::load(std::istream& in)
+{
+    impl_of::read_marca(in, marca, "Top_k");
+
+    uint64_t k;
+    impl_of::read_binary(in, k);
+    if (k == 0 or k > std::numeric_limits<size_t>::max())
+	throw Error_de_formato{"Top_k::load: formato incorrecto"};
+
+    // No reservamos los k candidatos: k viene del fichero
+    Top_k t{1, 1, 1};
+    t.k_ = static_cast<size_t>(k);
+    t.cms_.load(in);
+
+    uint64_t n;
+    impl_of::read_binary(in, n);
+    if (n > k)
+	throw Error_de_formato{"Top_k::load: formato incorrecto"};
+
+    impl_of::read_binary(in, t.candidato_, n);
+
+    t.calcula_min();
+    *this = std::move(t);
+}
+
+
+}// namespace
+
+#endif
@@ -16,6 +16,9 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "alp_string.h"
+#include "alp_text_layout.h"
+
+#include <cstring>
 
 
 using std::string;
@@ -71,19 +74,25 @@ std::string ltrim(const std::string& s)
 }
 
 
-// cuenta el número de líneas que tiene la cadena [begin, end).
-unsigned num_lineas(std::string::const_iterator begin, 
-	    std::string::const_iterator end)
+// cuenta el número de líneas que tiene la cadena [p0, pe).
+size_t num_lineas(const char* p0, const char* pe)
 {
-    if(begin == end) 
+    if (p0 == pe)
 	return 0;
 
-    for(;begin != end; ++begin){
-	 if(*begin == '\n')
-		return num_lineas(++begin, end) + 1;
+    size_t n = 0;
+    const char* q;
+    while ((q = static_cast<const char*>(std::memchr(p0, '\n', pe - p0)))
+								!= nullptr){
+	++n;
+	p0 = q + 1;
     }
 
-    return 1;
+    // La última línea no acaba en '\n'
+    if (p0 != pe)
+	++n;
+
+    return n;
 }
 
 
@@ -131,14 +140,21 @@ std::string split_lineas_ancho(const std::string& s, unsigned ancho_max)
 {
     std::string res = s;
 
-    std::string::iterator first = begin(res);
-    std::string::iterator last = end(res);
-
-    while(first != last)
-	first = cambia_ultimo_espacio_por_enter(first, last, ancho_max);
+    wrap_lines(res.data(), res.data() + res.size(), ancho_max, res.data());
 
     return res;
+}
+
+
+void mismo_ancho_y_centradas(std::string& s1, std::string& s2)
+{
+    size_t n1 = display_width(s1);
+    size_t n2 = display_width(s2);
 
+    if(n1 == n2) return;
+    if(n1 > n2)
+	s2 = add_centrados(s2, n1-n2, ' ');
+    else s1 = add_centrados(s1, n2-n1, ' ');
 }
 
 // Devuelve el basename (nombre del fichero, incluida la extensión)
@@ -25,23 +25,23 @@
 #include <algorithm>
 #include <sstream>  // stringstream
 #include <cctype>
+#include <memory>   // to_address
+#include <string_view>
+#include <charconv> // to_chars/from_chars
+#include <cstring>  // memcpy
+#include <ostream>
+#include <type_traits>
+#include <limits>   // numeric_limits
 
 namespace alp{
 
 // convertimos un tipo A en un tipo B
 // auto x = to<int>("3");
 // auto x = to<string>(3);
+// Las conversiones número <-> cadena no usan std::stringstream (ver
+// to_chars/from_chars más abajo).
 template<typename B, typename A>
-inline B to(A x)
-{
-    B y;
-
-    std::stringstream s;
-    s << x;
-    s >> y;
-
-    return y;
-}
+B to(A x);
 
 // Cuando la representación de cadena de A tiene espacios (como ColorRGB),
 // la función to<string> falla, ya que solo devuelve el primer color, hasta el
@@ -49,16 +49,7 @@ inline B to(A x)
 // TODO: hacer una especialización de to<string>!!!
 // TODO: ¿esta no es la función estandar std::to_string??? <--- Sí!!!
 template<typename A>
-inline std::string to_string(A x)
-{
-    std::string y;
-
-    std::stringstream s;
-    s << x;
-    y = s.str();
-
-    return y;
-}
+std::string to_string(A x);
 
 
 /*!
@@ -89,6 +80,313 @@ struct as_str{
 };
 
 
+
+
+/***************************************************************************
+ *		    FORMATEO SIN std::stringstream
+ ***************************************************************************/
+// as_str es muy cómoda pero cada llamada crea un std::stringstream (locale,
+// funciones virtuales, memoria dinámica...). as_chars y Str_writer tienen
+// la misma sintaxis pero escriben los números con std::to_chars:
+//	as_chars: escribe en un buffer en la pila (no usa memoria dinámica).
+//	Str_writer: escribe en una std::string que se puede reutilizar.
+//
+// Los números en coma flotante se escriben igual que los escribe por
+// defecto std::ostream (%g con 6 cifras), para que los mensajes no cambien
+// al pasar de as_str a as_chars.
+
+/// Para escribir enteros en hexadecimal: as_chars() << hex(c);
+/// (equivale a out << std::hex << x).
+template <typename Int>
+struct Hex{
+    Int x;
+};
+
+template <typename Int>
+inline Hex<std::make_unsigned_t<Int>> hex(Int x)
+{ return {static_cast<std::make_unsigned_t<Int>>(x)}; }
+
+
+namespace impl_of{
+// Número máximo de caracteres que ocupa un número escrito con to_chars.
+constexpr size_t max_chars_number = 64;
+
+template <typename T>
+concept Is_string_like = std::is_convertible_v<const T&, std::string_view>;
+
+// std::ostream escribe char, signed char y unsigned char (uint8_t) como
+// caracteres, no como números.
+template <typename T>
+concept Is_char = std::is_same_v<T, char> or std::is_same_v<T, signed char>
+		  or std::is_same_v<T, unsigned char>;
+
+// Escribe el número x en buf. Devuelve el número de caracteres escritos.
+// Precondición: buf tiene, como mínimo, max_chars_number caracteres.
+template <typename T>
+size_t number_to_chars(char* buf, const T& x)
+{
+    std::to_chars_result res;
+
+    if constexpr (std::is_floating_point_v<T>)
+	res = std::to_chars(buf, buf + max_chars_number, x,
+				    std::chars_format::general, 6);
+    else
+	res = std::to_chars(buf, buf + max_chars_number, x);
+
+    return res.ptr - buf;
+}
+
+
+/// streambuf que escribe en un Writer (as_chars, Str_writer). Lo usamos para
+/// los tipos que solo se pueden escribir con operator<<(std::ostream&).
+template <typename Writer>
+class Writer_streambuf : public std::streambuf{
+public:
+    explicit Writer_streambuf(Writer& w) : w_{w} {}
+
+protected:
+    int_type overflow(int_type c) override
+    {
+	if (!traits_type::eq_int_type(c, traits_type::eof())){
+	    char ch = traits_type::to_char_type(c);
+	    w_.append(&ch, 1);
+	}
+
+	return c;
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+	w_.append(s, static_cast<size_t>(n));
+	return n;
+    }
+
+private:
+    Writer& w_;
+};
+
+
+/// Implementación común de operator<< de as_chars y Str_writer.
+/// Writer tiene que definir append(const char* p, size_t n).
+template <typename Writer, typename T>
+void write(Writer& w, const T& x)
+{
+    if constexpr (Is_char<T>){	// igual que std::ostream: como caracter
+	char c = static_cast<char>(x);
+	w.append(&c, 1);
+    }
+
+    else if constexpr (std::is_same_v<T, bool>)
+	w.append(x? "1": "0", 1);   // igual que std::ostream
+
+    else if constexpr (std::is_arithmetic_v<T>){
+	char buf[max_chars_number];
+	w.append(buf, number_to_chars(buf, x));
+    }
+
+    else if constexpr (Is_string_like<T>){
+	std::string_view s = x;
+	w.append(s.data(), s.size());
+    }
+
+    else{ // tipos de usuario: usamos su operator<<
+	Writer_streambuf<Writer> buf{w};
+	std::ostream out{&buf};
+	out << x;
+    }
+}
+
+template <typename Writer, typename Int>
+void write(Writer& w, const Hex<Int>& h)
+{
+    char buf[max_chars_number];
+    auto res = std::to_chars(buf, buf + max_chars_number, h.x, 16);
+    w.append(buf, res.ptr - buf);
+}
+
+}// namespace impl_of
+
+
+/*!
+ *  \brief  Como as_str, pero escribe en un buffer de N caracteres en la pila.
+ *
+ *  No usa memoria dinámica (salvo al convertirlo en std::string). Si el
+ *  texto no cabe en el buffer se trunca y se marca acabándolo en "..."
+ *  (ver truncated()). Para los mensajes de las excepciones, que pueden
+ *  tener cualquier longitud, usar as_str.
+ *
+ *  Ejemplo:
+ *	log(as_chars() << "f(" << x << ", " << y << ")");
+ *
+ */
+template <size_t N = 256>
+class as_chars{
+public:
+    as_chars() {buf_[0] = '\0';}
+
+    template <typename T>
+    as_chars& operator<<(const T& x)
+    {
+	impl_of::write(*this, x);
+	return *this;
+    }
+
+    /// Añade [p, p + n) al final de la cadena.
+    void append(const char* p, size_t n)
+    {
+	if (truncated_)
+	    return;
+
+	if (n > N - n_){
+	    n = N - n_;
+	    truncated_ = true;
+	}
+
+	std::memcpy(buf_ + n_, p, n);
+	n_ += n;
+
+	if (truncated_)	// que se vea que se ha truncado
+	    for (size_t i = (N < 3? 0: N - 3); i < N; ++i)
+		buf_[i] = '.';
+
+	buf_[n_] = '\0';
+    }
+
+    size_t size() const {return n_;}
+
+    /// ¿Se ha truncado el texto por no caber en el buffer?
+    bool truncated() const {return truncated_;}
+
+    std::string_view view() const {return std::string_view{buf_, n_};}
+    const char* c_str() const {return buf_;}
+
+    operator std::string() const {return std::string{buf_, n_};}
+
+    friend std::ostream& operator<<(std::ostream& out, const as_chars& s)
+    { return out << s.view(); }
+
+private:
+    char buf_[N + 1];	// + 1 para el '\0' final
+    size_t n_ = 0;
+    bool truncated_ = false;
+};
+
+
+/*!
+ *  \brief  Como as_str, pero escribe en la std::string que se le pasa.
+ *
+ *  Al construirlo se borra el contenido de la cadena pero no su memoria, de
+ *  tal manera que si se reutiliza la cadena no hay que volver a pedir
+ *  memoria.
+ *
+ *  Ejemplo:
+ *	std::string msg;    // la reutilizamos en cada iteración
+ *	for (...){
+ *	    Str_writer{msg} << "i = " << i << "; x = " << x;
+ *	    log(msg);
+ *	}
+ *
+ */
+class Str_writer{
+public:
+    explicit Str_writer(std::string& s) : s_{s} {s_.clear();}
+
+    template <typename T>
+    Str_writer& operator<<(const T& x)
+    {
+	impl_of::write(*this, x);
+	return *this;
+    }
+
+    void append(const char* p, size_t n) {s_.append(p, n);}
+
+    const std::string& str() const {return s_;}
+
+    operator std::string() const {return s_;}
+
+private:
+    std::string& s_;
+};
+
+
+/***************************************************************************
+ *				to/to_string
+ ***************************************************************************/
+template<typename B, typename A>
+B to(A x)
+{
+    if constexpr (std::is_same_v<B, std::string> and
+		  std::is_arithmetic_v<A> and !impl_of::Is_char<A>)
+	return to_string(x);
+
+    else if constexpr (std::is_arithmetic_v<B> and 
+		       !impl_of::Is_char<B> and !std::is_same_v<B, bool> and
+		       impl_of::Is_string_like<A>){
+	// Igual que operator>>: ignoramos el whitespace inicial. 
+	std::string_view s = x;
+	const char* p = s.data();
+	const char* pe = p + s.size();
+
+	while (p != pe and std::isspace(static_cast<unsigned char>(*p)))
+	    ++p;
+
+	if (p != pe and *p == '+')  // from_chars no admite '+'
+	    ++p;
+
+	B y{};
+	auto ec = std::from_chars(p, pe, y).ec;
+	if (ec == std::errc::result_out_of_range){
+	    // Igual que operator>>: los enteros se saturan. Con coma flotante
+	    // puede ser overflow o underflow: lo dejamos a operator>>.
+	    if constexpr (std::is_integral_v<B>)
+		return (*p == '-')? std::numeric_limits<B>::lowest():
+				    std::numeric_limits<B>::max();
+	    else{
+		std::stringstream ss{std::string{p, pe}};
+		ss >> y;
+		return y;
+	    }
+	}
+
+	if (ec != std::errc{})
+	    return B{};
+
+	return y;
+    }
+
+    else{
+	B y;
+
+	std::stringstream s;
+	s << x;
+	s >> y;
+
+	return y;
+    }
+}
+
+
+template<typename A>
+std::string to_string(A x)
+{
+    if constexpr (std::is_arithmetic_v<A>)
+	return as_chars<impl_of::max_chars_number>() << x;
+
+    else if constexpr (impl_of::Is_string_like<A>)
+	return std::string{std::string_view{x}};
+
+    else{
+	std::string y;
+
+	std::stringstream s;
+	s << x;
+	y = s.str();
+
+	return y;
+    }
+}
+
+
 /// Busca el primer caracter no whitespace = [ \t\n\v...]
 /// Si no lo encuentra devuelve pe.
 //template <typename It>
@@ -129,16 +427,15 @@ struct as_str{
  */
 inline std::string add_centrados(const std::string& s, int n, char c)
 {
-    std::string res;
+    if (n < 0) n = 0;
     int m = n/2;    // la mitad
 
-    for(int i = 0; i < m; ++i)
-	res+=c;
-    
-    res+=s;
+    std::string res;
+    res.reserve(s.size() + n);
 
-    for(int i = m; i < n; ++i)
-	res+=c;
+    res.append(m, c);
+    res.append(s);
+    res.append(n - m, c);
 
     return res;
 }
@@ -158,27 +455,12 @@ inline std::string add_centrados(const std::string& s, int n, char c)
  *	    >>> s1 = "  hola   "
  *		s2 = "nos vemos"
  *
- *   - TODO: funciona mal con los acentos!!!
- *	     La cadena string s="está" tiene 5 caracteres, no 4!!!  
- *	     length() considera que 'á' son 2 caracteres!!!
- *
- *	     ¿No sería mejor hacer:
- *		mismo_ancho(s1, s2); // añade espacios al final para igualar
- *				    // anchos.
- *		centra(s1);
- *		centra(s2);???
+ *   - COMENTARIOS: El ancho es el número de columnas que ocupan en
+ *	    pantalla (ver display_width en alp_text_layout.h), no el número
+ *	    de bytes: "está" ocupa 4 columnas aunque tenga 5 bytes.
  *
  ****************************************************************************/
-inline void mismo_ancho_y_centradas(std::string& s1, std::string& s2)
-{
-    int n1 = s1.length();
-    int n2 = s2.length();
-
-    if(n1 == n2) return;
-    if(n1 > n2)
-	s2 = add_centrados(s2, n1-n2, ' ');
-    else s1 = add_centrados(s1, n2-n1, ' ');
-}
+void mismo_ancho_y_centradas(std::string& s1, std::string& s2);
 
 
 
@@ -313,12 +595,21 @@ std::pair<std::string, std::string> split_into_directory_and_name(
 
 
 
+/// Cuenta el número de líneas que tiene la cadena [p0, pe).
+/// Busca los '\n' con memchr, así que se puede usar con ficheros grandes
+/// (por ejemplo, mapeados en memoria).
+size_t num_lineas(const char* p0, const char* pe);
+
 /// Cuenta el número de líneas que tiene la cadena [begin, end).
 /// 
 /// Ejemplo: la cadena s = "Esto\nes\nuna\prueba", tiene 4 líneas.
 /// Usamos '\n' como separador entre líneas.
-unsigned num_lineas(std::string::const_iterator begin, 
-	    std::string::const_iterator end);
+inline unsigned num_lineas(std::string::const_iterator begin, 
+	    std::string::const_iterator end)
+{ 
+    return static_cast<unsigned>(
+		num_lineas(std::to_address(begin), std::to_address(end))); 
+}
 
 /// Cuenta el número de líneas que tiene la cadena s.
 /// 
@@ -336,6 +627,8 @@ auto cambia_ultimo_espacio_por_enter( std::string::iterator begin
 				, unsigned ancho_max);
 
 /// Divide la 'texto' en lineas de longitud máxima 'ancho_max'.
+/// La longitud es el número de columnas que ocupa en pantalla (ver
+/// wrap_lines en alp_text_layout.h).
 // DUDA: ¿en lugar de usar int ancho_max usar Maximo<int> ancho?
 std::string split_lineas_ancho(const std::string& texto, unsigned ancho_max);
 
@@ -0,0 +1,363 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "alp_text_layout.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace alp{
+
+/***************************************************************************
+ *			    TABLAS DE ANCHOS
+ ***************************************************************************/
+namespace {
+// Rango de code points [first, last]
+struct Rango{
+    char32_t first, last;
+};
+
+// Caracteres que no ocupan espacio: marcas combinadas (acentos,
+// diacríticos...), selectores de variación y caracteres de formato.
+// Fuente: Unicode, categorías Mn, Me y Cf (los bloques más habituales).
+constexpr Rango ancho_cero[] = {
+    {0x0300, 0x036F}, {0x0483, 0x0489}, {0x0591, 0x05BD}, {0x05BF, 0x05BF},
+    {0x05C1, 0x05C2}, {0x05C4, 0x05C5}, {0x05C7, 0x05C7}, {0x0610, 0x061A},
+    {0x064B, 0x065F}, {0x0670, 0x0670}, {0x06D6, 0x06DC}, {0x06DF, 0x06E4},
+    {0x06E7, 0x06E8}, {0x06EA, 0x06ED}, {0x0711, 0x0711}, {0x0730, 0x074A},
+    {0x07A6, 0x07B0}, {0x07EB, 0x07F3}, {0x0816, 0x0819}, {0x081B, 0x0823},
+    {0x0825, 0x0827}, {0x0829, 0x082D}, {0x0859, 0x085B}, {0x08D3, 0x08E1},
+    {0x08E3, 0x0902}, {0x093A, 0x093A}, {0x093C, 0x093C}, {0x0941, 0x0948},
+    {0x094D, 0x094D}, {0x0951, 0x0957}, {0x0962, 0x0963}, {0x0981, 0x0981},
+    {0x09BC, 0x09BC}, {0x09C1, 0x09C4}, {0x09CD, 0x09CD}, {0x09E2, 0x09E3},
+    {0x0E31, 0x0E31}, {0x0E34, 0x0E3A}, {0x0E47, 0x0E4E}, {0x0EB1, 0x0EB1},
+    {0x0EB4, 0x0EBC}, {0x0EC8, 0x0ECD}, {0x1AB0, 0x1AFF}, {0x1DC0, 0x1DFF},
+    {0x200B, 0x200F}, {0x202A, 0x202E}, {0x2060, 0x2064}, {0x20D0, 0x20F0},
+    {0x302A, 0x302D}, {0x3099, 0x309A}, {0xFE00, 0xFE0F}, {0xFE20, 0xFE2F},
+    {0xFEFF, 0xFEFF}, {0x1D167, 0x1D169}, {0x1D173, 0x1D182}, 
+    {0xE0001, 0xE0001}, {0xE0020, 0xE007F}, {0xE0100, 0xE01EF}
+};
+
+// Caracteres que ocupan 2 columnas.
+// Fuente: Unicode, EastAsianWidth.txt, valores W y F.
+constexpr Rango ancho_doble[] = {
+    {0x1100, 0x115F}, {0x231A, 0x231B}, {0x2329, 0x232A}, {0x23E9, 0x23EC},
+    {0x23F0, 0x23F0}, {0x23F3, 0x23F3}, {0x25FD, 0x25FE}, {0x2614, 0x2615},
+    {0x2648, 0x2653}, {0x267F, 0x267F}, {0x2693, 0x2693}, {0x26A1, 0x26A1},
+    {0x26AA, 0x26AB}, {0x26BD, 0x26BE}, {0x26C4, 0x26C5}, {0x26CE, 0x26CE},
+    {0x26D4, 0x26D4}, {0x26EA, 0x26EA}, {0x26F2, 0x26F3}, {0x26F5, 0x26F5},
+    {0x26FA, 0x26FA}, {0x26FD, 0x26FD}, {0x2705, 0x2705}, {0x270A, 0x270B},
+    {0x2728, 0x2728}, {0x274C, 0x274C}, {0x274E, 0x274E}, {0x2753, 0x2755},
+    {0x2757, 0x2757}, {0x2795, 0x2797}, {0x27B0, 0x27B0}, {0x27BF, 0x27BF},
+    {0x2B1B, 0x2B1C}, {0x2B50, 0x2B50}, {0x2B55, 0x2B55}, {0x2E80, 0x3029},
+    {0x302E, 0x303E}, {0x3041, 0x3098}, {0x309B, 0x33FF}, {0x3400, 0x4DBF},
+    {0x4E00, 0x9FFF}, {0xA000, 0xA4CF}, {0xA960, 0xA97F}, {0xAC00, 0xD7A3},
+    {0xF900, 0xFAFF}, {0xFE10, 0xFE19}, {0xFE30, 0xFE6F}, {0xFF00, 0xFF60},
+    {0xFFE0, 0xFFE6}, {0x16FE0, 0x16FE4}, {0x17000, 0x18AFF},
+    {0x1B000, 0x1B2FF}, {0x1F004, 0x1F004}, {0x1F0CF, 0x1F0CF},
+    {0x1F18E, 0x1F18E}, {0x1F191, 0x1F19A}, {0x1F200, 0x1F202},
+    {0x1F210, 0x1F23B}, {0x1F240, 0x1F248}, {0x1F250, 0x1F251},
+    {0x1F260, 0x1F265}, {0x1F300, 0x1F320}, {0x1F32D, 0x1F335},
+    {0x1F337, 0x1F37C}, {0x1F37E, 0x1F393}, {0x1F3A0, 0x1F3CA},
+    {0x1F3CF, 0x1F3D3}, {0x1F3E0, 0x1F3F0}, {0x1F3F4, 0x1F3F4},
+    {0x1F3F8, 0x1F43E}, {0x1F440, 0x1F440}, {0x1F442, 0x1F4FC},
+    {0x1F4FF, 0x1F53D}, {0x1F54B, 0x1F54E}, {0x1F550, 0x1F567},
+    {0x1F57A, 0x1F57A}, {0x1F595, 0x1F596}, {0x1F5A4, 0x1F5A4},
+    {0x1F5FB, 0x1F64F}, {0x1F680, 0x1F6C5}, {0x1F6CC, 0x1F6CC},
+    {0x1F6D0, 0x1F6D2}, {0x1F6D5, 0x1F6D7}, {0x1F6EB, 0x1F6EC},
+    {0x1F6F4, 0x1F6FC}, {0x1F7E0, 0x1F7EB}, {0x1F90C, 0x1F93A},
+    {0x1F93C, 0x1F945}, {0x1F947, 0x1F9FF}, {0x1FA70, 0x1FAFF},
+    {0x20000, 0x2FFFD}, {0x30000, 0x3FFFD}
+};
+
+
+// Las búsquedas binarias necesitan que los rangos estén ordenados y no se
+// solapen.
+template <size_t N>
+constexpr bool esta_ordenada(const Rango (&t)[N])
+{
+    for (size_t i = 0; i < N; ++i){
+	if (t[i].first > t[i].last)
+	    return false;
+
+	if (i > 0 and t[i - 1].last >= t[i].first)
+	    return false;
+    }
+
+    return true;
+}
+
+static_assert(esta_ordenada(ancho_cero));
+static_assert(esta_ordenada(ancho_doble));
+
+
+template <size_t N>
+inline bool pertenece(char32_t c, const Rango (&t)[N])
+{
+    if (c < t[0].first or c > t[N - 1].last)
+	return false;
+
+    auto p = std::upper_bound(std::begin(t), std::end(t), c,
+		    [](char32_t c, const Rango& r) { return c < r.first; });
+
+    // p apunta al primer rango con first > c
+    return p != std::begin(t) and c <= std::prev(p)->last;
+}
+
+}// namespace
+
+
+
+/***************************************************************************
+ *			    ANCHO EN PANTALLA
+ ***************************************************************************/
+char32_t utf8_decode(const char*& p, const char* pe)
+{
+    constexpr char32_t sustitucion = 0xFFFD;
+
+    unsigned char c0 = static_cast<unsigned char>(*p);
+
+    int n;
+    char32_t c;
+    if (c0 < 0x80)		    {++p; return c0;}
+    else if ((c0 & 0xE0) == 0xC0)   {n = 2; c = c0 & 0x1F;}
+    else if ((c0 & 0xF0) == 0xE0)   {n = 3; c = c0 & 0x0F;}
+    else if ((c0 & 0xF8) == 0xF0)   {n = 4; c = c0 & 0x07;}
+    else			    {++p; return sustitucion;}
+
+    if (pe - p < n){
+	++p;
+	return sustitucion;
+    }
+
+    for (int i = 1; i < n; ++i){
+	unsigned char ci = static_cast<unsigned char>(p[i]);
+	if ((ci & 0xC0) != 0x80){
+	    ++p;
+	    return sustitucion;
+	}
+
+	c = (c << 6) | (ci & 0x3F);
+    }
+
+    p += n;
+    return c;
+}
+
+
+int display_width(char32_t c)
+{
+    // Caracteres de control
+    if (c < 0x20 or (0x7F <= c and c < 0xA0))
+	return 0;
+
+    // Antes de 0x0300 no hay ni caracteres combinados ni dobles
+    if (c < 0x0300)
+	return 1;
+
+    if (pertenece(c, ancho_cero))
+	return 0;
+
+    if (pertenece(c, ancho_doble))
+	return 2;
+
+    return 1;
+}
+
+
+size_t display_width(const char* p0, const char* pe)
+{
+    size_t n = 0;
+
+    while (p0 != pe){
+	// Camino rápido: ASCII imprimible
+	unsigned char c = static_cast<unsigned char>(*p0);
+	if (0x20 <= c and c < 0x7F){
+	    ++n;
+	    ++p0;
+	}
+	else
+	    n += display_width(utf8_decode(p0, pe));
+    }
+
+    return n;
+}
+
+
+/***************************************************************************
+ *			    DIVISIÓN EN LÍNEAS
+ ***************************************************************************/
+// Vamos copiando [p0, pe) en out. Cuando la línea se pasa de ancho_max
+// cambiamos el último espacio por '\n'. Para no tener que volver atrás
+// llevamos la cuenta del ancho que hay desde el último espacio.
+char* wrap_lines(const char* p0, const char* pe, size_t ancho_max, char* out)
+{
+    if (out != p0)
+	std::memcpy(out, p0, pe - p0);
+
+    size_t ancho_linea = 0;	    // ancho de la línea actual
+    size_t ancho_tras_espacio = 0;  // ancho desde el último espacio
+    char* ultimo_espacio = nullptr; // último espacio de la línea actual
+
+    const char* p = p0;
+    while (p != pe){
+	char* q = out + (p - p0);
+
+	if (*p == '\n'){
+	    ancho_linea = 0;
+	    ultimo_espacio = nullptr;
+	    ++p;
+	}
+
+	else if (*p == ' '){
+	    if (ancho_linea >= ancho_max){ // la línea ya está llena
+		*q = '\n';
+		ancho_linea = 0;
+		ultimo_espacio = nullptr;
+	    }
+	    else{
+		ultimo_espacio = q;
+		ancho_tras_espacio = 0;
+		++ancho_linea;
+	    }
+
+	    ++p;
+	}
+
+	else{
+	    size_t w = display_width(utf8_decode(p, pe));
+
+	    if (ancho_linea + w > ancho_max and ultimo_espacio != nullptr){
+		*ultimo_espacio = '\n';
+		ancho_linea = ancho_tras_espacio;
+		ultimo_espacio = nullptr;
+	    }
+
+	    ancho_linea += w;
+	    ancho_tras_espacio += w;
+	}
+    }
+
+    return out + (pe - p0);
+}
+
+
+
+/***************************************************************************
+ *			    ALINEACIÓN
+ ***************************************************************************/
+void append_alineado(std::string& out, std::string_view s, size_t ancho_s,
+		     size_t ancho, Alineacion al, char c)
+{
+    size_t n = (ancho > ancho_s)? ancho - ancho_s : 0;	// relleno
+
+    size_t izq = 0;
+    if (al == Alineacion::derecha)
+	izq = n;
+
+    else if (al == Alineacion::centro)
+	izq = n / 2;
+
+    out.append(izq, c);
+    out.append(s);
+    out.append(n - izq, c);
+}
+
+
+void append_alineado(std::string& out, std::string_view s, size_t ancho,
+		     Alineacion al, char c)
+{ append_alineado(out, s, display_width(s), ancho, al, c); }
+
+
+
+/***************************************************************************
+ *				Text_table
+ ***************************************************************************/
+Text_table::Text_table(size_t num_cols, std::string sep)
+    : num_cols_{num_cols}, sep_{std::move(sep)},
+      alineacion_(num_cols, Alineacion::izquierda),
+      ancho_(num_cols, 0)
+{
+    if (num_cols == 0)
+	throw std::invalid_argument{"Text_table: la tabla tiene que tener "
+				    "alguna columna"};
+}
+
+
+void Text_table::reserve(size_t num_rows, size_t num_bytes)
+{
+    celdas_.reserve(num_rows * num_bytes);
+    fin_celda_.reserve(num_rows * num_cols_);
+    ancho_celda_.reserve(num_rows * num_cols_);
+}
+
+
+void Text_table::end_cell(size_t j)
+{
+    size_t ini = fin_celda_.empty()? 0 : fin_celda_.back();
+    size_t w = display_width(celdas_.data() + ini, 
+			     celdas_.data() + celdas_.size());
+
+    fin_celda_.push_back(celdas_.size());
+    ancho_celda_.push_back(w);
+
+    if (w > ancho_[j])
+	ancho_[j] = w;
+}
+
+
+void Text_table::format(std::string& out) const
+{
+    // Reservamos la memoria necesaria de una vez
+    size_t ancho_fila = 0;
+    for (auto w: ancho_)
+	ancho_fila += w;
+
+    if (num_cols_ > 0)
+	ancho_fila += (num_cols_ - 1) * sep_.size();
+
+    // Los caracteres multibyte ocupan más bytes que columnas
+    out.reserve(out.size() + rows() * (ancho_fila + 1) + celdas_.size());
+
+    size_t ini = 0;
+    for (size_t k = 0; k < fin_celda_.size(); ++k){
+	size_t j = k % num_cols_;
+	std::string_view celda{celdas_.data() + ini, fin_celda_[k] - ini};
+
+	if (j != 0)
+	    out.append(sep_);
+
+	// No rellenamos con espacios el final de la línea
+	if (j == num_cols_ - 1 and alineacion_[j] != Alineacion::derecha){
+	    if (alineacion_[j] == Alineacion::centro)
+		out.append((ancho_[j] - ancho_celda_[k]) / 2, ' ');
+
+	    out.append(celda);
+	}
+	else
+	    append_alineado(out, celda, ancho_celda_[k], ancho_[j], 
+							    alineacion_[j]);
+
+	if (j == num_cols_ - 1)
+	    out.push_back('\n');
+
+	ini = fin_celda_[k];
+    }
+}
+
+
+}// namespace
@@ -0,0 +1,192 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#ifndef __ALP_TEXT_LAYOUT_H__
+#define __ALP_TEXT_LAYOUT_H__
+/****************************************************************************
+ *
+ *  - DESCRIPCION: Maquetación de texto UTF-8: ancho en pantalla, división
+ *	en líneas, alineación y tablas.
+ *
+ *  - COMENTARIOS: El número de bytes de una cadena UTF-8 no es el número
+ *	de columnas que ocupa en pantalla: "está" tiene 5 bytes pero ocupa 4
+ *	columnas; los caracteres chinos o japoneses ocupan 2 columnas; los
+ *	acentos combinados (U+0301...) no ocupan ninguna.
+ *
+ *	El ancho se calcula con dos tablas de rangos de code points (ver
+ *	alp_text_layout.cpp). Las tablas cubren los bloques más habituales,
+ *	no son una copia completa de Unicode.
+ *
+ *  - HISTORIA:
+ *    Manuel Perez
+ *    18/10/2026 Escrito
+ *
+ ****************************************************************************/
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ostream>
+#include <stdexcept>
+
+#include "alp_string.h"
+
+namespace alp{
+
+/***************************************************************************
+ *			    ANCHO EN PANTALLA
+ ***************************************************************************/
+/// Decodifica el caracter UTF-8 que empieza en p, avanzando p al siguiente
+/// caracter. Si el caracter está mal codificado devuelve U+FFFD (el
+/// caracter de sustitución) y avanza un único byte.
+/// Precondición: p != pe
+char32_t utf8_decode(const char*& p, const char* pe);
+
+/// Número de columnas que ocupa en pantalla el code point c: 0, 1 o 2.
+int display_width(char32_t c);
+
+/// Número de columnas que ocupa en pantalla la cadena UTF-8 [p0, pe).
+/// Cada byte mal codificado ocupa una columna (como U+FFFD).
+size_t display_width(const char* p0, const char* pe);
+
+inline size_t display_width(std::string_view s)
+{ return display_width(s.data(), s.data() + s.size()); }
+
+
+/***************************************************************************
+ *			    DIVISIÓN EN LÍNEAS
+ ***************************************************************************/
+/// Divide el texto UTF-8 [p0, pe) en líneas de, como máximo, ancho_max
+/// columnas cambiando espacios por '\n'. Las palabras más largas que
+/// ancho_max se dejan en una línea ellas solas.
+///
+/// El resultado ocupa lo mismo que [p0, pe) y se escribe en out
+/// (puede ser out == p0). Recorre el texto una única vez.
+///
+/// Devuelve out + (pe - p0).
+char* wrap_lines(const char* p0, const char* pe, size_t ancho_max, char* out);
+
+
+/***************************************************************************
+ *			    ALINEACIÓN
+ ***************************************************************************/
+enum class Alineacion{ izquierda, centro, derecha };
+
+/// Añade s al final de out, ocupando ancho columnas (rellenando con c).
+/// Si s ocupa más de ancho columnas lo añade tal cual.
+void append_alineado(std::string& out, std::string_view s, size_t ancho,
+		     Alineacion al = Alineacion::izquierda, char c = ' ');
+
+/// Igual que la anterior, pero ya sabemos que s ocupa ancho_s columnas.
+void append_alineado(std::string& out, std::string_view s, size_t ancho_s,
+		     size_t ancho, Alineacion al, char c = ' ');
+
+
+/***************************************************************************
+ *				Text_table
+ ***************************************************************************/
+/*!
+ *  \brief  Tabla de texto con las columnas alineadas.
+ *
+ *  Todas las celdas se guardan seguidas en una única std::string, y el
+ *  ancho de cada columna se va calculando al añadir las filas. Al formatear
+ *  se reserva la memoria de la salida una única vez.
+ *
+ *  Ejemplo:
+ *  \code
+ *	Text_table t{3};
+ *	t.alineacion(0, Alineacion::derecha);
+ *	for (size_t i = 0; i < v.size(); ++i)
+ *	    t.add_row(i, "=", v[i]);	// igual que Tabla
+ *
+ *	std::cout << t;
+ *  \endcode
+ */
+class Text_table{
+public:
+    /// Tabla de num_cols columnas, separadas por sep.
+    /// Precondición: num_cols > 0
+    explicit Text_table(size_t num_cols, std::string sep = " ");
+
+    /// Alineación de la columna j (por defecto a la izquierda).
+    void alineacion(size_t j, Alineacion al) {alineacion_.at(j) = al;}
+
+    /// Añade una fila. Cada celda se escribe igual que en as_chars.
+    /// Precondición: sizeof...(T) == cols()
+    template <typename... T>
+    void add_row(const T&... x);
+
+    /// Reserva memoria para num_rows filas de num_bytes bytes.
+    void reserve(size_t num_rows, size_t num_bytes);
+
+    size_t rows() const {return fin_celda_.size() / num_cols_;}
+    size_t cols() const {return num_cols_;}
+
+    /// Ancho en columnas de la columna j.
+    size_t ancho(size_t j) const {return ancho_[j];}
+
+    /// Añade la tabla formateada al final de out.
+    void format(std::string& out) const;
+
+    std::string format() const
+    {
+	std::string res;
+	format(res);
+	return res;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const Text_table& t)
+    { return out << t.format(); }
+
+private:
+    size_t num_cols_;
+    std::string sep_;
+    std::vector<Alineacion> alineacion_;
+
+    std::string celdas_;	    // todas las celdas seguidas
+    std::vector<size_t> fin_celda_; // fin de cada celda dentro de celdas_
+    std::vector<size_t> ancho_celda_;
+    std::vector<size_t> ancho_;    // ancho de cada columna
+
+    // Para poder usar impl_of::write
+    struct Writer{
+	std::string& s;
+	void append(const char* p, size_t n) {s.append(p, n);}
+    };
+
+    // Cierra la celda que acabamos de escribir
+    void end_cell(size_t j);
+};
+
+
+template <typename... T>
+void Text_table::add_row(const T&... x)
+{
+    if (sizeof...(T) != num_cols_)
+	throw std::logic_error{as_str() << "Text_table::add_row: la tabla "
+	    "tiene " << num_cols_ << " columnas y se pasan " << sizeof...(T)};
+
+    Writer w{celdas_};
+    size_t j = 0;
+    ((impl_of::write(w, x), end_cell(j++)), ...);
+}
+
+
+}// namespace
+
+#endif
@@ -20,6 +20,9 @@
 #include "alp_string.h"
 #include "alp_cast.h"
 
+#include <bit>
+#include <cstdint>
+
 namespace alp{
 
 bool isalnum(const utf8_char_t& c)
@@ -202,5 +205,161 @@ char to_iso88951(const utf8_char_t& c)
 }
 
 
+
+/***************************************************************************
+ *		    CONVERSIÓN DE CADENAS ISO-8895-1 <-> UTF-8
+ ***************************************************************************/
+namespace {
+// Procesamos los bytes de 8 en 8 metiéndolos en un uint64_t. En cada byte
+// solo miramos el bit más significativo.
+constexpr uint64_t mask_bit7 = 0x8080808080808080ull;
+
+inline uint64_t lee_8_bytes(const char* p)
+{
+    uint64_t x;
+    std::memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+// Devuelve el primer byte no ASCII de [p0, pe) (o pe si todos son ASCII).
+// Recorre la cadena de 16 en 16 bytes.
+const char* skip_ascii(const char* p0, const char* pe)
+{
+    while (pe - p0 >= 16){
+	if ((lee_8_bytes(p0) | lee_8_bytes(p0 + 8)) & mask_bit7)
+	    break;
+
+	p0 += 16;
+    }
+
+    while (p0 != pe and is_ascii(*p0))
+	++p0;
+
+    return p0;
+}
+
+// Copia el bloque ASCII que hay al principio de [p0, pe) en out.
+// Al salir p0 apunta al primer byte no ASCII.
+inline char* copy_ascii(const char*& p0, const char* pe, char* out)
+{
+    const char* q = skip_ascii(p0, pe);
+    std::memcpy(out, p0, q - p0);
+    out += q - p0;
+    p0 = q;
+
+    return out;
+}
+
 }// namespace
 
+
+size_t iso88951_to_utf8_size(const char* p0, const char* pe)
+{
+    // Cada byte >= 0x80 ocupa 2 bytes en UTF-8.
+    size_t n = pe - p0;
+
+    for (; pe - p0 >= 8; p0 += 8)
+	n += std::popcount(lee_8_bytes(p0) & mask_bit7);
+
+    for (; p0 != pe; ++p0)
+	if (!is_ascii(*p0))
+	    ++n;
+
+    return n;
+}
+
+
+char* iso88951_to_utf8(const char* p0, const char* pe, char* out)
+{
+    while (p0 != pe){
+	out = copy_ascii(p0, pe, out);
+
+	for (; p0 != pe and !is_ascii(*p0); ++p0){
+	    unsigned char c = static_cast<unsigned char>(*p0);
+	    *out++ = static_cast<char>(0xC0 | (c >> 6));
+	    *out++ = static_cast<char>(0x80 | (c & 0x3F));
+	}
+    }
+
+    return out;
+}
+
+
+std::string iso88951_to_utf8(const std::string& s)
+{
+    const char* p0 = s.data();
+    const char* pe = p0 + s.size();
+
+    std::string res(iso88951_to_utf8_size(p0, pe), '\0');
+    iso88951_to_utf8(p0, pe, res.data());
+
+    return res;
+}
+
+
+size_t utf8_to_iso88951_size(const char* p0, const char* pe)
+{
+    // Contamos los bytes que no son de continuación (10xxxxxx).
+    // Al desplazar x un bit a la izquierda, el bit 6 de cada byte pasa a
+    // ocupar la posición del bit 7.
+    size_t n = pe - p0;
+
+    for (; pe - p0 >= 8; p0 += 8){
+	uint64_t x = lee_8_bytes(p0);
+	n -= std::popcount(x & ~(x << 1) & mask_bit7);
+    }
+
+    for (; p0 != pe; ++p0)
+	if (is_continuing_byte(*p0))
+	    --n;
+
+    return n;
+}
+
+
+// Cada primer byte de [p0, pe) genera exactamente un byte en out (de ahí que
+// los bytes de continuación sueltos se ignoren). Así el resultado ocupa lo
+// que dice utf8_to_iso88951_size.
+char* utf8_to_iso88951(const char* p0, const char* pe, char* out, char no_iso)
+{
+    while (p0 != pe){
+	out = copy_ascii(p0, pe, out);
+
+	if (p0 == pe)
+	    break;
+
+	unsigned char c = static_cast<unsigned char>(*p0);
+
+	if ((c == 0xC2 or c == 0xC3) and 
+	    (pe - p0) >= 2 and is_continuing_byte(p0[1])){
+	    unsigned char c1 = static_cast<unsigned char>(p0[1]);
+	    *out++ = static_cast<char>(((c & 0x03) << 6) | (c1 & 0x3F));
+	    p0 += 2;
+	}
+
+	else if (is_continuing_byte(*p0))
+	    ++p0;
+
+	else{
+	    *out++ = no_iso;
+	    ++p0;
+	}
+    }
+
+    return out;
+}
+
+
+std::string utf8_to_iso88951(const std::string& s, char no_iso)
+{
+    const char* p0 = s.data();
+    const char* pe = p0 + s.size();
+
+    std::string res(utf8_to_iso88951_size(p0, pe), '\0');
+    utf8_to_iso88951(p0, pe, res.data(), no_iso);
+
+    return res;
+}
+
+
+}// namespace
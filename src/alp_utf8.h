@@ -48,6 +48,7 @@
  *
  *   - HISTORIA:
  *           Manuel Perez- 30/04/2019 Escrito
+ *			   18/10/2026 Conversión de cadenas ISO-8895-1 <-> UTF-8
  *
  ****************************************************************************/
 
@@ -289,6 +290,43 @@ inline std::istream& operator>>(std::istream& in, utf8_char_t& uc)
 /// Si no se puede devuelve 0.
 char to_iso88951(const utf8_char_t& uc);
 
+
+// Conversión de cadenas completas
+// -------------------------------
+// Los ficheros antiguos vienen en ISO-8895-1 (Latin-1) y hay que convertirlos
+// a UTF-8 (y viceversa). Las funciones de tamaño permiten reservar la
+// memoria de salida una única vez. Los bloques ASCII (que en la práctica son
+// la mayor parte del texto) se detectan y copian de 16 en 16 bytes.
+//
+// Ejemplo:
+//	std::string out(iso88951_to_utf8_size(p0, pe), '\0');
+//	iso88951_to_utf8(p0, pe, out.data());
+
+/// Número de bytes que ocupará en UTF-8 la cadena ISO-8895-1 [p0, pe).
+size_t iso88951_to_utf8_size(const char* p0, const char* pe);
+
+/// Convierte la cadena ISO-8895-1 [p0, pe) a UTF-8, escribiéndola en out.
+/// Devuelve el último byte escrito + 1.
+/// Precondición: out tiene mínimo iso88951_to_utf8_size(p0, pe) bytes.
+char* iso88951_to_utf8(const char* p0, const char* pe, char* out);
+
+std::string iso88951_to_utf8(const std::string& s);
+
+
+/// Número de bytes que ocupará en ISO-8895-1 la cadena UTF-8 [p0, pe).
+/// Coincide con el número de caracteres UTF-8 de [p0, pe).
+size_t utf8_to_iso88951_size(const char* p0, const char* pe);
+
+/// Convierte la cadena UTF-8 [p0, pe) a ISO-8895-1, escribiéndola en out.
+/// Los caracteres que no se pueden representar en ISO-8895-1 (y los que
+/// estén mal codificados) se sustituyen por no_iso.
+/// Devuelve el último byte escrito + 1.
+/// Precondición: out tiene mínimo utf8_to_iso88951_size(p0, pe) bytes.
+char* utf8_to_iso88951(const char* p0, const char* pe, char* out,
+						    char no_iso = '?');
+
+std::string utf8_to_iso88951(const std::string& s, char no_iso = '?');
+
 /***************************************************************************
  *			    utf8_char_view_t
  ***************************************************************************/
@@ -613,6 +651,10 @@ public:
     size_type size() const; // estas son noexcept, a diferencia de std::string
     size_type length() const {return size();}
 
+    /// Número de bytes que ocupa la cadena (size() es el número de
+    /// caracteres).
+    size_type num_bytes() const {return data_.size();}
+
     // max_size <-- ¿tiene sentido en utf8? Creo que no.
     // reserve
     // capacity
@@ -624,6 +666,10 @@ public:
 
     void push_back(const utf8_char_t& uc);
 
+    /// Sustituye el contenido por los bytes [p0, pe), reutilizando
+    /// la memoria que ya tenga reservada.
+    void assign(const char* p0, const char* pe) {data_.assign(p0, pe);}
+
     // ...
     
 
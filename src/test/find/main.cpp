@@ -0,0 +1,178 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../alp_find.h"
+#include "../../alp_array.h"
+#include "../../alp_test.h"
+
+#include <iostream>
+#include <vector>
+#include <list>
+#include <random>
+
+using namespace test;
+
+// Envolviendo la relación en una lambda no es simple: se usa la
+// versión genérica.
+template <typename R>
+auto generica(R rel)
+{ return [rel](const auto& a, const auto& b) { return rel(a, b); }; }
+
+// Compara la versión por bloques con la genérica
+template <typename T, typename R>
+bool compara(const std::vector<T>& v, R rel)
+{
+    static_assert(alp::is_simple_relation_v<R>);
+
+    auto g = generica(rel);
+    int n = static_cast<int>(v.size());
+
+    for (int j0 = 0; j0 < n; j0 += 7){
+	for (int je: {j0 + 1, j0 + 2, (j0 + n) / 2, n}){
+	    if (je > n)
+		continue;
+
+	    if (alp::find_pair_if_i(v, j0, je, rel) != 
+		alp::find_pair_if_i(v, j0, je, g))
+		return false;
+
+	    if (alp::find_pair_if_not_i(v, j0, je, rel) != 
+		alp::find_pair_if_not_i(v, j0, je, g))
+		return false;
+
+	    if (je - j0 < 2)
+		continue;
+
+	    auto p0 = v.begin() + j0;
+	    auto pe = v.begin() + je;
+	    if (alp::find_pair_if(p0, pe, rel) != alp::find_pair_if(p0, pe, g))
+		return false;
+
+	    if (alp::find_pair_if_not(p0, pe, rel) != 
+		alp::find_pair_if_not(p0, pe, g))
+		return false;
+
+	    auto p1 = std::prev(pe);
+	    if (alp::rfind_pair_if(p1, p0, rel) != 
+		alp::rfind_pair_if(p1, p0, g))
+		return false;
+
+	    if (alp::rfind_pair_if_not(p1, p0, rel) != 
+		alp::rfind_pair_if_not(p1, p0, g))
+		return false;
+	}
+    }
+
+    return true;
+}
+
+template <typename T>
+std::vector<T> aleatorio(size_t n, int a, int b)
+{
+    static std::mt19937 gen{1234};
+    std::uniform_int_distribution<int> d{a, b};
+
+    std::vector<T> v(n);
+    for (auto& x: v)
+	x = static_cast<T>(d(gen));
+
+    return v;
+}
+
+// Vector creciente con algún salto
+template <typename T>
+std::vector<T> creciente(size_t n, size_t salto)
+{
+    std::vector<T> v(n);
+    for (size_t i = 0; i < n; ++i)
+	v[i] = static_cast<T>((i % salto == salto - 1)? 0 : i % 100);
+
+    return v;
+}
+
+void test_find_pair()
+{
+    test::interfaz("find_pair_if");
+
+    {
+    std::vector<int> v = {5, 4, 3, 4, 5, 1};
+    auto [j0, j1] = alp::find_pair_if_i(v, 0, 6, std::less<int>{});
+    CHECK_TRUE(j0 == 2 and j1 == 3, "find_pair_if_i");
+
+    std::tie(j0, j1) = alp::find_pair_if_not_i(v, 2, 6, std::less<int>{});
+    CHECK_TRUE(j0 == 4 and j1 == 5, "find_pair_if_not_i");
+
+    std::tie(j0, j1) = alp::find_pair_if_i(v, 3, 5, std::greater<int>{});
+    CHECK_TRUE(j0 == 5 and j1 == 5, "find_pair_if_i(no encontrado)");
+
+    auto [p0, p1] = alp::rfind_pair_if(v.end() - 1, v.begin(), 
+						    std::less<int>{});
+    CHECK_TRUE(p0 == v.begin() + 3 and p1 == v.begin() + 4, "rfind_pair_if");
+    }
+    {// operator[] da la vuelta: no se puede leer directamente de data()
+    alp::Array_circular<int, 4> a{5, 4, 3, 4};
+    auto [j0, j1] = alp::find_pair_if_i(a, 2, 7, std::greater<int>{});
+    CHECK_TRUE(j0 == 4 and j1 == 5, "find_pair_if_i(Array_circular)");
+
+    std::tie(j0, j1) = alp::find_pair_if_not_i(a, 0, 3, std::greater<int>{});
+    CHECK_TRUE(j0 == 3 and j1 == 3, "find_pair_if_not_i(Array_circular)");
+    }
+    {// iteradores no continuos en memoria
+    std::list<int> l = {5, 4, 3, 4, 5, 1};
+    auto [p0, p1] = alp::find_pair_if(l.begin(), l.end(), std::less<int>{});
+    CHECK_TRUE(*p0 == 3 and *p1 == 4, "find_pair_if(list)");
+    }
+
+    CHECK_TRUE(compara(aleatorio<unsigned char>(1000, 0, 255), 
+				    std::less<unsigned char>{}), "uint8_t");
+    CHECK_TRUE(compara(creciente<unsigned char>(1000, 150), 
+		alp::Incr_positivo_menor_o_igual_que<unsigned char>{3}),
+							    "Incr uint8_t");
+    CHECK_TRUE(compara(creciente<int>(1000, 70),
+		alp::Incr_positivo_menor_que<int>{2}), "Incr int");
+    CHECK_TRUE(compara(creciente<int>(1000, 300), 
+		alp::Incr_negativo_mayor_que<int>{0}), "Incr_negativo int");
+    CHECK_TRUE(compara(aleatorio<float>(500, -10, 10), 
+				    std::greater_equal<float>{}), "float");
+    CHECK_TRUE(compara(aleatorio<double>(500, 0, 1), 
+				    std::equal_to<double>{}), "double");
+}
+
+void test_find_first_range_overlapped_if()
+{
+    test::interfaz("find_first_range_overlapped_if");
+
+    std::vector<int> v = {5, 4, 3, 4, 5, 6, 2, 1};
+    auto b = v.begin();
+    auto [q0, qe] = alp::find_first_range_overlapped_if(b, v.end(), 
+				    b + 4, b + 6, std::less<int>{});
+    CHECK_TRUE(q0 == b + 2 and qe == b + 6, "rango");
+}
+
+int main()
+{
+try{
+    test::header("alp_find.h");
+
+    test_find_pair();
+    test_find_first_range_overlapped_if();
+
+}catch(const std::exception& e){
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
@@ -0,0 +1,152 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../alp_line_reader.h"
+#include "../../alp_test.h"
+#include "../../alp_string.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+using namespace test;
+
+// Lee todas las líneas de in
+template <typename Reader>
+std::vector<std::string> lee_lineas(Reader& in)
+{
+    std::vector<std::string> res;
+
+    std::string_view line;
+    while (in.getline(line))
+	res.push_back(std::string{line});
+
+    return res;
+}
+
+void test_line_reader()
+{
+    test::interfaz("Line_reader");
+
+    {
+    std::string s = "uno\ndos\n\ncuatro";
+    alp::Line_reader in{s};
+    std::vector<std::string> res = {"uno", "dos", "", "cuatro"};
+    CHECK_EQUAL_CONTAINERS(lee_lineas(in), res, "getline");
+    }
+    {
+    std::string s = "uno\ndos\n";
+    alp::Line_reader in{s};
+    std::vector<std::string> res = {"uno", "dos"};
+    CHECK_EQUAL_CONTAINERS(lee_lineas(in), res, "getline('\\n' final)");
+    }
+    {
+    std::string s;
+    alp::Line_reader in{s};
+    CHECK_TRUE(lee_lineas(in).empty(), "getline(vacía)");
+    }
+}
+
+
+void test_buffered_line_reader(size_t buffer_size, bool prefetch)
+{
+    std::string s;
+    std::vector<std::string> res;
+    for (int i = 0; i < 1000; ++i){
+	res.push_back(alp::as_str() << "línea " << i << std::string(i % 37, 'x'));
+	s += res.back() + '\n';
+    }
+    res.push_back("sin fin de línea");
+    s += res.back();
+
+    std::istringstream str{s};
+    alp::Buffered_line_reader in{str, buffer_size, prefetch};
+
+    CHECK_EQUAL_CONTAINERS(lee_lineas(in), res, 
+	    alp::as_str() << "getline(" << buffer_size << ", " 
+			  << prefetch << ")");
+}
+
+void test_buffered_line_reader()
+{
+    test::interfaz("Buffered_line_reader");
+
+    test_buffered_line_reader(7, false);	// líneas más largas que el buffer
+    test_buffered_line_reader(64, false);
+    test_buffered_line_reader(1 << 20, false);
+    test_buffered_line_reader(7, true);
+    test_buffered_line_reader(64, true);
+    test_buffered_line_reader(1 << 20, true);
+}
+
+
+void test_mapped_file()
+{
+    test::interfaz("Mapped_file");
+
+    std::string fname = "/tmp/alp_line_reader";
+    {
+    std::ofstream out{fname};
+    out << "uno\ndos\ntres\n";
+    }
+
+    alp::Mapped_file file{fname};
+    CHECK_TRUE(file.size() == 13, "size");
+
+    alp::Line_reader in{file};
+    std::vector<std::string> res = {"uno", "dos", "tres"};
+    CHECK_EQUAL_CONTAINERS(lee_lineas(in), res, "getline");
+
+    CHECK_TRUE(alp::num_lineas_fichero(fname) == 3, "num_lineas_fichero");
+
+    CHECK_EXCEPTION(alp::Mapped_file{"/tmp/no_existe/alp_line_reader"},
+		    "Mapped_file(no existe)");
+}
+
+
+void test_getline_utf8_string()
+{
+    test::interfaz("getline(Reader, utf8_string)");
+
+    std::string s = "año\nañada";
+    alp::Line_reader in{s};
+
+    alp::utf8_string line;
+    alp::getline(in, line);
+    CHECK_TRUE(line == "año" and line.size() == 3, "getline");
+    alp::getline(in, line);
+    CHECK_TRUE(line == "añada" and line.size() == 5, "getline");
+    CHECK_FALSE(alp::getline(in, line), "getline(eof)");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_line_reader.h");
+
+    test_line_reader();
+    test_buffered_line_reader();
+    test_mapped_file();
+    test_getline_utf8_string();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
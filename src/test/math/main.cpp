@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 
 using namespace test;
 
@@ -57,6 +58,150 @@ void test_multiplos()
     CHECK_TRUE(!alp::es_multiplo(4).de(3), "es_multiplo.de");
 }
 
+void test_max_comun_divisor()
+{
+    test::interfaz("max_comun_divisor");
+
+    // Euclides, para comparar
+    auto mcd = [](long a, long b) {
+	a = std::abs(a); b = std::abs(b);
+	while (b != 0){
+	    long r = a % b;
+	    a = b;
+	    b = r;
+	}
+	return a;
+    };
+
+    bool ok = true;
+    for (int a = -60; a <= 60; ++a)
+	for (int b = -60; b <= 60; ++b)
+	    ok = ok and alp::max_comun_divisor(a, b) == mcd(a, b);
+    CHECK_TRUE(ok, "int");
+
+    static_assert(alp::max_comun_divisor(12u, 18u) == 6u);
+    CHECK_TRUE(alp::max_comun_divisor(uint64_t{1} << 40, uint64_t{3} << 20)
+						    == (uint64_t{1} << 20), "uint64_t");
+    CHECK_TRUE(alp::min_comun_multiplo(4, 6) == 12, "min_comun_multiplo");
+}
+
+
+template <typename Int>
+bool check_divisor(Int d, Int x0, Int xe)
+{
+    alp::Divisor<Int> div{d};
+    for (Int x = x0; x != xe; ++x){
+	long c = alp::cociente(x, d);
+	if (std::is_unsigned_v<Int>)
+	    c = x / d;
+
+	long r = static_cast<long>(x) - c * static_cast<long>(d);
+
+	if (div.cociente(x) != c or div.resto(x) != r or
+	    div.divide_a(x) != (r == 0))
+	    return false;
+
+	if (x >= 0 and
+	    (div.multiplo_mayor_que(x) !=
+			static_cast<Int>(alp::multiplo_de_mayor_que(d, x)) or
+	     div.multiplo_mas_proximo_a(x) !=
+			static_cast<Int>(alp::multiplo_de_mas_proximo_a(d, x))))
+	    return false;
+    }
+
+    return true;
+}
+
+template <auto d, typename Int>
+concept admite_divisor = requires (Int x) {
+    alp::cociente<d>(x);
+    alp::resto<d>(x);
+};
+
+void test_divisor()
+{
+    test::interfaz("Divisor");
+
+    bool ok = true;
+    for (int d = 1; d < 300; ++d)
+	ok = ok and check_divisor<int>(d, -1000, 1000);
+    CHECK_TRUE(ok, "int");
+
+    ok = true;
+    for (unsigned d = 1; d < 300; ++d)
+	ok = ok and check_divisor<unsigned>(d, 0, 1000);
+    CHECK_TRUE(ok, "unsigned");
+
+    ok = true;
+    for (int d: {7, 1000, 65536, 1 << 30, 2147483647}){
+	alp::Divisor<int> div{d};
+	for (long x: {-2147483648L, -2147483647L, -2147483000L, -1L, 0L,
+		      2147483000L, 2147483646L, 2147483647L}){
+	    long c = (x >= 0)? x / d: -((-x - 1) / d) - 1;
+	    ok = ok and div.cociente(int(x)) == c and div.resto(int(x)) == x - c*d;
+	}
+    }
+    CHECK_TRUE(ok, "int: extremos");
+
+    {// 64 bits
+    uint64_t n = 0xFEDCBA9876543210;
+    for (uint64_t d: {uint64_t{3}, uint64_t{1} << 40, uint64_t{1000000007},
+				    ~uint64_t{0}})
+	ok = ok and alp::Divisor<uint64_t>{d}.cociente(n) == n / d;
+    alp::Divisor<long> d{12345};
+    ok = ok and d.cociente(-1234567890123L) == -100005500L
+	    and d.resto(-1234567890123L) == 7377L;
+    CHECK_TRUE(ok, "64 bits");
+    }
+
+    static_assert(alp::Divisor<int>{7}.cociente(-1) == -1);
+    CHECK_EXCEPTION(alp::Divisor<int>{0}, "Divisor{0}");
+    CHECK_EXCEPTION(alp::Divisor<int>{-3}, "Divisor{-3}");
+
+    // Divisor en compilación
+    ok = true;
+    for (int x = -100; x <= 100; ++x){
+	ok = ok and alp::cociente<8>(x) == alp::cociente(x, 8)
+		and alp::resto<8>(x) == alp::resto(x, 8)
+		and alp::cociente<7>(x) == alp::cociente(x, 7)
+		and alp::resto<7>(x) == alp::resto(x, 7)
+		and alp::es_multiplo_de<4>(x) == (alp::resto(x, 4) == 0)
+		and alp::es_multiplo_de<6>(x) == (alp::resto(x, 6) == 0)
+		and alp::multiplo_de_mayor_que<16>(x)
+				== alp::Divisor<int>{16}.multiplo_mayor_que(x)
+		and alp::multiplo_de_mayor_que<10>(x)
+				== alp::Divisor<int>{10}.multiplo_mayor_que(x)
+		and alp::multiplo_de_mas_proximo_a<8>(x)
+				== alp::Divisor<int>{8}.multiplo_mas_proximo_a(x)
+		and alp::multiplo_de_mas_proximo_a<5>(x)
+				== alp::Divisor<int>{5}.multiplo_mas_proximo_a(x);
+    }
+    CHECK_TRUE(ok, "cociente<d>/resto<d>/multiplo_de_...<d>");
+    static_assert(alp::multiplo_de_mayor_que<64>(size_t{65}) == 128);
+
+    {// cociente(D) * d no es representable en int
+    constexpr int m = std::numeric_limits<int>::min();
+    constexpr int M = std::numeric_limits<int>::max();
+    alp::Divisor<int> d7{7};
+    CHECK_TRUE(d7.cociente(m) == -306783379 and d7.resto(m) == 5,
+						    "Divisor::resto(INT_MIN)");
+    CHECK_TRUE(d7.multiplo_mayor_que(m) == m + 2 and
+	       d7.multiplo_mas_proximo_a(m) == m + 2, 
+					"Divisor::multiplo_...(INT_MIN)");
+    CHECK_TRUE(alp::Divisor<int>{M}.resto(m) == M - 1, "Divisor{INT_MAX}");
+    CHECK_TRUE(alp::Divisor<int>{M}.multiplo_mas_proximo_a(M - 1) == M,
+				    "Divisor{INT_MAX}.multiplo_mas_proximo_a");
+    static_assert(alp::resto<7>(m) == 5 and alp::cociente<7>(m) == -306783379);
+    static_assert(alp::multiplo_de_mayor_que<7>(m) == m + 2);
+    static_assert(alp::multiplo_de_mas_proximo_a<7>(m) == m + 2);
+    }
+
+    // d tiene que ser representable en Int
+    static_assert(admite_divisor<200, uint8_t>);
+    static_assert(!admite_divisor<300, uint8_t>);
+    static_assert(!admite_divisor<200, int8_t>);
+}
+
 
 
 void test_average()
@@ -125,6 +270,106 @@ void test_cartesianas2polares()
 }
 
 
+// Error máximo de las versiones por bloques respecto de las escalares
+template <typename Real>
+void test_polares_bloques(alp::Precision p, double error_angulo, 
+			  double error_sin, const char* nombre)
+{
+    std::vector<Real> x, y;
+    for (int i = -50; i <= 50; ++i)
+	for (int j = -50; j <= 50; ++j){
+	    x.push_back(static_cast<Real>(i * 0.37));
+	    y.push_back(static_cast<Real>(j * 0.29));
+	}
+
+    size_t n = x.size();
+    std::vector<Real> r(n), t(n);
+    alp::cartesianas2polares(x.data(), x.data() + n, y.data(), 
+			     r.data(), t.data(), p);
+
+    double e_r = 0, e_t = 0;
+    for (size_t i = 0; i < n; ++i){
+	auto [r0, t0] = alp::cartesianas2polares(x[i], y[i]);
+	e_r = std::max(e_r, std::abs(r[i] - r0) / std::max(1.0, r0));
+
+	double d = std::abs(t[i] - t0);
+	e_t = std::max(e_t, std::min(d, 360 - d));
+	if (t[i] < 0 or t[i] >= 360)
+	    e_t = 1000;
+    }
+
+    CHECK_TRUE(e_r < 1e-6 and e_t < error_angulo,
+		alp::as_str() << "cartesianas2polares (" << nombre << ")");
+
+    std::vector<Real> x2(n), y2(n);
+    alp::polares2cartesianas(r.data(), r.data() + n, t.data(), 
+			     x2.data(), y2.data(), p);
+
+    double e_x = 0;
+    for (size_t i = 0; i < n; ++i)
+	e_x = std::max<double>(e_x, std::max(std::abs(x2[i] - x[i]), 
+				     std::abs(y2[i] - y[i])) / std::max<Real>(1, r[i]));
+
+    CHECK_TRUE(e_x < error_sin + error_angulo / 50,
+		alp::as_str() << "polares2cartesianas (" << nombre << ")");
+
+    std::vector<Real> a, s(2001), c(2001);
+    for (int i = -1000; i <= 1000; ++i)
+	a.push_back(static_cast<Real>(i * 1.13));
+
+    alp::sincosd(a.data(), a.data() + a.size(), s.data(), c.data(), p);
+
+    double e_s = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+	e_s = std::max({e_s, std::abs(s[i] - sin(alp::Degree{a[i]})),
+			     std::abs(c[i] - cos(alp::Degree{a[i]}))});
+
+    CHECK_TRUE(e_s < error_sin, alp::as_str() << "sincosd (" << nombre << ")");
+}
+
+
+struct Vector_prueba{
+    int x, y;
+};
+
+
+void test_polares_bloques()
+{
+    test::interfaz("cartesianas2polares (bloques)");
+
+    test_polares_bloques<double>(alp::Precision::alta, 1e-9, 1e-9, "alta");
+    test_polares_bloques<double>(alp::Precision::media, 7e-4, 3e-8, "media");
+    test_polares_bloques<double>(alp::Precision::baja, 0.09, 4e-5, "baja");
+    test_polares_bloques<float>(alp::Precision::media, 7e-4, 1e-6, 
+							    "media, float");
+
+    // Múltiplos de 90 exactos
+    std::vector<double> a{0, 90, 180, 270, -90, 360, 720};
+    std::vector<double> s(a.size()), c(a.size());
+    alp::sincosd(a.data(), a.data() + a.size(), s.data(), c.data());
+    CHECK_EQUAL_CONTAINERS(s, (std::vector<double>{0, 1, 0, -1, -1, 0, 0}),
+								"sincosd(90*n)");
+    CHECK_EQUAL_CONTAINERS(c, (std::vector<double>{1, 0, -1, 0, 0, 1, 1}),
+								"sincosd(90*n)");
+
+    // Arrays de estructuras
+    std::vector<Vector_prueba> v{{1, 0}, {0, 2}, {-3, 0}, {0, -4}, {0, 0}};
+    std::vector<double> r(v.size()), t(v.size());
+    alp::cartesianas2polares(v.begin(), v.end(), r.data(), t.data());
+    CHECK_EQUAL_CONTAINERS(r, (std::vector<double>{1, 2, 3, 4, 0}), 
+						"cartesianas2polares(Vector)");
+    CHECK_EQUAL_CONTAINERS(t, (std::vector<double>{0, 90, 180, 270, 0}), 
+						"cartesianas2polares(Vector)");
+
+    std::vector<Vector_prueba> w(v.size());
+    alp::polares2cartesianas(r.data(), r.data() + r.size(), t.data(), 
+								    w.begin());
+    CHECK_TRUE(std::equal(v.begin(), v.end(), w.begin(), 
+		[](auto a, auto b) { return a.x == b.x and a.y == b.y; }),
+						"polares2cartesianas(Vector)");
+}
+
+
 void test_maximo()
 {
     test::interfaz("maximo");
@@ -294,9 +539,12 @@ try{
 
     test_abs();
     test_multiplos();
+    test_max_comun_divisor();
+    test_divisor();
     test_average();
     test_punto_medio();
     test_cartesianas2polares();
+    test_polares_bloques();
     test_maximo();
     test_angles();
 
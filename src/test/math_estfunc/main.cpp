@@ -16,11 +16,14 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "../../alp_math_efunc.h"
+#include "../../alp_matrix.h"
 #include "../../alp_test.h"
 
 #include <iostream>
 #include <limits>
 #include <functional>
+#include <random>
+#include <sstream>
 
 
 using namespace std;
@@ -202,13 +205,108 @@ void test_estudia_crecimiento()
 
 
 
+// Algoritmo original: relación a relación.
+using Relacion = Estudia_crecimiento_decrecimiento::Relacion;
+using Estudio = Estudia_crecimiento_decrecimiento::Estudio;
+
+Estudio estudia_uno_a_uno(const std::vector<Relacion>& rels, 
+			  const std::vector<int>& p)
+{
+    Estudio res;
+    int ie = p.size();
+    int i0 = 0;
+    while (i0 + 1 < ie){
+	auto rel = *std::find_if(rels.begin(), rels.end(), 
+			    [&](auto& r) { return r(p[i0], p[i0 + 1]); });
+
+	Estudia_crecimiento_decrecimiento::Region reg;
+	reg.i = i0;
+	while (i0 + 1 < ie and rel(p[i0], p[i0 + 1]))
+	    ++i0;
+
+	reg.j = i0;
+	reg.incr = p[reg.j] - p[reg.i];
+	reg.name = rel.name;
+	res.push_back(reg);
+    }
+
+    return res;
+}
+
+bool operator==(const Estudio& a, const Estudio& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), 
+	    [](auto& x, auto& y) {
+		return x.i == y.i and x.j == y.j and x.incr == y.incr 
+		   and x.name == y.name; });
+}
+
+void test_compara()
+{
+    test::interfaz("Estudia_crecimiento_decrecimiento(aleatorio)");
+
+    // Relaciones que se solapan: se sigue usando la relación de la región
+    // mientras se cumpla.
+    std::vector<Relacion> rels = { {neg_infinity<int>(), -300, 'D'}
+				 , {-300, 0, 'd'}
+				 , {0, 0, '='}
+				 , {0, 1000, 'c'}
+				 , {2, infinity<int>(), 'C'} };
+
+    Estudia_crecimiento_decrecimiento estudia = 
+		{rels[0], rels[1], rels[2], rels[3], rels[4]};
+
+    std::mt19937 gen{1234};
+    std::uniform_int_distribution<int> d{-2000, 2000};
+
+    std::vector<int> f;
+    for (int i = 0; i < 5000; ++i)
+	f.push_back(((i / 10) % 3 == 0)? 7 : d(gen));
+
+    Estudio est;
+    estudia(f.begin(), f.size(), est);
+    CHECK_TRUE(est == estudia_uno_a_uno(rels, f), "compara");
+
+    CHECK_EXCEPTION((Estudia_crecimiento_decrecimiento{{0, 5, 'c'}}
+			(f.begin(), f.size())), "sin relación");
+}
+
+void test_por_filas()
+{
+    test::interfaz("Estudia_crecimiento_decrecimiento::por_filas");
+
+    Estudia_crecimiento_decrecimiento
+	estudia = {   {neg_infinity<int>(), 0, 'D'}
+		    , {0, 0, '='} 
+		    , {0, infinity<int>(), 'C'} };
+
+    Matrix<unsigned char> m{37, 100};
+    std::mt19937 gen{4321};
+    std::uniform_int_distribution<int> d{0, 255};
+    for (auto& x: m)
+	x = static_cast<unsigned char>(d(gen) / 64);
+
+    for (unsigned num_threads: {1u, 4u, 0u}){
+	auto res = estudia.por_filas(m, num_threads);
+
+	bool ok = (res.size() == m.rows());
+	for (size_t i = 0; ok and i < m.rows(); ++i)
+	    ok = (res[i] == estudia(m.row(i).begin(), m.cols()));
+
+	CHECK_TRUE(ok, "por_filas");
+    }
+}
+
+
 int main()
 {
 try{
-    test::init("alp_math_estfunc.h");
+    test::header("alp_math_efunc.h");
 
     test_relacion();
     test_estudia_crecimiento();
+    test_compara();
+    test_por_filas();
 
 
 }catch(std::exception& e)
@@ -18,11 +18,13 @@
 
 #include "../../../alp_matrix_algorithm.h"
 #include "../../../alp_test.h"
+#include "../../../alp_line_reader.h"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <iterator>
+#include <algorithm>
 
 
 using namespace test;
@@ -60,6 +62,25 @@ void test_read_matrix()
     CHECK_EQUAL_CONTAINERS_C(m, res, "read_matrix");
     }
 
+    {// Line_reader
+    std::string file = "1 2  3\n"
+		       "4 5 -6\n"
+		       "\n"
+		       "Esto ya no lo lee";
+
+    alp::Line_reader in{file};
+    std::vector<int> res = {1,2,3,4,5,-6};
+    auto m = alp::read_matrix<int, size_t>(in);
+
+    CHECK_TRUE(m.rows() == 2 and m.cols() == 3, "read_matrix(Line_reader)");
+    CHECK_EQUAL_CONTAINERS_C(m, res, "read_matrix");
+
+    std::string bad = "1 2 x\n";
+    alp::Line_reader in2{bad};
+    CHECK_EXCEPTION((alp::read_matrix<int, size_t>(in2)), 
+		    "read_matrix(Line_reader) con error");
+    }
+
 }
 
 
@@ -387,6 +408,71 @@ void test_operations()
 }
 }
 
+// Mediana calculada ordenando la ventana entera
+template <typename T, typename I>
+alp::Matrix<T, I> median_filter_ordenando(const alp::Matrix<T, I>& m, I r)
+{
+    alp::Matrix<T, I> res{m.rows(), m.cols()};
+    for (I i = 0; i < m.rows(); ++i)
+	for (I j = 0; j < m.cols(); ++j){
+	    std::vector<T> v;
+	    for (I a = (i < r? 0: i - r); a < std::min(i + r + 1, m.rows()); ++a)
+		for (I b = (j < r? 0: j - r); b < std::min(j + r + 1, m.cols()); ++b)
+		    v.push_back(m(a, b));
+
+	    std::sort(v.begin(), v.end());
+	    res(i, j) = v[(v.size() + 1) / 2 - 1];
+	}
+
+    return res;
+}
+
+
+template <typename T, typename I>
+void test_median_filter(I rows, I cols, I r, uint32_t semilla)
+{
+    alp::Matrix<T, I> m{rows, cols};
+    for (auto& x: m){
+	semilla = semilla * 1664525u + 1013904223u;
+	x = static_cast<T>(semilla >> 16);
+    }
+
+    auto res = alp::median_filter(m, r);
+    auto ok  = median_filter_ordenando(m, r);
+
+    CHECK_TRUE(std::equal(res.begin(), res.end(), ok.begin(), ok.end()),
+	    alp::as_str() << "median_filter(" << rows << "x" << cols 
+			  << ", r = " << r << ", " << sizeof(T) << " bytes)");
+}
+
+
+void test_median_filter()
+{
+    test::interfaz("median_filter");
+
+    for (size_t r: {0, 1, 2, 3, 4}){
+	test_median_filter<uint8_t, size_t>(13, 17, r, 1);
+	test_median_filter<int8_t, size_t>(9, 8, r, 2);
+	test_median_filter<uint16_t, size_t>(11, 14, r, 3);
+	test_median_filter<int16_t, size_t>(7, 6, r, 4);
+	test_median_filter<double, size_t>(10, 10, r, 5);
+	test_median_filter<uint8_t, size_t>(3, 20, r, 6); // ventana > filas
+    }
+
+    test_median_filter<uint8_t, int>(40, 50, 7, 7);
+    test_median_filter<uint16_t, int>(30, 20, 5, 8);
+
+    // Sal y pimienta
+    alp::Matrix<uint8_t> m{8, 8};
+    std::fill(m.begin(), m.end(), 100);
+    m(2, 3) = 255;
+    m(5, 5) = 0;
+    auto res = alp::median_filter(m, 1);
+    CHECK_TRUE(std::all_of(res.begin(), res.end(), 
+			[](uint8_t x) { return x == 100; }), "sal y pimienta");
+}
+
+
 
 int main()
 {
@@ -404,6 +490,7 @@ try{
     test_rotate();
     test_differences();
     test_operations();
+    test_median_filter();
 
 }catch(std::exception& e){
     std::cerr << e.what() << std::endl;
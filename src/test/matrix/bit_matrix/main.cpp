@@ -0,0 +1,259 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#include "../../../alp_bit_matrix.h"
+#include "../../../alp_matrix_morphology.h"
+#include "../../../alp_test.h"
+
+#include <iostream>
+#include <random>
+
+using namespace test;
+
+using Mask = alp::Bit_matrix<int>;
+using Matrix = alp::Matrix<uint8_t, int>;
+using Pos  = Mask::Position;
+using Range = Mask::Range2D;
+
+Matrix aleatoria(std::mt19937& g, int rows, int cols, int prob)
+{
+    Matrix m{rows, cols};
+    std::uniform_int_distribution<int> d{0, 99};
+    for (auto& x: m)
+	x = (d(g) < prob);
+
+    return m;
+}
+
+bool iguales(const Mask& b, const Matrix& m)
+{
+    if (b.rows() != m.rows() or b.cols() != m.cols())
+	return false;
+
+    for (int i = 0; i < m.rows(); ++i)
+	for (int j = 0; j < m.cols(); ++j)
+	    if (b(i, j) != (m(i, j) != 0))
+		return false;
+
+    return true;
+}
+
+
+void test_basico()
+{
+    test::interfaz("Bit_matrix");
+
+    Mask b{3, 70};
+    CHECK_TRUE(b.rows() == 3 and b.cols() == 70 and b.words_per_row() == 2
+	       and b.size() == 210, "dimensiones");
+    CHECK_TRUE(b.none() and b.count() == 0, "inicialmente a 0");
+
+    b(1, 65) = true;
+    b(Pos{2, 0}) = true;
+    CHECK_TRUE(b(1, 65) and b(2, 0) and !b(1, 64) and b.count() == 2,
+							    "reference");
+    b(0, 3) = b(1, 65);
+    b(1, 65).flip();
+    CHECK_TRUE(b(0, 3) and !b(1, 65) and b.count() == 2, "reference");
+
+    const Mask& c = b;
+    CHECK_TRUE(c(0, 3) and !c(Pos{0, 4}), "const");
+
+    Mask u{2, 70, true};
+    CHECK_TRUE(u.count() == 140, "constructor a 1 (sin relleno)");
+    u.flip();
+    CHECK_TRUE(u.none(), "flip");
+    u.fill(true);
+    CHECK_TRUE(u.count() == 140, "fill");
+
+    u.fill(Range{0, 2, 60, 68}, false);
+    CHECK_TRUE(u.count() == 140 - 16 and !u(1, 60) and !u(1, 67) and
+	       u(1, 68) and u(1, 59), "fill(rango)");
+}
+
+
+void test_logicas()
+{
+    test::interfaz("operaciones lógicas");
+
+    std::mt19937 g{50};
+    Matrix ma = aleatoria(g, 7, 130, 40);
+    Matrix mb = aleatoria(g, 7, 130, 40);
+    Mask a = Mask::from_matrix(ma);
+    Mask b = Mask::from_matrix(mb);
+
+    Matrix r{7, 130};
+    auto op = [&](auto f) {
+	for (int i = 0; i < 7; ++i)
+	    for (int j = 0; j < 130; ++j)
+		r(i, j) = f(ma(i, j) != 0, mb(i, j) != 0);
+	return r;
+    };
+
+    CHECK_TRUE(iguales(a & b, op([](bool x, bool y) {return x and y;})), "&");
+    CHECK_TRUE(iguales(a | b, op([](bool x, bool y) {return x or y;})), "|");
+    CHECK_TRUE(iguales(a ^ b, op([](bool x, bool y) {return x != y;})), "^");
+    CHECK_TRUE(iguales(~a, op([](bool x, bool) {return !x;})), "~");
+
+    Mask c = a;
+    c.and_not(b);
+    CHECK_TRUE(iguales(c, op([](bool x, bool y) {return x and !y;})),
+								"and_not");
+    CHECK_TRUE((~~a) == a and !(a == b), "==");
+
+    Mask d{7, 129};
+    CHECK_EXCEPTION(a &= d, "tamaños diferentes");
+}
+
+
+void test_count()
+{
+    test::interfaz("count");
+
+    std::mt19937 g{5};
+    Matrix m = aleatoria(g, 9, 200, 30);
+    Mask b = Mask::from_matrix(m);
+
+    auto cuenta = [&](int i0, int ie, int j0, int je) {
+	int n = 0;
+	for (int i = std::max(i0, 0); i < std::min(ie, 9); ++i)
+	    for (int j = std::max(j0, 0); j < std::min(je, 200); ++j)
+		n += (m(i, j) != 0);
+	return n;
+    };
+
+    CHECK_TRUE(b.count() == cuenta(0, 9, 0, 200), "count()");
+
+    bool ok = true;
+    for (int i = 0; i < 9; ++i)
+	if (b.count_row(i) != cuenta(i, i + 1, 0, 200))
+	    ok = false;
+    CHECK_TRUE(ok, "count_row");
+
+    ok = true;
+    for (auto [j0, je]: {std::pair{0, 200}, {3, 5}, {10, 64}, {63, 65},
+			 {64, 128}, {1, 199}, {70, 300}, {-5, 10}, {120, 120}})
+	if (b.count(Range{2, 8, j0, je}) != cuenta(2, 8, j0, je))
+	    ok = false;
+    CHECK_TRUE(ok, "count(rango)");
+}
+
+
+void test_find()
+{
+    test::interfaz("find_next/for_each_set");
+
+    std::mt19937 g{8};
+    Matrix m = aleatoria(g, 6, 150, 3);
+    Mask b = Mask::from_matrix(m);
+
+    std::vector<Pos> esperado;
+    for (int i = 0; i < m.rows(); ++i)
+	for (int j = 0; j < m.cols(); ++j)
+	    if (m(i, j))
+		esperado.push_back(Pos{i, j});
+
+    std::vector<Pos> v;
+    b.for_each_set([&](int i, int j) { v.push_back(Pos{i, j}); });
+    CHECK_TRUE(v == esperado, "for_each_set");
+
+    v.clear();
+    for (Pos p = b.find_first(); p.i < b.rows(); p = b.find_next(Pos{p.i, p.j + 1}))
+	v.push_back(p);
+    CHECK_TRUE(v == esperado, "find_next");
+
+    Mask vacia{4, 10};
+    CHECK_TRUE(vacia.find_first() == (Pos{4, 0}), "sin pixels");
+}
+
+
+void test_conversiones()
+{
+    test::interfaz("from_matrix/to_matrix");
+
+    alp::Matrix<int, int> m{5, 66};
+    for (int i = 0; i < m.rows(); ++i)
+	for (int j = 0; j < m.cols(); ++j)
+	    m(i, j) = i * 100 + j;
+
+    auto b = Mask::from_matrix(m, [](int x) { return x % 3 == 0; });
+    bool ok = true;
+    for (int i = 0; i < m.rows(); ++i)
+	for (int j = 0; j < m.cols(); ++j)
+	    if (b(i, j) != (m(i, j) % 3 == 0))
+		ok = false;
+    CHECK_TRUE(ok, "from_matrix(pred)");
+
+    alp::Matrix<int, int> r{5, 66};
+    alp::to_matrix(b, r, 7, -1);
+    ok = true;
+    for (int i = 0; i < m.rows(); ++i)
+	for (int j = 0; j < m.cols(); ++j)
+	    if (r(i, j) != ((m(i, j) % 3 == 0)? 7: -1))
+		ok = false;
+    CHECK_TRUE(ok, "to_matrix");
+}
+
+
+void test_morphology()
+{
+    test::interfaz("binary_erode/dilate/open/close (Bit_matrix)");
+
+    std::mt19937 g{9};
+    alp::Morphology_buffer<bool> buf;
+    alp::Size_ij<int> se{3, 5};
+
+    bool ok = true;
+    for (int prob: {10, 60, 90}){
+	Matrix m = aleatoria(g, 11, 100, prob);
+	Mask b = Mask::from_matrix(m);
+
+	if (!iguales(alp::binary_erode(b, se), alp::binary_erode(m, se)) or
+	    !iguales(alp::binary_dilate(b, se), alp::binary_dilate(m, se)) or
+	    !iguales(alp::binary_open(b, se), alp::binary_open(m, se)))
+	    ok = false;
+
+	alp::binary_close(b, se, buf);
+	if (!iguales(b, alp::binary_close(m, se)))
+	    ok = false;
+
+	// los bits de relleno siguen a 0
+	if (b.count() != b.count(b.extension()))
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "igual que con Matrix");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_bit_matrix.h");
+
+    test_basico();
+    test_logicas();
+    test_count();
+    test_find();
+    test_conversiones();
+    test_morphology();
+
+}catch(const std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+
+}
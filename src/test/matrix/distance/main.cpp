@@ -0,0 +1,211 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#include "../../../alp_matrix_distance.h"
+#include "../../../alp_test.h"
+
+#include <iostream>
+#include <random>
+#include <cmath>
+
+using namespace test;
+
+using Mask = alp::Matrix<int, int>;
+using Pos  = alp::Vector_ij<int>;
+
+Mask mascara_aleatoria(std::mt19937& g, int rows, int cols, int prob)
+{
+    Mask m{rows, cols};
+    std::uniform_int_distribution<int> d{0, 99};
+    for (auto& x: m)
+	x = (d(g) < prob);
+
+    return m;
+}
+
+int64_t d2(const Pos& p, const Pos& q)
+{
+    int64_t di = p.i - q.i;
+    int64_t dj = p.j - q.j;
+    return di * di + dj * dj;
+}
+
+int32_t d34(const Pos& p, const Pos& q)
+{
+    int32_t di = std::abs(p.i - q.i);
+    int32_t dj = std::abs(p.j - q.j);
+    return 3 * std::max(di, dj) + std::min(di, dj);
+}
+
+// Mínimo de dist(p, q) para los pixels objeto q de m
+template <typename F>
+auto fuerza_bruta(const Mask& m, const Pos& p, F dist)
+{
+    using R = decltype(dist(p, p));
+    R res = std::numeric_limits<R>::max();
+    for (int i = 0; i < m.rows(); ++i)
+	for (int j = 0; j < m.cols(); ++j)
+	    if (m(i, j))
+		res = std::min(res, dist(p, Pos{i, j}));
+
+    return res;
+}
+
+
+void test_euclidea()
+{
+    test::interfaz("distance_transform2");
+
+    {// un solo punto
+    Mask m{5, 7};
+    std::fill(m.begin(), m.end(), 0);
+    m(1, 2) = 1;
+
+    auto d = alp::distance_transform2(m);
+    CHECK_TRUE(d(1, 2) == 0 and d(4, 6) == 9 + 16 and d(0, 0) == 1 + 4,
+							    "un punto");
+
+    auto r = alp::distance_transform(m);
+    CHECK_TRUE(r(4, 6) == 5.0, "distance_transform");
+    }
+
+    {// sin pixels objeto
+    Mask m{3, 4};
+    std::fill(m.begin(), m.end(), 0);
+
+    alp::Matrix<Pos, int> nearest{0, 0};
+    auto d = alp::distance_transform2(m, [](int x) {return x != 0;}, nearest);
+
+    bool ok = true;
+    for (int i = 0; i < 3; ++i)
+	for (int j = 0; j < 4; ++j)
+	    if (d(i, j) != std::numeric_limits<int64_t>::max() or
+		nearest(i, j) != Pos{-1, -1})
+		ok = false;
+    CHECK_TRUE(ok, "sin objetos");
+    CHECK_TRUE(std::isinf(alp::distance_transform(m)(0, 0)), "sin objetos");
+    }
+
+    {// aleatorio
+    std::mt19937 g{47};
+    bool ok = true;
+    for (int prob: {1, 5, 30}){
+	Mask m = mascara_aleatoria(g, 23, 37, prob);
+
+	alp::Matrix<Pos, int> nearest{0, 0};
+	auto d = alp::distance_transform2(m, [](int x) {return x != 0;},
+								    nearest);
+
+	for (int i = 0; i < m.rows(); ++i)
+	    for (int j = 0; j < m.cols(); ++j){
+		Pos p{i, j};
+		int64_t b = fuerza_bruta(m, p, d2);
+		Pos q = nearest(i, j);
+		if (d(i, j) != b or d2(p, q) != b or m(q.i, q.j) == 0)
+		    ok = false;
+	    }
+    }
+    CHECK_TRUE(ok, "aleatorio");
+    }
+
+    {// por bandas
+    std::mt19937 g{7};
+    Mask m = mascara_aleatoria(g, 20, 30, 3);
+    auto d = alp::distance_transform2(m);
+
+    auto pred = [](int x) { return x != 0; };
+    alp::Matrix<int, int> fila{20, 30};
+    alp::edt_columns(m, pred, fila, 0, 11);
+    alp::edt_columns(m, pred, fila, 11, 30);
+
+    alp::Matrix<int64_t, int> d2{20, 30};
+    alp::Matrix<Pos, int>* sin_nearest = nullptr;
+    alp::edt_rows(fila, d2, sin_nearest, 0, 7);
+    alp::edt_rows(fila, d2, sin_nearest, 7, 20);
+
+    CHECK_TRUE(std::equal(d.begin(), d.end(), d2.begin()), "bandas");
+    }
+
+    {// varios threads
+    std::mt19937 g{8};
+    Mask m = mascara_aleatoria(g, 150, 290, 1);
+    auto pred = [](int x) { return x != 0; };
+
+    alp::Matrix<Pos, int> nearest{0, 0};
+    auto d = alp::distance_transform2(m, pred, nearest);
+
+    bool ok = true;
+    for (unsigned n: {0u, 1u, 3u, 8u}){
+	alp::Matrix<Pos, int> nearest_t{0, 0};
+	auto dt = alp::distance_transform2(m, pred, nearest_t, n);
+	auto dn = alp::distance_transform2(m, pred, n);
+	ok = ok and std::equal(d.begin(), d.end(), dt.begin())
+		and std::equal(d.begin(), d.end(), dn.begin())
+		and std::equal(nearest.begin(), nearest.end(), 
+			       nearest_t.begin());
+    }
+    CHECK_TRUE(ok, "num_threads");
+    }
+}
+
+
+void test_chamfer()
+{
+    test::interfaz("chamfer_distance");
+
+    std::mt19937 g{34};
+    bool ok = true;
+    for (int prob: {1, 5, 30}){
+	Mask m = mascara_aleatoria(g, 19, 41, prob);
+
+	alp::Matrix<Pos, int> nearest{0, 0};
+	auto d = alp::chamfer_distance(m, [](int x) {return x != 0;}, nearest);
+	auto d1 = alp::chamfer_distance(m);
+
+	for (int i = 0; i < m.rows(); ++i)
+	    for (int j = 0; j < m.cols(); ++j){
+		Pos p{i, j};
+		int32_t b = fuerza_bruta(m, p, d34);
+		Pos q = nearest(i, j);
+		if (d(i, j) != b or d1(i, j) != b or d34(p, q) != b
+		    or m(q.i, q.j) == 0)
+		    ok = false;
+	    }
+    }
+    CHECK_TRUE(ok, "aleatorio");
+
+    Mask m{2, 3};
+    std::fill(m.begin(), m.end(), 0);
+    auto d = alp::chamfer_distance(m);
+    CHECK_TRUE(d(1, 2) == std::numeric_limits<int32_t>::max(), "sin objetos");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_matrix_distance.h");
+
+    test_euclidea();
+    test_chamfer();
+
+}catch(const std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+
+}
@@ -0,0 +1,289 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#include "../../../alp_matrix_match.h"
+#include "../../../alp_submatrix.h"
+#include "../../../alp_test.h"
+
+#include <iostream>
+#include <random>
+#include <cmath>
+
+using namespace test;
+
+using Image = alp::Matrix<uint8_t, int>;
+using Metric = alp::Match_metric;
+
+Image imagen_aleatoria(std::mt19937& g, int rows, int cols)
+{
+    Image m{rows, cols};
+    std::uniform_int_distribution<int> d{0, 255};
+    for (auto& x: m)
+	x = static_cast<uint8_t>(d(g));
+
+    return m;
+}
+
+// Imagen suave (para que la pirámide tenga sentido)
+Image imagen_suave(int rows, int cols)
+{
+    Image m{rows, cols};
+    for (int i = 0; i < rows; ++i)
+	for (int j = 0; j < cols; ++j)
+	    m(i, j) = static_cast<uint8_t>(127.5 + 60 * std::sin(0.21 * i)
+					+ 60 * std::cos(0.13 * j + 0.02 * i * j));
+    return m;
+}
+
+Image recorta(const Image& m, int i0, int j0, int rows, int cols)
+{
+    Image t{rows, cols};
+    for (int i = 0; i < rows; ++i)
+	for (int j = 0; j < cols; ++j)
+	    t(i, j) = m(i0 + i, j0 + j);
+
+    return t;
+}
+
+double fuerza_bruta(const Image& img, const Image& tpl, int i0, int j0,
+		    Metric met)
+{
+    double n = tpl.rows() * tpl.cols();
+    double s = 0, si = 0, st = 0, sii = 0, stt = 0, sit = 0;
+    for (int i = 0; i < tpl.rows(); ++i)
+	for (int j = 0; j < tpl.cols(); ++j){
+	    double a = img(i0 + i, j0 + j);
+	    double b = tpl(i, j);
+	    if (met == Metric::sad)
+		s += std::abs(a - b);
+	    else
+		s += (a - b) * (a - b);
+	    si += a; st += b; sii += a * a; stt += b * b; sit += a * b;
+	}
+
+    if (met != Metric::ncc)
+	return s;
+
+    double vi = sii - si * si / n;
+    double vt = stt - st * st / n;
+    if (vi <= 0 or vt <= 0)
+	return 0;
+
+    return (sit - si * st / n) / std::sqrt(vi * vt);
+}
+
+
+void test_match_map()
+{
+    test::interfaz("match_map");
+
+    std::mt19937 g{48};
+    Image img = imagen_aleatoria(g, 21, 40);
+    Image tpl = imagen_aleatoria(g, 5, 19);	// 19 = bloque + resto
+
+    for (Metric met: {Metric::sad, Metric::ssd, Metric::ncc}){
+	auto map = alp::match_map(img, tpl, met);
+	bool ok = (map.rows() == 17 and map.cols() == 22);
+	for (int i = 0; i < map.rows(); ++i)
+	    for (int j = 0; j < map.cols(); ++j)
+		if (std::abs(map(i, j) - fuerza_bruta(img, tpl, i, j, met))
+			> 1e-9)
+		    ok = false;
+
+	CHECK_TRUE(ok, "match_map");
+    }
+
+    {// por bandas
+    auto map = alp::match_map(img, tpl, Metric::ncc);
+    alp::Matrix<double, int> m2{17, 22};
+    alp::match_map_rows(img, tpl, Metric::ncc, m2, 0, 8);
+    alp::match_map_rows(img, tpl, Metric::ncc, m2, 8, 17);
+    CHECK_TRUE(std::equal(map.begin(), map.end(), m2.begin()), "bandas");
+    }
+
+    {// varios threads
+    Image big = imagen_aleatoria(g, 120, 60);
+    bool ok = true;
+    for (Metric met: {Metric::sad, Metric::ssd, Metric::ncc}){
+	auto map = alp::match_map(big, tpl, met);
+	for (unsigned n: {0u, 3u, 8u}){
+	    auto mt = alp::match_map(big, tpl, met, n);
+	    ok = ok and mt.rows() == map.rows() and mt.cols() == map.cols()
+		    and std::equal(map.begin(), map.end(), mt.begin());
+	}
+    }
+    CHECK_TRUE(ok, "num_threads");
+    }
+
+    {// ssd con enteros de 16 bits: (2^16 - 1)^2 no cabe en 32 bits
+    alp::Matrix<uint16_t, int> a{1, 1};
+    alp::Matrix<uint16_t, int> b{1, 1};
+    a(0, 0) = 65535;
+    b(0, 0) = 0;
+    auto map = alp::match_map(a, b, Metric::ssd);
+    CHECK_TRUE(map(0, 0) == 4294836225.0, "ssd(uint16_t)");
+
+    alp::Matrix<uint16_t, int> c{2, 35};	// bloques y resto
+    alp::Matrix<uint16_t, int> d{2, 35};
+    std::fill(c.begin(), c.end(), 65535);
+    std::fill(d.begin(), d.end(), 0);
+    map = alp::match_map(c, d, Metric::ssd);
+    CHECK_TRUE(map(0, 0) == 70.0 * 4294836225.0, "ssd(uint16_t, bloques)");
+
+    map = alp::match_map(c, d, Metric::sad);
+    CHECK_TRUE(map(0, 0) == 70.0 * 65535, "sad(uint16_t, bloques)");
+    }
+
+    {// patrón constante: ncc = 0
+    Image c{3, 3};
+    std::fill(c.begin(), c.end(), 7);
+    auto map = alp::match_map(img, c, Metric::ncc);
+    CHECK_TRUE(map(0, 0) == 0 and map(5, 7) == 0, "ncc degenerada");
+    }
+
+    {// patrón mayor que la imagen
+    Image t{30, 2};
+    auto map = alp::match_map(img, t, Metric::sad);
+    CHECK_TRUE(map.rows() == 0, "patrón demasiado grande");
+    }
+}
+
+
+void test_find_best_matches()
+{
+    test::interfaz("find_best_matches");
+
+    std::mt19937 g{4};
+    Image img = imagen_aleatoria(g, 30, 50);
+
+    for (Metric met: {Metric::sad, Metric::ssd, Metric::ncc}){
+	Image tpl = recorta(img, 11, 23, 6, 9);
+	auto res = alp::find_best_matches(img, tpl, met, 4);
+
+	auto map = alp::match_map(img, tpl, met);
+	std::vector<double> v(map.begin(), map.end());
+	if (met == Metric::ncc)
+	    std::sort(v.begin(), v.end(), std::greater<double>{});
+	else
+	    std::sort(v.begin(), v.end());
+
+	bool ok = (res.size() == 4 and res[0].pos == alp::Vector_ij<int>{11, 23});
+	for (size_t k = 0; k < res.size() and ok; ++k)
+	    if (std::abs(res[k].score - v[k]) > 1e-9 or
+		res[k].score != map(res[k].pos.i, res[k].pos.j))
+		ok = false;
+
+	CHECK_TRUE(ok, "find_best_matches");
+
+	ok = true;
+	for (unsigned n: {0u, 2u, 3u}){
+	    auto rt = alp::find_best_matches(img, tpl, met, 4, n);
+	    ok = ok and rt.size() == res.size();
+	    for (size_t k = 0; k < rt.size() and ok; ++k)
+		ok = rt[k].pos == res[k].pos and rt[k].score == res[k].score;
+	}
+	CHECK_TRUE(ok, "find_best_matches(num_threads)");
+    }
+
+    {// empates: gana la primera posición, como con un thread
+    Image c{40, 10};
+    std::fill(c.begin(), c.end(), 3);
+    Image t{2, 2};
+    std::fill(t.begin(), t.end(), 3);
+    auto r1 = alp::find_best_matches(c, t, Metric::sad, 3);
+    auto r4 = alp::find_best_matches(c, t, Metric::sad, 3, 4);
+    bool ok = r1.size() == 3 and r4.size() == 3;
+    for (size_t k = 0; k < 3 and ok; ++k)
+	ok = r1[k].pos == r4[k].pos and 
+	     r4[k].pos == (alp::Vector_ij<int>{0, static_cast<int>(k)});
+    CHECK_TRUE(ok, "empates");
+    }
+
+    {// el patrón puede ser una submatriz
+    using Position = Image::Position;
+    using Size = Image::Size2D;
+    auto tpl = alp::Submatrix{img, Position{3, 40}, Size{7, 8}};
+    auto res = alp::find_best_matches(img, tpl, Metric::ssd);
+    CHECK_TRUE(res.size() == 1 and res[0].pos == alp::Vector_ij<int>{3, 40}
+	       and res[0].score == 0, "submatrix");
+    }
+}
+
+
+void test_find_best_match()
+{
+    test::interfaz("find_best_match");
+
+    Image img = imagen_suave(90, 120);
+
+    for (Metric met: {Metric::sad, Metric::ssd, Metric::ncc}){
+	Image tpl = recorta(img, 37, 61, 24, 30);
+	auto r = alp::find_best_match(img, tpl, met);
+	CHECK_TRUE(r.pos == alp::Vector_ij<int>{37, 61}, "coarse-to-fine");
+
+	auto r1 = alp::find_best_match(img, tpl, met, 1);
+	CHECK_TRUE(r1.pos == alp::Vector_ij<int>{37, 61}, "exhaustiva");
+
+	// En el nivel 0 la puntuación es la de la imagen original
+	auto map = alp::match_map(img, tpl, met);
+	CHECK_TRUE(r.score == map(37, 61) and r1.score == map(37, 61),
+								    "score");
+    }
+
+    {// imágenes de 16 bits
+    alp::Matrix<uint16_t, int> img16{img.rows(), img.cols()};
+    for (int i = 0; i < img.rows(); ++i)
+	for (int j = 0; j < img.cols(); ++j)
+	    img16(i, j) = static_cast<uint16_t>(img(i, j) * 257);
+
+    alp::Matrix<uint16_t, int> tpl16{24, 30};
+    for (int i = 0; i < 24; ++i)
+	for (int j = 0; j < 30; ++j)
+	    tpl16(i, j) = img16(37 + i, 61 + j);
+
+    auto r = alp::find_best_match(img16, tpl16, Metric::ssd);
+    CHECK_TRUE(r.pos == alp::Vector_ij<int>{37, 61} and r.score == 0,
+								"uint16_t");
+    }
+
+    Image tpl{100, 3};
+    CHECK_EXCEPTION(alp::find_best_match(img, tpl, Metric::sad),
+		    "patrón demasiado grande");
+
+    Image t2 = recorta(img, 37, 61, 24, 30);
+    CHECK_EXCEPTION(alp::find_best_match(img, t2, Metric::sad, 3, 0),
+		    "num_candidatos = 0");
+    CHECK_EXCEPTION(alp::find_best_match(img, t2, Metric::sad, 1, 0),
+		    "num_candidatos = 0 (exhaustiva)");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_matrix_match.h");
+
+    test_match_map();
+    test_find_best_matches();
+    test_find_best_match();
+
+}catch(const std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+
+}
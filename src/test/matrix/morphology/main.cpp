@@ -0,0 +1,189 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#include "../../../alp_matrix_morphology.h"
+#include "../../../alp_test.h"
+
+#include <iostream>
+#include <random>
+
+using namespace test;
+
+using Size = alp::Size_ij<int>;
+
+template <typename T>
+alp::Matrix<T, int> aleatoria(std::mt19937& g, int rows, int cols, int max)
+{
+    alp::Matrix<T, int> m{rows, cols};
+    std::uniform_int_distribution<int> d{0, max};
+    for (auto& x: m)
+	x = static_cast<T>(d(g));
+
+    return m;
+}
+
+// Erosión (dilatación) por fuerza bruta
+template <typename T>
+alp::Matrix<T, int> fuerza_bruta(const alp::Matrix<T, int>& m, Size se,
+				 bool erosion)
+{
+    // La dilatación usa el rectángulo reflejado
+    int ai = se.rows / 2;
+    int aj = se.cols / 2;
+
+    alp::Matrix<T, int> res{m.rows(), m.cols()};
+    for (int i = 0; i < m.rows(); ++i)
+	for (int j = 0; j < m.cols(); ++j){
+	    T r = m(i, j);
+	    for (int di = -ai; di < se.rows - ai; ++di)
+		for (int dj = -aj; dj < se.cols - aj; ++dj){
+		    int p = erosion? i + di: i - di;
+		    int q = erosion? j + dj: j - dj;
+		    if (0 <= p and p < m.rows() and 0 <= q and q < m.cols())
+			r = erosion? std::min(r, m(p, q)): std::max(r, m(p, q));
+		}
+	    res(i, j) = r;
+	}
+
+    return res;
+}
+
+template <typename T>
+bool iguales(const alp::Matrix<T, int>& a, const alp::Matrix<T, int>& b)
+{
+    return a.rows() == b.rows() and a.cols() == b.cols() and
+	   std::equal(a.begin(), a.end(), b.begin());
+}
+
+
+const Size elementos[] = {{1, 1}, {3, 3}, {1, 5}, {4, 1}, {2, 6}, {5, 7},
+			  {7, 2}, {30, 3}, {3, 100}};
+
+template <typename T>
+void test_grises(const char* tipo)
+{
+    test::interfaz(std::string{"erode/dilate/open/close: "} + tipo);
+
+    std::mt19937 g{49};
+    bool ok = true;
+    for (auto [rows, cols]: {std::pair{1, 1}, {17, 23}, {9, 130}}){
+	auto m = aleatoria<T>(g, rows, cols, 200);
+
+	for (Size se: elementos){
+	    auto e = fuerza_bruta(m, se, true);
+	    auto d = fuerza_bruta(m, se, false);
+
+	    if (!iguales(alp::erode(m, se), e) or
+		!iguales(alp::dilate(m, se), d) or
+		!iguales(alp::open(m, se), fuerza_bruta(e, se, false)) or
+		!iguales(alp::close(m, se), fuerza_bruta(d, se, true)))
+		ok = false;
+	}
+    }
+    CHECK_TRUE(ok, "aleatorio");
+
+    {// reutilizando el buffer in situ
+    alp::Morphology_buffer<T> buf;
+    auto m = aleatoria<T>(g, 20, 70, 200);
+    auto m0 = m;
+    alp::open(m, Size{3, 5}, buf);
+    alp::close(m, Size{3, 5}, buf);
+    auto r = alp::close(alp::open(m0, Size{3, 5}), Size{3, 5});
+    CHECK_TRUE(iguales(m, r), "in situ");
+
+    bool anti = true;
+    auto a = alp::open(m0, Size{4, 4});
+    auto c = alp::close(m0, Size{4, 4});
+    for (int i = 0; i < m0.rows(); ++i)
+	for (int j = 0; j < m0.cols(); ++j)
+	    if (a(i, j) > m0(i, j) or c(i, j) < m0(i, j))
+		anti = false;
+    CHECK_TRUE(anti, "open <= m <= close");
+    }
+}
+
+
+void test_binaria()
+{
+    test::interfaz("binary_erode/dilate/open/close");
+
+    std::mt19937 g{50};
+    bool ok = true;
+    // 64 y 128: filas que ocupan palabras completas
+    for (auto [rows, cols]: {std::pair{1, 1}, {13, 64}, {21, 70}, {8, 128},
+			     {5, 200}}){
+	for (int prob: {1, 3}){
+	    auto m = aleatoria<uint8_t>(g, rows, cols, prob);
+	    for (auto& x: m)
+		x = (x != 0);
+
+	    for (Size se: elementos){
+		auto e = fuerza_bruta(m, se, true);
+		auto d = fuerza_bruta(m, se, false);
+
+		if (!iguales(alp::binary_erode(m, se), e) or
+		    !iguales(alp::binary_dilate(m, se), d) or
+		    !iguales(alp::binary_open(m, se),
+			     fuerza_bruta(e, se, false)) or
+		    !iguales(alp::binary_close(m, se),
+			     fuerza_bruta(d, se, true)))
+		    ok = false;
+	    }
+	}
+    }
+    CHECK_TRUE(ok, "aleatorio");
+
+    {// cualquier valor != 0 es 1
+    alp::Matrix<int, int> m{3, 3};
+    std::fill(m.begin(), m.end(), 0);
+    m(1, 1) = 7;
+    auto d = alp::binary_dilate(m, Size{3, 3});
+    CHECK_TRUE(std::count(d.begin(), d.end(), 1) == 9, "valores != 0");
+    }
+
+    {// in situ
+    alp::Morphology_buffer<bool> buf;
+    alp::Matrix<bool, int> m{10, 80};
+    std::fill(m.begin(), m.end(), true);
+    m(4, 40) = false;
+    alp::binary_erode(m, Size{3, 3}, buf);
+    alp::binary_erode(m, Size{1, 1}, buf);
+    CHECK_TRUE(std::count(m.begin(), m.end(), false) == 9, "in situ");
+    }
+
+    alp::Matrix<int, int> m{3, 3};
+    CHECK_EXCEPTION(alp::binary_erode(m, Size{0, 3}), "se vacío");
+    CHECK_EXCEPTION(alp::erode(m, Size{3, 0}), "se vacío");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_matrix_morphology.h");
+
+    test_grises<uint8_t>("uint8_t");
+    test_grises<int>("int");
+    test_grises<double>("double");
+    test_binaria();
+
+}catch(const std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+
+}
@@ -0,0 +1,285 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../../alp_matrix_raster.h"
+#include "../../../alp_submatrix.h"
+#include "../../../alp_test.h"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using namespace test;
+
+using Pos     = alp::Vector_ij<int>;
+using Range   = alp::Range_ij<int>;
+using Segment = alp::Segment_ij<int>;
+using Img     = alp::Matrix<int, int>;
+
+Img matriz(int rows, int cols)
+{
+    Img m{rows, cols};
+    std::fill(m.begin(), m.end(), 0);
+    return m;
+}
+
+// Pintamos los tramos en m (sumando, para ver si se solapan)
+struct Suma{
+    Img& m;
+    void operator()(int i, int j0, int je)
+    {
+	for (int j = j0; j < je; ++j)
+	    ++m(i, j);
+    }
+};
+
+bool iguales(const Img& a, const Img& b)
+{ return std::equal(a.begin(), a.end(), b.begin()); }
+
+void print(const Img& m)
+{
+    for (int i = 0; i < m.rows(); ++i){
+	for (int j = 0; j < m.cols(); ++j)
+	    std::cout << (m(i, j) == 0? '.': char('0' + m(i, j)));
+	std::cout << '\n';
+    }
+    std::cout << '\n';
+}
+
+
+// Segmento por fuerza bruta: b = b0 + sb·round(t·m/n)
+Img segmento(const Segment& s, int rows, int cols, int i_off = 0, int j_off = 0)
+{
+    Img m = matriz(rows, cols);
+    int di = s.B.i - s.A.i;
+    int dj = s.B.j - s.A.j;
+    bool h = std::abs(dj) >= std::abs(di);
+    int n = h? std::abs(dj): std::abs(di);
+    int mm = h? std::abs(di): std::abs(dj);
+    int sa = ((h? dj: di) < 0)? -1: 1;
+    int sb = ((h? di: dj) < 0)? -1: 1;
+
+    for (int t = 0; t <= n; ++t){
+	int o = (n == 0)? 0: (2*t*mm + n) / (2*n);
+	int i = h? s.A.i + sb*o: s.A.i + sa*t;
+	int j = h? s.A.j + sa*t: s.A.j + sb*o;
+	i -= i_off;
+	j -= j_off;
+	if (0 <= i and i < rows and 0 <= j and j < cols)
+	    ++m(i, j);
+    }
+
+    return m;
+}
+
+void test_segment()
+{
+    test::interfaz("raster_segment");
+
+    {
+    Img m = matriz(5, 8);
+    alp::draw_segment(m, Segment{Pos{0, 0}, Pos{4, 7}}, 1);
+    print(m);
+    CHECK_TRUE(m(0, 0) == 1 and m(4, 7) == 1, "extremos");
+    CHECK_TRUE(std::count(m.begin(), m.end(), 1) == 8, "número de pixels");
+    }
+
+    // Comparamos con la fuerza bruta, recortando con clip
+    Range clip{3, 17, 2, 21};	// rows = 14, cols = 19
+    bool ok = true;
+    for (int i0 = -5; i0 < 25; i0 += 3)
+    for (int j0 = -5; j0 < 25; j0 += 4)
+    for (int i1 = -5; i1 < 25; i1 += 2)
+    for (int j1 = -5; j1 < 25; j1 += 3){
+	Segment s{Pos{i0, j0}, Pos{i1, j1}};
+	Img res = segmento(s, 14, 19, 3, 2);
+
+	Img m = matriz(14, 19);
+	alp::raster_segment(s, clip, [&](int i, int a, int b) {
+				for (int j = a; j < b; ++j)
+				    ++m(i - 3, j - 2); });
+	if (!iguales(m, res)){
+	    std::cout << s << '\n';
+	    print(m);
+	    print(res);
+	    ok = false;
+	}
+    }
+    CHECK_TRUE(ok, "clip");
+
+    {// segmentos muy largos: solo se recorre la parte visible
+    Img m = matriz(10, 10);
+    alp::draw_segment(m, Segment{Pos{-1000000000, -1000000000},
+				 Pos{1000000000, 1000000000}}, 1);
+    bool diag = true;
+    for (int i = 0; i < 10; ++i)
+	diag = diag and m(i, i) == 1;
+    CHECK_TRUE(diag and std::count(m.begin(), m.end(), 1) == 10, "largo");
+    }
+}
+
+
+void test_rectangle()
+{
+    test::interfaz("raster_rectangle");
+
+    Img m = matriz(6, 8);
+    alp::fill_rectangle(m, Range{-2, 3, 5, 20}, 1);
+    alp::draw_rectangle(m, Range{2, 6, 0, 4}, 2);
+    print(m);
+
+    Img res = matriz(6, 8);
+    for (int i = 0; i < 3; ++i)
+	for (int j = 5; j < 8; ++j)
+	    res(i, j) = 1;
+    for (int i = 2; i < 6; ++i)
+	for (int j = 0; j < 4; ++j)
+	    if (i == 2 or i == 5 or j == 0 or j == 3)
+		res(i, j) = 2;
+
+    CHECK_TRUE(iguales(m, res), "fill/draw");
+
+    // El borde no pasa dos veces por las esquinas
+    Img s = matriz(6, 8);
+    alp::raster_rectangle_border(Range{1, 5, 1, 7}, Range{0, 6, 0, 8},
+				 Suma{s});
+    CHECK_TRUE(*std::max_element(s.begin(), s.end()) == 1 and
+	       std::count(s.begin(), s.end(), 1) == 16, "border");
+}
+
+
+void test_polygon()
+{
+    test::interfaz("raster_polygon");
+
+    {// un cuadrado es un rango
+    Img m = matriz(6, 6);
+    alp::fill_polygon(m, std::vector<Pos>{{0, 0}, {0, 4}, {4, 4}, {4, 0}}, 1);
+    Img res = matriz(6, 6);
+    alp::fill_rectangle(res, Range{0, 4, 0, 4}, 1);
+    CHECK_TRUE(iguales(m, res), "cuadrado");
+    }
+    {// dos triángulos con un lado común no se solapan y cubren el cuadrado
+    Img m = matriz(12, 12);
+    alp::raster_polygon(std::vector<Pos>{{1, 1}, {1, 11}, {11, 1}},
+				    Range{0, 12, 0, 12}, Suma{m});
+    alp::raster_polygon(std::vector<Pos>{{1, 11}, {11, 11}, {11, 1}},
+				    Range{0, 12, 0, 12}, Suma{m});
+    print(m);
+    Img res = matriz(12, 12);
+    alp::fill_rectangle(res, Range{1, 11, 1, 11}, 1);
+    CHECK_TRUE(iguales(m, res), "triángulos");
+    }
+    {// cóncavo, recortado
+    std::vector<Pos> p{{0, 0}, {0, 10}, {10, 10}, {5, 5}, {10, 0}};
+    Img m = matriz(10, 10);
+    alp::fill_polygon(m, p, 1);
+    print(m);
+    CHECK_TRUE(m(9, 0) == 1 and m(9, 5) == 0 and m(9, 9) == 1 and
+	       m(4, 5) == 1, "cóncavo");
+
+    Img s = matriz(10, 10);
+    alp::Submatrix<Img> sub{s, Range{2, 8, 3, 9}};
+    alp::fill_polygon(sub, p, 1);
+    bool ok = true;
+    for (int i = 0; i < 10; ++i)
+	for (int j = 0; j < 10; ++j){
+	    int esperado = (2 <= i and i < 8 and 3 <= j and j < 9)?
+						    m(i - 2, j - 3): 0;
+	    ok = ok and s(i, j) == esperado;
+	}
+    CHECK_TRUE(ok, "Submatrix");
+    }
+}
+
+
+void test_circle()
+{
+    test::interfaz("raster_circle");
+
+    for (int r = 0; r < 12; ++r){
+	Img f = matriz(30, 30);
+	Img c = matriz(30, 30);
+	alp::raster_circle(Pos{15, 15}, r, Range{0, 30, 0, 30}, Suma{f});
+	alp::raster_circumference(Pos{15, 15}, r, Range{0, 30, 0, 30}, Suma{c});
+
+	bool ok = true;
+	for (int i = 0; i < 30; ++i)
+	    for (int j = 0; j < 30; ++j){
+		int di = i - 15, dj = j - 15;
+		auto dentro = [r](int a, int b) { return a*a + b*b <= r*r + r; };
+		bool in = dentro(di, dj);
+		bool borde = in and (!dentro(di - 1, dj) or !dentro(di + 1, dj)
+				  or !dentro(di, dj - 1) or !dentro(di, dj + 1));
+		ok = ok and f(i, j) == in and c(i, j) == borde;
+	    }
+
+	if (!ok){
+	    print(f);
+	    print(c);
+	}
+	CHECK_TRUE(ok, alp::as_str() << "r = " << r);
+    }
+
+    Img m = matriz(9, 14);
+    alp::draw_circle(m, Pos{4, 4}, 4, 1);
+    alp::fill_circle(m, Pos{4, 12}, 3, 2);	// recortado
+    print(m);
+}
+
+
+void test_matrix_xy()
+{
+    test::interfaz("Matrix_xy");
+
+    using V = alp::Vector_xy<int>;
+    Img m = matriz(5, 6);
+    alp::Matrix_xy<int, int> xy{m};	    // origen abajo a la izda
+
+    alp::fill_rectangle(xy, alp::Rectangle_xy<int>{V{1, 0}, 3, 2}, 1);
+    alp::draw_segment(xy, V{0, 4}, V{5, 4}, 2);
+    alp::draw_circle(xy, V{5, 0}, 1, 3);
+    print(m);
+
+    CHECK_TRUE(m(4, 1) == 1 and m(3, 3) == 1 and m(2, 1) == 0, "fill_rectangle");
+    bool ok = true;
+    for (int j = 0; j < 6; ++j)
+	ok = ok and m(0, j) == 2;
+    CHECK_TRUE(ok, "draw_segment");
+    CHECK_TRUE(m(3, 5) == 3 and m(4, 4) == 3 and m(4, 5) == 0, "draw_circle");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_matrix_raster.h");
+
+    test_segment();
+    test_rectangle();
+    test_polygon();
+    test_circle();
+    test_matrix_xy();
+
+}catch(const std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+
+}
@@ -286,6 +286,75 @@ void test_matrix_xy()
 
 }
 
+template <int xs, int ys>
+void test_matrix_xy_for_each()
+{
+    test::interfaz("Matrix_xy::for_each");
+
+    using Matrix = alp::Matrix<int, int>;
+    Matrix m{4,5};
+
+    for (int i = 0; i < m.rows(); ++i)
+	for (int j = 0; j < m.cols(); ++j)
+	    m(i,j) = i*m.cols() + j;
+
+    alp::Matrix_xy<int,int, xs, ys> mxy{m, 1, 3};
+
+    {// for_each
+    int n = 0;
+    bool ok = true;
+    mxy.for_each([&](int x, int y, int& v){
+	    if (v != n or &v != &mxy(x, y))
+		ok = false;
+	    ++n;
+    });
+    CHECK_TRUE(ok and n == 20, "for_each");
+    }
+
+    {// for_each_in_row
+    bool ok = true;
+    for (int y = mxy.y_min(); y <= mxy.y_max(); ++y){
+	int x1 = mxy.x_min();
+	mxy.for_each_in_row(y, [&](int x, int& v){
+		if (x != x1 or &v != &mxy(x, y))
+		    ok = false;
+		++x1;
+	});
+
+	if (x1 != mxy.x_max() + 1)
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "for_each_in_row");
+
+    int y = mxy.y_min();
+    int x0 = mxy.x_min() + 1;
+    int xe = mxy.x_max();
+    mxy.for_each_in_row(y, x0, xe, [](int, int& v) { v = -1; });
+
+    ok = true;
+    for (int x = mxy.x_min(); x <= mxy.x_max(); ++x){
+	bool dentro = (x0 <= x and x < xe);
+	if ((mxy(x, y) == -1) != dentro)
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "for_each_in_row(x0, xe)");
+    }
+
+    {// const
+    const Matrix& m1 = m;
+    alp::const_Matrix_xy<int,int, xs, ys> cxy{m1, 1, 3};
+    int suma = 0;
+    cxy.for_each([&](int, int, const int& v) { suma += v; });
+
+    int suma2 = 0;
+    for (int y = cxy.y_min(); y <= cxy.y_max(); ++y)
+	cxy.for_each_in_row(y, [&](int, const int& v) { suma2 += v; });
+
+    CHECK_TRUE(suma == suma2, "const");
+    }
+}
+
+
 int main()
 {
 try{
@@ -293,6 +362,9 @@ try{
 
     test_matrix_view();
     test_matrix_xy();
+    test_matrix_xy_for_each<+1, +1>();
+    test_matrix_xy_for_each<-1, -1>();
+    test_matrix_xy_for_each<+1, -1>();
 
 }catch(std::exception& e)
 {
@@ -0,0 +1,357 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#include "../../../alp_matrix_warp.h"
+#include "../../../alp_matrix_algorithm.h"
+#include "../../../alp_test.h"
+
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+using namespace test;
+
+using Affine = alp::Affine_xy<double>;
+using Homography = alp::Homography_xy<double>;
+using V = alp::Vector_xy<double>;
+using alp::Border;
+using alp::Interpolation;
+
+bool casi_igual(const V& a, const V& b, double eps = 1e-9)
+{ return std::abs(a.x - b.x) < eps and std::abs(a.y - b.y) < eps; }
+
+template <typename T>
+alp::Matrix<T, int> matriz(int rows, int cols)
+{
+    alp::Matrix<T, int> m{rows, cols};
+    for (int i = 0; i < rows; ++i)
+	for (int j = 0; j < cols; ++j)
+	    m(i, j) = static_cast<T>((i * 37 + j * 11 + i * j) % 251);
+
+    return m;
+}
+
+template <typename M>
+bool iguales(const M& a, const M& b)
+{
+    if (a.rows() != b.rows() or a.cols() != b.cols())
+	return false;
+
+    return std::equal(a.begin(), a.end(), b.begin());
+}
+
+
+void test_affine()
+{
+    test::interfaz("Affine_xy");
+
+    V p{3, -2};
+    CHECK_TRUE(casi_igual(Affine{}(p), p), "identidad");
+    CHECK_TRUE(casi_igual(Affine::translation(V{1, 2})(p), V{4, 0}),
+							    "translation");
+    CHECK_TRUE(casi_igual(Affine::scale(2, 3)(p), V{6, -6}), "scale");
+    CHECK_TRUE(casi_igual(Affine::scale(2, 2, V{1, 1})(p), V{5, -5}),
+							    "scale(centro)");
+
+    alp::Radian a = std::numbers::pi / 2;
+    CHECK_TRUE(casi_igual(Affine::rotation(a)(V{1, 0}), V{0, 1}), "rotation");
+    CHECK_TRUE(casi_igual(Affine::rotation(a, V{1, 1})(V{2, 1}), V{1, 2}),
+							"rotation(centro)");
+
+    Affine t = Affine::rotation(0.3, V{4, 5}) * Affine::scale(1.5, 0.7);
+    CHECK_TRUE(casi_igual(t(p), Affine::rotation(0.3, V{4, 5})(
+					    Affine::scale(1.5, 0.7)(p))),
+							    "operator*");
+    CHECK_TRUE(casi_igual(t.inverse()(t(p)), p), "inverse");
+
+    CHECK_EXCEPTION(Affine::scale(0, 1).inverse(), "inverse(no invertible)");
+}
+
+
+void test_homography()
+{
+    test::interfaz("Homography_xy");
+
+    std::array<V, 4> src = {V{0, 0}, V{10, 0}, V{10, 10}, V{0, 10}};
+    std::array<V, 4> dst = {V{1, 2}, V{12, 1}, V{9, 14}, V{-1, 8}};
+
+    Homography h = Homography::from_points(src, dst);
+    bool ok = true;
+    for (int k = 0; k < 4; ++k)
+	if (!casi_igual(h(src[k]), dst[k], 1e-9))
+	    ok = false;
+    CHECK_TRUE(ok, "from_points");
+
+    V p{3.5, 7.25};
+    CHECK_TRUE(casi_igual(h.inverse()(h(p)), p), "inverse");
+    CHECK_TRUE(casi_igual((h * h.inverse())(p), p), "operator*");
+
+    Affine t = Affine::rotation(0.4, V{2, 3});
+    CHECK_TRUE(casi_igual(Homography{t}(p), t(p)), "Homography(Affine)");
+
+    std::array<V, 4> alineados = {V{0, 0}, V{1, 1}, V{2, 2}, V{0, 10}};
+    CHECK_EXCEPTION(Homography::from_points(alineados, dst),
+					    "from_points(degenerados)");
+}
+
+
+template <typename T>
+void test_warp_identidad()
+{
+    auto m = matriz<T>(13, 70);	// más de un bloque por fila
+
+    alp::Warp_params<T> p;
+    p.interpolation = Interpolation::nearest;
+    CHECK_TRUE(iguales(alp::warp(m, Affine{}, p), m), "identidad(nearest)");
+
+    p.interpolation = Interpolation::bilinear;
+    CHECK_TRUE(iguales(alp::warp(m, Affine{}, p), m), "identidad(bilinear)");
+    CHECK_TRUE(iguales(alp::warp(m, Homography{}, p), m),
+					    "identidad(homografía)");
+}
+
+
+void test_warp_border()
+{
+    test::interfaz("warp(Border)");
+
+    using M = alp::Matrix<int, int>;
+    auto m = matriz<int>(5, 6);
+    Affine t = Affine::translation(V{2, 1});	// x + 2, y + 1
+
+    alp::Warp_params<int> p;
+    p.interpolation = Interpolation::nearest;
+
+    auto comprueba = [&](auto valor){
+	M r{m.rows(), m.cols()};
+	std::fill(r.begin(), r.end(), -7);
+	alp::warp(m, r, t, p);
+
+	bool ok = true;
+	for (int i = 0; i < r.rows(); ++i)
+	    for (int j = 0; j < r.cols(); ++j)
+		if (r(i, j) != valor(i - 1, j - 2))
+		    ok = false;
+	return ok;
+    };
+
+    auto dentro = [&](int i, int j)
+		{ return 0 <= i and i < m.rows() and 0 <= j and j < m.cols(); };
+
+    p.border = Border::constant;
+    p.border_value = 99;
+    CHECK_TRUE(comprueba([&](int i, int j) {
+			    return dentro(i, j)? m(i, j): 99; }), "constant");
+
+    p.border = Border::transparent;
+    CHECK_TRUE(comprueba([&](int i, int j) {
+			    return dentro(i, j)? m(i, j): -7; }), "transparent");
+
+    p.border = Border::replicate;
+    CHECK_TRUE(comprueba([&](int i, int j) {
+			return m(std::max(i, 0), std::max(j, 0)); }), "replicate");
+
+    p.border = Border::reflect;
+    CHECK_TRUE(comprueba([&](int i, int j) {
+			return m(i < 0? -1 - i: i, j < 0? -1 - j: j); }), "reflect");
+
+    // Bilineal con translación entera: igual que nearest
+    p.interpolation = Interpolation::bilinear;
+    CHECK_TRUE(comprueba([&](int i, int j) {
+			return m(i < 0? -1 - i: i, j < 0? -1 - j: j); }),
+						    "reflect(bilinear)");
+}
+
+
+void test_rotate()
+{
+    test::interfaz("rotate");
+
+    alp::Warp_params<int> p;
+    p.interpolation = Interpolation::nearest;
+
+    auto m = matriz<int>(7, 7);
+    alp::Radian a90 = std::numbers::pi / 2;
+    CHECK_TRUE(iguales(alp::rotate(m, a90, p), alp::rotate_plus90(m)),
+							    "rotate(90)");
+    CHECK_TRUE(iguales(alp::rotate(m, -a90, p), alp::rotate_minus90(m)),
+							    "rotate(-90)");
+
+    auto m2 = matriz<int>(6, 9);
+    alp::Radian a180 = std::numbers::pi;
+    CHECK_TRUE(iguales(alp::rotate(m2, a180, p), alp::rotate_180(m2)),
+							    "rotate(180)");
+}
+
+
+void test_bilinear()
+{
+    test::interfaz("warp(bilinear)");
+
+    {// desplazamiento de medio pixel
+    auto m = matriz<double>(4, 9);
+    auto r = alp::warp(m, Affine::translation(V{0.5, 0}));
+
+    bool ok = true;
+    for (int i = 0; i < m.rows(); ++i)
+	for (int j = 1; j < m.cols(); ++j)
+	    if (std::abs(r(i, j) - (m(i, j - 1) + m(i, j)) / 2) > 1e-9)
+		ok = false;
+    CHECK_TRUE(ok, "translation(0.5)");
+    }
+
+    {// uint8_t (punto fijo) frente a double
+    auto m8 = matriz<uint8_t>(40, 150);
+    auto md = matriz<double>(40, 150);
+
+    Affine t = Affine::rotation(0.3, V{75, 20}) * Affine::scale(1.3, 0.8);
+
+    alp::Warp_params<uint8_t> p8;
+    p8.border = Border::replicate;
+    alp::Warp_params<double> pd;
+    pd.border = Border::replicate;
+
+    auto r8 = alp::warp(m8, t, p8);
+    auto rd = alp::warp(md, t, pd);
+
+    bool ok = true;
+    for (int i = 0; i < r8.rows(); ++i)
+	for (int j = 0; j < r8.cols(); ++j)
+	    if (std::abs(r8(i, j) - rd(i, j)) > 1.5)
+		ok = false;
+    CHECK_TRUE(ok, "uint8_t");
+    }
+
+    {// homografía afín == afín
+    auto m = matriz<double>(30, 80);
+    Affine t = Affine::rotation(-0.7, V{40, 15});
+
+    auto r1 = alp::warp(m, t);
+    auto r2 = alp::warp(m, Homography{t});
+
+    bool ok = true;
+    for (int i = 0; i < r1.rows(); ++i)
+	for (int j = 0; j < r1.cols(); ++j)
+	    if (std::abs(r1(i, j) - r2(i, j)) > 1e-6)
+		ok = false;
+    CHECK_TRUE(ok, "Homography == Affine");
+    }
+}
+
+
+void test_warp_rows()
+{
+    test::interfaz("warp_rows");
+
+    auto m = matriz<uint8_t>(31, 100);
+    std::array<V, 4> src = {V{0, 0}, V{99, 0}, V{99, 30}, V{0, 30}};
+    std::array<V, 4> dst = {V{5, 2}, V{90, 8}, V{95, 28}, V{2, 25}};
+    Homography h = Homography::from_points(src, dst);
+
+    auto r = alp::warp(m, h);
+
+    alp::Matrix<uint8_t, int> r2{m.rows(), m.cols()};
+    alp::warp_rows(m, r2, h, 0, 10);
+    alp::warp_rows(m, r2, h, 10, 25);
+    alp::warp_rows(m, r2, h, 25, 31);
+
+    CHECK_TRUE(iguales(r, r2), "bandas");
+
+    {// repartiendo las filas entre varios threads
+    auto g = matriz<uint8_t>(200, 90);
+    Affine t = Affine::rotation(0.3, V{45, 100});
+    alp::Warp_params<uint8_t> p;
+    p.interpolation = alp::Interpolation::bilinear;
+
+    alp::Matrix<uint8_t, int> a{g.rows(), g.cols()};
+    alp::Matrix<uint8_t, int> b{g.rows(), g.cols()};
+    alp::warp(g, a, t, p);
+    bool ok = true;
+    for (unsigned n: {0u, 1u, 3u, 8u}){
+	alp::warp(g, b, t, p, n);
+	ok = ok and iguales(a, b);
+
+	alp::warp(g, b, Homography{t}, p, n);
+	ok = ok and iguales(a, b);
+    }
+    CHECK_TRUE(ok, "num_threads");
+    }
+
+    // Puntos sin imagen (w <= 0 para x >= 10)
+    Homography inv{{1, 0, 0, 0, 1, 0, -0.1, 0, 1}};
+    alp::Warp_params<uint8_t> p;
+    p.border_value = 255;
+    auto r3 = alp::warp(m, inv.inverse(), p);
+
+    bool ok = true;
+    for (int i = 0; i < r3.rows(); ++i)
+	for (int j = 10; j < r3.cols(); ++j)
+	    if (r3(i, j) != 255)
+		ok = false;
+    CHECK_TRUE(ok, "w <= 0");
+}
+
+
+struct Color{
+    int r = 0, g = 0;
+
+    friend bool operator==(const Color&, const Color&) = default;
+};
+
+void test_no_aritmetico()
+{
+    test::interfaz("warp(no aritmético)");
+
+    alp::Matrix<Color, int> m{3, 4};
+    for (int i = 0; i < 3; ++i)
+	for (int j = 0; j < 4; ++j)
+	    m(i, j) = Color{i, j};
+
+    alp::Warp_params<Color> p;
+    CHECK_EXCEPTION(alp::warp(m, Affine{}, p), "bilinear");
+
+    p.interpolation = Interpolation::nearest;
+    CHECK_TRUE(iguales(alp::warp(m, Affine{}, p), m), "nearest");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_matrix_warp.h");
+
+    test_affine();
+    test_homography();
+
+    test::interfaz("warp(identidad)");
+    test_warp_identidad<uint8_t>();
+    test_warp_identidad<int>();
+    test_warp_identidad<double>();
+
+    test_warp_border();
+    test_rotate();
+    test_bilinear();
+    test_warp_rows();
+    test_no_aritmetico();
+
+}catch(const std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+
+}
@@ -0,0 +1,178 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../alp_multi_find.h"
+#include "../../alp_test.h"
+
+#include <iostream>
+#include <algorithm>
+#include <random>
+
+using namespace test;
+using alp::Match;
+
+// Búsqueda trivial, patrón a patrón
+std::vector<Match> busca_uno_a_uno(const std::vector<std::string>& patrones,
+				   const std::string& s)
+{
+    std::vector<Match> res;
+    for (size_t i = 0; i < patrones.size(); ++i){
+	auto& p = patrones[i];
+	for (auto k = s.find(p); k != std::string::npos; k = s.find(p, k + 1))
+	    res.push_back(Match{k, p.size(), i});
+    }
+
+    return res;
+}
+
+void ordena(std::vector<Match>& v)
+{
+    std::sort(v.begin(), v.end(), [](const Match& a, const Match& b) {
+	    return std::tie(a.pos, a.patron) < std::tie(b.pos, b.patron); });
+}
+
+bool busca_igual(const std::vector<std::string>& patrones, 
+		 const std::string& s)
+{
+    alp::Multi_find mf{patrones};
+    auto res = mf.find_all(s);
+    auto res2 = busca_uno_a_uno(patrones, s);
+
+    ordena(res);
+    ordena(res2);
+
+    return res == res2;
+}
+
+
+void test_find_all()
+{
+    test::interfaz("find_all");
+
+    {
+    alp::Multi_find mf{{"he", "she", "his", "hers"}};
+    std::vector<Match> res = {{1, 3, 1}, {2, 2, 0}, {2, 4, 3}};
+    CHECK_TRUE(mf.find_all("ushers") == res, "ushers");
+    CHECK_TRUE(mf.contains("this") and !mf.contains("hola"), "contains");
+    CHECK_TRUE(mf.find_all("").empty(), "find_all(vacía)");
+    }
+    {
+    alp::Multi_find mf{{"aa", "a", "aa"}};
+    std::vector<Match> res = {{0, 1, 1}, {0, 2, 2}, {0, 2, 0}, {1, 1, 1}};
+    CHECK_TRUE(mf.find_all("aa") == res, "solapados y repetidos");
+    }
+    {
+    alp::Multi_find mf{{"niño", "año"}};
+    alp::utf8_string s{"el niño tiene un año"};
+    std::vector<Match> res = {{3, 5, 0}, {18, 4, 1}};
+    CHECK_TRUE(mf.find_all(s) == res, "utf8_string");
+    }
+
+    CHECK_EXCEPTION(alp::Multi_find({"a", ""}), "patrón vacío");
+
+    // Con y sin prefiltro, comparando con la búsqueda trivial
+    std::mt19937 gen{1234};
+    std::uniform_int_distribution<int> letra{'a', 'h'};
+    auto aleatoria = [&](size_t n) {
+	std::string s(n, ' ');
+	for (auto& c: s) c = letra(gen);
+	return s;
+    };
+
+    std::string texto = aleatoria(10000);
+
+    CHECK_TRUE(busca_igual({"abc"}, texto), "1 patrón (memchr)");
+    CHECK_TRUE(busca_igual({"abc", "bca", "cab", "ab"}, texto), 
+					"3 bytes iniciales (8 en 8)");
+
+    std::vector<std::string> patrones;
+    for (int i = 0; i < 200; ++i)
+	patrones.push_back(aleatoria(1 + i % 6));
+
+    CHECK_TRUE(busca_igual(patrones, texto), "200 patrones");
+}
+
+
+void test_ignore_case()
+{
+    test::interfaz("ignore_case");
+
+    alp::Multi_find mf{{"árbol", "niño", "ab"}, true};
+    std::vector<Match> res = {{0, 6, 0}, {8, 5, 1}, {16, 2, 2}};
+    CHECK_TRUE(mf.find_all("ÁRBOL, Niño y aB") == res, "mayúsculas");
+
+    alp::Multi_find mf2{{"ÑU"}, true};
+    CHECK_TRUE(mf2.contains("un ñu"), "patrón en mayúsculas");
+    CHECK_TRUE(!mf2.contains("un \xC4\x91u"), "solo Latin-1");
+
+    alp::Multi_find mf3{{"árbol"}};
+    CHECK_TRUE(!mf3.contains("ÁRBOL"), "sin ignore_case");
+}
+
+
+void test_stream()
+{
+    test::interfaz("Stream");
+
+    std::vector<std::string> patrones = {"he", "she", "his", "hers", 
+					 "ÁRBOL", "x"};
+    std::string texto = "ushers, his árbol; she is here. xx";
+
+    for (bool ic: {false, true}){
+	alp::Multi_find mf{patrones, ic};
+	auto res = mf.find_all(texto);
+
+	bool ok = true;
+	for (size_t i = 0; i <= texto.size(); ++i){
+	    alp::Multi_find::Stream st{mf};
+	    std::vector<Match> res2;
+	    auto f = [&](const Match& m) { res2.push_back(m); };
+
+	    st.feed(texto.data(), texto.data() + i, f);
+	    st.feed(texto.data() + i, texto.data() + texto.size(), f);
+
+	    ok = ok and (res == res2) and st.pos() == texto.size();
+	}
+
+	CHECK_TRUE(ok, "partido en 2 bloques");
+    }
+
+    alp::Multi_find mf{{"ab"}};
+    alp::Multi_find::Stream st{mf};
+    size_t n = 0;
+    for (char c: std::string{"xabxxaby"})
+	st.feed(&c, &c + 1, [&](const Match& m) { n += m.pos; });
+
+    CHECK_TRUE(n == 1 + 5, "byte a byte");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_multi_find.h");
+
+    test_find_all();
+    test_ignore_case();
+    test_stream();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
@@ -0,0 +1,193 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../alp_point_cloud.h"
+#include "../../alp_random.h"
+#include "../../alp_test.h"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using namespace test;
+
+using V3 = alp::Vector_xyz<double>;
+using V2 = alp::Vector_xy<double>;
+
+std::vector<V3> puntos_aleatorios(size_t n)
+{
+    alp::Xoshiro256pp g{777};
+    alp::Uniform_real<double> u{-10.0, 10.0};
+
+    std::vector<V3> v;
+    for (size_t i = 0; i < n; ++i)
+	v.push_back(V3{u(g), u(g), u(g)});
+
+    return v;
+}
+
+bool aprox(double a, double b) {return std::abs(a - b) < 1e-9;}
+
+bool aprox(const V3& a, const V3& b)
+{ return aprox(a.x, b.x) and aprox(a.y, b.y) and aprox(a.z, b.z); }
+
+
+void test_point_cloud()
+{
+    test::interfaz("Point_cloud");
+
+    std::vector<V3> v = puntos_aleatorios(150);
+    alp::Point_cloud<V3> p{v};
+
+    CHECK_TRUE(p.size() == 150 and !p.empty(), "size");
+    CHECK_TRUE(p.as_vector() == v, "AoS -> SoA -> AoS");
+    CHECK_TRUE(p.component(1)[7] == v[7].y, "component");
+
+    // proxy
+    p[3].x = 1.0;
+    CHECK_TRUE(p.component(0)[3] == 1.0, "reference");
+    p[4] = V3{1, 2, 3};
+    CHECK_TRUE(V3{p[4]} == (V3{1, 2, 3}), "reference = V");
+
+    // vista AoS
+    v[3].x = 1.0;
+    v[4] = V3{1, 2, 3};
+    CHECK_TRUE(std::equal(p.begin(), p.end(), v.begin(),
+		      [](const auto& a, const V3& b) { return V3{a} == b; }),
+								"iterator");
+    const auto& cp = p;
+    CHECK_TRUE(cp.end() - cp.begin() == 150 and V3{cp.begin()[4]} == v[4],
+							    "const_iterator");
+
+    p.push_back(V3{0, 0, 0});
+    CHECK_TRUE(p.size() == 151, "push_back");
+
+    {
+    alp::Point_cloud<alp::Vector_ij<int>> q;
+    q.push_back(alp::Vector_ij<int>{1, 2});
+    CHECK_TRUE(q[0].i == 1 and q[0].j == 2, "Vector_ij");
+    }
+}
+
+
+void test_operaciones()
+{
+    test::interfaz("operaciones");
+
+    std::vector<V3> v = puntos_aleatorios(1000);
+    std::vector<V3> w = puntos_aleatorios(1000);
+    std::reverse(w.begin(), w.end());
+
+    alp::Point_cloud<V3> p{v};
+    alp::Point_cloud<V3> q{w};
+
+    {
+    auto d = alp::dot_product(p, q);
+    auto e = alp::dot_product(p, V3{1, 2, 3});
+    auto m = alp::modulo(p);
+    std::vector<double> m2(p.size());
+    alp::modulo2(p, std::span{m2});
+
+    bool ok = true;
+    for (size_t i = 0; i < v.size(); ++i)
+	ok = ok and aprox(d[i], alp::dot_product(v[i], w[i]))
+		and aprox(e[i], alp::dot_product(v[i], V3{1, 2, 3}))
+		and aprox(m2[i], alp::dot_product(v[i], v[i]))
+		and aprox(m[i], std::sqrt(alp::dot_product(v[i], v[i])));
+    CHECK_TRUE(ok, "dot_product/modulo");
+    }
+    {
+    auto c = alp::cross_product(p, q);
+    auto e = alp::cross_product(p, V3{1, 2, 3});
+    bool ok = true;
+    for (size_t i = 0; i < v.size(); ++i)
+	ok = ok and aprox(c[i], alp::cross_product(v[i], w[i]))
+		and aprox(e[i], alp::cross_product(v[i], V3{1, 2, 3}));
+    CHECK_TRUE(ok, "cross_product");
+    }
+    {
+    auto [mn, mx] = alp::bounding_box(p);
+    bool ok = true;
+    for (auto& x: v)
+	ok = ok and mn.x <= x.x and x.x <= mx.x and mn.y <= x.y and
+	     x.y <= mx.y and mn.z <= x.z and x.z <= mx.z;
+    ok = ok and std::any_of(v.begin(), v.end(),
+			    [&](const V3& x) { return x.x == mn.x; })
+	    and std::any_of(v.begin(), v.end(),
+			    [&](const V3& x) { return x.z == mx.z; });
+    CHECK_TRUE(ok, "bounding_box");
+    }
+    {// R = giro de 90º alrededor del eje z, después trasladamos y escalamos
+    std::array<std::array<double, 3>, 3> R{{{0, -1, 0}, {1, 0, 0}, {0, 0, 1}}};
+    alp::rotate(p, R);
+    alp::translate(p, V3{1, 2, 3});
+    alp::scale(p, 2.0);
+    bool ok = true;
+    for (size_t i = 0; i < v.size(); ++i)
+	ok = ok and aprox(p[i], 2.0 * V3{-v[i].y + 1, v[i].x + 2, v[i].z + 3});
+    CHECK_TRUE(ok, "rotate/translate/scale");
+    }
+    {// Vector_xy
+    std::vector<V2> a;
+    for (auto& x: v)
+	a.push_back(V2{x.x, x.y});
+
+    alp::Point_cloud<V2> pa{a};
+    alp::rotate(pa, alp::Degree{30});
+    bool ok = true;
+    for (size_t i = 0; i < a.size(); ++i){
+	V2 r = alp::rotate(a[i], alp::Degree{30});
+	ok = ok and aprox(pa[i].x, r.x) and aprox(pa[i].y, r.y);
+    }
+    CHECK_TRUE(ok, "rotate(Vector_xy<double>)");
+
+    using Vi = alp::Vector_xy<int>;
+    std::vector<Vi> b{Vi{3, 0}, Vi{-2, 5}, Vi{7, 7}};
+    alp::Point_cloud<Vi> pb{b};
+    alp::rotate(pb, alp::Degree{90});
+    CHECK_TRUE(pb.as_vector() == (std::vector<Vi>{Vi{0, 3}, Vi{-5, -2},
+						  Vi{-7, 7}}), "rotate(Vector_xy<int>)");
+
+    // con Degree se gira en double; con Rotation_deg en punto fijo
+    alp::Point_cloud<Vi> pc{std::vector<Vi>{Vi{1000000, 0}}};
+    alp::rotate(pc, alp::Degree{1});
+    CHECK_TRUE(static_cast<Vi>(pc[0]) == alp::rotate(Vi{1000000, 0}, alp::Degree{1}),
+						    "rotate(Degree) en double");
+    pc[0] = Vi{1000000, 0};
+    alp::rotate(pc, alp::Rotation_deg{1});
+    CHECK_TRUE(static_cast<Vi>(pc[0]) == alp::Rotation_deg{1}(Vi{1000000, 0}),
+						    "rotate(Rotation_deg)");
+    }
+}
+
+
+int main()
+{
+try{
+    test::header("alp_point_cloud.h");
+
+    test_point_cloud();
+    test_operaciones();
+
+}catch(const std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+
+}
@@ -0,0 +1,244 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../alp_random.h"
+#include "../../alp_test.h"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <tuple>
+
+using namespace test;
+
+// Media y varianza de x
+template <typename T>
+std::pair<double, double> media_varianza(const std::vector<T>& x)
+{
+    double m = 0;
+    for (auto a: x)
+	m += static_cast<double>(a);
+    m /= x.size();
+
+    double v = 0;
+    for (auto a: x)
+	v += (static_cast<double>(a) - m) * (static_cast<double>(a) - m);
+
+    return {m, v / x.size()};
+}
+
+
+void test_xoshiro()
+{
+    test::interfaz("Xoshiro256pp");
+
+    // Valores calculados a mano: rotl(s0 + s3, 23) + s0
+    alp::Xoshiro256pp g{std::array<uint64_t, 4>{1, 2, 3, 4}};
+    CHECK_TRUE(g() == (uint64_t{5} << 23) + 1, "operator()");
+
+    static_assert(std::uniform_random_bit_generator<alp::Xoshiro256pp>);
+
+    alp::Xoshiro256pp a{42};
+    alp::Xoshiro256pp b{42};
+    std::vector<uint64_t> x(1000);
+    a.fill(x);
+    bool ok = true;
+    for (auto y: x)
+	ok = ok and y == b();
+    CHECK_TRUE(ok and a == b, "fill");
+
+    // El salto es lineal: conmuta con avanzar el generador
+    alp::Xoshiro256pp c{7};
+    alp::Xoshiro256pp d{7};
+    c.jump();
+    c();
+    d();
+    d.jump();
+    CHECK_TRUE(c == d, "jump");
+
+    auto s0 = alp::Xoshiro256pp::stream(7, 0);
+    auto s2 = alp::Xoshiro256pp::stream(7, 2);
+    alp::Xoshiro256pp e{7};
+    e.jump();
+    e.jump();
+    CHECK_TRUE(s0 == alp::Xoshiro256pp{7} and s2 == e, "stream");
+}
+
+
+void test_pcg32()
+{
+    test::interfaz("Pcg32");
+
+    // Salida de referencia de pcg32_srandom(42, 54)
+    alp::Pcg32 g{42, 54};
+    std::vector<uint32_t> res{0xa15c02b7, 0x7b47f409, 0xba1d3330, 
+			      0x83d2f293, 0xbfa4784b, 0xcbed606e};
+    std::vector<uint32_t> x(6);
+    g.fill(x);
+    CHECK_EQUAL_CONTAINERS(x, res, "operator()");
+
+    alp::Pcg32 a{1, 2};
+    alp::Pcg32 b{1, 2};
+    for (int i = 0; i < 12345; ++i)
+	a();
+    b.advance(12345);
+    CHECK_TRUE(a == b, "advance");
+
+    auto s1 = alp::Pcg32::stream(5, 1);
+    auto s2 = alp::Pcg32::stream(5, 2);
+    CHECK_TRUE(s1() != s2(), "stream");
+}
+
+
+template <typename Int, typename G>
+bool test_uniform_int(Int a, Int b, G& g)
+{
+    alp::Uniform_int<Int> u{a, b};
+    std::vector<Int> x(5000);
+    u.fill(g, x);
+    for (int i = 0; i < 100; ++i)
+	x.push_back(u(g));
+
+    return std::all_of(x.begin(), x.end(), 
+			    [&](Int y) { return a <= y and y <= b; });
+}
+
+
+void test_uniform_int()
+{
+    test::interfaz("Uniform_int");
+
+    alp::Xoshiro256pp g{1};
+    alp::Pcg32 h{1};
+
+    CHECK_TRUE(test_uniform_int<int>(-3, 7, g), "int");
+    CHECK_TRUE(test_uniform_int<int>(-3, 7, h), "int (Pcg32)");
+    CHECK_TRUE(test_uniform_int<uint8_t>(0, 255, g), "uint8_t");
+    CHECK_TRUE(test_uniform_int<int8_t>(-128, 127, g), "int8_t");
+    CHECK_TRUE(test_uniform_int<int>(5, 5, g), "a == b");
+    CHECK_TRUE(test_uniform_int<int64_t>(-(int64_t{1} << 40), 
+					  int64_t{1} << 50, g), "int64_t");
+    CHECK_TRUE(test_uniform_int<int64_t>(
+		    std::numeric_limits<int64_t>::min(),
+		    std::numeric_limits<int64_t>::max(), g), "int64_t (todo)");
+    CHECK_TRUE(test_uniform_int<uint32_t>(0, 0xFFFFFFFF, h), "uint32_t (todo)");
+
+    // Sin sesgo: con 3 valores cada uno sale 1/3 de las veces
+    alp::Uniform_int<int> u{0, 2};
+    std::vector<int> x(300000);
+    u.fill(g, x);
+    std::array<size_t, 3> n{};
+    for (auto y: x)
+	++n[y];
+    CHECK_TRUE(std::all_of(n.begin(), n.end(), 
+		[](size_t c) { return 99000 < c and c < 101000; }), "uniforme");
+
+    CHECK_EXCEPTION((alp::Uniform_int<int>{3, 2}), "b < a");
+}
+
+
+void test_distribuciones()
+{
+    test::interfaz("distribuciones");
+
+    alp::Xoshiro256pp g{3};
+
+    std::vector<double> x(200000);
+    alp::Uniform_real<double>{-1, 3}.fill(g, x);
+    auto [m, v] = media_varianza(x);
+    CHECK_TRUE(std::all_of(x.begin(), x.end(), 
+		    [](double y) { return -1 <= y and y < 3; }), "Uniform_real");
+    CHECK_TRUE(std::abs(m - 1) < 0.02 and std::abs(v - 16.0/12) < 0.02, 
+						"Uniform_real (media)");
+
+    std::vector<float> f(100001);
+    alp::Uniform_real<float>{}.fill(g, f);
+    CHECK_TRUE(std::all_of(f.begin(), f.end(), 
+		    [](float y) { return 0 <= y and y < 1; }), "float");
+
+    alp::Normal<double> normal{2, 3};
+    normal.fill(g, x);
+    std::tie(m, v) = media_varianza(x);
+    CHECK_TRUE(std::abs(m - 2) < 0.05 and std::abs(v - 9) < 0.15, "Normal");
+
+    for (auto& y: x)
+	y = normal(g);
+    std::tie(m, v) = media_varianza(x);
+    CHECK_TRUE(std::abs(m - 2) < 0.05 and std::abs(v - 9) < 0.15, 
+							"Normal (operator())");
+
+    alp::Exponential<double>{4}.fill(g, x);
+    std::tie(m, v) = media_varianza(x);
+    CHECK_TRUE(std::abs(m - 0.25) < 0.005 and 
+	       std::all_of(x.begin(), x.end(), [](double y) { return y >= 0; }),
+							    "Exponential");
+
+    std::vector<uint8_t> b(100000);
+    alp::Bernoulli ber{0.3};
+    for (auto& y: b)
+	y = ber(g);
+    std::tie(m, v) = media_varianza(b);
+    CHECK_TRUE(std::abs(m - 0.3) < 0.01, "Bernoulli");
+
+    auto bs = std::make_unique<bool[]>(1000);
+    alp::Bernoulli{1}.fill(g, std::span{bs.get(), 1000});
+    CHECK_TRUE(std::all_of(bs.get(), bs.get() + 1000, 
+				[](bool y) { return y; }), "Bernoulli(1)");
+
+    CHECK_EXCEPTION(alp::Bernoulli{1.5}, "Bernoulli(1.5)");
+}
+
+
+void test_random_number()
+{
+    test::interfaz("Random_number");
+
+    alp::Random_number<int> a{1, 6, 123};
+    alp::Random_number<int> b{1, 6, 123};
+    std::vector<int> x(100);
+    a.fill(x);
+    CHECK_TRUE(std::all_of(x.begin(), x.end(), 
+			[](int y) { return 1 <= y and y <= 6; }), "fill");
+
+    std::vector<int> y(100);
+    b.fill(y);
+    CHECK_TRUE(x == y and a() == b(), "misma semilla");
+
+    alp::Random_number<int> c{1, 1000000};
+    alp::Random_number<int> d{1, 1000000};
+    CHECK_TRUE(c() != d() or c() != d(), "random_seed");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_random.h");
+
+    test_xoshiro();
+    test_pcg32();
+    test_uniform_int();
+    test_distribuciones();
+    test_random_number();
+
+}catch(std::exception& e){
+    std::cerr << e.what() << std::endl;
+    return 1;
+}
+    return 0;
+}
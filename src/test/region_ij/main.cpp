@@ -0,0 +1,216 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#include "../../alp_region_ij.h"
+#include "../../alp_matrix.h"
+#include "../../alp_test.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace test;
+
+using Region = alp::Region_ij<int>;
+using Run    = alp::Run_ij<int>;
+using Range  = alp::Range_ij<int>;
+using Pos    = alp::Vector_ij<int>;
+using Mask   = alp::Matrix<int, int>;
+
+Mask matriz(int rows, int cols, int v = 0)
+{
+    Mask m{rows, cols};
+    std::fill(m.begin(), m.end(), v);
+    return m;
+}
+
+// Máscara aleatoria con pixels agrupados en tramos
+Mask mascara_aleatoria(std::mt19937& g, int rows, int cols)
+{
+    Mask m = matriz(rows, cols);
+    std::uniform_int_distribution<int> d{0, 9};
+    for (int i = 0; i < rows; ++i){
+	int v = 0;
+	for (int j = 0; j < cols; ++j){
+	    if (d(g) < 3)
+		v = !v;
+	    m(i, j) = v;
+	}
+    }
+
+    return m;
+}
+
+
+void test_basico()
+{
+    test::interfaz("Region_ij");
+
+    Region r0;
+    CHECK_TRUE(r0.empty() and r0.area() == 0, "Region_ij()");
+
+    Region r{Range{2, 5, -1, 3}};
+    CHECK_TRUE(r.num_runs() == 3 and r.area() == 12, "Region_ij(Range)");
+    CHECK_TRUE(r.runs()[0] == (Run{2, -1, 3}), "runs");
+
+    Range bb = r.bounding_box();
+    CHECK_TRUE(bb.i0 == 2 and bb.ie == 5 and bb.j0 == -1 and bb.je == 3,
+							    "bounding_box");
+
+    CHECK_TRUE(r.contains(Pos{2, -1}), "contains");
+    CHECK_TRUE(r.contains(Pos{4, 2}), "contains");
+    CHECK_TRUE(!r.contains(Pos{4, 3}), "contains");
+    CHECK_TRUE(!r.contains(Pos{1, 0}), "contains");
+    CHECK_TRUE(!r.contains(Pos{5, 0}), "contains");
+
+    Region s = Region::from_runs({Run{3, 5, 8}, Run{1, 0, 2}, Run{3, 0, 3},
+				  Run{3, 2, 5}, Run{1, 4, 4}, Run{1, 3, 6}});
+    std::cout << "s = " << s << '\n';
+    CHECK_TRUE((s.runs() == std::vector<Run>{Run{1, 0, 2}, Run{1, 3, 6},
+					     Run{3, 0, 8}}), "from_runs");
+    CHECK_TRUE(s.area() == 13, "area");
+
+    s.translate(Pos{-2, 1});
+    CHECK_TRUE((s.runs() == std::vector<Run>{Run{-1, 1, 3}, Run{-1, 4, 7},
+					     Run{1, 1, 9}}), "translate");
+}
+
+
+void test_algebra()
+{
+    test::interfaz("Region_ij: |, &, -");
+
+    Region a{Range{0, 4, 0, 6}};
+    Region b{Range{2, 6, 4, 10}};
+
+    Region u = a | b;
+    CHECK_TRUE(u.area() == 24 + 24 - 4, "operator|");
+    CHECK_TRUE(u.runs()[2] == (Run{2, 0, 10}), "operator|");
+
+    Region in = a & b;
+    CHECK_TRUE(in == Region{Range{2, 4, 4, 6}}, "operator&");
+
+    Region d = a - b;
+    CHECK_TRUE(d.area() == 20 and d.runs()[3] == (Run{3, 0, 4}), "operator-");
+
+    CHECK_TRUE((a - a).empty(), "a - a");
+    CHECK_TRUE((a | a) == a and (a & a) == a, "a | a, a & a");
+    CHECK_TRUE((a | Region{}) == a and (a & Region{}).empty(), "vacía");
+
+    // Tramos que se tocan se unen
+    Region c = Region{Range{0, 1, 0, 3}} | Region{Range{0, 1, 3, 5}};
+    CHECK_TRUE(c.num_runs() == 1 and c.runs()[0] == (Run{0, 0, 5}),
+							"operator|(tocan)");
+
+    // Comparamos con el resultado pixel a pixel
+    std::mt19937 g{12345};
+    bool ok = true;
+    for (int n = 0; n < 50 and ok; ++n){
+	Mask ma = mascara_aleatoria(g, 17, 40);
+	Mask mb = mascara_aleatoria(g, 17, 40);
+
+	Region ra = Region::from_mask(ma);
+	Region rb = Region::from_mask(mb);
+	rb.translate(Pos{-2, -3});
+
+	Region ru = ra | rb;
+	Region ri = ra & rb;
+	Region rd = ra - rb;
+
+	size_t au = 0, ai = 0, ad = 0;
+	for (int i = -3; i < 20; ++i)
+	    for (int j = -5; j < 45; ++j){
+		Pos p{i, j};
+		bool x = ra.contains(p);
+		bool y = 0 <= i + 2 and i + 2 < 17 and 0 <= j + 3 and j + 3 < 40
+			 and mb(i + 2, j + 3) != 0;
+
+		if (y != rb.contains(p))	ok = false;
+		if (ru.contains(p) != (x or y))	ok = false;
+		if (ri.contains(p) != (x and y))ok = false;
+		if (rd.contains(p) != (x and !y))ok = false;
+
+		au += (x or y);
+		ai += (x and y);
+		ad += (x and !y);
+	    }
+
+	if (ru.area() != au or ri.area() != ai or rd.area() != ad)
+	    ok = false;
+
+	// Representación única: a | b == (a - b) | (a & b) | (b - a)
+	if (ru != ((rd | ri) | (rb - ra)))
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "aleatorio");
+}
+
+
+void test_matrix()
+{
+    test::interfaz("Region_ij y Matrix");
+
+    std::mt19937 g{2026};
+    Mask m = mascara_aleatoria(g, 9, 70);
+
+    Region r = Region::from_mask(m);
+    Mask m2 = matriz(9, 70, 5);
+    alp::to_mask(r, m2, 1, 0);
+    CHECK_TRUE(std::equal(m.begin(), m.end(), m2.begin()), "from_mask/to_mask");
+
+    Region r2 = Region::from_mask(m, [](int x) { return x == 0; });
+    CHECK_TRUE(r2.area() + r.area() == 9 * 70 and (r & r2).empty(),
+							    "from_mask(pred)");
+
+    // La región se sale de la matriz: solo se pinta lo de dentro
+    Mask m3 = matriz(4, 5);
+    Region c{Range{-2, 2, 3, 8}};
+    alp::fill(m3, c, 7);
+    int suma = 0;
+    for (int i = 0; i < 4; ++i)
+	for (int j = 0; j < 5; ++j)
+	    suma += m3(i, j);
+    CHECK_TRUE(suma == 7 * 4 and m3(0, 3) == 7 and m3(1, 4) == 7,
+							    "fill(clip)");
+
+    int n = 0;
+    alp::for_each(m3, c | Region{Range{3, 4, 0, 1}}, [&](int& x) { x += 1; ++n; });
+    CHECK_TRUE(n == 5 and m3(3, 0) == 1 and m3(0, 3) == 8, "for_each");
+
+    std::vector<Run> runs;
+    alp::for_each_run(r, Range{2, 4, 10, 20}, [&](int i, int j0, int je) {
+			runs.push_back(Run{i, j0, je}); });
+    CHECK_TRUE(runs == (r & Region{Range{2, 4, 10, 20}}).runs(),
+							    "for_each_run");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_region_ij.h");
+
+    test_basico();
+    test_algebra();
+    test_matrix();
+
+}catch(const std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+
+}
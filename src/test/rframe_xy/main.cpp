@@ -19,6 +19,8 @@
 #include "../../alp_test.h"
 
 #include <iostream>
+#include <cmath>
+#include <vector>
 
 using namespace test;
 
@@ -157,6 +159,79 @@ void test_rotate()
     }
 }
 
+void test_rotation_deg()
+{
+    test::interfaz("Rotation_deg");
+
+    CHECK_TRUE(alp::sin_q16(0) == 0 and alp::cos_q16(0) == 65536, "0");
+    CHECK_TRUE(alp::sin_q16(90) == 65536 and alp::cos_q16(90) == 0, "90");
+    CHECK_TRUE(alp::sin_q16(-90) == -65536 and alp::cos_q16(540) == -65536,
+							"normalize");
+    CHECK_TRUE(alp::sin_q16(30) == 32768, "sin(30)");
+
+    for (int g = -720; g <= 720; ++g){
+	double r = alp::degree2radian(g);
+	if (std::abs(alp::sin_q16(g) - std::sin(r) * 65536) > 0.5 or
+	    std::abs(alp::cos_q16(g) - std::cos(r) * 65536) > 0.5)
+	    CHECK_TRUE(false, "tabla");
+    }
+
+    // Comparamos con el giro en double
+    using V = alp::Vector_xy<int>;
+    for (int g = 0; g < 360; g += 7){
+	alp::Rotation_deg rot{g};
+	double r = alp::degree2radian(g);
+	for (int x = -50; x <= 50; x += 3)
+	    for (int y = -50; y <= 50; y += 5){
+		V u = rot(V{x, y});
+		double ux = x * std::cos(r) - y * std::sin(r);
+		double uy = x * std::sin(r) + y * std::cos(r);
+		if (std::abs(u.x - ux) > 0.5 + 1e-3 or
+		    std::abs(u.y - uy) > 0.5 + 1e-3)
+		    CHECK_TRUE(false, "Rotation_deg");
+	    }
+    }
+
+    static_assert(alp::Rotation_deg{180}(V{3, -2}) == V{-3, 2});
+    CHECK_TRUE((alp::Rotation_deg{30}(V{2, 0}) == V{2, 1}), "Rotation_deg(30)");
+    CHECK_TRUE((alp::Rotation_deg{30}(V{-1, 0}) == V{-1, -1}), 
+						    "Rotation_deg(-1, 30)");
+
+    // rotate(v, Degree) no usa Rotation_deg: tiene que dar lo mismo que
+    // rotate(v, Radian)
+    CHECK_TRUE((alp::rotate(V{1000000, 0}, alp::Degree{1}) == 
+		alp::rotate(V{1000000, 0}, alp::Radian{alp::Degree{1}}) and
+		alp::rotate(V{1000000, 0}, alp::Degree{1}) == V{999848, 17452}),
+							    "rotate(Degree)");
+
+    // bulk
+    {
+    std::vector<V> p, q(100);
+    for (int i = 0; i < 100; ++i)
+	p.push_back(V{i - 50, 3*i - 20});
+
+    auto e = alp::rotate(p.begin(), p.end(), q.begin(),
+			   alp::Rotation_deg{37});
+    CHECK_TRUE(e == q.end(), "rotate(p0, pe, out)");
+    bool ok = true;
+    for (size_t i = 0; i < p.size(); ++i)
+	ok = ok and q[i] == alp::Rotation_deg{37}(p[i]);
+    CHECK_TRUE(ok, "rotate(p0, pe, out)");
+
+    std::vector<int> x, y;
+    for (auto& v: p){
+	x.push_back(v.x);
+	y.push_back(v.y);
+    }
+    alp::rotate(x.data(), y.data(), x.size(), x.data(), y.data(),
+		alp::Rotation_deg{37});
+    ok = true;
+    for (size_t i = 0; i < p.size(); ++i)
+	ok = ok and q[i] == V{x[i], y[i]};
+    CHECK_TRUE(ok, "rotate(x, y, n)");
+    }
+}
+
 int main()
 {
 try{
@@ -166,6 +241,7 @@ try{
     test_rectangle_xy();
 
     test_rotate();
+    test_rotation_deg();
 
 }catch(const std::exception& e)
 {
@@ -19,6 +19,7 @@
 #include "../../alp_test.h"
 
 #include <iostream>
+#include <vector>
 
 
 using namespace test;
@@ -196,6 +197,67 @@ void test_reference_frame()
 
 
 
+void test_reference_frame_array()
+{
+    test::interfaz("Reference_frames_xy::convert(array)");
+
+    using RF = alp::Reference_frames_xy<3>;
+
+    RF::origin[0] = RF::Origin{0,0};
+    RF::origin[1] = RF::Origin{0,7};
+    RF::origin[2] = RF::Origin{-3,5};
+
+    using Vector0 = alp::Vector_xy_in<0>;
+    using Vector2 = alp::Vector_xy_in<2>;
+
+    CHECK_TRUE((RF::offset<2, 1>() == alp::Vector_xy<int>{3, 2}), "offset");
+
+    std::vector<Vector0> p;
+    for (int k = 0; k < 100; ++k)
+	p.push_back(Vector0{k, 3*k - 50});
+
+    {// array de vectores
+    std::vector<Vector2> q = RF::convert<2>(p);
+    CHECK_TRUE(q.size() == p.size(), "size");
+
+    bool ok = true;
+    for (size_t k = 0; k < p.size(); ++k)
+	if (q[k] != RF::convert<2>(p[k]))
+	    ok = false;
+
+    CHECK_TRUE(ok, "convert(vector)");
+
+    std::vector<Vector0> r(q.size());
+    auto pe = RF::convert<0>(q.data(), q.data() + q.size(), r.data());
+    CHECK_TRUE(pe == r.data() + r.size(), "convert(p0, pe, out)");
+    CHECK_TRUE(r == p, "convert(p0, pe, out)");
+    }
+
+    {// arrays de coordenadas
+    std::vector<int> x, y;
+    for (auto& v: p){
+	x.push_back(v.x);
+	y.push_back(v.y);
+    }
+
+    std::vector<int> xr(x.size()), yr(y.size());
+    RF::convert<2, 0>(x.data(), y.data(), x.size(), xr.data(), yr.data());
+
+    bool ok = true;
+    for (size_t k = 0; k < p.size(); ++k){
+	Vector2 q = RF::convert<2>(p[k]);
+	if (xr[k] != q.x or yr[k] != q.y)
+	    ok = false;
+    }
+    CHECK_TRUE(ok, "convert(x, y, n, xr, yr)");
+
+    // in situ
+    RF::convert<0, 2>(xr.data(), yr.data(), xr.size(), xr.data(), yr.data());
+    CHECK_TRUE(xr == x and yr == y, "convert(in situ)");
+    }
+}
+
+
 int main()
 {
 try{
@@ -204,6 +266,7 @@ try{
     test_vector_xy();
     test_vector_ij();
     test_reference_frame();
+    test_reference_frame_array();
 
 
 
@@ -0,0 +1,236 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../alp_spatial_index.h"
+#include "../../alp_random.h"
+#include "../../alp_test.h"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+using namespace test;
+
+using Range = alp::Range_ij<int>;
+using Pos   = alp::Vector_ij<int>;
+
+Range rango_aleatorio(alp::Xoshiro256pp& g)
+{
+    alp::Uniform_int<int> pos{0, 999};
+    alp::Uniform_int<int> tam{0, 40};
+
+    int i0 = pos(g);
+    int j0 = pos(g);
+    return Range{i0, i0 + tam(g), j0, j0 + tam(g)};
+}
+
+// Búsquedas por fuerza bruta
+std::vector<size_t> containing(const std::vector<Range>& v,
+			       const std::vector<bool>& vivo, const Pos& p)
+{
+    std::vector<size_t> res;
+    for (size_t i = 0; i < v.size(); ++i)
+	if (vivo[i] and alp::belongs(p).to(v[i]))
+	    res.push_back(i);
+    return res;
+}
+
+std::vector<size_t> intersecting(const std::vector<Range>& v,
+			         const std::vector<bool>& vivo, const Range& r)
+{
+    std::vector<size_t> res;
+    for (size_t i = 0; i < v.size(); ++i){
+	Range x{std::max(r.i0, v[i].i0), std::max(std::min(r.ie, v[i].ie),
+							std::max(r.i0, v[i].i0)),
+		std::max(r.j0, v[i].j0), std::max(std::min(r.je, v[i].je),
+							std::max(r.j0, v[i].j0))};
+	if (vivo[i] and !x.empty())
+	    res.push_back(i);
+    }
+    return res;
+}
+
+std::vector<size_t> inside(const std::vector<Range>& v,
+			   const std::vector<bool>& vivo, const Range& r)
+{
+    std::vector<size_t> res;
+    for (size_t i = 0; i < v.size(); ++i)
+	if (vivo[i] and alp::es_subconjunto(v[i]).de(r))
+	    res.push_back(i);
+    return res;
+}
+
+double distancia2(const Range& r, const Pos& p)
+{
+    double da = std::max({r.i0 - p.i, 0, p.i - (r.ie - 1)});
+    double db = std::max({r.j0 - p.j, 0, p.j - (r.je - 1)});
+    return da * da + db * db;
+}
+
+std::vector<size_t> nearest(const std::vector<Range>& v,
+			    const std::vector<bool>& vivo, const Pos& p,
+			    size_t k)
+{
+    std::vector<std::pair<double, size_t>> d;
+    for (size_t i = 0; i < v.size(); ++i)
+	if (vivo[i] and !v[i].empty())
+	    d.push_back({distancia2(v[i], p), i});
+
+    std::sort(d.begin(), d.end());
+    std::vector<size_t> res;
+    for (size_t i = 0; i < k and i < d.size(); ++i)
+	res.push_back(d[i].second);
+    return res;
+}
+
+std::vector<size_t> ordena(std::vector<size_t> v)
+{
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+
+bool compara(const alp::Spatial_index<Range>& index,
+	     const std::vector<Range>& v, const std::vector<bool>& vivo,
+	     alp::Xoshiro256pp& g)
+{
+    alp::Uniform_int<int> pos{-20, 1020};
+
+    for (int n = 0; n < 200; ++n){
+	Pos p{pos(g), pos(g)};
+	Range r = rango_aleatorio(g);
+
+	if (ordena(index.containing(p)) != containing(v, vivo, p) or
+	    ordena(index.intersecting(r)) != intersecting(v, vivo, r) or
+	    ordena(index.inside(Range{r.i0, r.ie + 100, r.j0, r.je + 100}))
+		!= inside(v, vivo, Range{r.i0, r.ie + 100, r.j0, r.je + 100}))
+	    return false;
+
+	for (size_t k: {1, 5, 20}){
+	    auto nn = index.nearest(p, k);
+	    auto nb = nearest(v, vivo, p, k);
+	    if (nn != nb)
+		return false;
+	}
+    }
+
+    return true;
+}
+
+void test_range_ij()
+{
+    test::interfaz("Spatial_index<Range_ij>");
+
+    alp::Xoshiro256pp g{12345};
+
+    {// básico
+    std::vector<Range> v{Range{0, 10, 0, 10}, Range{5, 15, 5, 15},
+			 Range{20, 30, 20, 30}};
+
+    alp::Spatial_index<Range> index{v};
+    CHECK_TRUE(index.size() == 3, "size");
+    CHECK_TRUE(ordena(index.containing(Pos{7, 7})) ==
+				    (std::vector<size_t>{0, 1}), "containing");
+    CHECK_TRUE(index.containing(Pos{10, 10}) ==
+				    (std::vector<size_t>{1}), "containing");
+    CHECK_TRUE(index.containing(Pos{15, 15}).empty(), "containing");
+    CHECK_TRUE(index.intersecting(Range{10, 20, 10, 20}) ==
+				    (std::vector<size_t>{1}), "intersecting");
+    CHECK_TRUE(index.inside(Range{0, 16, 0, 16}).size() == 2, "inside");
+    CHECK_TRUE(index.nearest(Pos{40, 40}, 2) ==
+				    (std::vector<size_t>{2, 1}), "nearest");
+    }
+
+    std::vector<Range> v;
+    for (int i = 0; i < 3000; ++i)
+	v.push_back(rango_aleatorio(g));
+    std::vector<bool> vivo(v.size(), true);
+
+    alp::Spatial_index<Range> index{v};
+    CHECK_TRUE(compara(index, v, vivo, g), "bulk");
+
+    // Insertamos y borramos (obligando a reconstruir varias veces)
+    alp::Uniform_int<size_t> elige{0, 2999};
+    for (int n = 0; n < 2000; ++n){
+	size_t id = index.insert(rango_aleatorio(g));
+	v.push_back(index[id]);
+	vivo.push_back(true);
+	if (id != v.size() - 1)
+	    CHECK_TRUE(false, "insert: id");
+
+	size_t b = elige(g);
+	if (index.remove(b) != vivo[b])
+	    CHECK_TRUE(false, "remove");
+	vivo[b] = false;
+
+	if (n % 250 == 0 and !compara(index, v, vivo, g))
+	    CHECK_TRUE(false, "insert/remove");
+    }
+
+    CHECK_TRUE(compara(index, v, vivo, g), "insert/remove");
+    CHECK_TRUE(index.size() == size_t(std::count(vivo.begin(), vivo.end(),
+							true)), "size");
+    CHECK_TRUE(!index.remove(100000), "remove");
+
+    index.rebuild();
+    CHECK_TRUE(compara(index, v, vivo, g), "rebuild");
+}
+
+
+void test_rectangle_xy()
+{
+    test::interfaz("Spatial_index<Rectangle_xy>");
+
+    using Rect = alp::Rectangle_xy<int>;
+    using V    = alp::Vector_xy<int>;
+
+    alp::Spatial_index<Rect> index;
+    CHECK_TRUE(index.empty() and index.containing(V{0, 0}).empty(), "vacío");
+
+    size_t a = index.insert(Rect{V{0, 0}, 10, 5});	// [0,10) x [0, 5)
+    size_t b = index.insert(Rect{V{8, 3}, 4, 4});	// [8,12) x [3, 7)
+
+    CHECK_TRUE(ordena(index.containing(V{9, 4})) ==
+				(std::vector<size_t>{a, b}), "containing");
+    CHECK_TRUE(index.containing(V{9, 5}) == (std::vector<size_t>{b}),
+								"containing");
+    CHECK_TRUE(index.nearest(V{0, 10}, 1) == (std::vector<size_t>{a}),
+								"nearest");
+    CHECK_TRUE(index.intersecting(Rect{V{10, 0}, 5, 5}) ==
+				    (std::vector<size_t>{b}), "intersecting");
+
+    index.remove(b);
+    CHECK_TRUE(index.containing(V{9, 4}) == (std::vector<size_t>{a}),
+								"remove");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_spatial_index.h");
+
+    test_range_ij();
+    test_rectangle_xy();
+
+}catch(const std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+
+}
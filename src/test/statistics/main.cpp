@@ -19,8 +19,15 @@
 
 #include "../../alp_test.h"
 #include "../../alp_string.h"
+#include "../../alp_matrix.h"
+#include "../../alp_submatrix.h"
 
 #include <iostream>
+#include <list>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
 
 using namespace test;
 
@@ -47,6 +54,80 @@ void test_median()
     test_median(6, 4, 2, 4);
 }
 
+void test_percentile()
+{
+    test::interface("percentile");
+
+    std::vector<int> v{5, 1, 4, 2, 3};
+    CHECK_TRUE(alp::median(v.begin(), v.end()) == 3, "median (impar)");
+    CHECK_TRUE(alp::median(v.begin(), v.begin() + 4) == 2, "median (par)");
+    CHECK_TRUE(alp::percentile(v.begin(), v.end(), 0.0) == 1 and
+	       alp::percentile(v.begin(), v.end(), 0.2) == 1 and
+	       alp::percentile(v.begin(), v.end(), 0.21) == 2 and
+	       alp::percentile(v.begin(), v.end(), 1.0) == 5, "percentile");
+    CHECK_TRUE((v == std::vector<int>{5, 1, 4, 2, 3}), "no modifica v");
+
+    std::list<double> l{3.5, 0.5, 2.5};
+    CHECK_TRUE(alp::median(l.begin(), l.end()) == 2.5, "median(list)");
+
+    std::vector<int> x(1001);
+    for (size_t i = 0; i < x.size(); ++i)
+	x[i] = static_cast<int>((i * 37) % x.size());
+    CHECK_TRUE(alp::percentile_inplace(x.begin(), x.end(), 0.9) == 900, 
+						    "percentile_inplace");
+    CHECK_TRUE(alp::median_inplace(x.begin(), x.end()) == 500, 
+						    "median_inplace");
+
+    alp::Matrix<int> m{5, 6};
+    std::iota(m.begin(), m.end(), 0);
+    alp::Submatrix sm{m, alp::Vector_ij<size_t>{1, 1}, 
+			 alp::Size_ij<size_t>{3, 3}};
+    std::vector<int> buf;
+    CHECK_TRUE(alp::median(sm.begin(), sm.end(), buf) == 14, 
+						    "median(Submatrix)");
+
+    CHECK_EXCEPTION(alp::median(v.begin(), v.begin()), "median(vacio)");
+    CHECK_EXCEPTION(alp::percentile(v.begin(), v.end(), 1.5), "q > 1");
+}
+
+
+// Comprobamos la red con todas las entradas de ceros y unos: si funciona
+// para ellas funciona para cualquier entrada (principio 0-1).
+template <size_t N>
+bool test_median_of()
+{
+    for (uint32_t m = 0; m < (uint32_t{1} << N); ++m){
+	std::array<uint8_t, N> v;
+	size_t unos = 0;
+	for (size_t i = 0; i < N; ++i){
+	    v[i] = (m >> i) & 1;
+	    unos += v[i];
+	}
+
+	if (alp::median_of(v) != (unos > N / 2))
+	    return false;
+    }
+
+    return true;
+}
+
+
+void test_median_of()
+{
+    test::interface("median_of");
+
+    CHECK_TRUE(test_median_of<3>(), "3");
+    CHECK_TRUE(test_median_of<9>(), "9");
+    CHECK_TRUE(test_median_of<15>(), "15");
+
+    std::array<double, 25> v;
+    for (size_t i = 0; i < v.size(); ++i)
+	v[i] = static_cast<double>((i * 7) % 25);
+    CHECK_TRUE(alp::median_of(v) == 12, "25");
+}
+
+
+
 void test_frequency_table()
 {
     test::interface("frequency_table");
@@ -71,8 +152,431 @@ void test_frequency_table()
     for (const auto& x: lsort)
 	std::cout << x.first << " = " << x.second << '\n';
 
+    t.add("d", 10);
+    auto top = t.most_frequent(2);
+    CHECK_TRUE((top == std::vector<std::pair<std::string, size_t>>{
+			    {"d", 10}, {"a", 3}}), "most_frequent");
+    CHECK_TRUE(t.most_frequent(10).size() == 4, "most_frequent(k > size)");
+    CHECK_TRUE(t.most_frequent(0).empty(), "most_frequent(0)");
+}
+
+
+template <typename T>
+bool test_unique_count_unsorted(std::vector<T> v, unsigned num_threads)
+{
+    auto res = alp::unique_count_unsorted(v.begin(), v.end(), num_threads);
+
+    std::sort(v.begin(), v.end());
+    auto ok = alp::unique_count(v.begin(), v.end());
+
+    if constexpr (!std::is_integral_v<T>)
+	std::sort(res.begin(), res.end());
+
+    return res == ok;
+}
+
+
+void test_unique_count_unsorted()
+{
+    test::interface("unique_count_unsorted");
+
+    std::vector<int64_t> x(300000);
+    uint32_t s = 1;
+    for (auto& a: x){
+	s = s * 1664525u + 1013904223u;
+	a = static_cast<int64_t>(s % 5000) - 2500 + 
+				    (s % 3 == 0? (int64_t{1} << 40) : 0);
+    }
+
+    CHECK_TRUE(test_unique_count_unsorted(x, 1), "int64_t (1 thread)");
+    CHECK_TRUE(test_unique_count_unsorted(x, 4), "int64_t (4 threads)");
+
+    std::vector<int16_t> y(x.begin(), x.end());
+    CHECK_TRUE(test_unique_count_unsorted(y, 1), "int16_t (1 thread)");
+    CHECK_TRUE(test_unique_count_unsorted(y, 3), "int16_t (3 threads)");
+
+    std::vector<uint8_t> z(x.begin(), x.end());
+    CHECK_TRUE(test_unique_count_unsorted(z, 0), "uint8_t");
+
+    std::vector<std::string> w;
+    for (size_t i = 0; i < 200000; ++i)
+	w.push_back(std::to_string(x[i] % 100));
+    CHECK_TRUE(test_unique_count_unsorted(w, 1), "string (1 thread)");
+    CHECK_TRUE(test_unique_count_unsorted(w, 3), "string (3 threads)");
+
+    std::list<int> l{3, -1, 3, 2, -1, 3};
+    auto res = alp::unique_count_unsorted(l.begin(), l.end());
+    CHECK_TRUE((res == std::vector<std::pair<int, size_t>>{
+				    {-1, 2}, {2, 1}, {3, 3}}), "list");
+
+    std::vector<int> vacio;
+    CHECK_TRUE(alp::unique_count_unsorted(vacio.begin(), vacio.end()).empty(),
+								    "vacio");
+
+    alp::most_frequent(res, 2);
+    CHECK_TRUE((res == std::vector<std::pair<int, size_t>>{{3, 3}, {-1, 2}}),
+							    "most_frequent");
+}
+
+
+// Estadísticos calculados directamente
+struct Estadisticos{
+    double mean = 0, var = 0, skew = 0, kurt = 0, min, max;
+
+    Estadisticos(const std::vector<double>& x)
+    {
+	double n = x.size();
+	for (auto v: x) mean += v;
+	mean /= n;
+
+	double m2 = 0, m3 = 0, m4 = 0;
+	for (auto v: x){
+	    double d = v - mean;
+	    m2 += d*d; m3 += d*d*d; m4 += d*d*d*d;
+	}
+
+	var = m2 / n;
+	skew = std::sqrt(n) * m3 / std::pow(m2, 1.5);
+	kurt = n * m4 / (m2*m2) - 3;
+	min = *std::min_element(x.begin(), x.end());
+	max = *std::max_element(x.begin(), x.end());
+    }
+};
+
+bool casi_igual(double a, double b)
+{ return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b)); }
+
+bool igual(const alp::Online_statistics<>& st, const Estadisticos& e)
+{
+    return casi_igual(st.mean(), e.mean) and casi_igual(st.variance(), e.var)
+	and casi_igual(st.skewness(), e.skew) 
+	and casi_igual(st.kurtosis(), e.kurt)
+	and st.min() == e.min and st.max() == e.max;
+}
+
+void test_online_statistics()
+{
+    test::interface("Online_statistics");
+
+    std::mt19937 gen{1234};
+    std::exponential_distribution<double> d{0.5};
+    std::vector<double> x;
+    for (int i = 0; i < 10001; ++i)
+	x.push_back(1000 + d(gen));
+
+    Estadisticos e{x};
+
+    {
+    alp::Online_statistics<> st;
+    for (auto v: x)
+	st.add(v);
+
+    CHECK_TRUE(st.count() == x.size(), "count");
+    CHECK_TRUE(igual(st, e), "add(x)");
+    CHECK_TRUE(casi_igual(st.sum(), e.mean * x.size()), "sum");
+    CHECK_TRUE(casi_igual(st.sample_variance(), 
+			  e.var * x.size() / (x.size() - 1)), "sample_variance");
+    }
+    {
+    alp::Online_statistics<> st{x.begin(), x.end()};
+    CHECK_TRUE(igual(st, e), "add(p0, pe) por bloques");
+
+    std::list<double> l{x.begin(), x.end()};
+    alp::Online_statistics<> st2{l.begin(), l.end()};
+    CHECK_TRUE(igual(st2, e), "add(p0, pe) list");
+    }
+    {// merge en paralelo
+    std::vector<alp::Online_statistics<>> st(4);
+    std::vector<std::thread> th;
+    size_t n = x.size() / 4;
+    for (size_t k = 0; k < 4; ++k){
+	auto p0 = x.begin() + k*n;
+	auto pe = (k == 3)? x.end() : p0 + n;
+	th.emplace_back([&st, k, p0, pe]{ st[k].add(p0, pe); });
+    }
+
+    for (auto& t: th) t.join();
+
+    alp::Online_statistics<> res;
+    for (auto& s: st)
+	res += s;
+
+    CHECK_TRUE(igual(res, e), "merge");
+    CHECK_TRUE(igual(alp::Online_statistics<>{} + res, e), "merge(vacío)");
+    }
+    {
+    alp::Online_statistics<> st;
+    CHECK_EXCEPTION(st.mean(), "mean(vacío)");
+    st.add(2);
+    CHECK_TRUE(st.variance() == 0 and st.skewness() == 0, "1 elemento");
+    CHECK_EXCEPTION(st.sample_variance(), "sample_variance(1 elemento)");
+    }
 }
 
+void test_online_statistics_matrix()
+{
+    test::interface("Online_statistics(Matrix)");
+
+    alp::Matrix<int> m{10, 20};
+    int k = 0;
+    for (auto& x: m)
+	x = (k++ * 7) % 23;
+
+    {
+    alp::Online_statistics<> st;
+    st.add_rows(m);
+    Estadisticos e{std::vector<double>(m.begin(), m.end())};
+    CHECK_TRUE(igual(st, e), "Matrix");
+    }
+    {
+    alp::Submatrix sm{m, alp::Vector_ij<size_t>{2, 3}, 
+			 alp::Size_ij<size_t>{4, 5}};
+    alp::Online_statistics<> st;
+    st.add_rows(sm);
+    Estadisticos e{std::vector<double>(sm.begin(), sm.end())};
+    CHECK_TRUE(st.count() == 20 and igual(st, e), "Submatrix");
+    }
+}
+
+void test_online_covariance()
+{
+    test::interface("Online_covariance");
+
+    std::vector<double> x, y;
+    std::mt19937 gen{4321};
+    std::normal_distribution<double> d{0, 1};
+    for (int i = 0; i < 1000; ++i){
+	x.push_back(d(gen));
+	y.push_back(2 * x.back() + d(gen));
+    }
+
+    double mx = 0, my = 0;
+    for (size_t i = 0; i < x.size(); ++i){ mx += x[i]; my += y[i]; }
+    mx /= x.size(); my /= y.size();
+
+    double c = 0, sx = 0, sy = 0;
+    for (size_t i = 0; i < x.size(); ++i){
+	c += (x[i] - mx) * (y[i] - my);
+	sx += (x[i] - mx) * (x[i] - mx);
+	sy += (y[i] - my) * (y[i] - my);
+    }
+
+    alp::Online_covariance<> a, b;
+    a.add(x.begin(), x.begin() + 300, y.begin());
+    b.add(x.begin() + 300, x.end(), y.begin() + 300);
+    a += b;
+
+    CHECK_TRUE(a.count() == 1000, "count");
+    CHECK_TRUE(casi_igual(a.mean_x(), mx) and casi_igual(a.mean_y(), my), 
+								    "mean");
+    CHECK_TRUE(casi_igual(a.covariance(), c / x.size()), "covariance");
+    CHECK_TRUE(casi_igual(a.correlation(), c / std::sqrt(sx * sy)), 
+								"correlation");
+}
+
+void test_quantile_sketch()
+{
+    test::interfaz("Quantile_sketch");
+
+    std::vector<double> x(100000);
+    for (size_t i = 0; i < x.size(); ++i)
+	x[i] = static_cast<double>((i * 7919) % x.size());
+
+    alp::Quantile_sketch<double> a;
+    alp::Quantile_sketch<double> b;
+    a.add(x.begin(), x.begin() + 60000);
+    b.add(x.begin() + 60000, x.end());
+    a += b;
+
+    CHECK_TRUE(a.count() == x.size(), "count");
+    CHECK_TRUE(a.num_retained() < 1000, "num_retained");
+    CHECK_TRUE(a.min() == 0 and a.max() == x.size() - 1, "min/max");
+
+    for (double q: {0.01, 0.25, 0.5, 0.9, 0.99}){
+	double e = a.quantile(q) / x.size() - q;
+	CHECK_TRUE(std::abs(e) < 0.02, "quantile");
+    }
+
+    CHECK_TRUE(std::abs(a.rank(50000) - 0.5) < 0.02, "rank");
+
+    std::stringstream s;
+    a.save(s);
+    alp::Quantile_sketch<double> c{50};
+    c.load(s);
+    CHECK_TRUE(c.k() == a.k() and c.count() == a.count() and
+	       c.quantile(0.5) == a.quantile(0.5), "save/load");
+
+    {// tamaños corruptos: no se reserva memoria a partir de ellos
+    std::string b = s.str();
+    std::stringstream mal{b.substr(0, b.size() - 8)};
+    CHECK_EXCEPTION(c.load(mal), "load(fin de fichero)");
+
+    // tamaño del nivel 0 (va después de marca, k, n, min, max y niveles)
+    size_t i = 4 + 4 + 8 + 8 + 8 + 8;
+    uint64_t n = uint64_t{1} << 60;
+    b.replace(i, sizeof(n), reinterpret_cast<const char*>(&n), sizeof(n));
+    std::stringstream mal2{b};
+    CHECK_EXCEPTION(c.load(mal2), "load(tamaño)");
+    CHECK_TRUE(c.count() == a.count(), "load(no modifica)");
+    }
+
+    alp::Quantile_sketch<double> vacio;
+    CHECK_EXCEPTION(vacio.quantile(0.5), "quantile(vacio)");
+    CHECK_EXCEPTION(a.merge(alp::Quantile_sketch<double>{100}), "merge(k)");
+}
+
+
+void test_hyperloglog()
+{
+    test::interfaz("Hyperloglog");
+
+    alp::Hyperloglog a;
+    alp::Hyperloglog b;
+    for (int i = 0; i < 60000; ++i){
+	a.add(i);
+	a.add(i);   // los repetidos no cuentan
+    }
+    for (int i = 40000; i < 100000; ++i)
+	b.add(i);
+
+    a += b;
+    CHECK_TRUE(std::abs(a.estimate() / 100000 - 1) < 0.03, "estimate");
+
+    alp::Hyperloglog p;
+    for (int i = 0; i < 100; ++i)
+	p.add(std::to_string(i));
+    CHECK_TRUE(std::abs(p.estimate() - 100) < 3, "estimate (pocos)");
+
+    std::stringstream s;
+    a.save(s);
+    alp::Hyperloglog c{4};
+    c.load(s);
+    CHECK_TRUE(c.p() == a.p() and c.estimate() == a.estimate(), "save/load");
+
+    CHECK_EXCEPTION(alp::Hyperloglog{3}, "p < 4");
+    CHECK_EXCEPTION(a.merge(alp::Hyperloglog{10}), "merge(p)");
+
+    std::stringstream mal{"no es un sketch"};
+    CHECK_EXCEPTION(c.load(mal), "load(formato)");
+
+    {// p incorrecto
+    std::string b = s.str();
+    b[4] = 40;
+    std::stringstream mal2{b};
+    try{
+	c.load(mal2);
+	CHECK_TRUE(false, "load(p)");
+    }
+    catch(const alp::Error_de_formato&){
+	CHECK_TRUE(true, "load(p)");
+    }
+    }
+
+    {// Para p < 7 alfa no sigue la fórmula general
+    for (uint8_t p: {4, 5, 6, 7}){
+	alp::Hyperloglog h{p};
+	for (int i = 0; i < 2000; ++i)
+	    h.add(i);
+	CHECK_TRUE(std::abs(h.estimate() / 2000 - 1) < 
+			    4 * 1.04 / std::sqrt(double(1 << p)), "alfa");
+    }
+    }
+}
+
+
+void test_count_min_sketch()
+{
+    test::interfaz("Count_min_sketch");
+
+    alp::Count_min_sketch<int> a{1024, 4};
+    alp::Count_min_sketch<int> b{1024, 4};
+    for (int i = 0; i < 10000; ++i){
+	a.add(i);
+	b.add(i % 10, 5);
+    }
+
+    a += b;
+    CHECK_TRUE(a.count() == 10000 + 50000, "count");
+
+    bool ok = true;
+    for (int i = 0; i < 10; ++i)
+	ok = ok and a.estimate(i) >= 5001 and a.estimate(i) < 5001 + 200;
+    CHECK_TRUE(ok, "estimate");
+
+    std::stringstream s;
+    a.save(s);
+    alp::Count_min_sketch<int> c{1, 1};
+    c.load(s);
+    CHECK_TRUE(c.count() == a.count() and c.estimate(3) == a.estimate(3),
+								"save/load");
+
+    CHECK_EXCEPTION(a.merge(alp::Count_min_sketch<int>{512, 4}), "merge");
+
+    {// width * depth enorme
+    std::string b = s.str();
+    uint32_t w = 0xFFFFFFFF;
+    b.replace(4, sizeof(w), reinterpret_cast<const char*>(&w), sizeof(w));
+    b.replace(8, sizeof(w), reinterpret_cast<const char*>(&w), sizeof(w));
+    std::stringstream mal{b};
+    CHECK_EXCEPTION(c.load(mal), "load(tamaño)");
+
+    uint32_t cero = 0;
+    b.replace(4, sizeof(cero), reinterpret_cast<const char*>(&cero), 4);
+    std::stringstream mal2{b};
+    CHECK_EXCEPTION(c.load(mal2), "load(width = 0)");
+    CHECK_TRUE(c.count() == a.count(), "load(no modifica)");
+    }
+}
+
+
+void test_top_k()
+{
+    test::interfaz("Top_k");
+
+    alp::Top_k<std::string> a{3};
+    alp::Top_k<std::string> b{3};
+
+    for (int i = 0; i < 1000; ++i){
+	a.add("ruido" + std::to_string(i));
+	b.add("ruido" + std::to_string(i + 1000));
+    }
+    a.add("uno", 300);
+    a.add("dos", 200);
+    b.add("dos", 200);
+    b.add("tres", 250);
+
+    a += b;
+    auto v = a.as_sorted_vector();
+
+    CHECK_TRUE(v.size() == 3, "size");
+    CHECK_TRUE(v[0].first == "dos" and v[1].first == "uno" and
+	       v[2].first == "tres", "as_sorted_vector");
+    CHECK_TRUE(v[0].second >= 400, "frecuencia");
+
+    std::stringstream s;
+    a.save(s);
+    alp::Top_k<std::string> c{1};
+    c.load(s);
+    CHECK_TRUE(c.as_sorted_vector() == v, "save/load");
+
+    CHECK_EXCEPTION(alp::Top_k<std::string>{0}, "k = 0");
+
+    {
+    std::string b = s.str();
+    uint64_t k = 0;
+    b.replace(4, sizeof(k), reinterpret_cast<const char*>(&k), sizeof(k));
+    std::stringstream mal{b};
+    CHECK_EXCEPTION(c.load(mal), "load(k = 0)");
+
+    k = uint64_t{1} << 62;	// no se reservan k candidatos
+    b.replace(4, sizeof(k), reinterpret_cast<const char*>(&k), sizeof(k));
+    std::stringstream mal2{b};
+    c.load(mal2);
+    CHECK_TRUE(c.k() == k and c.as_sorted_vector() == v, "load(k grande)");
+    }
+}
+
+
 
 int main()
 {
@@ -80,7 +584,17 @@ try{
     test::header("alp::statistics");
 
     test_median();
+    test_percentile();
+    test_median_of();
     test_frequency_table();
+    test_unique_count_unsorted();
+    test_online_statistics();
+    test_online_statistics_matrix();
+    test_online_covariance();
+    test_quantile_sketch();
+    test_hyperloglog();
+    test_count_min_sketch();
+    test_top_k();
 
 }catch(std::exception& e)
 {
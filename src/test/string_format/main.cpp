@@ -0,0 +1,144 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../alp_string.h"
+#include "../../alp_test.h"
+
+#include <iostream>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+using namespace alp;
+using namespace test;
+
+struct Punto{ int x, y; };
+
+std::ostream& operator<<(std::ostream& out, const Punto& p)
+{ return out << '(' << p.x << ", " << p.y << ')'; }
+
+
+void test_as_chars()
+{
+    test::interfaz("as_chars");
+
+    {
+    std::string s = alp::as_chars() << "f(" << 12 << ", " << -3 << ", "
+				    << 'c' << ", " << true << ")";
+    CHECK_TRUE(s == "f(12, -3, c, 1)", "as_chars");
+    }
+    {// los números en coma flotante se escriben igual que con as_str
+    double x = 0.1 + 0.2;
+    std::string s1 = alp::as_chars() << x << ' ' << 1.0/3.0 << ' ' << 1e20f;
+    std::string s2 = alp::as_str() << x << ' ' << 1.0/3.0 << ' ' << 1e20f;
+    CHECK_TRUE(s1 == s2, "as_chars(double)");
+    }
+    {// los char se escriben como caracteres, igual que con as_str
+    unsigned char a = 'A';
+    signed char b = 'B';
+    uint8_t c = 'C';
+    std::string s1 = alp::as_chars() << a << b << c;
+    std::string s2 = alp::as_str() << a << b << c;
+    CHECK_TRUE(s1 == s2 and s1 == "ABC", "as_chars(unsigned char)");
+    }
+    {
+    std::string s = alp::as_chars() << Punto{2, 3} << std::string{"!"};
+    CHECK_TRUE(s == "(2, 3)!", "as_chars(operator<<)");
+    }
+    {
+    char c = static_cast<char>(0xC3);
+    std::string s = alp::as_chars() << "0x" << hex(c) << " 0x" << hex(255);
+    CHECK_TRUE(s == "0xc3 0xff", "as_chars(hex)");
+    }
+    {
+    alp::as_chars<6> s;
+    s << "abc" << "defgh" << "ijk";
+    CHECK_TRUE(s.view() == "abc..." and s.truncated(), "as_chars(truncated)");
+    }
+}
+
+
+void test_str_writer()
+{
+    test::interfaz("Str_writer");
+
+    std::string msg;
+    Str_writer{msg} << "i = " << 10 << "; x = " << 2.5;
+    CHECK_TRUE(msg == "i = 10; x = 2.5", "Str_writer");
+
+    Str_writer{msg} << Punto{1, 2};
+    CHECK_TRUE(msg == "(1, 2)", "Str_writer(reutilizada)");
+}
+
+
+void test_to()
+{
+    test::interfaz("to/to_string");
+
+    CHECK_TRUE(alp::to<int>("  -34") == -34, "to<int>");
+    CHECK_TRUE(alp::to<int>(std::string{"+34"}) == 34, "to<int>");
+    CHECK_TRUE(alp::to<double>("2.5") == 2.5, "to<double>");
+    CHECK_TRUE(alp::to<std::string>(123) == "123", "to<string>");
+    CHECK_TRUE(alp::to_string(-7) == "-7", "to_string(int)");
+    CHECK_TRUE(alp::to_string(0.5) == "0.5", "to_string(double)");
+    CHECK_TRUE(alp::to_string(Punto{1, 2}) == "(1, 2)", "to_string(Punto)");
+
+    // Los char son caracteres
+    CHECK_TRUE(alp::to_string(uint8_t{65}) == "A", "to_string(uint8_t)");
+    CHECK_TRUE(alp::to<std::string>('x') == "x", "to<string>(char)");
+    CHECK_TRUE(alp::to<unsigned char>("65") == '6', "to<unsigned char>");
+    CHECK_TRUE(alp::to<signed char>(" 7") == '7', "to<signed char>");
+
+    // Fuera de rango: como operator>>, se satura
+    CHECK_TRUE(alp::to<int>("99999999999") == std::numeric_limits<int>::max(),
+						    "to<int>(overflow)");
+    CHECK_TRUE(alp::to<int>(" -99999999999") == 
+		    std::numeric_limits<int>::lowest(), "to<int>(-overflow)");
+    CHECK_TRUE(alp::to<uint16_t>("+70000") == 65535 and
+	       alp::to<int16_t>("-40000") == -32768, "to<uint16_t/int16_t>");
+    CHECK_TRUE(alp::to<uint64_t>("99999999999999999999999") ==
+		    std::numeric_limits<uint64_t>::max(), "to<uint64_t>");
+
+    auto stream = [](const char* s) {
+	double y;
+	std::stringstream ss{s};
+	ss >> y;
+	return y;
+    };
+    CHECK_TRUE(alp::to<double>("1e999") == stream("1e999") and
+	       alp::to<double>("-1e999") == stream("-1e999") and
+	       alp::to<double>("1e-999") == stream("1e-999"), "to<double>");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_string.h: as_chars, Str_writer, to");
+
+    test_as_chars();
+    test_str_writer();
+    test_to();
+
+}catch(std::exception& e)
+{
+    cerr << e.what() << endl;
+    return 1;
+}
+
+}
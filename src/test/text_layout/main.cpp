@@ -0,0 +1,153 @@
+// Copyright (C) 2026 Manuel Perez <manuel2perez@proton.me>
+//
+// This file is part of the ALP Library.
+//
+// ALP Library is a free library: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "../../alp_text_layout.h"
+#include "../../alp_test.h"
+
+#include <iostream>
+#include <sstream>
+
+using namespace test;
+
+void test_display_width()
+{
+    test::interfaz("display_width");
+
+    CHECK_TRUE(alp::display_width("") == 0, "vacía");
+    CHECK_TRUE(alp::display_width("hola") == 4, "ASCII");
+    CHECK_TRUE(alp::display_width("está") == 4, "acentos");
+    CHECK_TRUE(alp::display_width("nin\u0303o") == 4, "acento combinado");
+    CHECK_TRUE(alp::display_width("日本") == 4, "CJK");
+    CHECK_TRUE(alp::display_width("한국") == 4, "hangul");
+    CHECK_TRUE(alp::display_width("a\U0001F600b") == 4, "emoji");
+    CHECK_TRUE(alp::display_width("a\tb") == 2, "control");
+    CHECK_TRUE(alp::display_width(std::string_view{"\xE6\x97", 2}) == 2, 
+						    "UTF-8 incompleto");
+
+    const char* p = "ñ";
+    CHECK_TRUE(alp::utf8_decode(p, p + 2) == U'ñ', "utf8_decode");
+}
+
+void test_wrap_lines(const std::string& s, size_t ancho_max, 
+					    const std::string& res)
+{
+    std::string out(s.size(), '\0');
+    alp::wrap_lines(s.data(), s.data() + s.size(), ancho_max, out.data());
+    CHECK_TRUE(out == res, "wrap_lines(" + s + ")");
+
+    // sobre sí mismo
+    out = s;
+    alp::wrap_lines(out.data(), out.data() + out.size(), ancho_max, out.data());
+    CHECK_TRUE(out == res, "wrap_lines(in == out)");
+}
+
+void test_wrap_lines()
+{
+    test::interfaz("wrap_lines");
+
+    test_wrap_lines("", 10, "");
+    test_wrap_lines("123456 12345 1234 123 12 1", 5, 
+		    "123456\n12345\n1234\n123\n12 1");
+    test_wrap_lines("multicolor nació", 10, "multicolor\nnació");
+    test_wrap_lines("uno\ndos tres cuatro", 8, "uno\ndos tres\ncuatro");
+    test_wrap_lines("está aquí ahora", 9, "está aquí\nahora");
+    test_wrap_lines("日本 日本 日本", 5, "日本\n日本\n日本");
+
+    CHECK_TRUE(alp::split_lineas_ancho("está aquí ahora", 9) 
+		== "está aquí\nahora", "split_lineas_ancho");
+}
+
+void test_alineacion()
+{
+    test::interfaz("append_alineado");
+
+    std::string s;
+    alp::append_alineado(s, "está", 6);
+    CHECK_TRUE(s == "está  ", "izquierda");
+
+    s.clear();
+    alp::append_alineado(s, "está", 6, alp::Alineacion::derecha);
+    CHECK_TRUE(s == "  está", "derecha");
+
+    s.clear();
+    alp::append_alineado(s, "está", 7, alp::Alineacion::centro, '.');
+    CHECK_TRUE(s == ".está..", "centro");
+
+    s.clear();
+    alp::append_alineado(s, "está", 2);
+    CHECK_TRUE(s == "está", "no cabe");
+
+    std::string s1 = "está";
+    std::string s2 = "nos vemos";
+    alp::mismo_ancho_y_centradas(s1, s2);
+    CHECK_TRUE(s1 == "  está   ", "mismo_ancho_y_centradas");
+    CHECK_TRUE(s2 == "nos vemos", "mismo_ancho_y_centradas");
+}
+
+void test_text_table()
+{
+    test::interfaz("Text_table");
+
+    alp::Text_table t{3};
+    t.alineacion(0, alp::Alineacion::derecha);
+    t.add_row(1, "=", "uno");
+    t.add_row(10, "=", "diez");
+    t.add_row(100, "=", "cien");
+    t.add_row("año", "=", 2.5);
+
+    CHECK_TRUE(t.rows() == 4 and t.cols() == 3, "rows/cols");
+    CHECK_TRUE(t.ancho(0) == 3 and t.ancho(2) == 4, "ancho");
+
+    CHECK_TRUE(t.format() == 
+		"  1 = uno\n"
+		" 10 = diez\n"
+		"100 = cien\n"
+		"año = 2.5\n", "format");
+
+    std::ostringstream out;
+    out << t;
+    CHECK_TRUE(out.str() == t.format(), "operator<<");
+
+    alp::Text_table t2{2, " | "};
+    t2.alineacion(1, alp::Alineacion::centro);
+    t2.add_row("日本", 'x');
+    t2.add_row('y', "abcd");
+    CHECK_TRUE(t2.format() == 
+		"日本 |  x\n"
+		"y    | abcd\n", "separador y centro");
+
+    CHECK_EXCEPTION(t2.add_row(1, 2, 3), "add_row(num columnas incorrecto)");
+    CHECK_EXCEPTION(alp::Text_table{0}, "Text_table{0}");
+}
+
+
+int main()
+{
+try{
+    test::header("alp_text_layout.h");
+
+    test_display_width();
+    test_wrap_lines();
+    test_alineacion();
+    test_text_table();
+
+}catch(std::exception& e)
+{
+    std::cerr << e.what() << '\n';
+    return 1;
+}
+}
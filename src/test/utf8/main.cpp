@@ -18,6 +18,7 @@
 #include "../../alp_utf8.h"
 #include "../../alp_string.h"
 #include "../../alp_test.h"
+#include "../../alp_iso88591.h"
 
 #include <fstream>
 #include <map>
@@ -365,6 +366,62 @@ void test_to_iso88951()
 
 }
 
+void test_iso88951_to_utf8()
+{
+    test::interfaz("iso88951_to_utf8/utf8_to_iso88951");
+
+    // "año, canción" en ISO-8895-1
+    std::string iso = "a\xF1o, canci\xF3n";
+    std::string utf8 = "año, canción";
+
+    CHECK_TRUE(iso88951_to_utf8_size(iso.data(), iso.data() + iso.size())
+						    == utf8.size(),
+	       "iso88951_to_utf8_size");
+    CHECK_TRUE(iso88951_to_utf8(iso) == utf8, "iso88951_to_utf8");
+
+    CHECK_TRUE(utf8_to_iso88951_size(utf8.data(), utf8.data() + utf8.size())
+						    == iso.size(),
+	       "utf8_to_iso88951_size");
+    CHECK_TRUE(utf8_to_iso88951(utf8) == iso, "utf8_to_iso88951");
+
+    // caracteres que no son ISO-8895-1
+    CHECK_TRUE(utf8_to_iso88951("aઅb🚕c") == "a?b?c", "utf8_to_iso88951(no iso)");
+    CHECK_TRUE(utf8_to_iso88951("aઅb", '_') == "a_b", "utf8_to_iso88951(no iso)");
+
+    // Cadenas largas: probamos el camino rápido de 16 bytes
+    std::string ascii(100, 'x');
+    CHECK_TRUE(iso88951_to_utf8(ascii + iso + ascii) == ascii + utf8 + ascii,
+	       "iso88951_to_utf8(largo)");
+    CHECK_TRUE(utf8_to_iso88951(ascii + utf8 + ascii) == ascii + iso + ascii,
+	       "utf8_to_iso88951(largo)");
+
+    // Todos los caracteres ISO-8895-1
+    std::string all;
+    for (int i = 1; i < 256; ++i)
+	all.push_back(static_cast<char>(i));
+
+    CHECK_TRUE(utf8_to_iso88951(iso88951_to_utf8(all)) == all,
+	       "utf8_to_iso88951(iso88951_to_utf8(x)) == x");
+
+    std::ifstream in{"iso88951.in"};
+    std::string s{std::istreambuf_iterator<char>{in},
+		  std::istreambuf_iterator<char>{}};
+    CHECK_TRUE(iso88951_to_utf8(utf8_to_iso88951(s)) == s,
+	       "iso88951_to_utf8(utf8_to_iso88951(iso88951.in))");
+}
+
+void test_iso88951_to_lower()
+{
+    test::interfaz("iso88951::to_lower");
+
+    std::string s = utf8_to_iso88951("AÁÑÜ xÿ×Ý");
+    CHECK_TRUE(iso88951_to_utf8(iso88951::to_lower(s)) == "aáñü xÿ×ý",
+	       "to_lower");
+    CHECK_TRUE(iso88951_to_utf8(iso88951::to_lower_without_accents(s))
+							== "aañu xÿ×ý",
+	       "to_lower_without_accents");
+}
+
 
 int main()
 {
@@ -379,6 +436,8 @@ try{
     test_split_words();
     test_map();
     test_to_iso88951();
+    test_iso88951_to_utf8();
+    test_iso88951_to_lower();
 
 }catch(std::exception& e){
     std::cerr << e.what() << '\n';